@@ -17,17 +17,20 @@ HOT_SOURCES = \
 	$(SRC)/Terrain/Intersection.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Screen/Memory/Canvas.cpp \
-	$(ENGINE_SRC_DIR)/Waypoints/Waypoints.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/Waypoints.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/WaypointIndex.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/MacCready.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlidePolar.cpp \
 	$(ENGINE_SRC_DIR)/Route/FlatTriangleFan.cpp \
 	$(ENGINE_SRC_DIR)/Route/FlatTriangleFanTree.cpp \
+	$(ENGINE_SRC_DIR)/Route/ReachRayCache.cpp \
 	$(ENGINE_SRC_DIR)/Route/ReachFan.cpp \
 	$(ENGINE_SRC_DIR)/Route/RoutePolar.cpp \
 	$(ENGINE_SRC_DIR)/Route/RouteLink.cpp \
 	$(ENGINE_SRC_DIR)/Route/RoutePolars.cpp \
+	$(ENGINE_SRC_DIR)/Route/TerrainClearanceCache.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/ContestDijkstra.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/TraceManager.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/TriangleContest.cpp
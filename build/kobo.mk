@@ -55,6 +55,7 @@ KOBO_POWER_OFF_SOURCES = \
 	$(SRC)/Hardware/DisplaySize.cpp \
 	$(SRC)/Screen/Layout.cpp \
 	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
 	$(SRC)/Renderer/FlightListRenderer.cpp \
 	$(SRC)/FlightInfo.cpp \
 	$(SRC)/Kobo/Model.cpp \
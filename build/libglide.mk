@@ -8,6 +8,7 @@ GLIDE_SOURCES = \
 	$(GLIDE_SRC_DIR)/PolarCoefficients.cpp \
 	$(GLIDE_SRC_DIR)/GlideResult.cpp \
 	$(GLIDE_SRC_DIR)/MacCready.cpp \
+	$(GLIDE_SRC_DIR)/GlideResultCache.cpp \
 	$(GLIDE_SRC_DIR)/InstantSpeed.cpp
 
 $(eval $(call link-library,libglide,GLIDE))
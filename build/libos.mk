@@ -11,6 +11,7 @@ OS_SOURCES := \
 	$(OS_SRC_DIR)/Path.cpp \
 	$(OS_SRC_DIR)/PathName.cpp \
 	$(OS_SRC_DIR)/Process.cpp \
+	$(OS_SRC_DIR)/ProcessorCount.cpp \
 	$(OS_SRC_DIR)/SystemLoad.cpp
 
 ifeq ($(HAVE_POSIX),y)
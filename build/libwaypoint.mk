@@ -2,6 +2,8 @@ WAYPOINT_SRC_DIR = $(SRC)/Engine/Waypoint
 
 WAYPOINT_SOURCES = \
 	$(WAYPOINT_SRC_DIR)/WaypointVisitor.cpp \
+	$(WAYPOINT_SRC_DIR)/WaypointIndex.cpp \
+	$(WAYPOINT_SRC_DIR)/WaypointNameIndex.cpp \
 	$(WAYPOINT_SRC_DIR)/Waypoints.cpp \
 	$(WAYPOINT_SRC_DIR)/Waypoint.cpp
 
@@ -35,6 +35,7 @@ LUA_SOURCES = \
         $(SRC)/Lua/Tracking.cpp \
 		$(SRC)/Lua/Replay.cpp \
 	    $(SRC)/Lua/InputEvent.cpp \
+	$(SRC)/Lua/ComputerTimers.cpp \
 
 LUA_CPPFLAGS_INTERNAL = $(LIBLUA_CPPFLAGS) $(SCREEN_CPPFLAGS)
 LUA_LDLIBS = $(LIBLUA_LDLIBS)
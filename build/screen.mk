@@ -218,6 +218,7 @@ SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/Memory/RawBitmap.cpp \
 	$(SCREEN_SRC_DIR)/Memory/VirtualCanvas.cpp \
 	$(SCREEN_SRC_DIR)/Memory/SubCanvas.cpp \
+	$(SCREEN_SRC_DIR)/Memory/BandPool.cpp \
 	$(SCREEN_SRC_DIR)/Memory/Canvas.cpp
 MEMORY_CANVAS_CPPFLAGS = -DUSE_MEMORY_CANVAS
 endif
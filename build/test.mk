@@ -85,23 +85,26 @@ $(foreach name,$(HARNESS_PROGRAMS),$(eval $(call link-harness-program,$(name))))
 TEST_NAMES = \
 	test_fixed \
 	TestWaypoints \
+	TestWaypointIndex \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
-	TestDateTime TestRoughTime TestWrapClock \
+	TestDateTime TestRoughTime TestWrapClock TestIdleScheduler \
 	TestMath \
 	TestMathTables \
 	TestAngle TestARange \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM TestProfile \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
-	TestLogger TestGRecord TestDriver TestClimbAvCalc \
+	TestRadixTree TestGeoBounds TestGeoClip TestTopographyPrefetch \
+	TestBufferAllocator \
+	TestLogger TestFlightIndex TestGRecord TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
-	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestColorRamp TestRasterBands TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
+	TestReachRayCache \
 	TestMacCready TestOrderedTask TestAATPoint \
 	TestPlanes \
 	TestTaskPoint \
@@ -115,6 +118,7 @@ TEST_NAMES = \
 	TestByteOrder2 \
 	TestStrings TestUTF8 \
 	TestCRC \
+	TestNMEAChecksum \
 	TestUnitsFormatter \
 	TestGeoPointFormatter \
 	TestHexColorFormatter \
@@ -140,6 +144,13 @@ TEST_CRC_SOURCES = \
 	$(TEST_SRC_DIR)/TestCRC.cpp
 $(eval $(call link-program,TestCRC,TEST_CRC))
 
+TEST_NMEA_CHECKSUM_SOURCES = \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Device/Util/ControlCharacter.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEAChecksum.cpp
+$(eval $(call link-program,TestNMEAChecksum,TEST_NMEA_CHECKSUM))
+
 TEST_LEASTSQUARES_SOURCES = \
 	$(SRC)/Math/LeastSquares.cpp \
 	$(SRC)/Math/XYDataStore.cpp \
@@ -164,9 +175,10 @@ $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFE
 
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCBulkReader.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestIGCParser.cpp
-TEST_IGC_PARSER_DEPENDS = MATH UTIL
+TEST_IGC_PARSER_DEPENDS = MATH OS TIME UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
 TEST_BYTE_ORDER_SOURCES = \
@@ -222,6 +234,12 @@ TEST_WRAP_CLOCK_SOURCES = \
 TEST_WRAP_CLOCK_DEPENDS = MATH TIME
 $(eval $(call link-program,TestWrapClock,TEST_WRAP_CLOCK))
 
+TEST_IDLE_SCHEDULER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/TestIdleScheduler.cpp
+$(eval $(call link-program,TestIdleScheduler,TEST_IDLE_SCHEDULER))
+
 TEST_PROFILE_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
@@ -402,6 +420,19 @@ TEST_GEO_BOUNDS_SOURCES = \
 TEST_GEO_BOUNDS_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoBounds,TEST_GEO_BOUNDS))
 
+TEST_TOPOGRAPHY_PREFETCH_SOURCES = \
+	$(SRC)/Topography/Prefetch.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTopographyPrefetch.cpp
+TEST_TOPOGRAPHY_PREFETCH_DEPENDS = GEO MATH
+$(eval $(call link-program,TestTopographyPrefetch,TEST_TOPOGRAPHY_PREFETCH))
+
+TEST_BUFFER_ALLOCATOR_SOURCES = \
+	$(SRC)/Topography/BufferAllocator.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestBufferAllocator.cpp
+$(eval $(call link-program,TestBufferAllocator,TEST_BUFFER_ALLOCATOR))
+
 TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
@@ -567,6 +598,19 @@ TEST_FLAT_LINE_SOURCES = \
 TEST_FLAT_LINE_DEPENDS = GEO MATH
 $(eval $(call link-program,TestFlatLine,TEST_FLAT_LINE))
 
+TEST_REACH_RAY_CACHE_SOURCES = \
+	$(SRC)/Engine/Route/ReachRayCache.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestReachRayCache.cpp
+TEST_REACH_RAY_CACHE_DEPENDS = GEO MATH
+$(eval $(call link-program,TestReachRayCache,TEST_REACH_RAY_CACHE))
+
+TEST_WAYPOINT_INDEX_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointIndex.cpp
+TEST_WAYPOINT_INDEX_DEPENDS = WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,TestWaypointIndex,TEST_WAYPOINT_INDEX))
+
 TEST_THERMALBASE_SOURCES = \
 	$(SRC)/Computer/ThermalBase.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -588,6 +632,13 @@ TEST_COLOR_RAMP_SOURCES = \
 TEST_COLOR_RAMP_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,TestColorRamp,TEST_COLOR_RAMP))
 
+TEST_RASTER_BANDS_SOURCES = \
+	$(SRC)/Screen/Memory/BandPool.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRasterBands.cpp
+TEST_RASTER_BANDS_DEPENDS = OS THREAD UTIL
+$(eval $(call link-program,TestRasterBands,TEST_RASTER_BANDS))
+
 TEST_SUN_EPHEMERIS_SOURCES = \
 	$(SRC)/Math/SunEphemeris.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -628,14 +679,24 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/Util/MD5.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS GEO MATH THREAD UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
+TEST_FLIGHT_INDEX_SOURCES = \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
+	$(SRC)/FlightInfo.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlightIndex.cpp
+TEST_FLIGHT_INDEX_DEPENDS = IO OS TIME UTIL
+$(eval $(call link-program,TestFlightIndex,TEST_FLIGHT_INDEX))
+
 TEST_GRECORD_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Util/MD5.cpp \
@@ -696,6 +757,7 @@ TEST_WAY_POINT_FILE_SOURCES = \
 	$(SRC)/Waypoint/WaypointReaderFS.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
 	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/Factory.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/RadioFrequency.cpp \
@@ -737,9 +799,18 @@ DEBUG_PROGRAM_NAMES = \
 	RunTrace \
 	RunOLCAnalysis \
 	RunWaveComputer \
+	RunReplayBatch \
+	RunCalculationLatency \
 	FlightPath \
 	BenchmarkProjection \
+	BenchmarkRasterBands \
 	BenchmarkFAITriangleSector \
+	BenchmarkRoutePlanner \
+	BenchmarkWaypoints \
+	BenchmarkTaskSolvers \
+	BenchmarkOrderedTask \
+	BenchmarkNMEAParser \
+	BenchmarkIGCParser \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -825,6 +896,11 @@ ifeq ($(LUA),y)
 DEBUG_PROGRAM_NAMES += RunLua
 endif
 
+ifeq ($(OPENGL),y)
+# needs the OpenGL triangulation to build the index arrays
+DEBUG_PROGRAM_NAMES += PackTopography
+endif
+
 DEBUG_PROGRAMS = $(call name-to-bin,$(DEBUG_PROGRAM_NAMES))
 
 ifeq ($(LUA),y)
@@ -844,6 +920,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCBulkReader.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -907,6 +984,12 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+BENCHMARK_RASTER_BANDS_SOURCES = \
+	$(SRC)/Screen/Memory/BandPool.cpp \
+	$(TEST_SRC_DIR)/BenchmarkRasterBands.cpp
+BENCHMARK_RASTER_BANDS_DEPENDS = OS THREAD UTIL
+$(eval $(call link-program,BenchmarkRasterBands,BENCHMARK_RASTER_BANDS))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleSettings.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
@@ -914,6 +997,64 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_ROUTE_PLANNER_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/BenchmarkRoutePlanner.cpp
+BENCHMARK_ROUTE_PLANNER_LDADD = $(DRIVER_LDADD)
+BENCHMARK_ROUTE_PLANNER_DEPENDS = TERRAIN ROUTE GLIDE IO THREAD OS ZZIP GEO MATH UTIL TIME
+$(eval $(call link-program,BenchmarkRoutePlanner,BENCHMARK_ROUTE_PLANNER))
+
+BENCHMARK_WAYPOINTS_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkWaypoints.cpp
+BENCHMARK_WAYPOINTS_DEPENDS = WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,BenchmarkWaypoints,BENCHMARK_WAYPOINTS))
+
+BENCHMARK_TASK_SOLVERS_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskSolvers.cpp
+BENCHMARK_TASK_SOLVERS_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+$(eval $(call link-program,BenchmarkTaskSolvers,BENCHMARK_TASK_SOLVERS))
+
+BENCHMARK_ORDERED_TASK_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(TEST_SRC_DIR)/BenchmarkOrderedTask.cpp
+BENCHMARK_ORDERED_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+$(eval $(call link-program,BenchmarkOrderedTask,BENCHMARK_ORDERED_TASK))
+
+BENCHMARK_NMEA_PARSER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/ControlCharacter.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEAParser.cpp
+BENCHMARK_NMEA_PARSER_DEPENDS = DRIVER GEO MATH IO OS UTIL TIME
+$(eval $(call link-program,BenchmarkNMEAParser,BENCHMARK_NMEA_PARSER))
+
+BENCHMARK_IGC_PARSER_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCBulkReader.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIGCParser.cpp
+BENCHMARK_IGC_PARSER_DEPENDS = GEO MATH IO OS UTIL TIME
+$(eval $(call link-program,BenchmarkIGCParser,BENCHMARK_IGC_PARSER))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1115,6 +1256,7 @@ FIX_GRECORD_DEPENDS = IO OS UTIL
 $(eval $(call link-program,FixGRecord,FIX_GRECORD))
 
 ADD_CHECKSUM_SOURCES = \
+	$(SRC)/NMEA/Checksum.cpp \
 	$(TEST_SRC_DIR)/AddChecksum.cpp
 ADD_CHECKSUM_DEPENDS = IO
 $(eval $(call link-program,AddChecksum,ADD_CHECKSUM))
@@ -1134,6 +1276,7 @@ LOAD_TOPOGRAPHY_SOURCES = \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/PackedTopography.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Operation/Operation.cpp \
@@ -1146,6 +1289,20 @@ LOAD_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH THREAD IO UTIL SHAPELIB ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+PACK_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/PackedTopography.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp \
+	$(TEST_SRC_DIR)/PackTopography.cpp
+PACK_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH THREAD IO OS UTIL SHAPELIB ZZIP
+PACK_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,PackTopography,PACK_TOPOGRAPHY))
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/LoadTerrain.cpp
@@ -1567,17 +1724,21 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/Util/MD5.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL TIME
+RUN_IGC_WRITER_DEPENDS = GEO MATH THREAD UTIL TIME
 $(eval $(call link-program,RunIGCWriter,RUN_IGC_WRITER))
 
 RUN_FLIGHT_LOGGER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/CirclingComputer.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
+	$(SRC)/FlightInfo.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/RunFlightLogger.cpp
 RUN_FLIGHT_LOGGER_LDADD = $(DEBUG_REPLAY_LDADD)
@@ -1881,10 +2042,13 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/Thread.cpp \
+	$(SRC)/Topography/Prefetch.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
+	$(SRC)/Topography/BufferAllocator.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
 	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/PackedTopography.cpp \
 	$(SRC)/Topography/CachedTopographyRenderer.cpp \
 	$(SRC)/Units/Units.cpp \
 	$(SRC)/Units/Settings.cpp \
@@ -1910,6 +2074,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2198,6 +2363,7 @@ RUN_FLIGHT_LIST_RENDERER_SOURCES = \
 	$(SRC)/Renderer/FlightListRenderer.cpp \
 	$(SRC)/FlightInfo.cpp \
 	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
 	$(TEST_SRC_DIR)/FakeAsset.cpp \
 	$(TEST_SRC_DIR)/Fonts.cpp \
 	$(TEST_SRC_DIR)/RunFlightListRenderer.cpp
@@ -2332,6 +2498,8 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/ComputerTimers.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
 	$(SRC)/Computer/RouteComputer.cpp \
@@ -2389,6 +2557,91 @@ RUN_ANALYSIS_DEPENDS = \
 	CONTEST TASK ROUTE GLIDE WAYPOINT ROUTE AIRSPACE ZZIP UTIL GEO MATH TIME
 $(eval $(call link-program,RunAnalysis,RUN_ANALYSIS))
 
+RUN_REPLAY_BATCH_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/Wind/Settings.cpp \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalBase.cpp \
+	$(SRC)/Computer/ThermalBandComputer.cpp \
+	$(SRC)/Computer/GlideRatioCalculator.cpp \
+	$(SRC)/Computer/AutoQNH.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/AverageVarioComputer.cpp \
+	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/TaskComputer.cpp \
+	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/GlideComputerAirData.cpp \
+	$(SRC)/Computer/WaveComputer.cpp \
+	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/GlideComputerInterface.cpp \
+	$(SRC)/Computer/LogComputer.cpp \
+	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/Settings.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/Units/Temperature.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/Computer/ComputerTimers.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/ReplayEngine.cpp \
+	$(TEST_SRC_DIR)/RunReplayBatch.cpp
+RUN_REPLAY_BATCH_DEPENDS = \
+	TERRAIN \
+	DRIVER \
+	IO OS THREAD \
+	CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,RunReplayBatch,RUN_REPLAY_BATCH))
+
+RUN_CALCULATION_LATENCY_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/RunReplayBatch.cpp,$(RUN_REPLAY_BATCH_SOURCES)) \
+	$(TEST_SRC_DIR)/RunCalculationLatency.cpp
+RUN_CALCULATION_LATENCY_DEPENDS = $(RUN_REPLAY_BATCH_DEPENDS)
+$(eval $(call link-program,RunCalculationLatency,RUN_CALCULATION_LATENCY))
+
 RUN_AIRSPACE_WARNING_DIALOG_SOURCES = \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
 	$(SRC)/NMEA/FlyingState.cpp \
@@ -2508,6 +2761,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Formatter/Units.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2567,6 +2821,7 @@ $(eval $(call link-program,FeedVega,FEED_VEGA))
 EMULATE_DEVICE_SOURCES = \
 	$(SRC)/Device/Port/ConfiguredPort.cpp \
 	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/ControlCharacter.cpp \
 	$(SRC)/Device/Util/NMEAWriter.cpp \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
@@ -46,10 +46,10 @@ namespace ActionInterface {
 void
 XCSoarInterface::ReceiveGPS()
 {
-  {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  ReadBlackboardBasic(*device_blackboard->GetBasicSnapshot());
 
-    ReadBlackboardBasic(device_blackboard->Basic());
+  {
+    std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
 
     const NMEAInfo &real = device_blackboard->RealState();
     Private::movement_detected = real.alive && real.gps.real &&
@@ -66,10 +66,10 @@ XCSoarInterface::ReceiveGPS()
 void
 XCSoarInterface::ReceiveCalculated()
 {
-  {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  ReadBlackboardCalculated(*device_blackboard->GetCalculatedSnapshot());
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+  {
+    std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -87,7 +87,7 @@ XCSoarInterface::ExchangeBlackboard()
 void
 XCSoarInterface::ExchangeDeviceBlackboard()
 {
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
 
   device_blackboard->ReadComputerSettings(GetComputerSettings());
 }
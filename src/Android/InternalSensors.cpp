@@ -197,7 +197,7 @@ Java_org_xcsoar_InternalGPS_setConnected(JNIEnv *env, jobject obj,
 {
   unsigned index = getDeviceIndex(env, obj);
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
 
   switch (connected) {
@@ -234,7 +234,7 @@ Java_org_xcsoar_InternalGPS_setLocation(JNIEnv *env, jobject obj,
 {
   unsigned index = getDeviceIndex(env, obj);
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   basic.UpdateClock();
   basic.alive.Update(basic.clock);
@@ -300,7 +300,7 @@ Java_org_xcsoar_NonGPSSensors_setAcceleration(JNIEnv *env, jobject obj,
   // TODO
   /*
   const unsigned int index = getDeviceIndex(env, obj);
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   */
 }
@@ -314,7 +314,7 @@ Java_org_xcsoar_NonGPSSensors_setRotation(JNIEnv *env, jobject obj,
   // TODO
   /*
   const unsigned int index = getDeviceIndex(env, obj);
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   */
 }
@@ -328,7 +328,7 @@ Java_org_xcsoar_NonGPSSensors_setMagneticField(JNIEnv *env, jobject obj,
   // TODO
   /*
   const unsigned int index = getDeviceIndex(env, obj);
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   */
 }
@@ -381,7 +381,7 @@ Java_org_xcsoar_NonGPSSensors_setBarometricPressure(JNIEnv *env, jobject obj,
   static SelfTimingKalmanFilter1d kalman_filter(KF_MAX_DT, KF_VAR_ACCEL);
 
   const unsigned int index = getDeviceIndex(env, obj);
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
 
   /* Kalman filter updates are also protected by the blackboard
      mutex. These should not take long; we won't hog the mutex
@@ -74,7 +74,7 @@ Copyright_License {
   else
     location = nil;
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(self->index);
   basic.UpdateClock();
   if (location) {
@@ -132,7 +132,7 @@ Copyright_License {
 - (void)locationManager:(CLLocationManager *)manager
     didFailWithError:(NSError *)error
 {
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(self->index);
   if ([error code] != kCLErrorHeadingFailure) {
     basic.alive.Clear();
@@ -50,6 +50,9 @@ DeviceBlackboard::DeviceBlackboard()
 
   simulator.Init(simulator_data);
 
+  basic_snapshot.Publish(gps_info);
+  calculated_snapshot.Publish(calculated_info);
+
   real_clock.Reset();
   replay_clock.Reset();
 }
@@ -64,9 +67,9 @@ DeviceBlackboard::DeviceBlackboard()
 void
 DeviceBlackboard::SetStartupLocation(const GeoPoint &loc, const double alt)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
 
-  if (Calculated().flight.flying)
+  if (GetCalculatedSnapshot()->flight.flying)
     return;
 
   for (unsigned i = 0; i < unsigned(NUMDEV); ++i)
@@ -88,7 +91,7 @@ DeviceBlackboard::SetStartupLocation(const GeoPoint &loc, const double alt)
  * Stops the replay
  */
 void DeviceBlackboard::StopReplay() {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
 
   replay_data.Reset();
 
@@ -101,7 +104,7 @@ DeviceBlackboard::ProcessSimulation()
   if (!is_simulator())
     return;
 
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
 
   simulator.Process(simulator_data);
   ScheduleMerge();
@@ -110,7 +113,7 @@ DeviceBlackboard::ProcessSimulation()
 void
 DeviceBlackboard::SetSimulatorLocation(const GeoPoint &location)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
   NMEAInfo &basic = simulator_data;
 
   simulator.Touch(basic);
@@ -129,7 +132,7 @@ DeviceBlackboard::SetSimulatorLocation(const GeoPoint &location)
 void
 DeviceBlackboard::SetSpeed(double val)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
   NMEAInfo &basic = simulator_data;
 
   simulator.Touch(basic);
@@ -147,7 +150,7 @@ DeviceBlackboard::SetSpeed(double val)
 void
 DeviceBlackboard::SetTrack(Angle val)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
   simulator.Touch(simulator_data);
   simulator_data.track = val.AsBearing();
 
@@ -163,7 +166,7 @@ DeviceBlackboard::SetTrack(Angle val)
 void
 DeviceBlackboard::SetAltitude(double val)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
   NMEAInfo &basic = simulator_data;
 
   simulator.Touch(basic);
@@ -172,18 +175,6 @@ DeviceBlackboard::SetAltitude(double val)
   ScheduleMerge();
 }
 
-/**
- * Reads the given derived_info usually provided by the
- * GlideComputerBlackboard and saves it to the own Blackboard
- * @param derived_info Calculated information usually provided
- * by the GlideComputerBlackboard
- */
-void
-DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
-{
-  calculated_info = derived_info;
-}
-
 /**
  * Reads the given settings usually provided by the InterfaceBlackboard
  * and saves it to the own Blackboard
@@ -199,7 +190,7 @@ DeviceBlackboard::ReadComputerSettings(const ComputerSettings &settings)
 void
 DeviceBlackboard::ExpireWallClock()
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<InstrumentedMutex> lock(mutex);
   if (!Basic().alive)
     return;
 
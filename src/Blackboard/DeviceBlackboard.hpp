@@ -28,7 +28,8 @@ Copyright_License {
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
-#include "Thread/Mutex.hxx"
+#include "Thread/InstrumentedMutex.hpp"
+#include "Thread/Snapshot.hpp"
 #include "Time/WrapClock.hpp"
 
 #include <cassert>
@@ -79,8 +80,20 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * Copies of #gps_info (published by the MergeThread) and of the
+   * #DerivedInfo calculated by the CalculationThread, for consumers
+   * which shall not block the producers by locking #mutex.
+   */
+  SnapshotPublisher<MoreData> basic_snapshot;
+  SnapshotPublisher<DerivedInfo> calculated_snapshot;
+
 public:
-  Mutex mutex;
+  /**
+   * Protects all device data and #gps_info.  It measures how long
+   * its callers wait and how long they hold it.
+   */
+  InstrumentedMutex mutex;
 
 public:
   DeviceBlackboard();
@@ -91,7 +104,37 @@ public:
     devices = &_devices;
   }
 
-  void ReadBlackboard(const DerivedInfo &derived_info);
+  /**
+   * Publish the results of the CalculationThread.  The caller does
+   * not need to lock the blackboard.
+   */
+  void PublishCalculated(const DerivedInfo &derived_info) {
+    calculated_snapshot.Publish(derived_info);
+  }
+
+  /**
+   * Returns the latest #MoreData published by the MergeThread.  The
+   * caller does not need to lock the blackboard.
+   */
+  std::shared_ptr<const MoreData> GetBasicSnapshot() const {
+    return basic_snapshot.Get();
+  }
+
+  /**
+   * Returns the latest #DerivedInfo published by the
+   * CalculationThread.  The caller does not need to lock the
+   * blackboard.
+   */
+  std::shared_ptr<const DerivedInfo> GetCalculatedSnapshot() const {
+    return calculated_snapshot.Get();
+  }
+
+  /**
+   * The #DerivedInfo is not stored here anymore, use
+   * GetCalculatedSnapshot().
+   */
+  const DerivedInfo &Calculated() const = delete;
+
   void ReadComputerSettings(const ComputerSettings &settings);
 
 protected:
@@ -170,6 +213,14 @@ public:
    * Caller must lock the blackboard.
    */
   void Merge();
+
+  /**
+   * Publish a snapshot of gps_info, see GetBasicSnapshot().  Caller
+   * must lock the blackboard.
+   */
+  void PublishBasic() {
+    basic_snapshot.Publish(gps_info);
+  }
 };
 
 #endif
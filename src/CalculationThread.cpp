@@ -25,6 +25,7 @@ Copyright_License {
 #include "Computer/GlideComputer.hpp"
 #include "Protection.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
+#include "Device/IngestionTrace.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
 
@@ -33,30 +34,41 @@ Copyright_License {
  * @param _glide_computer The GlideComputer used for the CalculationThread
  */
 CalculationThread::CalculationThread(GlideComputer &_glide_computer)
-  :WorkerThread("CalcThread", 450, 100, 50),
+  :SuspensibleThread("CalcThread"),
+   trigger_flag(false),
    force(false),
-   glide_computer(_glide_computer) {
+   glide_computer(_glide_computer),
+   publish_pending(false)
+{
+  GlideComputer::AddIdleJobs(scheduler);
 }
 
 void
 CalculationThread::SetComputerSettings(const ComputerSettings &new_value)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<Mutex> lock(settings_mutex);
   settings_computer = new_value;
 }
 
 void
 CalculationThread::SetScreenDistanceMeters(double new_value)
 {
-  std::lock_guard<Mutex> lock(mutex);
+  std::lock_guard<Mutex> lock(settings_mutex);
   screen_distance_meters = new_value;
 }
 
-/**
- * Main loop of the CalculationThread
- */
 void
-CalculationThread::Tick() noexcept
+CalculationThread::PublishCalculated() noexcept
+{
+  // values changed, so copy them back now: ONLY CALCULATED INFO
+  // should be changed in DoCalculations, so we only need to write
+  // that one back (otherwise we may write over new data)
+  device_blackboard->PublishCalculated(glide_computer.Calculated());
+  publish_pending = false;
+}
+
+void
+CalculationThread::ProcessGPS(IdleScheduler::TimePoint now) noexcept
 {
 #ifdef HAVE_CPU_FREQUENCY
   const ScopeLockCPU cpu;
@@ -66,17 +78,19 @@ CalculationThread::Tick() noexcept
 
   // update and transfer master info to glide computer
   {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    /* the snapshot is immutable, it can be copied without locking
+       the DeviceBlackboard */
+    const auto basic = device_blackboard->GetBasicSnapshot();
 
-    gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+    gps_updated = basic->location_available.Modified(glide_computer.Basic().location_available);
 
     // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard->Basic());
+    glide_computer.ReadBlackboard(*basic);
   }
 
   bool force;
   {
-    std::lock_guard<Mutex> lock(mutex);
+    std::lock_guard<Mutex> lock(settings_mutex);
     // Copy settings from ComputerSettingsBlackboard to GlideComputerBlackboard
     glide_computer.ReadComputerSettings(settings_computer);
 
@@ -89,38 +103,105 @@ CalculationThread::Tick() noexcept
 
   glide_computer.Expire();
 
-  bool do_idle = false;
-
-  if (gps_updated || force)
-    // perform idle call if time advanced and slow calculations need to be updated
-    do_idle |= glide_computer.ProcessGPS(force);
+  if (gps_updated) {
+    /* the return value (the old 500 ms idle clock) is obsolete, the
+       IdleScheduler decides when to run the slow calculations */
+    glide_computer.ProcessGPS(force);
+    ingestion_trace.Calculated();
 
-  // values changed, so copy them back now: ONLY CALCULATED INFO
-  // should be changed in DoCalculations, so we only need to write
-  // that one back (otherwise we may write over new data)
-  {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
+    if (force)
+      scheduler.Force(now);
+    else
+      scheduler.MarkDirty(now);
   }
 
+  PublishCalculated();
+
   // if (new GPS data)
-  if (gps_updated || force)
+  if (gps_updated)
     // inform map new data is ready
     TriggerCalculatedUpdate();
+}
 
-  if (do_idle) {
-    // do slow calculations last, to minimise latency
-    glide_computer.ProcessIdle();
+void
+CalculationThread::ProcessIdle(unsigned job,
+                               IdleScheduler::TimePoint now) noexcept
+{
+#ifdef HAVE_CPU_FREQUENCY
+  const ScopeLockCPU cpu;
+#endif
+
+  glide_computer.ProcessIdle(GlideComputer::IdleJob(job));
+  scheduler.Done(job, now);
+
+  /* publishing is postponed until the thread becomes idle or the
+     next fix arrives; most jobs are followed by another one */
+  publish_pending = true;
+}
+
+/**
+ * Main loop of the CalculationThread
+ */
+void
+CalculationThread::Run() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  while (!_CheckStoppedOrSuspended(lock)) {
+    const auto now = IdleScheduler::Clock::now();
+
+    const bool gps_ready = trigger_flag && now >= last_gps + MIN_GPS_PERIOD;
+    const int job = scheduler.Pick(now);
+
+    if (job >= 0 && (!gps_ready || scheduler.IsOverdue(job, now))) {
+      /* run one slow calculation; the new fix (if any) can't be
+         processed yet, or the job has been starved for too long */
+      const ScopeUnlock unlock(mutex);
+      ProcessIdle(job, now);
+    } else if (gps_ready) {
+      /* process the new fix; the slow calculations wait, to
+         minimise latency */
+      trigger_flag = false;
+      last_gps = now;
+
+      const ScopeUnlock unlock(mutex);
+      ProcessGPS(now);
+    } else {
+      if (publish_pending) {
+        const ScopeUnlock unlock(mutex);
+        PublishCalculated();
+        continue;
+      }
+
+      /* sleep until the next fix arrives or until the next job
+         becomes due */
+      auto wakeup = scheduler.GetNextRelease();
+      if (trigger_flag && last_gps + MIN_GPS_PERIOD < wakeup)
+        wakeup = last_gps + MIN_GPS_PERIOD;
+
+      if (wakeup == IdleScheduler::TimePoint::max())
+        command_trigger.wait(lock);
+      else if (wakeup > now)
+        command_trigger.wait_for(lock, wakeup - now);
+    }
   }
 }
 
+void
+CalculationThread::Trigger() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  trigger_flag = true;
+  command_trigger.notify_one();
+}
+
 void
 CalculationThread::ForceTrigger()
 {
   {
-    std::lock_guard<Mutex> lock(mutex);
+    std::lock_guard<Mutex> lock(settings_mutex);
     force = true;
   }
 
-  WorkerThread::Trigger();
+  Trigger();
 }
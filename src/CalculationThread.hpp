@@ -24,9 +24,10 @@ Copyright_License {
 #ifndef XCSOAR_CALCULATION_THREAD_HPP
 #define XCSOAR_CALCULATION_THREAD_HPP
 
-#include "Thread/WorkerThread.hpp"
+#include "Thread/SuspensibleThread.hpp"
 #include "Thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "Computer/IdleScheduler.hpp"
 
 class GlideComputer;
 
@@ -34,13 +35,31 @@ class GlideComputer;
  * The CalculationThread handles all expensive calculations
  * that should not be done directly in the device thread.
  * Data transfer is handled by a blackboard system.
+ *
+ * Each GPS fix is processed as soon as it arrives (limited to
+ * #MIN_GPS_PERIOD).  The slow calculations are split into jobs (see
+ * GlideComputer::IdleJob) which are run one at a time by an
+ * #IdleScheduler in the gaps between two fixes.
  */
-class CalculationThread final : public WorkerThread {
+class CalculationThread final : public SuspensibleThread {
   /**
-   * This mutex protects #settings_computer and
-   * #screen_distance_meters.
+   * The minimum time between two ProcessGPS() calls.  This bounds
+   * the CPU load with devices which send data at a high rate.
    */
-  Mutex mutex;
+  static constexpr IdleScheduler::Duration MIN_GPS_PERIOD =
+    std::chrono::milliseconds(100);
+
+  /**
+   * This mutex protects #settings_computer,
+   * #screen_distance_meters and #force.
+   */
+  Mutex settings_mutex;
+
+  /**
+   * Has Trigger() been called?  Protected by
+   * SuspensibleThread::mutex.
+   */
+  bool trigger_flag;
 
   /**
    * This flag forces a full run of all calculations.  It is set after
@@ -56,6 +75,23 @@ class CalculationThread final : public WorkerThread {
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * Decides which of the GlideComputer::IdleJob runs next.  Only
+   * accessed by the thread itself.
+   */
+  IdleScheduler scheduler;
+
+  /**
+   * The time of the last ProcessGPS() call.
+   */
+  IdleScheduler::TimePoint last_gps;
+
+  /**
+   * Has an idle job modified the calculated values which have not
+   * been published yet?
+   */
+  bool publish_pending;
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
 
@@ -63,17 +99,36 @@ public:
   void SetScreenDistanceMeters(double new_value);
 
   bool Start(bool suspended=false) {
-    if (!WorkerThread::Start(suspended))
+    if (!SuspensibleThread::Start(suspended))
       return false;
 
     SetLowPriority();
     return true;
   }
 
+  /**
+   * New data has arrived; wakes up the thread to process it.
+   */
+  void Trigger() noexcept;
+
   void ForceTrigger();
 
+private:
+  /**
+   * Read the new data from the DeviceBlackboard, process it and
+   * publish the results.
+   */
+  void ProcessGPS(IdleScheduler::TimePoint now) noexcept;
+
+  /**
+   * Run one of the slow calculations.
+   */
+  void ProcessIdle(unsigned job, IdleScheduler::TimePoint now) noexcept;
+
+  void PublishCalculated() noexcept;
+
 protected:
-  void Tick() noexcept override;
+  void Run() noexcept override;
 };
 
 #endif
@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ComputerTimers.hpp"
+
+#include <cassert>
+
+static constexpr const char *names[unsigned(ComputerTimers::Subsystem::COUNT)] = {
+  "air_data",
+  "task",
+  "contest",
+  "stats",
+  "cu",
+  "warning",
+  "log",
+  "retrospective",
+};
+
+static constexpr const TCHAR *labels[unsigned(ComputerTimers::Subsystem::COUNT)] = {
+  _T("Air data"),
+  _T("Task"),
+  _T("Contest"),
+  _T("Statistics"),
+  _T("Cu"),
+  _T("Airspace"),
+  _T("Log"),
+  _T("Retrospective"),
+};
+
+uint64_t
+ComputerTimers::GetTotalCPU() const
+{
+  uint64_t total = 0;
+  for (const auto &i : timers)
+    total += i.cpu_us;
+  return total;
+}
+
+double
+ComputerTimers::GetLoad() const
+{
+  const auto elapsed = GetElapsed();
+  if (!IsEnabled() || elapsed < 1000000)
+    return -1;
+
+  return double(GetTotalCPU()) / elapsed;
+}
+
+ComputerTimers::Subsystem
+ComputerTimers::GetMostExpensive() const
+{
+  unsigned result = 0;
+  for (unsigned i = 1; i < timers.size(); ++i)
+    if (timers[i].cpu_us > timers[result].cpu_us)
+      result = i;
+
+  return Subsystem(result);
+}
+
+const char *
+ComputerTimers::GetName(Subsystem subsystem)
+{
+  assert(unsigned(subsystem) < unsigned(Subsystem::COUNT));
+
+  return names[unsigned(subsystem)];
+}
+
+const TCHAR *
+ComputerTimers::GetLabel(Subsystem subsystem)
+{
+  assert(unsigned(subsystem) < unsigned(Subsystem::COUNT));
+
+  return labels[unsigned(subsystem)];
+}
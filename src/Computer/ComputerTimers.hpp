@@ -0,0 +1,203 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_COMPUTER_TIMERS_HPP
+#define XCSOAR_COMPUTER_TIMERS_HPP
+
+#include "OS/Clock.hpp"
+#include "Util/Compiler.h"
+
+#include <array>
+
+#include <stdint.h>
+#include <tchar.h>
+
+/**
+ * Accumulated CPU and wall clock time of the #GlideComputer
+ * subsystems.  This is a debugging aid to find out which computer is
+ * expensive on a given flight; it is only updated while
+ * ComputerSettings::computer_timers_enabled is set.
+ */
+struct ComputerTimers {
+  enum class Subsystem : uint8_t {
+    AIR_DATA,
+    TASK,
+    CONTEST,
+    STATS,
+    CU,
+    WARNING,
+    LOG,
+    RETROSPECTIVE,
+
+    COUNT
+  };
+
+  struct Timer {
+    /**
+     * CPU time of the calculation thread [us].
+     */
+    uint64_t cpu_us;
+
+    /**
+     * Wall clock time [us].
+     */
+    uint64_t wall_us;
+
+    /**
+     * The longest single invocation (wall clock) [us].
+     */
+    uint32_t max_wall_us;
+
+    /**
+     * Number of invocations.
+     */
+    uint32_t count;
+
+    void Clear() {
+      cpu_us = wall_us = 0;
+      max_wall_us = count = 0;
+    }
+
+    void Add(uint64_t cpu, uint64_t wall) {
+      cpu_us += cpu;
+      wall_us += wall;
+      if (wall > max_wall_us)
+        max_wall_us = wall;
+      ++count;
+    }
+
+    Timer &operator+=(const Timer &other) {
+      cpu_us += other.cpu_us;
+      wall_us += other.wall_us;
+      if (other.max_wall_us > max_wall_us)
+        max_wall_us = other.max_wall_us;
+      count += other.count;
+      return *this;
+    }
+  };
+
+  std::array<Timer, unsigned(Subsystem::COUNT)> timers;
+
+  /**
+   * MonotonicClockUS() when measuring was started; 0 if the timers
+   * are disabled.
+   */
+  uint64_t start_us;
+
+  /**
+   * MonotonicClockUS() of the latest update.
+   */
+  uint64_t update_us;
+
+  void Clear() {
+    for (auto &i : timers)
+      i.Clear();
+    start_us = update_us = 0;
+  }
+
+  /**
+   * Clear all timers and start measuring.
+   */
+  void Start() {
+    Clear();
+    start_us = update_us = MonotonicClockUS();
+  }
+
+  bool IsEnabled() const {
+    return start_us != 0;
+  }
+
+  Timer &operator[](Subsystem subsystem) {
+    return timers[unsigned(subsystem)];
+  }
+
+  const Timer &operator[](Subsystem subsystem) const {
+    return timers[unsigned(subsystem)];
+  }
+
+  /**
+   * Returns the wall clock time covered by the timers [us].
+   */
+  uint64_t GetElapsed() const {
+    return update_us - start_us;
+  }
+
+  gcc_pure
+  uint64_t GetTotalCPU() const;
+
+  /**
+   * Returns the share of CPU time consumed by all subsystems [0..1]
+   * or a negative value if not enough time has elapsed.
+   */
+  gcc_pure
+  double GetLoad() const;
+
+  /**
+   * Returns the subsystem which consumed the most CPU time.
+   */
+  gcc_pure
+  Subsystem GetMostExpensive() const;
+
+  /**
+   * Returns the identifier used by the Lua API, e.g. "air_data".
+   */
+  gcc_const
+  static const char *GetName(Subsystem subsystem);
+
+  /**
+   * Returns a short human readable name.
+   */
+  gcc_const
+  static const TCHAR *GetLabel(Subsystem subsystem);
+};
+
+/**
+ * Adds the CPU and wall clock time spent in its scope to one
+ * #ComputerTimers::Timer.  If constructed with nullptr (i.e. the
+ * timers are disabled), it does nothing.
+ */
+class ScopeComputerTimer {
+  ComputerTimers::Timer *const timer;
+  uint64_t start_cpu, start_wall;
+
+public:
+  ScopeComputerTimer(ComputerTimers *timers,
+                     ComputerTimers::Subsystem subsystem)
+    :timer(timers != nullptr ? &(*timers)[subsystem] : nullptr) {
+    if (timer != nullptr) {
+      start_cpu = ThreadCPUClockUS();
+      start_wall = MonotonicClockUS();
+    }
+  }
+
+  ~ScopeComputerTimer() {
+    if (timer != nullptr)
+      timer->Add(ThreadCPUClockUS() - start_cpu,
+                 MonotonicClockUS() - start_wall);
+  }
+
+  ScopeComputerTimer(const ScopeComputerTimer &) = delete;
+  ScopeComputerTimer &operator=(const ScopeComputerTimer &) = delete;
+};
+
+#endif
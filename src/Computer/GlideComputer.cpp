@@ -23,13 +23,12 @@ Copyright_License {
 
 #include "GlideComputer.hpp"
 #include "Computer/Settings.hpp"
+#include "IdleScheduler.hpp"
 #include "NMEA/Derived.hpp"
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "GlideComputerInterface.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 
-static PeriodClock last_team_code_update;
-
 GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              const Waypoints &_way_points,
                              Airspaces &_airspace_database,
@@ -42,9 +41,9 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
    retrospective(_way_points),
    team_code_ref_id(-1)
 {
+  timers.Clear();
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
-  idle_clock.Update();
 }
 
 void
@@ -69,12 +68,13 @@ GlideComputer::Initialise()
   ResetFlight(true);
 }
 
-bool
+void
 GlideComputer::ProcessGPS(bool force)
 {
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
   const ComputerSettings &settings = GetComputerSettings();
+  ComputerTimers *const t = UpdateTimers();
 
   const bool last_flying = calculated.flight.flying;
 
@@ -96,40 +96,64 @@ GlideComputer::ProcessGPS(bool force)
   calculated.Expire(basic.clock);
 
   // Process basic information
-  air_data_computer.ProcessBasic(Basic(), SetCalculated(),
-                                 settings);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::AIR_DATA);
+    air_data_computer.ProcessBasic(Basic(), SetCalculated(),
+                                   settings);
+  }
 
   // Process basic task information
   const bool last_finished = calculated.ordered_task_stats.task_finished;
 
-  task_computer.ProcessBasicTask(basic,
-                                 calculated,
-                                 settings,
-                                 force);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::TASK);
+    task_computer.ProcessBasicTask(basic,
+                                   calculated,
+                                   settings,
+                                   force);
+  }
 
   CalculateWorkingBand();
 
-  task_computer.ProcessMoreTask(basic, calculated, settings);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::TASK);
+    task_computer.ProcessMoreTask(basic, calculated, settings);
+  }
 
   if (!last_finished && calculated.ordered_task_stats.task_finished)
     OnFinishTask();
 
   // Check if everything is okay with the gps time and process it
-  air_data_computer.FlightTimes(Basic(), SetCalculated(),
-                                settings);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::AIR_DATA);
+    air_data_computer.FlightTimes(Basic(), SetCalculated(),
+                                  settings);
+  }
 
   TakeoffLanding(last_flying);
 
-  task_computer.ProcessAutoTask(basic, calculated);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::TASK);
+    task_computer.ProcessAutoTask(basic, calculated);
+  }
 
   // Process extended information
-  air_data_computer.ProcessVertical(Basic(),
-                                    SetCalculated(),
-                                    settings);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::AIR_DATA);
+    air_data_computer.ProcessVertical(Basic(),
+                                      SetCalculated(),
+                                      settings);
+  }
 
-  stats_computer.ProcessClimbEvents(calculated);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::STATS);
+    stats_computer.ProcessClimbEvents(calculated);
+  }
 
-  cu_computer.Compute(basic, calculated, settings);
+  {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::CU);
+    cu_computer.Compute(basic, calculated, settings);
+  }
 
   // Calculate the team code
   CalculateOwnTeamCode();
@@ -152,29 +176,121 @@ GlideComputer::ProcessGPS(bool force)
   // Update the ConditionMonitors
   ConditionMonitorsUpdate(Basic(), Calculated(), settings);
 
-  return idle_clock.CheckUpdate(std::chrono::milliseconds(500));
+  PublishTimers();
 }
 
 void
 GlideComputer::ProcessIdle(bool exhaustive)
+{
+  for (unsigned i = 0; i < unsigned(IdleJob::COUNT); ++i)
+    ProcessIdle(IdleJob(i), exhaustive);
+}
+
+/**
+ * The scheduling parameters of each GlideComputer::IdleJob: the
+ * minimum period and the priority (lower is more important).
+ */
+static constexpr struct {
+  IdleScheduler::Duration period;
+  unsigned priority;
+} idle_jobs[unsigned(GlideComputer::IdleJob::COUNT)] = {
+  /* LOG */
+  { std::chrono::milliseconds(500), 1 },
+
+  /* CONTEST: the most expensive one, and nobody waits for it */
+  { std::chrono::milliseconds(500), 3 },
+
+  /* TASK */
+  { std::chrono::milliseconds(500), 2 },
+
+  /* WARNING: the pilot must be warned quickly */
+  { std::chrono::milliseconds(500), 0 },
+};
+
+void
+GlideComputer::AddIdleJobs(IdleScheduler &scheduler)
+{
+  for (const auto &i : idle_jobs)
+    scheduler.Add(i.period, i.priority);
+}
+
+void
+GlideComputer::ProcessIdle(IdleJob job, bool exhaustive)
 {
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
+  ComputerTimers *const t = UpdateTimers();
+
+  switch (job) {
+  case IdleJob::LOG:
+    // Log GPS fixes for internal usage
+    // (snail trail, stats, olc, ...)
+    {
+      ScopeComputerTimer timer(t, ComputerTimers::Subsystem::STATS);
+      stats_computer.DoLogging(basic, calculated);
+    }
+
+    {
+      ScopeComputerTimer timer(t, ComputerTimers::Subsystem::LOG);
+      log_computer.Run(basic, calculated, GetComputerSettings().logger);
+    }
+
+    // Calculate summary of flight
+    if (basic.location_available) {
+      ScopeComputerTimer timer(t, ComputerTimers::Subsystem::RETROSPECTIVE);
+      retrospective.UpdateSample(basic.location);
+    }
+    break;
+
+  case IdleJob::CONTEST: {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::CONTEST);
+    task_computer.ProcessContest(basic, calculated, GetComputerSettings(),
+                                 exhaustive);
+  }
+    break;
 
-  // Log GPS fixes for internal usage
-  // (snail trail, stats, olc, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
+  case IdleJob::TASK: {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::TASK);
+    task_computer.ProcessTaskIdle(basic, calculated);
+  }
+    break;
 
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
+  case IdleJob::WARNING: {
+    ScopeComputerTimer timer(t, ComputerTimers::Subsystem::WARNING);
+    warning_computer.Update(GetComputerSettings(), basic,
+                            calculated, calculated.airspace_warnings);
+  }
+    break;
 
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  case IdleJob::COUNT:
+    gcc_unreachable();
+  }
+
+  PublishTimers();
+}
+
+ComputerTimers *
+GlideComputer::UpdateTimers()
+{
+  if (!GetComputerSettings().computer_timers_enabled) {
+    if (timers.IsEnabled())
+      timers.Clear();
+    return nullptr;
+  }
+
+  if (!timers.IsEnabled())
+    timers.Start();
+
+  return &timers;
+}
+
+void
+GlideComputer::PublishTimers()
+{
+  if (timers.IsEnabled())
+    timers.update_us = MonotonicClockUS();
 
-  // Calculate summary of flight
-  if (basic.location_available)
-    retrospective.UpdateSample(basic.location);
+  SetCalculated().computer_timers = timers;
 }
 
 bool
@@ -205,7 +321,7 @@ GlideComputer::CalculateOwnTeamCode()
     return;
 
   // Only calculate every 10sec otherwise cancel calculation
-  if (!last_team_code_update.CheckUpdate(std::chrono::seconds(10)))
+  if (!team_code_clock.CheckUpdate(std::chrono::seconds(10)))
     return;
 
   // Get bearing and distance to the reference waypoint
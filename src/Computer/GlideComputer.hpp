@@ -33,6 +33,7 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "ComputerTimers.hpp"
 #include "Util/Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -40,6 +41,7 @@ class Waypoints;
 class ProtectedTaskManager;
 class GlideComputerTaskEvents;
 class RasterTerrain;
+class IdleScheduler;
 
 // TODO: replace copy constructors so copies of these structures
 // do not replicate the large items or items that should be singletons
@@ -47,6 +49,37 @@ class RasterTerrain;
 
 class GlideComputer : public GlideComputerBlackboard
 {
+public:
+  /**
+   * The slow calculations performed by ProcessIdle().  They can be
+   * run separately, so the CalculationThread can schedule them
+   * between two GPS fixes.
+   */
+  enum class IdleJob : uint8_t {
+    /**
+     * Flight statistics, internal logging and the retrospective.
+     */
+    LOG,
+
+    /**
+     * The contest solvers.
+     */
+    CONTEST,
+
+    /**
+     * TaskManager::UpdateIdle().
+     */
+    TASK,
+
+    /**
+     * Airspace warnings.
+     */
+    WARNING,
+
+    COUNT
+  };
+
+private:
   GlideComputerAirData air_data_computer;
   WarningComputer warning_computer;
   TaskComputer task_computer;
@@ -61,7 +94,11 @@ class GlideComputer : public GlideComputerBlackboard
   bool team_code_ref_found;
   GeoPoint team_code_ref_location;
 
-  PeriodClock idle_clock;
+  /**
+   * Limits how often CalculateOwnTeamCode() updates the own team
+   * code.
+   */
+  PeriodClock team_code_clock;
 
   /**
    * This object is used to check whether to update
@@ -69,6 +106,12 @@ class GlideComputer : public GlideComputerBlackboard
    */
   DeltaTime trace_history_time;
 
+  /**
+   * CPU time statistics of the subsystems; copied to
+   * DerivedInfo::computer_timers after each cycle.
+   */
+  ComputerTimers timers;
+
 public:
   GlideComputer(const ComputerSettings &_settings,
                 const Waypoints &_way_points,
@@ -103,13 +146,25 @@ public:
    *
    * @param force forces calculation even if there was no new GPS fix
    */
-  bool ProcessGPS(bool force=false); // returns true if idle needs processing
+  void ProcessGPS(bool force=false);
 
   /**
-   * Process slow calculations. Called by the CalculationThread.
+   * Process all slow calculations.
    */
   void ProcessIdle(bool exhaustive=false);
 
+  /**
+   * Process one of the slow calculations.  Called by the
+   * CalculationThread.
+   */
+  void ProcessIdle(IdleJob job, bool exhaustive=false);
+
+  /**
+   * Register all #IdleJob values with the given scheduler, in enum
+   * order, i.e. the job ids are the #IdleJob values.
+   */
+  static void AddIdleJobs(IdleScheduler &scheduler);
+
   void ProcessExhaustive() {
     ProcessIdle(true);
   }
@@ -191,6 +246,20 @@ private:
 
   void CalculateWorkingBand();
   void CalculateVarioScale();
+
+  /**
+   * Start or stop #timers according to
+   * ComputerSettings::computer_timers_enabled.
+   *
+   * @return the #ComputerTimers to be passed to #ScopeComputerTimer,
+   * or nullptr if disabled
+   */
+  ComputerTimers *UpdateTimers();
+
+  /**
+   * Copy #timers to DerivedInfo::computer_timers.
+   */
+  void PublishTimers();
 };
 
 #endif
@@ -53,6 +53,11 @@ class GlideRatioCalculator {
    */
   unsigned short size;
 
+  /**
+   * Number of consecutive distances which were rejected by Add().
+   */
+  unsigned short errs;
+
   bool valid;
 
 public:
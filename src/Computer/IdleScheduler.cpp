@@ -0,0 +1,114 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IdleScheduler.hpp"
+
+#include <cassert>
+
+unsigned
+IdleScheduler::Add(Duration period, unsigned priority)
+{
+  assert(!jobs.full());
+
+  Job &job = jobs.append();
+  job.period = period;
+  job.priority = priority;
+  job.release = job.dirty_since = TimePoint();
+  job.dirty = false;
+  return jobs.size() - 1;
+}
+
+void
+IdleScheduler::MarkDirty(TimePoint now)
+{
+  for (auto &job : jobs) {
+    if (!job.dirty) {
+      job.dirty = true;
+      job.dirty_since = now;
+    }
+  }
+}
+
+void
+IdleScheduler::Force(TimePoint now)
+{
+  for (auto &job : jobs) {
+    job.dirty = true;
+    job.dirty_since = job.release = now;
+  }
+}
+
+int
+IdleScheduler::Pick(TimePoint now) const
+{
+  int result = -1;
+
+  for (unsigned i = 0; i < jobs.size(); ++i) {
+    const Job &job = jobs[i];
+    if (!job.dirty || job.release > now)
+      continue;
+
+    if (result < 0) {
+      result = i;
+      continue;
+    }
+
+    const Job &best = jobs[result];
+    if (job.priority < best.priority ||
+        (job.priority == best.priority && job.release < best.release))
+      result = i;
+  }
+
+  return result;
+}
+
+bool
+IdleScheduler::IsOverdue(unsigned id, TimePoint now) const
+{
+  assert(id < jobs.size());
+
+  const Job &job = jobs[id];
+  return job.dirty && now >= job.GetDueSince() + job.period;
+}
+
+void
+IdleScheduler::Done(unsigned id, TimePoint start)
+{
+  assert(id < jobs.size());
+
+  Job &job = jobs[id];
+  job.dirty = false;
+  job.release = start + job.period;
+}
+
+IdleScheduler::TimePoint
+IdleScheduler::GetNextRelease() const
+{
+  TimePoint result = TimePoint::max();
+
+  for (const auto &job : jobs)
+    if (job.dirty && job.release < result)
+      result = job.release;
+
+  return result;
+}
@@ -0,0 +1,142 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IDLE_SCHEDULER_HPP
+#define XCSOAR_IDLE_SCHEDULER_HPP
+
+#include "Util/TrivialArray.hxx"
+#include "Util/Compiler.h"
+
+#include <chrono>
+
+/**
+ * Decides which of the slow (idle) calculations shall run next.  The
+ * caller runs one job at a time between two GPS fixes, so a new fix
+ * never waits for more than one job.
+ *
+ * Each job has a period and a priority.  A job is due when new data
+ * has arrived since it ran last (see MarkDirty()) and its period has
+ * elapsed.  Among all due jobs, the one with the highest priority
+ * (lowest number) wins; ties are resolved by the earliest release
+ * time.
+ */
+class IdleScheduler {
+public:
+  typedef std::chrono::steady_clock Clock;
+  typedef Clock::time_point TimePoint;
+  typedef Clock::duration Duration;
+
+  static constexpr unsigned MAX_JOBS = 8;
+
+private:
+  struct Job {
+    Duration period;
+
+    /**
+     * Lower values are more important.
+     */
+    unsigned priority;
+
+    /**
+     * The job may not run again before this time.
+     */
+    TimePoint release;
+
+    /**
+     * The time of the first MarkDirty() call after the job ran last.
+     */
+    TimePoint dirty_since;
+
+    /**
+     * Has new data arrived since this job ran last?
+     */
+    bool dirty;
+
+    /**
+     * Returns the time since when the job is due.
+     */
+    TimePoint GetDueSince() const {
+      return release > dirty_since ? release : dirty_since;
+    }
+  };
+
+  TrivialArray<Job, MAX_JOBS> jobs;
+
+public:
+  IdleScheduler() {
+    jobs.clear();
+  }
+
+  /**
+   * Register a new job.  It is due immediately after the next
+   * MarkDirty() call.
+   *
+   * @return the job id, counting from zero in the order of Add()
+   * calls
+   */
+  unsigned Add(Duration period, unsigned priority);
+
+  /**
+   * New data has arrived; all jobs shall run again when their period
+   * has elapsed.
+   */
+  void MarkDirty(TimePoint now);
+
+  /**
+   * Release all jobs now, e.g. after the settings were changed.
+   */
+  void Force(TimePoint now);
+
+  /**
+   * Choose the job to be run now.
+   *
+   * @return the job id or -1 if no job is due
+   */
+  gcc_pure
+  int Pick(TimePoint now) const;
+
+  /**
+   * Is the given job so late that it shall run even if a GPS fix is
+   * pending?  That is the case if it has been due for a whole period
+   * already, which happens only if the GPS processing alone
+   * saturates the CPU.
+   */
+  gcc_pure
+  bool IsOverdue(unsigned id, TimePoint now) const;
+
+  /**
+   * The job has been run.
+   *
+   * @param start the time when the job was started
+   */
+  void Done(unsigned id, TimePoint start);
+
+  /**
+   * Returns the earliest time at which a dirty job becomes due, or
+   * TimePoint::max() if there is none.
+   */
+  gcc_pure
+  TimePoint GetNextRelease() const;
+};
+
+#endif
@@ -36,6 +36,8 @@ Copyright_License {
    http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2016/p0386r2.pdf */
 #if GCC_OLDER_THAN(9,0)
 constexpr std::chrono::steady_clock::duration RouteComputer::PERIOD;
+constexpr std::chrono::steady_clock::duration RouteComputer::REACH_PERIOD;
+constexpr std::chrono::steady_clock::duration RouteComputer::ROUTE_BUDGET;
 #endif
 
 RouteComputer::RouteComputer(const Airspaces &airspace_database,
@@ -113,11 +115,21 @@ RouteComputer::TerrainWarning(const MoreData &basic,
         }
       }
 
+      if (!dirty)
+        /* continue refining a route which did not finish within
+           its time budget; the planner continues it towards the
+           aircraft position it was started with, and a new search
+           begins at the next period after it has finished */
+        dirty = route_planner.GetSolveStats().pending;
+
       last_task_type = calculated.common_stats.task_type;
       last_active_tp = calculated.task_stats.active_index;
 
       if (dirty) {
-        protected_route_planner.SolveRoute(dest, start, config, h_ceiling);
+        RoutePlannerConfig route_config = config;
+        route_config.time_budget = ROUTE_BUDGET;
+        protected_route_planner.SolveRoute(dest, start, route_config,
+                                           h_ceiling);
         calculated.planned_route = route_planner.GetSolution();
 
         calculated.terrain_warning_location =
@@ -151,7 +163,7 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
   const int h_ceiling(std::max((int)basic.nav_altitude + 500,
                                (int)calculated.common_stats.height_max_working));
 
-  if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
+  if (reach_clock.CheckAdvance(basic.time, REACH_PERIOD)) {
     protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
 
     if (do_solve) {
@@ -40,6 +40,21 @@ class GlidePolar;
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
 
+  /**
+   * The reach is updated more often than the route, because
+   * incremental reach solutions (see
+   * RoutePlannerConfig::reach_incremental) are cheap as long as the
+   * aircraft has not moved far.
+   */
+  static constexpr std::chrono::steady_clock::duration REACH_PERIOD = std::chrono::seconds(2);
+
+  /**
+   * Upper bound for the time spent in one route solution.  Routes
+   * which need longer are refined in the following calculation
+   * cycles, see RoutePlannerConfig::time_budget.
+   */
+  static constexpr std::chrono::steady_clock::duration ROUTE_BUDGET = std::chrono::milliseconds(100);
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
@@ -85,4 +85,6 @@ ComputerSettings::SetDefaults()
 #endif
   weather.SetDefaults();
   radio.SetDefaults();
+
+  computer_timers_enabled = false;
 }
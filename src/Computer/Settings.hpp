@@ -231,6 +231,13 @@ struct ComputerSettings {
 
   RadioSettings radio;
 
+  /**
+   * Measure the CPU time of the #GlideComputer subsystems, see
+   * #ComputerTimers?  This is a debugging aid which is not stored in
+   * the profile.
+   */
+  bool computer_timers_enabled;
+
   void SetDefaults();
 };
 
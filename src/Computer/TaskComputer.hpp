@@ -101,9 +101,27 @@ public:
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
+  /**
+   * Run the contest solvers.
+   */
+  void ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
+
+  /**
+   * Slow task calculations, see TaskManager::UpdateIdle().
+   */
+  void ProcessTaskIdle(const MoreData &basic, const DerivedInfo &calculated);
+
+  /**
+   * Shortcut for ProcessContest() and ProcessTaskIdle().
+   */
   void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
                    const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+                   bool exhaustive=false) {
+    ProcessContest(basic, calculated, settings_computer, exhaustive);
+    ProcessTaskIdle(basic, calculated);
+  }
 };
 
 #endif
@@ -248,7 +248,7 @@ DeviceDescriptor::OpenOnPort(DumpPort *_port, OperationEnvironment &env)
   reopen_clock.Update();
 
   {
-    const std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
     device_blackboard->SetRealState(index).Reset();
     device_blackboard->ScheduleMerge();
   }
@@ -595,7 +595,7 @@ DeviceDescriptor::Close()
   ticker = false;
 
   {
-    const std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
     device_blackboard->SetRealState(index).Reset();
     device_blackboard->ScheduleMerge();
   }
@@ -733,7 +733,7 @@ DeviceDescriptor::Return()
 bool
 DeviceDescriptor::IsAlive() const
 {
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   return device_blackboard->RealState(index).alive;
 }
 
@@ -830,7 +830,7 @@ DeviceDescriptor::PutMacCready(double value, OperationEnvironment &env)
   if (!device->PutMacCready(value, env))
     return false;
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   settings_sent.mac_cready = value;
   settings_sent.mac_cready_available.Update(basic.clock);
@@ -855,7 +855,7 @@ DeviceDescriptor::PutBugs(double value, OperationEnvironment &env)
   if (!device->PutBugs(value, env))
     return false;
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   settings_sent.bugs = value;
   settings_sent.bugs_available.Update(basic.clock);
@@ -882,7 +882,7 @@ DeviceDescriptor::PutBallast(double fraction, double overload,
   if (!device->PutBallast(fraction, overload, env))
     return false;
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   settings_sent.ballast_fraction = fraction;
   settings_sent.ballast_fraction_available.Update(basic.clock);
@@ -962,7 +962,7 @@ DeviceDescriptor::PutQNH(const AtmosphericPressure &value,
   if (!device->PutQNH(value, env))
     return false;
 
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   settings_sent.qnh = value;
   settings_sent.qnh_available.Update(basic.clock);
@@ -1152,7 +1152,7 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
 bool
 DeviceDescriptor::ParseLine(const char *line)
 {
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   basic.UpdateClock();
   return ParseNMEA(line, basic);
@@ -1210,9 +1210,11 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
   if (monitor != nullptr)
     monitor->DataReceived(data, length);
 
+  received_time = ingestion_trace.Received(index, length);
+
   // Pass data directly to drivers that use binary data protocols
   if (driver != nullptr && device != nullptr && driver->UsesRawData()) {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
     NMEAInfo &basic = device_blackboard->SetRealState(index);
     basic.UpdateClock();
 
@@ -1222,6 +1224,7 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
+      ingestion_trace.Parsed(index, 1, received_time);
       device_blackboard->ScheduleMerge();
     }
 
@@ -1247,3 +1250,35 @@ DeviceDescriptor::LineReceived(const char *line) noexcept
 
   return true;
 }
+
+bool
+DeviceDescriptor::LinesReceived(const char *const*lines, unsigned n) noexcept
+{
+  for (unsigned i = 0; i < n; ++i) {
+    NMEALogger::Log(lines[i]);
+
+    if (dispatcher != nullptr)
+      dispatcher->LineReceived(lines[i]);
+  }
+
+  /* parse the whole burst with only one DeviceBlackboard lock and
+     one merge */
+  unsigned n_parsed = 0;
+
+  {
+    std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
+    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    basic.UpdateClock();
+
+    for (unsigned i = 0; i < n; ++i)
+      if (ParseNMEA(lines[i], basic))
+        ++n_parsed;
+  }
+
+  if (n_parsed > 0) {
+    ingestion_trace.Parsed(index, n_parsed, received_time);
+    device_blackboard->ScheduleMerge();
+  }
+
+  return true;
+}
@@ -30,6 +30,7 @@ Copyright_License {
 #include "Port/State.hpp"
 #include "Port/Listener.hpp"
 #include "Device/Parser.hpp"
+#include "IngestionTrace.hpp"
 #include "RadioFrequency.hpp"
 #include "NMEA/ExternalSettings.hpp"
 #include "Time/PeriodClock.hpp"
@@ -201,6 +202,12 @@ class DeviceDescriptor final : PortListener, PortLineSplitter {
    */
   ExternalSettings settings_received;
 
+  /**
+   * The time the data currently being handled by DataReceived() was
+   * received, for #ingestion_trace.
+   */
+  IngestionTrace::TimePoint received_time;
+
   /**
    * If this device has failed, then this attribute may contain an
    * error message.
@@ -544,6 +551,7 @@ private:
 
   /* virtual methods from PortLineHandler */
   bool LineReceived(const char *line) noexcept override;
+  bool LinesReceived(const char *const*lines, unsigned n) noexcept override;
 };
 
 #endif
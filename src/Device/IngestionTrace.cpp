@@ -0,0 +1,255 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IngestionTrace.hpp"
+#include "IO/FileOutputStream.hxx"
+#include "IO/BufferedOutputStream.hxx"
+
+#include <cassert>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+IngestionTrace ingestion_trace;
+
+static constexpr const char *stage_names[IngestionTrace::N_STAGES] = {
+  "parsed",
+  "merged",
+  "calculated",
+  "displayed",
+};
+
+void
+IngestionTrace::Histogram::Add(Duration d)
+{
+  unsigned i = 0;
+  for (auto limit = Duration(BUCKET_BASE);
+       d >= limit && i < N_BUCKETS - 1; limit *= 2)
+    ++i;
+
+  ++buckets[i];
+  ++count;
+  sum += d;
+  if (d > max)
+    max = d;
+}
+
+IngestionTrace::Duration
+IngestionTrace::Histogram::GetPercentile(double fraction) const
+{
+  const double n = fraction * count;
+
+  Duration limit = BUCKET_BASE;
+  unsigned long total = 0;
+  for (unsigned i = 0; i < N_BUCKETS - 1; ++i, limit *= 2) {
+    total += buckets[i];
+    if (total >= n)
+      return std::min(limit, max);
+  }
+
+  return max;
+}
+
+void
+IngestionTrace::DeviceStatistics::Clear()
+{
+  n_bytes = n_sentences = 0;
+  first = last = TimePoint();
+
+  for (auto &i : latency)
+    i.Clear();
+}
+
+void
+IngestionTrace::Reset()
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  for (auto &i : devices)
+    i.Clear();
+
+  for (auto &i : pending)
+    i.fill(TimePoint());
+}
+
+IngestionTrace::TimePoint
+IngestionTrace::Received(unsigned device, size_t nbytes)
+{
+  if (!IsEnabled())
+    return TimePoint();
+
+  const auto now = Clock::now();
+
+  const std::lock_guard<Mutex> lock(mutex);
+  auto &d = devices[device];
+  if (d.first == TimePoint())
+    d.first = now;
+  d.last = now;
+  d.n_bytes += nbytes;
+  return now;
+}
+
+void
+IngestionTrace::Parsed(unsigned device, unsigned n_sentences,
+                       TimePoint received)
+{
+  if (!IsEnabled() || received == TimePoint())
+    /* disabled, or enabled after the data was received */
+    return;
+
+  const auto now = Clock::now();
+
+  const std::lock_guard<Mutex> lock(mutex);
+  auto &d = devices[device];
+  d.n_sentences += n_sentences;
+  d.latency[unsigned(Stage::PARSED)].Add(now - received);
+
+  /* keep the oldest data which is waiting for the next stage */
+  auto &next = pending[device][unsigned(Stage::MERGED)];
+  if (next == TimePoint())
+    next = received;
+}
+
+void
+IngestionTrace::Advance(Stage _stage)
+{
+  if (!IsEnabled())
+    return;
+
+  const unsigned stage = unsigned(_stage);
+  assert(stage > 0);
+
+  const auto now = Clock::now();
+
+  const std::lock_guard<Mutex> lock(mutex);
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    auto &p = pending[i];
+    if (p[stage] == TimePoint())
+      continue;
+
+    devices[i].latency[stage].Add(now - p[stage]);
+
+    if (stage + 1 < N_STAGES && p[stage + 1] == TimePoint())
+      p[stage + 1] = p[stage];
+
+    p[stage] = TimePoint();
+  }
+}
+
+static double
+ToMilliseconds(IngestionTrace::Duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static void
+AppendFormat(std::string &dest, const char *fmt, ...)
+  gcc_printf(2, 3);
+
+static void
+AppendFormat(std::string &dest, const char *fmt, ...)
+{
+  char buffer[256];
+
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buffer, sizeof(buffer), fmt, ap);
+  va_end(ap);
+
+  dest.append(buffer);
+}
+
+std::string
+IngestionTrace::Format() const
+{
+  std::string result;
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    const auto &d = devices[i];
+    if (d.n_bytes == 0)
+      continue;
+
+    const double seconds =
+      std::chrono::duration<double>(d.last - d.first).count();
+
+    AppendFormat(result, "Device %c: %lu sentences, %lu bytes",
+                 'A' + i, d.n_sentences, d.n_bytes);
+    if (seconds > 0)
+      AppendFormat(result, " (%.1f/s, %.0f B/s)",
+                   d.n_sentences / seconds, d.n_bytes / seconds);
+    result.push_back('\n');
+
+    AppendFormat(result, "  %-10s %8s %7s %7s %7s %7s %7s  [ms]\n",
+                 "stage", "count", "avg", "p50", "p90", "p99", "max");
+
+    for (unsigned stage = 0; stage < N_STAGES; ++stage) {
+      const auto &h = d.latency[stage];
+      if (h.count == 0)
+        continue;
+
+      AppendFormat(result, "  %-10s %8lu %7.2f %7.2f %7.2f %7.2f %7.2f\n",
+                   stage_names[stage], h.count,
+                   ToMilliseconds(h.sum) / h.count,
+                   ToMilliseconds(h.GetPercentile(0.5)),
+                   ToMilliseconds(h.GetPercentile(0.9)),
+                   ToMilliseconds(h.GetPercentile(0.99)),
+                   ToMilliseconds(h.max));
+    }
+  }
+
+  return result;
+}
+
+void
+IngestionTrace::Dump(Path path) const
+{
+  const std::string text = Format();
+
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  os.Write(text.c_str());
+
+  /* the raw histograms, for further analysis */
+  os.Format("\nbuckets: <%lldus, then doubling\n",
+            (long long)Histogram::BUCKET_BASE.count());
+
+  const std::lock_guard<Mutex> lock(mutex);
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    const auto &d = devices[i];
+    if (d.n_bytes == 0)
+      continue;
+
+    for (unsigned stage = 0; stage < N_STAGES; ++stage) {
+      os.Format("%c %-10s", 'A' + i, stage_names[stage]);
+      for (auto n : d.latency[stage].buckets)
+        os.Format(" %u", n);
+      os.Write('\n');
+    }
+  }
+
+  os.Flush();
+  file.Commit();
+}
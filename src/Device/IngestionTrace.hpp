@@ -0,0 +1,198 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_INGESTION_TRACE_HPP
+#define XCSOAR_DEVICE_INGESTION_TRACE_HPP
+
+#include "Features.hpp"
+#include "Thread/Mutex.hxx"
+#include "Util/Compiler.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <stddef.h>
+
+class Path;
+
+/**
+ * Optional instrumentation which measures the latency of data
+ * received from each device through the stages of the pipeline:
+ * parser, #MergeThread, #CalculationThread and the user interface.
+ * All latencies are measured from the moment the data was received
+ * from the #Port.
+ *
+ * While disabled, all hooks return immediately.
+ */
+class IngestionTrace {
+public:
+  typedef std::chrono::steady_clock Clock;
+  typedef Clock::time_point TimePoint;
+  typedef Clock::duration Duration;
+
+  enum class Stage : unsigned {
+    /** the data was parsed by DeviceDescriptor */
+    PARSED,
+
+    /** DeviceBlackboard::Merge() has been called */
+    MERGED,
+
+    /** GlideComputer::ProcessGPS() has been called */
+    CALCULATED,
+
+    /** the user interface (InfoBoxes) has been updated */
+    DISPLAYED,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+  /**
+   * A histogram with logarithmic buckets.  Bucket 0 counts latencies
+   * below #BUCKET_BASE, and each following bucket has twice the
+   * range of the previous one.
+   */
+  struct Histogram {
+    static constexpr unsigned N_BUCKETS = 16;
+    static constexpr std::chrono::microseconds BUCKET_BASE{64};
+
+    std::array<unsigned, N_BUCKETS> buckets;
+    unsigned long count;
+    Duration sum, max;
+
+    void Clear() {
+      buckets.fill(0);
+      count = 0;
+      sum = max = Duration::zero();
+    }
+
+    void Add(Duration d);
+
+    /**
+     * Returns the upper bound of the bucket which contains the
+     * given fraction of all samples.
+     */
+    gcc_pure
+    Duration GetPercentile(double fraction) const;
+  };
+
+  struct DeviceStatistics {
+    unsigned long n_bytes, n_sentences;
+
+    /** the first and the last time data was received */
+    TimePoint first, last;
+
+    std::array<Histogram, N_STAGES> latency;
+
+    void Clear();
+  };
+
+private:
+  std::atomic<bool> enabled{false};
+
+  mutable Mutex mutex;
+
+  std::array<DeviceStatistics, NUMDEV> devices;
+
+  /**
+   * The receive time of the oldest data from each device which has
+   * not yet reached the given stage; a default constructed value
+   * means nothing is pending.
+   */
+  std::array<std::array<TimePoint, N_STAGES>, NUMDEV> pending;
+
+public:
+  IngestionTrace() {
+    Reset();
+  }
+
+  bool IsEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  void SetEnabled(bool _enabled) {
+    enabled.store(_enabled, std::memory_order_relaxed);
+  }
+
+  /**
+   * Clear all statistics.
+   */
+  void Reset();
+
+  /**
+   * Data was received from a device.
+   *
+   * @return the time stamp to be passed to Parsed()
+   */
+  TimePoint Received(unsigned device, size_t nbytes);
+
+  /**
+   * Sentences received at the given time have been parsed.
+   *
+   * @param n_sentences the number of sentences which have updated
+   * the device state; lines which were not understood are not
+   * counted
+   */
+  void Parsed(unsigned device, unsigned n_sentences, TimePoint received);
+
+  void Merged() {
+    Advance(Stage::MERGED);
+  }
+
+  void Calculated() {
+    Advance(Stage::CALCULATED);
+  }
+
+  void Displayed() {
+    Advance(Stage::DISPLAYED);
+  }
+
+  DeviceStatistics GetStatistics(unsigned device) const {
+    const std::lock_guard<Mutex> lock(mutex);
+    return devices[device];
+  }
+
+  /**
+   * Format the statistics of all devices which have received data
+   * as human readable text.
+   */
+  std::string Format() const;
+
+  /**
+   * Write the text returned by Format() and the raw histograms to
+   * the specified file.
+   *
+   * Throws on error.
+   */
+  void Dump(Path path) const;
+
+private:
+  void Advance(Stage stage);
+};
+
+extern IngestionTrace ingestion_trace;
+
+#endif
@@ -32,6 +32,9 @@ Copyright_License {
 #include "Driver/FLARM/StaticParser.hpp"
 #include "Util/CharUtil.hxx"
 
+#include <stdint.h>
+#include <string.h>
+
 NMEAParser::NMEAParser()
 {
   Reset();
@@ -45,6 +48,19 @@ NMEAParser::Reset()
   last_time = 0;
 }
 
+/**
+ * Pack the first #n characters of the string into an integer, to
+ * compare sentence names with a single integer comparison.
+ */
+static constexpr uint64_t
+PackSentenceName(const char *p, unsigned n)
+{
+  return n == 0
+    ? 0
+    : (uint64_t((unsigned char)*p) << (8 * (n - 1))) |
+    PackSentenceName(p + 1, n - 1);
+}
+
 bool
 NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 {
@@ -61,58 +77,96 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
   char type[16];
   line.Read(type, 16);
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
-      return GSA(line, info);
-
-    if (StringIsEqual(type + 3, "GLL"))
-      return GLL(line, info);
+  /* all sentences known by this parser have the form "$ttSSS"
+     (talker id and sentence) or "$PMMMS" (proprietary) */
+  if (strlen(type) != 6)
+    return false;
 
-    if (StringIsEqual(type + 3, "RMC"))
-      return RMC(line, info);
+  typedef bool (*Handler)(NMEAParser &parser,
+                          NMEAInputLine &line, NMEAInfo &info);
+
+  struct Sentence {
+    uint64_t name;
+    Handler handler;
+  };
+
+  /* standard sentences, matched without the talker id */
+  static constexpr Sentence talker_sentences[] = {
+    { PackSentenceName("GSA", 3),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.GSA(line, info);
+      } },
+    { PackSentenceName("GLL", 3),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.GLL(line, info);
+      } },
+    { PackSentenceName("RMC", 3),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.RMC(line, info);
+      } },
+    { PackSentenceName("GGA", 3),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.GGA(line, info);
+      } },
+    { PackSentenceName("HDM", 3),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.HDM(line, info);
+      } },
+    { PackSentenceName("MWV", 3),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        return MWV(line, info);
+      } },
+  };
+
+  static constexpr Sentence proprietary_sentences[] = {
+    // Airspeed and vario sentence
+    { PackSentenceName("PTAS1", 5),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        return PTAS1(line, info);
+      } },
 
-    if (StringIsEqual(type + 3, "GGA"))
-      return GGA(line, info);
+    // FLARM sentences
+    { PackSentenceName("PFLAE", 5),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        ParsePFLAE(line, info.flarm.error, info.clock);
+        return true;
+      } },
+    { PackSentenceName("PFLAV", 5),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        ParsePFLAV(line, info.flarm.version, info.clock);
+        return true;
+      } },
+    { PackSentenceName("PFLAA", 5),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        ParsePFLAA(line, info.flarm.traffic, info.clock);
+        return true;
+      } },
+    { PackSentenceName("PFLAU", 5),
+      [](NMEAParser &, NMEAInputLine &line, NMEAInfo &info) {
+        ParsePFLAU(line, info.flarm.status, info.clock);
+        return true;
+      } },
 
-    if (StringIsEqual(type + 3, "HDM"))
-      return HDM(line, info);
+    // Garmin altitude sentence
+    { PackSentenceName("PGRMZ", 5),
+      [](NMEAParser &parser, NMEAInputLine &line, NMEAInfo &info) {
+        return parser.RMZ(line, info);
+      } },
+  };
 
-    if (StringIsEqual(type + 3, "MWV"))
-      return MWV(line, info);
+  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
+    const uint64_t name = PackSentenceName(type + 3, 3);
+    for (const auto &i : talker_sentences)
+      if (i.name == name)
+        return i.handler(*this, line, info);
   }
 
   // if (proprietary sentence) ...
   if (type[1] == 'P') {
-    // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
-      return PTAS1(line, info);
-
-    // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
-      ParsePFLAE(line, info.flarm.error, info.clock);
-      return true;
-    }
-
-    if (StringIsEqual(type + 1, "PFLAV")) {
-      ParsePFLAV(line, info.flarm.version, info.clock);
-      return true;
-    }
-
-    if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
-      return true;
-    }
-
-    if (StringIsEqual(type + 1, "PFLAU")) {
-      ParsePFLAU(line, info.flarm.status, info.clock);
-      return true;
-    }
-
-    // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
-      return RMZ(line, info);
-
-    return false;
+    const uint64_t name = PackSentenceName(type + 1, 5);
+    for (const auto &i : proprietary_sentences)
+      if (i.name == name)
+        return i.handler(*this, line, info);
   }
 
   return false;
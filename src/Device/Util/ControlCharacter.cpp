@@ -0,0 +1,72 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ControlCharacter.hpp"
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+
+static constexpr bool
+IsControlCharacter(char ch)
+{
+  return (unsigned char)ch < 0x20;
+}
+
+const char *
+FindControlCharacter(const char *p, const char *end) noexcept
+{
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+  const uint8x16_t limit = vdupq_n_u8(0x20);
+  for (; end - p >= 16; p += 16) {
+    const uint64x2_t mask =
+      vreinterpretq_u64_u8(vcltq_u8(vld1q_u8((const uint8_t *)p), limit));
+    if ((vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) != 0)
+      /* there is one in this block; let the scalar loop below find
+         it */
+      break;
+  }
+#elif defined(__SSE2__)
+  const __m128i limit = _mm_set1_epi8(0x20);
+  for (; end - p >= 16; p += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)p);
+
+    /* max(v, 0x20) == v for all bytes which are not control
+       characters */
+    const unsigned mask =
+      ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, limit), v)) & 0xffff;
+    if (mask != 0)
+      return p + __builtin_ctz(mask);
+  }
+#endif
+
+  for (; p != end; ++p)
+    if (IsControlCharacter(*p))
+      return p;
+
+  return nullptr;
+}
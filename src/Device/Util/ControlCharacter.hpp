@@ -0,0 +1,50 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_CONTROL_CHARACTER_HPP
+#define XCSOAR_DEVICE_CONTROL_CHARACTER_HPP
+
+#include "Util/Compiler.h"
+
+/**
+ * Find the first ASCII control character (less than 0x20, including
+ * the NUL byte) in the specified range.  This uses SIMD instructions
+ * if available, because it is applied to every line received from a
+ * device.
+ *
+ * @return a pointer to the control character or nullptr if there is
+ * none
+ */
+gcc_pure
+const char *
+FindControlCharacter(const char *begin, const char *end) noexcept;
+
+gcc_pure
+static inline char *
+FindControlCharacter(char *begin, char *end) noexcept
+{
+  return const_cast<char *>(FindControlCharacter((const char *)begin,
+                                                 (const char *)end));
+}
+
+#endif
@@ -27,6 +27,22 @@ Copyright_License {
 class PortLineHandler {
 public:
   virtual bool LineReceived(const char *line) noexcept = 0;
+
+  /**
+   * A burst of lines was received.  Implementations may override
+   * this to handle all of them at once, e.g. to lock shared data
+   * only once per burst.  The default implementation calls
+   * LineReceived() for each line.
+   *
+   * @return false if the handler wishes to receive no more data
+   */
+  virtual bool LinesReceived(const char *const*lines, unsigned n) noexcept {
+    for (unsigned i = 0; i < n; ++i)
+      if (!LineReceived(lines[i]))
+        return false;
+
+    return true;
+  }
 };
 
 #endif
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "LineSplitter.hpp"
+#include "ControlCharacter.hpp"
 #include "Util/TextFile.hxx"
 #include "Util/StringStrip.hxx"
 
@@ -42,7 +43,11 @@ IsInsaneChar(char ch)
 static void
 SanitiseLine(char *const begin, char *const end)
 {
-  std::replace_if(begin, end, IsInsaneChar, ' ');
+  /* most lines are clean; find the first control character with a
+     vectorised scan before falling back to the byte loop */
+  char *const first = FindControlCharacter(begin, end);
+  if (first != nullptr)
+    std::replace_if(first, end, IsInsaneChar, ' ');
 }
 
 bool
@@ -67,6 +72,11 @@ PortLineSplitter::DataReceived(const void *_data, size_t length) noexcept
     data += nbytes;
     buffer.Append(nbytes);
 
+    /* the lines stay valid until the next buffer.Write() call,
+       which may shift the buffer */
+    const char *lines[MAX_BATCH];
+    unsigned n_lines = 0;
+
     while (true) {
       /* read data from the buffer, to see if there's a newline
          character */
@@ -89,9 +99,17 @@ PortLineSplitter::DataReceived(const void *_data, size_t length) noexcept
       while ((nul = memchr(line, 0, end - line)) != nullptr)
         line = (char *)nul + 1;
 
-      if (!LineReceived(line))
-        return false;
+      lines[n_lines++] = line;
+      if (n_lines == MAX_BATCH) {
+        if (!LinesReceived(lines, n_lines))
+          return false;
+
+        n_lines = 0;
+      }
     }
+
+    if (n_lines > 0 && !LinesReceived(lines, n_lines))
+      return false;
   } while (data < end);
 
   return true;
@@ -28,8 +28,23 @@ Copyright_License {
 #include "LineHandler.hpp"
 #include "Util/StaticFifoBuffer.hxx"
 
+/**
+ * Splits the data received from a #Port into lines.  All complete
+ * lines found in one chunk of data are passed to
+ * PortLineHandler::LinesReceived() at once.
+ */
 class PortLineSplitter : public DataHandler, protected PortLineHandler {
-  typedef StaticFifoBuffer<char, 256u> Buffer;
+  /**
+   * Large enough for the bursts delivered by the #Port
+   * implementations, so most bursts are dispatched as one batch.
+   */
+  typedef StaticFifoBuffer<char, 1024u> Buffer;
+
+  /**
+   * The maximum number of lines passed to LinesReceived() in one
+   * call.
+   */
+  static constexpr unsigned MAX_BATCH = 32;
 
   Buffer buffer;
 
@@ -31,6 +31,7 @@ Copyright_License {
 #include "LX/ManageNanoDialog.hpp"
 #include "LX/ManageLX16xxDialog.hpp"
 #include "PortMonitor.hpp"
+#include "IngestionTraceDialog.hpp"
 #include "Dialogs/WidgetDialog.hpp"
 #include "Dialogs/Message.hpp"
 #include "UIGlobals.hpp"
@@ -70,7 +71,7 @@ class DeviceListWidget final
   enum Buttons {
     DISABLE,
     RECONNECT, FLIGHT, EDIT, MANAGE, MONITOR,
-    DEBUG,
+    DEBUG, LATENCY,
   };
 
   const DialogLook &look;
@@ -289,6 +290,7 @@ DeviceListWidget::CreateButtons(WidgetDialog &dialog)
   reconnect_button = dialog.AddButton(_("Reconnect"), *this, RECONNECT);
   disable_button = dialog.AddButton(_("Disable"), *this, DISABLE);
   debug_button = dialog.AddButton(_("Debug"), *this, DEBUG);
+  dialog.AddButton(_("Latency"), *this, LATENCY);
 }
 
 void
@@ -600,7 +602,7 @@ DeviceListWidget::ManageCurrent()
     FlarmVersion version;
 
     {
-      const std::lock_guard<Mutex> lock(device_blackboard->mutex);
+      const std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
       const NMEAInfo &basic = device_blackboard->RealState(current);
       version = basic.flarm.version;
     }
@@ -610,7 +612,7 @@ DeviceListWidget::ManageCurrent()
     DeviceInfo info, secondary_info;
 
     {
-      const std::lock_guard<Mutex> lock(device_blackboard->mutex);
+      const std::lock_guard<InstrumentedMutex> lock(device_blackboard->mutex);
       const NMEAInfo &basic = device_blackboard->RealState(current);
       info = basic.device;
       secondary_info = basic.secondary_device;
@@ -697,6 +699,10 @@ DeviceListWidget::OnAction(int id) noexcept
   case DEBUG:
     DebugCurrent();
     break;
+
+  case LATENCY:
+    ShowIngestionTrace();
+    break;
   }
 }
 
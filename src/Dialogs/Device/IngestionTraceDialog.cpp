@@ -0,0 +1,169 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IngestionTraceDialog.hpp"
+#include "Dialogs/WidgetDialog.hpp"
+#include "Dialogs/Message.hpp"
+#include "Dialogs/Error.hpp"
+#include "Widget/LargeTextWidget.hpp"
+#include "Form/ActionListener.hpp"
+#include "Form/Button.hpp"
+#include "Device/IngestionTrace.hpp"
+#include "Event/PeriodicTimer.hpp"
+#include "Language/Language.hpp"
+#include "LocalPath.hpp"
+#include "OS/Path.hpp"
+#include "Util/ConvertString.hpp"
+#include "Util/StaticString.hxx"
+#include "UIGlobals.hpp"
+
+class IngestionTraceWidget final : public LargeTextWidget, ActionListener {
+  enum Buttons {
+    ENABLE,
+    RESET,
+    DUMP,
+  };
+
+  Button *enable_button;
+
+  PeriodicTimer update_timer{[this]{ Update(); }};
+
+public:
+  explicit IngestionTraceWidget(const DialogLook &look)
+    :LargeTextWidget(look) {}
+
+  void CreateButtons(WidgetDialog &dialog);
+
+private:
+  void Update();
+  void UpdateButtons();
+  void Dump();
+
+  /* virtual methods from class Widget */
+  void Show(const PixelRect &rc) override;
+  void Hide() override;
+
+  /* virtual methods from class ActionListener */
+  void OnAction(int id) noexcept override;
+};
+
+void
+IngestionTraceWidget::CreateButtons(WidgetDialog &dialog)
+{
+  enable_button = dialog.AddButton(_("Enable"), *this, ENABLE);
+  dialog.AddButton(_("Reset"), *this, RESET);
+  dialog.AddButton(_("Dump"), *this, DUMP);
+  UpdateButtons();
+}
+
+void
+IngestionTraceWidget::UpdateButtons()
+{
+  enable_button->SetCaption(ingestion_trace.IsEnabled()
+                            ? _("Disable")
+                            : _("Enable"));
+}
+
+void
+IngestionTraceWidget::Update()
+{
+  const std::string text = ingestion_trace.Format();
+  if (text.empty()) {
+    SetText(ingestion_trace.IsEnabled()
+            ? _("No data received yet.")
+            : _("Tracing is disabled."));
+    return;
+  }
+
+  const UTF8ToWideConverter converted(text.c_str());
+  if (converted.IsValid())
+    SetText(converted);
+}
+
+inline void
+IngestionTraceWidget::Dump()
+{
+  const auto path = LocalPath(_T("ingestion-trace.txt"));
+
+  try {
+    ingestion_trace.Dump(path);
+  } catch (...) {
+    ShowError(std::current_exception(), _("Failed to save file."));
+    return;
+  }
+
+  StaticString<256> msg;
+  msg.Format(_T("%s\n%s"), _("File saved"), path.c_str());
+  ShowMessageBox(msg, _("Dump"), MB_OK | MB_ICONINFORMATION);
+}
+
+void
+IngestionTraceWidget::Show(const PixelRect &rc)
+{
+  LargeTextWidget::Show(rc);
+  Update();
+  update_timer.Schedule(std::chrono::seconds(1));
+}
+
+void
+IngestionTraceWidget::Hide()
+{
+  update_timer.Cancel();
+  LargeTextWidget::Hide();
+}
+
+void
+IngestionTraceWidget::OnAction(int id) noexcept
+{
+  switch (id) {
+  case ENABLE:
+    ingestion_trace.SetEnabled(!ingestion_trace.IsEnabled());
+    UpdateButtons();
+    Update();
+    break;
+
+  case RESET:
+    ingestion_trace.Reset();
+    Update();
+    break;
+
+  case DUMP:
+    Dump();
+    break;
+  }
+}
+
+void
+ShowIngestionTrace()
+{
+  const DialogLook &look = UIGlobals::GetDialogLook();
+  IngestionTraceWidget widget(look);
+
+  WidgetDialog dialog(WidgetDialog::Full{}, UIGlobals::GetMainWindow(),
+                      look, _("Latency"), &widget);
+  widget.CreateButtons(dialog);
+  dialog.AddButton(_("Close"), mrOK);
+
+  dialog.ShowModal();
+  dialog.StealWidget();
+}
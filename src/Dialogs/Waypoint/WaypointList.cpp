@@ -40,6 +40,7 @@ Copyright_License {
 #include "Waypoint/Waypoints.hpp"
 #include "Components.hpp"
 #include "Form/DataField/Enum.hpp"
+#include "Util/StringCompare.hxx"
 #include "Util/StringPointer.hxx"
 #include "Util/AllocatedString.hxx"
 #include "UIGlobals.hpp"
@@ -131,6 +132,12 @@ class WaypointListWidget final
 
   WaypointList items;
 
+  /**
+   * Was #items built by #WaypointListBuilder from the current
+   * #dialog_state?  Only then can it be refined incrementally.
+   */
+  bool items_filtered = false;
+
   TwoTextRowsRenderer row_renderer;
 
   const GeoPoint location;
@@ -153,6 +160,15 @@ public:
 
   void UpdateList();
 
+  /**
+   * Apply a name filter which was extended by some characters to
+   * the current list, instead of building it again.
+   *
+   * @return false if that is not possible, and UpdateList() must be
+   * called
+   */
+  bool RefineList(const TCHAR *old_name);
+
   void OnWaypointListEnter();
 
   WaypointPtr GetCursorObject() const {
@@ -273,13 +289,17 @@ WaypointFilterWidget::Update(Angle _last_heading)
   direction_control.RefreshDisplay();
 }
 
-static void
+/**
+ * @return true if the list was built by #WaypointListBuilder, false
+ * if it was left empty
+ */
+static bool
 FillList(WaypointList &list, const Waypoints &src,
          GeoPoint location, Angle heading, const WaypointListDialogState &state,
          OrderedTask *ordered_task, unsigned ordered_task_index)
 {
   if (!state.IsDefined() && src.size() >= 500)
-    return;
+    return false;
 
   WaypointFilter filter;
   state.ToFilter(filter, heading);
@@ -290,6 +310,8 @@ FillList(WaypointList &list, const Waypoints &src,
 
   if (filter.distance > 0 || !filter.direction.IsNegative())
     list.SortByDistance(location);
+
+  return true;
 }
 
 static void
@@ -311,19 +333,43 @@ WaypointListWidget::UpdateList()
 {
   items.clear();
 
+  items_filtered = false;
+
   if (dialog_state.type_index == TypeFilter::LAST_USED)
     FillLastUsedList(items, LastUsedWaypoints::GetList(),
                      way_points);
   else
-    FillList(items, way_points, location, last_heading,
-             dialog_state,
-             ordered_task, ordered_task_index);
+    items_filtered = FillList(items, way_points, location, last_heading,
+                              dialog_state,
+                              ordered_task, ordered_task_index);
+
+  auto &list = GetList();
+  list.SetLength(std::max(1u, (unsigned)items.size()));
+  list.SetOrigin(0);
+  list.SetCursorIndex(0);
+  list.Invalidate();
+}
+
+bool
+WaypointListWidget::RefineList(const TCHAR *old_name)
+{
+  if (!items_filtered ||
+      dialog_state.name.length() <= _tcslen(old_name) ||
+      !StringStartsWith(dialog_state.name.c_str(), old_name))
+    return false;
+
+  WaypointFilter filter;
+  dialog_state.ToFilter(filter, last_heading);
+
+  RefineWaypointList(items, filter, old_name,
+                     filter.distance <= 0 && filter.direction.IsNegative());
 
   auto &list = GetList();
   list.SetLength(std::max(1u, (unsigned)items.size()));
   list.SetOrigin(0);
   list.SetCursorIndex(0);
   list.Invalidate();
+  return true;
 }
 
 void
@@ -340,7 +386,7 @@ static const TCHAR *
 WaypointNameAllowedCharacters(const TCHAR *prefix)
 {
   static TCHAR buffer[256];
-  return way_points.SuggestNamePrefix(prefix, buffer, ARRAY_SIZE(buffer));
+  return way_points.SuggestNameContaining(prefix, buffer, ARRAY_SIZE(buffer));
 }
 
 static DataField *
@@ -419,6 +465,8 @@ void
 WaypointListWidget::OnModified(DataField &df)
 {
   if (filter_widget.IsDataField(NAME, df)) {
+    const StaticString<WaypointFilter::NAME_LENGTH + 1> old_name =
+      dialog_state.name;
     dialog_state.name = df.GetAsString();
 
     /* pass the focus to the list so the user can use the up/down keys
@@ -430,6 +478,10 @@ WaypointListWidget::OnModified(DataField &df)
        likely changed by left/right */
     if (dialog_state.name.length() > 1)
       GetList().SetFocus();
+
+    /* typing one more character only removes items from the list */
+    if (RefineList(old_name))
+      return;
   } else if (filter_widget.IsDataField(DISTANCE, df)) {
     const DataFieldEnum &dfe = (const DataFieldEnum &)df;
     dialog_state.distance_index = dfe.GetValue();
@@ -261,6 +261,7 @@ GlidePolar::IsGlidePossible(const GlideState &task) const
   return true;
 }
 
+#if 0
 /**
  * Finds speed to fly for a given MacCready setting
  * Intended to be used temporarily.
@@ -319,12 +320,33 @@ public:
   }
 };
 
+#endif
+
 double
 GlidePolar::SpeedToFly(const double stf_sink_rate, const double head_wind) const
 {
   assert(IsValid());
+
+  /* the speed range which GlidePolarSpeedToFly would search */
+  const auto v_low = std::max(1 + head_wind, Vmin);
+
+#if 0
+  // this method to be used if polar is not parabolic
   GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
   return gp_stf.solve(Vmax);
+#else
+  /* the tangent from (head_wind, -mc-stf_sink_rate) to the parabolic
+     polar, see GetBestGlideRatioSpeed(); the MacCready-adjusted
+     glide ratio over ground has no other extremum, so the optimum
+     within the speed range is the clamped tangent point */
+  const auto s = head_wind * head_wind +
+    (mc + stf_sink_rate + polar.c + polar.b * head_wind) / polar.a;
+  if (s < 0)
+    /* strong lift: the glide ratio improves when flying slower */
+    return std::min(v_low, Vmax);
+
+  return std::min(std::max(head_wind + sqrt(s), v_low), Vmax);
+#endif
 }
 
 double
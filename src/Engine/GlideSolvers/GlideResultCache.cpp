@@ -0,0 +1,98 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "GlideResultCache.hpp"
+#include "GlideState.hpp"
+#include "GlidePolar.hpp"
+#include "MacCready.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+static inline unsigned
+HashDouble(unsigned h, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return h * 31 + unsigned(bits ^ (bits >> 32));
+}
+
+unsigned
+GlideResultCache::Key::Hash() const
+{
+  unsigned h = HashDouble(0, distance);
+  h = HashDouble(h, altitude_difference);
+  h = HashDouble(h, mc);
+  /* spread the bits, the table index uses only the low ones */
+  h *= 0x9e3779b1u;
+  return h ^ (h >> 16);
+}
+
+void
+GlideResultCache::Clear()
+{
+  if (++generation == 0) {
+    /* wraparound: invalidate the items explicitly */
+    for (auto &i : items)
+      i.generation = 0;
+    generation = 1;
+  }
+}
+
+GlideResult
+GlideResultCache::Solve(const GlideSettings &settings,
+                        const GlidePolar &glide_polar,
+                        const GlideState &state)
+{
+  const Polar new_polar{
+    glide_polar.GetBugs(), glide_polar.GetBallast(),
+    glide_polar.GetVMax(), glide_polar.GetVMin(),
+    glide_polar.GetSMin(),
+    settings.predict_wind_drift,
+  };
+
+  if (!(new_polar == polar)) {
+    /* a different polar: all cached results are stale */
+    Clear();
+    polar = new_polar;
+  }
+
+  const Key key{
+    state.vector.distance, state.vector.bearing.Native(),
+    state.min_arrival_altitude, state.altitude_difference,
+    state.wind.norm, state.wind.bearing.Native(),
+    glide_polar.GetMC(), glide_polar.GetCruiseEfficiency(),
+  };
+
+  Item &item = items[key.Hash() % SIZE];
+  if (item.generation == generation && item.key == key) {
+    ++n_hits;
+    return item.result;
+  }
+
+  ++n_misses;
+
+  item.key = key;
+  item.result = MacCready::Solve(settings, glide_polar, state);
+  item.generation = generation;
+  return item.result;
+}
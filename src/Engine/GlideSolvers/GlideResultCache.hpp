@@ -0,0 +1,136 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef GLIDE_RESULT_CACHE_HPP
+#define GLIDE_RESULT_CACHE_HPP
+
+#include "GlideResult.hpp"
+#include "Util/Compiler.h"
+
+#include <array>
+
+struct GlideState;
+
+/**
+ * A cache of MacCready::Solve() results.  The task solvers solve the
+ * same legs with the same MacCready setting over and over again
+ * during one calculation cycle: the AAT target optimisers only move
+ * some of the targets, and the searches for the best MacCready
+ * setting and the cruise efficiency start with the current solution.
+ *
+ * The key is the exact #GlideState plus the MacCready setting and
+ * cruise efficiency, i.e. the cached results are exact.  All other
+ * parameters of the #GlidePolar and the #GlideSettings are assumed
+ * to be constant; if they change, the cache flushes itself.
+ *
+ * A look-up costs about as much as a fraction of a MacCready::Solve()
+ * call, so this is a direct mapped table instead of a LRU cache.
+ */
+class GlideResultCache {
+  static constexpr unsigned SIZE = 256;
+
+  struct Key {
+    double distance, bearing;
+    double min_arrival_altitude, altitude_difference;
+    double wind_speed, wind_bearing;
+    double mc, cruise_efficiency;
+
+    gcc_pure
+    bool operator==(const Key &other) const {
+      return distance == other.distance && bearing == other.bearing &&
+        min_arrival_altitude == other.min_arrival_altitude &&
+        altitude_difference == other.altitude_difference &&
+        wind_speed == other.wind_speed &&
+        wind_bearing == other.wind_bearing &&
+        mc == other.mc && cruise_efficiency == other.cruise_efficiency;
+    }
+
+    gcc_pure
+    unsigned Hash() const;
+  };
+
+  /**
+   * The parameters which are not part of the #Key.  The cache is
+   * flushed when one of them changes.
+   */
+  struct Polar {
+    double bugs, ballast, v_max, v_min, s_min;
+    bool predict_wind_drift;
+
+    gcc_pure
+    bool operator==(const Polar &other) const {
+      return bugs == other.bugs && ballast == other.ballast &&
+        v_max == other.v_max && v_min == other.v_min &&
+        s_min == other.s_min &&
+        predict_wind_drift == other.predict_wind_drift;
+    }
+  };
+
+  struct Item {
+    Key key;
+    GlideResult result;
+
+    /**
+     * The item is valid if this equals GlideResultCache::generation.
+     */
+    unsigned generation = 0;
+  };
+
+  std::array<Item, SIZE> items;
+
+  /**
+   * Incremented by Clear(), which invalidates all items at once.
+   */
+  unsigned generation = 1;
+
+  Polar polar{};
+
+  unsigned n_hits = 0, n_misses = 0;
+
+public:
+  void Clear();
+
+  /**
+   * A caching wrapper for MacCready::Solve().
+   */
+  GlideResult Solve(const GlideSettings &settings,
+                    const GlidePolar &glide_polar,
+                    const GlideState &state);
+
+  /**
+   * Returns the number of Solve() calls which were answered from the
+   * cache.
+   */
+  unsigned GetHits() const {
+    return n_hits;
+  }
+
+  /**
+   * Returns the number of Solve() calls which had to call
+   * MacCready::Solve().
+   */
+  unsigned GetMisses() const {
+    return n_misses;
+  }
+};
+
+#endif
@@ -27,7 +27,10 @@
 #include "Math/ZeroFinder.hpp"
 #include "Util/Tolerances.hpp"
 
+#include <algorithm>
+
 #include <cassert>
+#include <math.h>
 
 MacCready::MacCready(const GlideSettings &_settings,
                      const GlidePolar &_glide_polar,
@@ -380,11 +383,94 @@ public:
   }
 };
 
+double
+MacCready::CalcOptimumGlideSpeed(const GlideState &task) const
+{
+  /* the quantity to be minimised is S(V)/G(V) with the parabolic sink
+     rate S(V)=aV^2+bV+c and the ground speed
+     G(V)=sqrt(k^2V^2-X)-H, where k is the cruise efficiency, H the
+     head wind and X the square of the cross wind (see
+     GlideState::CalcAverageSpeed()).  S is convex and G is concave,
+     therefore the derivative condition g(V)=S'G-SG'=0 has exactly
+     one root where G is positive, and g is increasing there. */
+
+  const auto p = glide_polar.GetRealCoefficients();
+  const auto k = cruise_efficiency;
+  const auto k2 = k * k;
+  const auto h = task.head_wind;
+  const auto w = task.wind.norm;
+  const auto x = std::max(w * w - h * h, 0.);
+
+  const auto v_min = glide_polar.GetVMin();
+  const auto v_max = glide_polar.GetVMax();
+
+  /* below this speed there is no progress over ground */
+  const auto v_zero = (h > 0 ? w : sqrt(x)) / k;
+  if (v_zero >= v_max)
+    return -1;
+
+  /* returns g(V) and stores g'(V) in #dg */
+  const auto g = [&p, k2, h, x](double v, double &dg){
+    const auto r = sqrt(k2 * v * v - x);
+    const auto gs = r - h;
+    const auto s = v * (v * p.a + p.b) + p.c;
+    const auto ds = 2 * v * p.a + p.b;
+    dg = 2 * p.a * gs + s * k2 * x / (r * r * r);
+    return ds * gs - s * k2 * v / r;
+  };
+
+  double dg;
+  if (g(v_max, dg) <= 0)
+    return v_max;
+
+  auto lower = v_zero, upper = v_max;
+  if (v_min > v_zero) {
+    if (g(v_min, dg) >= 0)
+      return v_min;
+
+    lower = v_min;
+  }
+
+  /* start with the tangent for a pure head wind, then continue with
+     Newton's method, falling back to bisection whenever it leaves
+     the bracket */
+  const auto s0 = h * h + k * (p.b * h + k * p.c) / p.a;
+  auto v = s0 > 0 ? (h + sqrt(s0)) / k : upper;
+  if (!(v > lower && v < upper))
+    v = (lower + upper) / 2;
+
+  for (unsigned i = 0; i < 32; ++i) {
+    const auto gv = g(v, dg);
+    if (gv < 0)
+      lower = v;
+    else
+      upper = v;
+
+    auto next = v - gv / dg;
+    if (!(next > lower && next < upper))
+      next = (lower + upper) / 2;
+
+    if (fabs(next - v) < TOLERANCE_MC_OPT_GLIDE * TOLERANCE_MC_OPT_GLIDE)
+      return next;
+
+    v = next;
+  }
+
+  return v;
+}
+
 GlideResult
 MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
 {
   assert(glide_polar.GetMC() <= 0);
 
+  if (!allow_partial || task.altitude_difference > 0) {
+    const auto v = CalcOptimumGlideSpeed(task);
+    if (v > 0)
+      return SolveGlide(task, v, allow_partial);
+  }
+
+  /* no glide at any speed; let the search pick a speed as before */
   MacCreadyVopt mc_vopt(task, *this,
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
@@ -156,6 +156,18 @@ private:
   GlideResult OptimiseGlide(const GlideState &task,
                             const bool allow_partial = false) const;
 
+  /**
+   * Calculate the airspeed which maximises the glide ratio over
+   * ground for the given task, within the speed range of the polar.
+   *
+   * @param task Task to solve for
+   *
+   * @return Speed (m/s) or a negative value if no speed in the range
+   * makes progress against the wind
+   */
+  gcc_pure
+  double CalcOptimumGlideSpeed(const GlideState &task) const;
+
   /**
    * Solve a task which is known to be pure climb (no distance
    * to travel other than that due to drift).
@@ -31,4 +31,7 @@ RoutePlannerConfig::SetDefaults()
   safety_height_terrain = 150;
   reach_calc_mode = ReachMode::STRAIGHT;
   reach_polar_mode = Polar::SAFETY;
+  reach_incremental = true;
+  clearance_cache = true;
+  time_budget = std::chrono::steady_clock::duration::zero();
 }
@@ -23,6 +23,8 @@
 #ifndef XCSOAR_ROUTE_PLANNER_CONFIG_HPP
 #define XCSOAR_ROUTE_PLANNER_CONFIG_HPP
 
+#include <chrono>
+
 struct RoutePlannerConfig
 {
   enum class Mode {
@@ -58,8 +60,40 @@ struct RoutePlannerConfig
   /** Whether reach/abort calculations will use the task or safety polar */
   Polar reach_polar_mode;
 
+  /**
+   * Whether reach calculations may reuse the terrain scans of the
+   * previous solution if the aircraft has not moved far
+   */
+  bool reach_incremental;
+
+  /**
+   * Whether the route planner may cache terrain clearance results
+   * between solutions
+   */
+  bool clearance_cache;
+
+  /**
+   * Maximum time spent in one RoutePlanner::Solve() call.  If the
+   * search does not finish in time, the best route found so far is
+   * kept and the search continues in the next call.  Zero means no
+   * limit; the search then always runs to the end.
+   */
+  std::chrono::steady_clock::duration time_budget;
+
   void SetDefaults();
 
+  bool operator==(const RoutePlannerConfig &other) const {
+    return mode == other.mode &&
+      allow_climb == other.allow_climb &&
+      use_ceiling == other.use_ceiling &&
+      safety_height_terrain == other.safety_height_terrain &&
+      reach_calc_mode == other.reach_calc_mode &&
+      reach_polar_mode == other.reach_polar_mode &&
+      reach_incremental == other.reach_incremental &&
+      clearance_cache == other.clearance_cache &&
+      time_budget == other.time_budget;
+  }
+
   bool IsTerrainEnabled() const {
     return mode == Mode::TERRAIN || mode == Mode::BOTH;
   }
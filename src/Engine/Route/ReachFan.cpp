@@ -25,45 +25,109 @@
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
 
+#include <math.h>
+
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
+/**
+ * Maximum distance (m) from the previous origin for an incremental
+ * solution.
+ */
+static constexpr double REACH_INCREMENTAL_MAX_SHIFT = 500;
+
+/**
+ * Maximum height change (m) since the previous origin for an
+ * incremental solution.
+ */
+static constexpr double REACH_INCREMENTAL_MAX_HEIGHT_CHANGE = 50;
+
+/**
+ * Maximum distance (m) from the projection center for an incremental
+ * solution.  The projection is kept while solving incrementally, to
+ * keep the cached rays comparable.
+ */
+static constexpr double REACH_INCREMENTAL_MAX_DRIFT = 5000;
+
+/**
+ * Number of incremental solutions after which a full solution is
+ * forced, e.g. to pick up newly loaded terrain tiles.
+ */
+static constexpr unsigned REACH_INCREMENTAL_MAX_COUNT = 10;
+
 void
 ReachFan::Reset()
 {
   root.Clear();
   terrain_base = 0;
+  rays.Clear();
+  n_incremental = 0;
+}
+
+inline bool
+ReachFan::CanSolveIncremental(const AGeoPoint &new_origin,
+                              const RasterMap *terrain) const
+{
+  return terrain != nullptr && !root.IsEmpty() && !root.IsDummy() &&
+    rays.GetRayCount() > 0 &&
+    n_incremental < REACH_INCREMENTAL_MAX_COUNT &&
+    fabs(new_origin.altitude - origin.altitude) <=
+    REACH_INCREMENTAL_MAX_HEIGHT_CHANGE &&
+    new_origin.Distance(origin) <= REACH_INCREMENTAL_MAX_SHIFT &&
+    new_origin.Distance(projection.GetCenter()) <= REACH_INCREMENTAL_MAX_DRIFT;
 }
 
 bool
-ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-                const RasterMap* terrain, const bool do_solve)
+ReachFan::Solve(const AGeoPoint _origin, const RoutePolars &rpolars,
+                const RasterMap* terrain, const bool do_solve,
+                const bool incremental)
 {
-  Reset();
+  const bool use_previous = incremental && do_solve &&
+    CanSolveIncremental(_origin, terrain);
+
+  root.Clear();
+  terrain_base = 0;
 
-  // initialise projection
-  projection = FlatProjection(origin);
+  if (use_previous) {
+    /* keep the projection, the cached rays refer to it */
+    std::swap(rays, previous_rays);
+    ++n_incremental;
+  } else {
+    // initialise projection
+    projection = FlatProjection(_origin);
+    n_incremental = 0;
+  }
+
+  rays.Clear();
+  origin = _origin;
 
   const auto h = terrain
-    ? terrain->GetHeight(origin)
+    ? terrain->GetHeight(_origin)
     : TerrainHeight::Invalid();
   const int h2 = h.GetValueOr0();
 
   ReachFanParms parms(rpolars, projection, terrain_base, terrain);
-  const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
+  const AFlatGeoPoint ao(projection.ProjectInteger(_origin), _origin.altitude);
 
   // immediate exit if starting below terrain, or starting below floor
   // with some clearance (not worth scanning if too close)
   if ((!h.IsInvalid() &&
-      (origin.altitude <= h2 + rpolars.GetSafetyHeight()))
-      || (origin.altitude < MIN_FLOOR_CLEARANCE + rpolars.GetFloor() + rpolars.GetSafetyHeight())) {
+      (_origin.altitude <= h2 + rpolars.GetSafetyHeight()))
+      || (_origin.altitude < MIN_FLOOR_CLEARANCE + rpolars.GetFloor() + rpolars.GetSafetyHeight())) {
     terrain_base = h2;
     root.DummyReach(ao);
     return false;
   }
 
-  if (do_solve)
+  if (do_solve) {
+    if (use_previous)
+      parms.previous_rays = &previous_rays;
+    parms.rays = &rays;
+
     root.FillReach(ao, parms);
-  else
+
+    parms.previous_rays = nullptr;
+    parms.rays = nullptr;
+  } else
     root.DummyReach(ao);
 
   if (!h.IsInvalid()) {
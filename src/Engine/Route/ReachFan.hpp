@@ -25,6 +25,8 @@
 
 #include "Geo/Flat/FlatProjection.hpp"
 #include "FlatTriangleFanTree.hpp"
+#include "ReachRayCache.hpp"
+#include "Geo/GeoPoint.hpp"
 
 class RoutePolars;
 class RasterMap;
@@ -37,8 +39,27 @@ class ReachFan
   FlatTriangleFanTree root;
   int terrain_base;
 
+  /** The origin of the current solution */
+  AGeoPoint origin;
+
+  /**
+   * The rays scanned by the current solution, to be reused by the
+   * next incremental solution.  Empty if incremental solving is not
+   * possible.
+   */
+  ReachRayCache rays;
+
+  /** Scratch buffer for the rays of the previous solution */
+  ReachRayCache previous_rays;
+
+  /**
+   * The number of incremental solutions since the last full
+   * solution.
+   */
+  unsigned n_incremental;
+
 public:
-  ReachFan():terrain_base(0) {}
+  ReachFan():terrain_base(0), n_incremental(0) {}
 
   friend class PrintHelper;
 
@@ -52,8 +73,15 @@ public:
 
   void Reset();
 
-  bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-             const RasterMap *terrain, const bool do_solve = true);
+  /**
+   * @param incremental allow reusing the terrain rays of the previous
+   * solution which are not affected by the origin shift and height
+   * change; a full solution is calculated if the origin has moved too
+   * far
+   */
+  bool Solve(const AGeoPoint _origin, const RoutePolars &rpolars,
+             const RasterMap *terrain, const bool do_solve = true,
+             const bool incremental = false);
 
   bool FindPositiveArrival(const AGeoPoint dest, const RoutePolars &rpolars,
                            ReachResult &result_r) const;
@@ -64,6 +92,26 @@ public:
   int GetTerrainBase() const {
     return terrain_base;
   }
+
+  /**
+   * Returns the number of terrain rays of the current solution.
+   */
+  unsigned GetRayCount() const {
+    return rays.GetRayCount();
+  }
+
+  /**
+   * Returns the number of terrain rays of the current solution which
+   * were reused from the previous one.
+   */
+  unsigned GetReusedRayCount() const {
+    return rays.GetReusedCount();
+  }
+
+private:
+  gcc_pure
+  bool CanSolveIncremental(const AGeoPoint &new_origin,
+                           const RasterMap *terrain) const;
 };
 
 #endif
@@ -24,8 +24,9 @@
 #define REACHFAN_PARMS_HPP
 
 #include "Route/RoutePolars.hpp"
+#include "ReachRayCache.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
 
-class FlatProjection;
 class RasterMap;
 
 struct ReachFanParms {
@@ -38,6 +39,15 @@ struct ReachFanParms {
   unsigned vertex_counter = 0;
   unsigned char set_depth = 0;
 
+  /**
+   * Rays of the previous solution which may be reused instead of
+   * scanning the terrain again (optional).
+   */
+  const ReachRayCache *previous_rays = nullptr;
+
+  /** Receives all rays of this solution (optional) */
+  ReachRayCache *rays = nullptr;
+
   ReachFanParms(const RoutePolars& _rpolars,
                 const FlatProjection &_projection,
                 const short _terrain_base,
@@ -45,11 +55,27 @@ struct ReachFanParms {
     :rpolars(_rpolars), projection(_projection), terrain(_terrain),
      terrain_base(_terrain_base) {}
 
-  gcc_pure
   FlatGeoPoint ReachIntercept(int index, const AFlatGeoPoint &flat_origin,
                               const GeoPoint &origin) const {
-    return rpolars.ReachIntercept(index, flat_origin, origin,
-                                  terrain, projection);
+    const double gradient = rpolars.GetGlideGradient(index);
+
+    if (previous_rays != nullptr) {
+      const auto *ray =
+        previous_rays->Find(index, flat_origin, gradient,
+                            projection.GetApproximateScale());
+      if (ray != nullptr) {
+        if (rays != nullptr)
+          rays->Add(index, *ray, true);
+        return ray->intercept;
+      }
+    }
+
+    const FlatGeoPoint intercept =
+      rpolars.ReachIntercept(index, flat_origin, origin,
+                             terrain, projection);
+    if (rays != nullptr)
+      rays->Add(index, {flat_origin, intercept, gradient}, false);
+    return intercept;
   }
 };
 
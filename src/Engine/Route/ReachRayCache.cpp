@@ -0,0 +1,111 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "ReachRayCache.hpp"
+
+#include <math.h>
+
+/**
+ * Maximum lateral offset between the old and the new ray, relative
+ * to the ray length.  This is a quarter of the angular resolution of
+ * the root fan.
+ */
+static constexpr double REACH_RAY_LATERAL_FRACTION =
+  M_PI / (2 * ROUTEPOLAR_Q3);
+
+/**
+ * Maximum height (m) the new glide line may be above the old one at
+ * the old intercept.  Reusing such a ray under-estimates the reach,
+ * which is on the safe side.
+ */
+static constexpr double REACH_RAY_MAX_GAIN = 20;
+
+static constexpr unsigned
+SafeIndex(int index)
+{
+  return ((unsigned)index) % ROUTEPOLAR_POINTS;
+}
+
+void
+ReachRayCache::Clear()
+{
+  for (auto &i : rays)
+    i.clear();
+
+  n_rays = n_reused = 0;
+}
+
+void
+ReachRayCache::Add(int index, const Ray &ray, bool reused)
+{
+  rays[SafeIndex(index)].push_back(ray);
+
+  ++n_rays;
+  if (reused)
+    ++n_reused;
+}
+
+const ReachRayCache::Ray *
+ReachRayCache::Find(int index, const AFlatGeoPoint &origin,
+                    double gradient, double scale) const
+{
+  for (const auto &ray : rays[SafeIndex(index)]) {
+    /* use floating point, the products of flat coordinates may
+       overflow int */
+    const double lx = ray.intercept.x - ray.origin.x;
+    const double ly = ray.intercept.y - ray.origin.y;
+    const double length = hypot(lx, ly);
+    if (length <= 0)
+      /* blocked right at the origin; that is cheap to scan again */
+      continue;
+
+    const double dx = origin.x - ray.origin.x;
+    const double dy = origin.y - ray.origin.y;
+    const double along = (dx * lx + dy * ly) / length;
+    const double lateral = fabs(dx * ly - dy * lx) / length;
+    const double tolerance = length * REACH_RAY_LATERAL_FRACTION;
+    /* the terrain behind the old origin has never been scanned */
+    if (lateral > tolerance || along < 0 || along >= length)
+      continue;
+
+    /* compare the height of both glide lines at the new origin and
+       at the old intercept; if the new line is not lower at both
+       ends, it is not lower anywhere in between, even with a
+       different gradient.  A lower glide line may hit the terrain
+       before the old intercept, and reusing it would over-estimate
+       the reach. */
+    const double h_old_origin =
+      ray.origin.altitude - along * scale * ray.gradient;
+    if (origin.altitude < h_old_origin)
+      continue;
+
+    const double h_old = ray.origin.altitude - length * scale * ray.gradient;
+    const double h_new = origin.altitude - (length - along) * scale * gradient;
+    const double dh = h_new - h_old;
+    if (dh < 0 || dh > REACH_RAY_MAX_GAIN)
+      continue;
+
+    return &ray;
+  }
+
+  return nullptr;
+}
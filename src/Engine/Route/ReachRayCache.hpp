@@ -0,0 +1,106 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef REACH_RAY_CACHE_HPP
+#define REACH_RAY_CACHE_HPP
+
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "RoutePolar.hpp"
+#include "Util/Compiler.h"
+
+#include <array>
+#include <vector>
+
+/**
+ * Remembers the terrain intercept of every ray scanned while solving
+ * a #ReachFan, so that a later solution from a nearby origin can
+ * reuse the rays which are not affected by the origin shift and
+ * height change instead of scanning the terrain again.
+ *
+ * All points must be projected with the same #FlatProjection.
+ */
+class ReachRayCache {
+public:
+  struct Ray {
+    AFlatGeoPoint origin;
+    FlatGeoPoint intercept;
+
+    /** Glide slope gradient used to scan this ray (m loss / m travelled) */
+    double gradient;
+  };
+
+private:
+  typedef std::vector<Ray> RayVector;
+
+  /** the rays, indexed by their #RoutePolar direction index */
+  std::array<RayVector, ROUTEPOLAR_POINTS> rays;
+
+  unsigned n_rays = 0, n_reused = 0;
+
+public:
+  void Clear();
+
+  /**
+   * Remember a ray.
+   *
+   * @param reused true if the ray was obtained from Find() instead
+   * of a terrain scan; it is stored unmodified, so the tolerances of
+   * later Find() calls are always measured against the original scan
+   */
+  void Add(int index, const Ray &ray, bool reused);
+
+  /**
+   * Look for a ray in the given direction whose intercept is still
+   * valid when seen from the new origin.  That is the case if the new
+   * ray is (almost) a sub-segment of the old one, i.e. the lateral
+   * offset is small compared to the angular resolution of the fan
+   * and the new origin is not behind the old one, and if the new
+   * glide line is not below the old one at the new origin and arrives
+   * at the old intercept at the same height or slightly above it.  A
+   * lower glide line is never accepted, because it may hit the
+   * terrain earlier.
+   *
+   * @param scale the approximate scale of the #FlatProjection (m per
+   * unit)
+   * @return the ray or nullptr if the ray needs to be scanned
+   */
+  gcc_pure
+  const Ray *Find(int index, const AFlatGeoPoint &origin,
+                           double gradient, double scale) const;
+
+  /**
+   * Returns the number of rays added since the last Clear() call.
+   */
+  unsigned GetRayCount() const {
+    return n_rays;
+  }
+
+  /**
+   * Returns the number of rays added since the last Clear() call
+   * which were reused from a previous solution.
+   */
+  unsigned GetReusedCount() const {
+    return n_reused;
+  }
+};
+
+#endif
@@ -24,6 +24,8 @@
 #include "Terrain/RasterMap.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 
+#include <stdlib.h>
+
 RoutePlanner::RoutePlanner()
   :terrain(NULL), planner(0),
    unique_links(50000),
@@ -51,7 +53,11 @@ RoutePlanner::Reset()
   h_min = -1;
   h_max = 0;
   search_hull.clear();
+  search_epsilon = 1;
+  search_solved = false;
+  stats.Clear();
   ClearReach();
+  clearance_cache.Clear();
 }
 
 bool
@@ -62,7 +68,8 @@ RoutePlanner::SolveReachTerrain(const AGeoPoint &origin,
   rpolars_reach.SetConfig(config, origin.altitude, h_ceiling);
   reach_polar_mode = config.reach_polar_mode;
 
-  return reach_terrain.Solve(origin, rpolars_reach, terrain, do_solve);
+  return reach_terrain.Solve(origin, rpolars_reach, terrain, do_solve,
+                             config.reach_incremental);
 }
 
 bool
@@ -73,16 +80,33 @@ RoutePlanner::SolveReachWorking(const AGeoPoint &origin,
   rpolars_reach_working.SetConfig(config, origin.altitude, h_ceiling);
   // reach_polar_mode previously set by SolveReachTerrain
 
-  return reach_working.Solve(origin, rpolars_reach_working, terrain, do_solve);
+  return reach_working.Solve(origin, rpolars_reach_working, terrain, do_solve,
+                             config.reach_incremental);
 }
 
+/**
+ * Heuristic inflation factor of the first search in anytime mode.
+ */
+static constexpr double ANYTIME_EPSILON_START = 2;
+
+/**
+ * After each completed search in anytime mode, the inflation factor
+ * is lowered by this amount until it reaches 1.
+ */
+static constexpr double ANYTIME_EPSILON_STEP = 0.5;
+
 bool
 RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
                     const RoutePlannerConfig &config, const int h_ceiling)
 {
+  const auto start_time = std::chrono::steady_clock::now();
+  const bool anytime =
+    config.time_budget > std::chrono::steady_clock::duration::zero();
+  const auto deadline = anytime
+    ? start_time + config.time_budget
+    : std::chrono::steady_clock::time_point::max();
+
   OnSolve(origin, destination);
-  rpolars_route.SetConfig(config, std::max(destination.altitude, origin.altitude),
-                          h_ceiling);
 
   {
     const AFlatGeoPoint s_origin(projection.ProjectInteger(origin),
@@ -91,74 +115,174 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
     const AFlatGeoPoint s_destination(projection.ProjectInteger(destination),
                                       destination.altitude);
 
-    if (!(s_origin == origin_last) || !(s_destination == destination_last))
-      dirty = true;
+    /* a pending search is continued towards the destination it was
+       started with, even if the destination has moved since (e.g. the
+       aircraft in RouteComputer); the route then ends there, and all
+       of its legs have been checked against terrain and airspace.
+       The caller starts a new search by calling Solve() after the
+       pending one has finished. */
+    bool resume = stats.pending && !dirty && s_origin == origin_last;
+    if (resume) {
+      rpolars_route.SetConfig(config,
+                              std::max(search_destination.altitude,
+                                       origin.altitude),
+                              search_h_ceiling);
+
+      /* the polars or the configuration may have changed since the
+         pending search was started; its costs are then no longer
+         valid */
+      resume = rpolars_route == rpolars_search;
+    }
+
+    if (resume) {
+      /* continue the pending search */
+    } else {
+      rpolars_route.SetConfig(config,
+                              std::max(destination.altitude, origin.altitude),
+                              h_ceiling);
+
+      if (stats.pending)
+        /* abandon the pending search */
+        dirty = true;
+
+      if (!(s_origin == origin_last) || !(s_destination == destination_last))
+        dirty = true;
+
+      // new search
+
+      if (IsTrivial())
+        return false;
+
+      const bool same_origin = s_origin == origin_last;
+
+      dirty = false;
+      origin_last = s_origin;
+      destination_last = s_destination;
+
+      rpolars_search = rpolars_route;
+      search_destination = destination;
+      search_h_ceiling = h_ceiling;
+
+      h_min = std::min(s_origin.altitude, s_destination.altitude);
+      h_max = rpolars_route.cruise_altitude;
+
+      stats.pending = false;
+      stats.total_duration = std::chrono::steady_clock::duration::zero();
+
+      if (!rpolars_route.IsTerrainEnabled() &&
+          !rpolars_route.IsAirspaceEnabled()) {
+        SetDirectSolution(origin, destination);
+        return false; // trivial
+      }
+
+      astar_goal = destination_last;
 
-    if (IsTrivial())
-      return false;
+      RouteLink e_test(origin_last, astar_goal, projection);
+      if (e_test.IsShort() || !rpolars_route.IsAchievable(e_test)) {
+        SetDirectSolution(origin, destination);
+        return false;
+      }
 
-    dirty = false;
-    origin_last = s_origin;
-    destination_last = s_destination;
+      if (same_origin && stats.epsilon > 0)
+        /* keep the previous route to the same origin until the new
+           search has found one */
+        search_solved = false;
+      else
+        SetDirectSolution(origin, destination);
 
-    h_min = std::min(s_origin.altitude, s_destination.altitude);
-    h_max = rpolars_route.cruise_altitude;
+      search_epsilon = anytime ? ANYTIME_EPSILON_START : 1;
+      StartSearch();
+    }
   }
 
-  solution_route.clear();
-  solution_route.push_back(origin);
-  solution_route.push_back(destination);
+  stats.iterations = 0;
 
-  if (!rpolars_route.IsTerrainEnabled() && !rpolars_route.IsAirspaceEnabled())
-    return false; // trivial
+  bool retval = false;
+  SearchResult result;
+  while (true) {
+    result = RunSearch(deadline);
+    if (result == SearchResult::INTERRUPTED)
+      break;
 
-  search_hull.clear();
-  search_hull.emplace_back(origin_last, projection);
+    count_unique = unique_links.size();
 
-  RoutePoint start = origin_last;
-  astar_goal = destination_last;
+    if (result == SearchResult::FOUND) {
+      Route this_solution;
+      const unsigned d = FindSolution(astar_goal, this_solution);
+      if (!search_solved || d < stats.cost) {
+        // correct solution for rounding
+        assert(this_solution.size() >= 2);
+        for (auto &i : this_solution) {
+          FlatGeoPoint p(projection.ProjectInteger(i));
+          if (p == origin_last) {
+            i = AGeoPoint(origin, i.altitude);
+          } else if (p == destination_last) {
+            i = AGeoPoint(search_destination, i.altitude);
+          }
+        }
+
+        solution_route = std::move(this_solution);
+        stats.cost = d;
+        search_solved = true;
+        retval = true;
+      }
 
-  RouteLink e_test(start, astar_goal, projection);
-  if (e_test.IsShort())
-    return false;
-  if (!rpolars_route.IsAchievable(e_test))
-    return false;
+      stats.epsilon = search_epsilon;
+    } else if (!search_solved) {
+      // no route at all
+      SetDirectSolution(origin, destination);
+      break;
+    }
+
+    if (search_epsilon <= 1)
+      break;
+
+    search_epsilon = std::max(search_epsilon - ANYTIME_EPSILON_STEP, 1.);
+    StartSearch();
+  }
+
+  stats.pending = result == SearchResult::INTERRUPTED;
+  if (!stats.pending) {
+    planner.Clear();
+    unique_links.clear();
+  }
+
+  stats.duration = std::chrono::steady_clock::now() - start_time;
+  stats.total_duration += stats.duration;
+  return retval;
+}
+
+void
+RoutePlanner::StartSearch()
+{
+  search_hull.clear();
+  search_hull.emplace_back(origin_last, projection);
+  unique_links.clear();
 
   count_dij = 0;
   count_airspace = 0;
   count_terrain = 0;
   count_supressed = 0;
 
-  bool retval = false;
-  planner.Restart(start);
-
-  unsigned best_d = UINT_MAX;
+  planner.Restart(origin_last);
+}
 
+RoutePlanner::SearchResult
+RoutePlanner::RunSearch(const std::chrono::steady_clock::time_point deadline)
+{
   while (!planner.IsEmpty()) {
+    if (stats.iterations > 0 && std::chrono::steady_clock::now() >= deadline)
+      return SearchResult::INTERRUPTED;
+
     const RoutePoint node = planner.Pop();
+    ++stats.iterations;
 
     h_min = std::min(h_min, node.altitude);
     h_max = std::max(h_max, node.altitude);
 
-    bool is_final = (node == astar_goal);
-    if (is_final) {
-      if (!retval)
-        best_d = UINT_MAX;
-      retval = true;
-    }
-
-    if (is_final) // @todo: allow fallback if failed
-    { // copy improving solutions
-      Route this_solution;
-      unsigned d = FindSolution(node, this_solution);
-      if (d < best_d) {
-        best_d = d;
-        solution_route = this_solution;
-      }
-    }
-
-    if (retval)
-      break; // want top solution only
+    if (node == astar_goal)
+      // want top solution only
+      return SearchResult::FOUND;
 
     // shoot for final
     RouteLink e(node, astar_goal, projection);
@@ -169,33 +293,25 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
       AddEdges(links.front());
       links.pop();
     }
-
   }
 
-  count_unique = unique_links.size();
-
-  if (retval) {
-    // correct solution for rounding
-    assert(solution_route.size()>=2);
-    for (auto &i : solution_route) {
-      FlatGeoPoint p(projection.ProjectInteger(i));
-      if (p == origin_last) {
-        i = AGeoPoint(origin, i.altitude);
-      } else if (p == destination_last) {
-        i = AGeoPoint(destination, i.altitude);
-      }
-    }
-
-  } else {
-    solution_route.clear();
-    solution_route.push_back(origin);
-    solution_route.push_back(destination);
-  }
+  return SearchResult::EXHAUSTED;
+}
 
+void
+RoutePlanner::SetDirectSolution(const AGeoPoint &origin,
+                                const AGeoPoint &destination)
+{
   planner.Clear();
   unique_links.clear();
-  // m_search_hull.clear();
-  return retval;
+
+  solution_route.clear();
+  solution_route.push_back(origin);
+  solution_route.push_back(destination);
+
+  search_solved = false;
+  stats.epsilon = 0;
+  stats.cost = UINT_MAX;
 }
 
 unsigned
@@ -246,7 +362,7 @@ RoutePlanner::FindSolution(const RoutePoint &final_point,
     // @todo: assert check_clearance
   } while (!finished);
 
-  return planner.GetNodeValue(final_point).h;
+  return planner.GetNodeValue(final_point).g;
 }
 
 bool
@@ -277,8 +393,12 @@ RoutePlanner::LinkCleared(const RouteLink &e)
   assert(!(e.first==e.second));
 
   count_dij++;
+  /* the heuristic is inflated in anytime mode, which finds a route
+     faster at the expense of optimality */
   AStarPriorityValue v((is_final ? RoutePolars::RoundTime(g+h) : g),
-                       (is_final ? 0 : RoutePolars::RoundTime(h)));
+                       (is_final
+                        ? 0
+                        : RoutePolars::RoundTime(unsigned(h * search_epsilon))));
   // add one to tie-break towards lower number of links
 
   planner.Reserve(planner.DEFAULT_QUEUE_SIZE);
@@ -409,7 +529,10 @@ RoutePlanner::CheckClearanceTerrain(const RouteLink &e, RoutePoint& inp) const
     return true;
 
   count_terrain++;
-  return rpolars_route.CheckClearance(e, terrain, projection, inp);
+  return rpolars_route.CheckClearance(e, terrain, projection, inp,
+                                      rpolars_route.IsClearanceCacheEnabled()
+                                      ? &clearance_cache
+                                      : nullptr);
 }
 
 void
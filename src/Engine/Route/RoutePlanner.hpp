@@ -30,7 +30,9 @@
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/SearchPointVector.hpp"
 #include "ReachFan.hpp"
+#include "TerrainClearanceCache.hpp"
 
+#include <chrono>
 #include <utility>
 #include <unordered_set>
 
@@ -67,6 +69,14 @@ class GlidePolar;
  * Replanning is not performed when the origin/destination or other properties
  * have not changed.
  *
+ * With a time budget (RoutePlannerConfig::time_budget), the search runs in
+ * "anytime" mode: a first route is obtained quickly with an inflated
+ * heuristic, which is then lowered step by step until the optimal route has
+ * been found.  When the budget is exhausted, the best route so far is kept
+ * and the search continues in the next call with the same origin and a
+ * nearby destination.  Until a search has found its first route, the previous route
+ * to the same origin is kept.
+ *
  * Failures of the solver result in the route reverting to direct flight from
  * origin to destination.
  *
@@ -97,6 +107,49 @@ class RoutePlanner {
     }
   };
 
+public:
+  /**
+   * Quality and timing of the current solution.
+   */
+  struct SolveStats {
+    /**
+     * The current route is known to take at most this factor longer
+     * than the optimal route; 1 means it is optimal, 0 means there
+     * is no route (direct flight).
+     */
+    double epsilon;
+
+    /** Estimated time of the current route (s) */
+    unsigned cost;
+
+    /**
+     * True if the search was interrupted by the time budget, and the
+     * next Solve() call will continue refining the route.
+     */
+    bool pending;
+
+    /** Number of nodes expanded in the last Solve() call */
+    unsigned iterations;
+
+    /** Time spent in the last Solve() call */
+    std::chrono::steady_clock::duration duration;
+
+    /** Total time spent on the current origin and destination */
+    std::chrono::steady_clock::duration total_duration;
+
+    void Clear() {
+      epsilon = 0;
+      cost = UINT_MAX;
+      pending = false;
+      iterations = 0;
+      duration = total_duration = std::chrono::steady_clock::duration::zero();
+    }
+
+    bool IsOptimal() const {
+      return epsilon == 1;
+    }
+  };
+
 protected:
   typedef std::pair<AFlatGeoPoint, AFlatGeoPoint> ClearingPair;
 
@@ -138,6 +191,33 @@ private:
   /** Result route found by solve() method */
   Route solution_route;
 
+  /**
+   * Heuristic inflation factor of the search in progress.
+   */
+  double search_epsilon;
+
+  /**
+   * Has a route been found for the current origin and destination?
+   * If not, #solution_route is direct flight or the previous route.
+   */
+  bool search_solved;
+
+  SolveStats stats;
+
+  /**
+   * Copy of #rpolars_route at the start of the current search; a
+   * pending search is abandoned if the polars or the configuration
+   * have changed since.
+   */
+  RoutePolars rpolars_search;
+
+  /**
+   * The destination and the ceiling the current search was started
+   * with; a pending search is continued towards this destination.
+   */
+  AGeoPoint search_destination;
+  int search_h_ceiling;
+
   /** Origin at last call to solve() */
   AFlatGeoPoint origin_last;
   /** Destination at last call to solve() */
@@ -148,6 +228,11 @@ private:
 
   RoutePlannerConfig::Polar reach_polar_mode;
 
+  /**
+   * Terrain intersection results, shared between Solve() calls.
+   */
+  mutable TerrainClearanceCache clearance_cache;
+
   mutable unsigned long count_dij;
   mutable unsigned long count_unique;
   mutable unsigned long count_supressed;
@@ -184,17 +269,30 @@ public:
    */
   void ClearReach();
 
+  const TerrainClearanceCache &GetClearanceCache() const {
+    return clearance_cache;
+  }
+
+  const SolveStats &GetSolveStats() const {
+    return stats;
+  }
+
   /**
    * Find the optimal path.  Works in reverse time order, from the
    * origin (where you want to fly to) back to the destination (where you
    * are now).
    *
+   * If a search with a time budget (RoutePlannerConfig::time_budget)
+   * is pending for the same origin, it is continued towards the
+   * destination it was started with, and the new @a destination and
+   * @a h_ceiling are ignored until it has finished.
+   *
    * @param origin The start of the search (finish location)
    * @param destination The end of the search (current aircraft location)
    * @param config Control parameters for performance model constraints
    * @param h_ceiling Imposed absolute ceiling (m)
    *
-   * @return True if new solution was found
+   * @return True if new or improved solution was found
    */
   bool Solve(const AGeoPoint &origin, const AGeoPoint &destination,
              const RoutePlannerConfig &config,
@@ -455,6 +553,33 @@ private:
    */
   unsigned FindSolution(const RoutePoint &final_point,
                         Route& this_route) const;
+
+private:
+  enum class SearchResult {
+    FOUND,
+    EXHAUSTED,
+    INTERRUPTED,
+  };
+
+  /**
+   * Set up the A* search from #origin_last to #astar_goal, using the
+   * heuristic inflation #search_epsilon.
+   */
+  void StartSearch();
+
+  /**
+   * Continue the A* search until the goal has been reached, all nodes
+   * have been expanded or the deadline has passed.  At least one node
+   * is expanded, so the search makes progress with any budget.
+   */
+  SearchResult RunSearch(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * Abandon the search and revert to direct flight from origin to
+   * destination.
+   */
+  void SetDirectSolution(const AGeoPoint &origin,
+                         const AGeoPoint &destination);
 };
 
 #endif
@@ -69,6 +69,12 @@ class RoutePolar
       else
         inv_gradient = 0;
     };
+
+    bool operator==(const RoutePolarPoint &other) const {
+      return valid == other.valid &&
+        (!valid || (slowness == other.slowness &&
+                    gradient == other.gradient));
+    }
   };
 
   RoutePolarPoint points[ROUTEPOLAR_POINTS];
@@ -97,6 +103,9 @@ public:
     return points[index];
   }
 
+  gcc_pure
+  bool operator==(const RoutePolar &other) const;
+
   /**
    * Calculate distances normalised to 128 corresponding to direction index
    *
@@ -22,6 +22,7 @@
 
 #include "RoutePolars.hpp"
 #include "RouteLink.hpp"
+#include "TerrainClearanceCache.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Terrain/RasterMap.hpp"
@@ -107,7 +108,8 @@ RoutePolars::CalcVHeight(const RouteLink &link) const
 
 bool
 RoutePolars::CheckClearance(const RouteLink &e, const RasterMap* map,
-                            const FlatProjection &proj, RoutePoint& inp) const
+                            const FlatProjection &proj, RoutePoint& inp,
+                            TerrainClearanceCache *cache) const
 {
   if (!config.IsTerrainEnabled())
     return true;
@@ -119,10 +121,16 @@ RoutePolars::CheckClearance(const RouteLink &e, const RasterMap* map,
 
   assert(map);
 
-  if (!map->FirstIntersection(start, e.first.altitude, dest,
-                              e.second.altitude, CalcVHeight(e),
-                              climb_ceiling, GetSafetyHeight(),
-                              int_x, int_h))
+  const bool intersects = cache != nullptr
+    ? cache->FirstIntersection(*map, start, e.first.altitude, dest,
+                               e.second.altitude, CalcVHeight(e),
+                               climb_ceiling, GetSafetyHeight(),
+                               int_x, int_h)
+    : map->FirstIntersection(start, e.first.altitude, dest,
+                             e.second.altitude, CalcVHeight(e),
+                             climb_ceiling, GetSafetyHeight(),
+                             int_x, int_h);
+  if (!intersects)
     return true;
 
   inp = RoutePoint(proj.ProjectInteger(int_x), int_h);
@@ -205,6 +213,18 @@ RoutePolars::SetConfig(const RoutePlannerConfig& _config,
     climb_ceiling = INT_MAX;
 }
 
+bool
+RoutePolars::operator==(const RoutePolars &other) const
+{
+  return inv_mc == other.inv_mc &&
+    height_min_working == other.height_min_working &&
+    cruise_altitude == other.cruise_altitude &&
+    climb_ceiling == other.climb_ceiling &&
+    config == other.config &&
+    polar_glide == other.polar_glide &&
+    polar_cruise == other.polar_cruise;
+}
+
 bool
 RoutePolars::CanClimb() const
 {
@@ -39,6 +39,7 @@ struct AGeoPoint;
 struct FlatGeoPoint;
 struct AFlatGeoPoint;
 struct RouteLink;
+class TerrainClearanceCache;
 
 /**
  * Class to contain separate fast-lookup aircraft performance polars
@@ -105,11 +106,13 @@ public:
    * @param map RasterMap of terrain.
    * @param proj Task projection
    * @param inp (output) clearance after intersection point
+   * @param cache an optional cache for terrain intersection results
    *
    * @return True if intersect occurs
    */
   bool CheckClearance(const RouteLink &e, const RasterMap* map,
-                      const FlatProjection &proj, RoutePoint &inp) const;
+                      const FlatProjection &proj, RoutePoint &inp,
+                      TerrainClearanceCache *cache=nullptr) const;
 
   /**
    * Rotate line from start to end either left or right
@@ -178,6 +181,13 @@ public:
                  int _cruise_alt = INT_MAX,
                  int _ceiling_alt = INT_MAX);
 
+  /**
+   * Do both objects have the same performance tables and
+   * configuration?
+   */
+  gcc_pure
+  bool operator==(const RoutePolars &other) const;
+
   /**
    * Check whether the configuration requires intersection tests with airspace.
    *
@@ -205,6 +215,13 @@ public:
     return config.IsTurningReachEnabled();
   }
 
+  /**
+   * Check whether terrain clearance results may be cached.
+   */
+  bool IsClearanceCacheEnabled() const {
+    return config.clearance_cache;
+  }
+
   /**
    * round up just below nearest 8 second block in a quick way
    * this is an attempt to stabilise solutions
@@ -243,6 +260,15 @@ public:
     return height_min_working;
   }
 
+  /**
+   * Returns the pure glide gradient (m loss / m travelled) in the
+   * specified #RoutePolar direction.
+   */
+  gcc_pure
+  double GetGlideGradient(int index) const {
+    return polar_glide.GetPoint(((unsigned)index) % ROUTEPOLAR_POINTS).gradient;
+  }
+
   gcc_pure
   FlatGeoPoint ReachIntercept(int index, const AFlatGeoPoint &flat_origin,
                               const GeoPoint &origin,
@@ -0,0 +1,74 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "TerrainClearanceCache.hpp"
+#include "Terrain/RasterMap.hpp"
+
+bool
+TerrainClearanceCache::FirstIntersection(const RasterMap &_map,
+                                         const GeoPoint &origin,
+                                         const int h_origin,
+                                         const GeoPoint &destination,
+                                         const int h_destination,
+                                         const int h_virt, const int h_ceiling,
+                                         const int h_safety,
+                                         GeoPoint &intx, int &h)
+{
+  if (&_map != map || _map.GetSerial() != serial) {
+    /* the terrain has been reloaded; all cached results are stale */
+    cache.Clear();
+    map = &_map;
+    serial = _map.GetSerial();
+  }
+
+  const RasterProjection &projection = _map.GetProjection();
+  const Key key{
+    projection.ProjectCoarseRound(origin),
+    projection.ProjectCoarseRound(destination),
+    h_origin, h_destination, h_virt, h_ceiling, h_safety,
+  };
+
+  const Result *cached = cache.Get(key);
+  if (cached != nullptr) {
+    ++n_hits;
+    if (!cached->intersects)
+      return false;
+
+    intx = cached->intersection;
+    h = cached->height;
+    return true;
+  }
+
+  ++n_misses;
+
+  Result result;
+  result.intersects = _map.FirstIntersection(origin, h_origin,
+                                             destination, h_destination,
+                                             h_virt, h_ceiling, h_safety,
+                                             result.intersection,
+                                             result.height);
+  cache.Put(key, result);
+
+  intx = result.intersection;
+  h = result.height;
+  return result.intersects;
+}
@@ -0,0 +1,114 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef TERRAIN_CLEARANCE_CACHE_HPP
+#define TERRAIN_CLEARANCE_CACHE_HPP
+
+#include "Terrain/RasterLocation.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Util/Cache.hxx"
+#include "Util/Serial.hpp"
+#include "Util/Compiler.h"
+
+#include <stddef.h>
+
+class RasterMap;
+
+/**
+ * A LRU cache of RasterMap::FirstIntersection() results.  The route
+ * planner tests the same links over and over again, during one
+ * solution and between solutions.
+ *
+ * The link end points are quantised to the coarse terrain raster,
+ * which is what RasterMap::FirstIntersection() does internally, so
+ * the cached results are exact.  The cache is flushed when the
+ * terrain serial changes, i.e. when terrain tiles are reloaded.
+ */
+class TerrainClearanceCache {
+  struct Key {
+    SignedRasterLocation origin, destination;
+    int h_origin, h_destination, h_virt, h_ceiling, h_safety;
+
+    gcc_pure
+    bool operator==(const Key &other) const {
+      return origin == other.origin && destination == other.destination &&
+        h_origin == other.h_origin && h_destination == other.h_destination &&
+        h_virt == other.h_virt && h_ceiling == other.h_ceiling &&
+        h_safety == other.h_safety;
+    }
+
+    struct Hash {
+      gcc_pure
+      size_t operator()(const Key &key) const {
+        size_t h = key.origin.x;
+        h = h * 31 + key.origin.y;
+        h = h * 31 + key.destination.x;
+        h = h * 31 + key.destination.y;
+        h = h * 31 + key.h_origin;
+        h = h * 31 + key.h_destination;
+        h = h * 31 + key.h_virt;
+        return h;
+      }
+    };
+  };
+
+  struct Result {
+    GeoPoint intersection;
+    int height;
+    bool intersects;
+  };
+
+  Cache<Key, Result, 2048, 2039, Key::Hash> cache;
+
+  /** The map the cached results were obtained from */
+  const RasterMap *map = nullptr;
+
+  /** The serial of #map when the cached results were obtained */
+  Serial serial;
+
+  unsigned n_hits = 0, n_misses = 0;
+
+public:
+  void Clear() {
+    cache.Clear();
+    map = nullptr;
+  }
+
+  /**
+   * A caching wrapper for RasterMap::FirstIntersection().
+   */
+  bool FirstIntersection(const RasterMap &map,
+                         const GeoPoint &origin, int h_origin,
+                         const GeoPoint &destination, int h_destination,
+                         int h_virt, int h_ceiling, int h_safety,
+                         GeoPoint &intx, int &h);
+
+  unsigned GetHits() const {
+    return n_hits;
+  }
+
+  unsigned GetMisses() const {
+    return n_misses;
+  }
+};
+
+#endif
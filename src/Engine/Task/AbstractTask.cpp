@@ -239,6 +239,10 @@ AbstractTask::Update(const AircraftState &state,
                      const AircraftState &state_last,
                      const GlidePolar &glide_polar)
 {
+  /* a new cycle: the polar may have changed, and old results would
+     only crowd out the new ones */
+  glide_cache.Clear();
+
   stats.active_index = GetActiveTaskPointIndex();
   stats.task_valid = CheckTask();
 
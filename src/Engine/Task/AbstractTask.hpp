@@ -27,6 +27,7 @@
 #include "Stats/TaskStats.hpp"
 #include "Computer/TaskStatsComputer.hpp"
 #include "TaskBehaviour.hpp"
+#include "GlideSolvers/GlideResultCache.hpp"
 #include "Math/Filter.hpp"
 
 class TaskPointConstVisitor;
@@ -60,6 +61,14 @@ protected:
    */
   bool force_full_update;
 
+  /**
+   * Leg solutions of the current Update() and UpdateIdle() cycle.
+   * This is modified by const methods, which is safe because the
+   * solvers are only called by Update() and UpdateIdle(), which
+   * require exclusive access.
+   */
+  mutable GlideResultCache glide_cache;
+
 private:
   /** low pass filter on best MC calculations */
   Filter mc_lpf;
@@ -98,6 +107,10 @@ public:
   /** Reset the auto Mc calculator */
   void ResetAutoMC();
 
+  const GlideResultCache &GetGlideResultCache() const {
+    return glide_cache;
+  }
+
   void SetTaskBehaviour(const TaskBehaviour &tb) {
     task_behaviour = tb;
   }
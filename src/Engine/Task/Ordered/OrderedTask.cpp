@@ -178,6 +178,10 @@ OrderedTask::UpdateGeometry()
   UpdateObservationZones(task_points, task_projection);
   UpdateObservationZones(optional_start_points, task_projection);
 
+  // ... and the distances between them for TaskDijkstra
+  for (const auto tp : task_points)
+    tp->UpdateBoundaryDistances();
+
   // now that the task projection is stable, and oz is stable,
   // calculate the bounding box in projected coordinates
   for (const auto tp : task_points)
@@ -221,6 +225,25 @@ OrderedTask::ScanLegStartTime()
 
 // DISTANCES
 
+/**
+ * Pass the boundary distance tables of the task points to the
+ * #TaskDijkstra.  TaskDijkstra::SetLegDistances() ignores the tables
+ * of stages which do not use the boundary points.
+ */
+static void
+SetLegDistances(TaskDijkstra &dijkstra,
+                const OrderedTask::OrderedTaskPointVector &points,
+                unsigned first)
+{
+  for (unsigned i = first; i + 1 < points.size(); ++i) {
+    const unsigned *distances = points[i]->GetBoundaryDistances();
+    if (distances != nullptr)
+      dijkstra.SetLegDistances(i - first, points[i]->GetBoundaryPoints(),
+                               points[i + 1]->GetBoundaryPoints(),
+                               distances);
+  }
+}
+
 inline bool
 OrderedTask::RunDijsktraMin(const GeoPoint &location)
 {
@@ -239,6 +262,8 @@ OrderedTask::RunDijsktraMin(const GeoPoint &location)
     dijkstra.SetBoundary(i - active_index, boundary);
   }
 
+  SetLegDistances(dijkstra, task_points, active_index);
+
   SearchPoint ac(location, task_projection);
   if (!dijkstra.DistanceMin(ac))
     return false;
@@ -319,6 +344,8 @@ OrderedTask::RunDijsktraMax()
       dijkstra.SetBoundary(task_size - 1, finish.GetNominalPoints());
   }
 
+  SetLegDistances(dijkstra, task_points, 0);
+
   if (!dijkstra_max->DistanceMax())
     return false;
 
@@ -634,6 +661,7 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       TaskOptTarget tot(task_points, active_task_point, state,
                         task_behaviour.glide, glide_polar,
                         *ap, task_projection, taskpoint_start);
+      tot.set_cache(&glide_cache);
       tot.search(0.5);
     }
     retval = true;
@@ -924,6 +952,7 @@ OrderedTask::GlideSolutionRemaining(const AircraftState &aircraft,
   TaskMacCreadyRemaining tm(task_points.cbegin(), task_points.cend(),
                             active_task_point,
                             task_behaviour.glide, polar);
+  tm.set_cache(&glide_cache);
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 }
@@ -942,6 +971,7 @@ OrderedTask::GlideSolutionTravelled(const AircraftState &aircraft,
 
   TaskMacCreadyTravelled tm(task_points.cbegin(), active_task_point,
                             task_behaviour.glide, glide_polar);
+  tm.set_cache(&glide_cache);
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 }
@@ -967,6 +997,7 @@ OrderedTask::GlideSolutionPlanned(const AircraftState &aircraft,
   TaskMacCreadyTotal tm(task_points.cbegin(), task_points.cend(),
                         active_task_point,
                         task_behaviour.glide, glide_polar);
+  tm.set_cache(&glide_cache);
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 
@@ -1000,6 +1031,7 @@ OrderedTask::CalcBestMC(const AircraftState &aircraft,
   // note setting of lower limit on mc
   TaskBestMc bmc(task_points, active_task_point, aircraft,
                  task_behaviour.glide, glide_polar);
+  bmc.set_cache(&glide_cache);
   return bmc.search(glide_polar.GetMC(), best);
 }
 
@@ -1028,6 +1060,7 @@ OrderedTask::CalcCruiseEfficiency(const AircraftState &aircraft,
   if (AllowIncrementalBoundaryStats(aircraft)) {
     TaskCruiseEfficiency bce(task_points, active_task_point, aircraft,
                              task_behaviour.glide, glide_polar);
+    bce.set_cache(&glide_cache);
     val = bce.search(1);
     return true;
   } else {
@@ -1044,6 +1077,7 @@ OrderedTask::CalcEffectiveMC(const AircraftState &aircraft,
   if (AllowIncrementalBoundaryStats(aircraft)) {
     TaskEffectiveMacCready bce(task_points, active_task_point, aircraft,
                                task_behaviour.glide, glide_polar);
+    bce.set_cache(&glide_cache);
     val = bce.search(glide_polar.GetMC());
     return true;
   } else {
@@ -1065,6 +1099,7 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(task_points, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, taskpoint_start);
+    bmt.set_cache(&glide_cache);
     auto p = bmt.search(0);
     return p;
   }
@@ -131,26 +131,70 @@ AATPoint::CheckTargetOutside(const AircraftState& state)
 */
 }
 
+const AATIsolineSegment *
+AATPoint::GetCachedIsolineSegment() const
+{
+  if (isoline == nullptr ||
+      isoline_target != target_location ||
+      isoline_previous != GetPrevious()->GetLocationRemaining() ||
+      isoline_next != GetNext()->GetLocationRemaining())
+    return nullptr;
+
+  return isoline.get();
+}
+
+const AATIsolineSegment &
+AATPoint::GetIsolineSegment(const FlatProjection &projection)
+{
+  const AATIsolineSegment *cached = GetCachedIsolineSegment();
+  if (cached != nullptr)
+    return *cached;
+
+  isoline.reset(new AATIsolineSegment(*this, projection));
+  isoline_previous = GetPrevious()->GetLocationRemaining();
+  isoline_target = target_location;
+  isoline_next = GetNext()->GetLocationRemaining();
+  return *isoline;
+}
+
+void
+AATPoint::SetIsolineTarget(double t)
+{
+  assert(GetCachedIsolineSegment() != nullptr);
+
+  /* the isoline is the same for all targets on it, so it remains
+     valid */
+  target_location = isoline_target = isoline->Parametric(t);
+}
+
 bool
 AATPoint::SetRange(const double p, const bool force_if_current)
 {
-  if (target_locked)
+  const GeoPoint target = GetRangeTarget(p, force_if_current);
+  if (!target.IsValid())
     return false;
 
+  target_location = target;
+  return true;
+}
+
+GeoPoint
+AATPoint::GetRangeTarget(const double p, const bool force_if_current) const
+{
+  if (target_locked)
+    return GeoPoint::Invalid();
+
   switch (GetActiveState()) {
   case BEFORE_ACTIVE:
-    return false;
+    return GeoPoint::Invalid();
 
   case CURRENT_ACTIVE:
-    if (!HasEntered() || force_if_current) {
-      target_location = InterpolateLocationMinMax(p);
-      return true;
-    }
-    return false;
+    if (!HasEntered() || force_if_current)
+      return InterpolateLocationMinMax(p);
+    return GeoPoint::Invalid();
 
   case AFTER_ACTIVE:
-    target_location = InterpolateLocationMinMax(p);
-    return true;
+    return InterpolateLocationMinMax(p);
   }
 
   assert(false);
@@ -212,6 +256,15 @@ AATPoint::GetTargetRangeRadial(double oldrange) const
   return RangeAndRadial{ range, radial };
 }
 
+void
+AATPoint::UpdateGeometry()
+{
+  OrderedTaskPoint::UpdateGeometry();
+
+  /* the observation zone or the projection may have changed */
+  isoline.reset();
+}
+
 bool
 AATPoint::Equals(const OrderedTaskPoint &other) const
 {
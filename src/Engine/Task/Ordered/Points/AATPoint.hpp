@@ -25,8 +25,11 @@
 #define AATPOINT_HPP
 
 #include "IntermediatePoint.hpp"
+#include "Task/Ordered/AATIsolineSegment.hpp"
 #include "Math/Angle.hpp"
 
+#include <memory>
+
 struct RangeAndRadial {
   /**
    * Thesigned range [-1,1] from near point on perimeter through
@@ -58,6 +61,14 @@ class AATPoint final : public IntermediateTaskPoint {
   /** Whether target can float */
   bool target_locked;
 
+  /**
+   * The isoline segment through the target, see GetIsolineSegment().
+   * It was built for the locations #isoline_previous,
+   * #isoline_target and #isoline_next.
+   */
+  std::unique_ptr<AATIsolineSegment> isoline;
+  GeoPoint isoline_previous, isoline_target, isoline_next;
+
 public:
   /**
    * Constructor.  Initialises to unlocked target, target is
@@ -129,6 +140,30 @@ public:
     return target_location;
   }
 
+  /**
+   * Returns the isoline segment through the target.  Building it is
+   * expensive, so it is kept until the target is moved off the
+   * isoline, one of the neighbours' remaining locations changes or
+   * the geometry is updated.
+   */
+  const AATIsolineSegment &GetIsolineSegment(const FlatProjection &projection);
+
+  /**
+   * Returns the isoline segment built by GetIsolineSegment() if it is
+   * still valid, nullptr otherwise.  This does not modify the
+   * object.
+   */
+  gcc_pure
+  const AATIsolineSegment *GetCachedIsolineSegment() const;
+
+  /**
+   * Move the target to a point on the isoline segment returned by
+   * GetIsolineSegment(), which remains valid.
+   *
+   * @param t Parameter (0,1) of the isoline segment
+   */
+  void SetIsolineTarget(double t);
+
   /**
    * Test whether aircraft has travelled close to isoline of target
    * within threshold
@@ -155,6 +190,16 @@ public:
    */
   bool SetRange(double p, bool force_if_current);
 
+  /**
+   * Calculate the target location which SetRange() would set,
+   * without modifying this object.
+   *
+   * @return the new target location, or GeoPoint::Invalid() if
+   * SetRange() would not move the target
+   */
+  gcc_pure
+  GeoPoint GetRangeTarget(double p, bool force_if_current) const;
+
   /**
    * If this TaskPoint has the capability to adjust the
    * target/range, this indicates whether it is locked from
@@ -214,6 +259,7 @@ public:
   }
 
   /* virtual methods from class OrderedTaskPoint */
+  void UpdateGeometry() override;
   bool Equals(const OrderedTaskPoint &other) const override;
   bool UpdateSampleNear(const AircraftState &state,
                         const FlatProjection &projection) override;
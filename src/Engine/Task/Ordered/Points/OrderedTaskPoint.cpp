@@ -53,6 +53,12 @@ OrderedTaskPoint::SetNeighbours(OrderedTaskPoint *_previous,
   tp_previous = _previous;
   tp_next = _next;
 
+  /* the distance tables refer to the boundary of the old neighbours;
+     they are rebuilt by OrderedTask::UpdateGeometry() */
+  boundary_distances.clear();
+  if (tp_previous != nullptr)
+    tp_previous->boundary_distances.clear();
+
   UpdateGeometry();
 }
 
@@ -68,6 +74,31 @@ OrderedTaskPoint::UpdateOZ(const FlatProjection &projection)
   UpdateGeometry();
 
   SampledTaskPoint::UpdateOZ(projection, GetBoundary());
+
+  /* the boundary has changed: the distance tables to and from this
+     task point are obsolete */
+  boundary_distances.clear();
+  if (tp_previous != nullptr)
+    tp_previous->boundary_distances.clear();
+}
+
+void
+OrderedTaskPoint::UpdateBoundaryDistances()
+{
+  boundary_distances.clear();
+
+  if (tp_next == nullptr)
+    return;
+
+  const SearchPointVector &from = GetBoundaryPoints();
+  const SearchPointVector &to = tp_next->GetBoundaryPoints();
+
+  boundary_distances.reserve(from.size() * to.size());
+  for (const auto &a : from)
+    for (const auto &b : to)
+      /* same formula as TaskDijkstra::CalcDistance() */
+      boundary_distances.push_back((unsigned)a.GetLocation()
+                                   .Distance(b.GetLocation()));
 }
 
 bool
@@ -201,8 +232,9 @@ OrderedTaskPoint::UpdateBoundingBox(const FlatProjection &projection)
 {
   flat_bb = FlatBoundingBox(projection.ProjectInteger(GetLocation()));
 
-  for (const auto &i : GetBoundary())
-    flat_bb.Expand(projection.ProjectInteger(i));
+  /* the boundary points were projected by UpdateOZ() already */
+  for (const auto &i : GetBoundaryPoints())
+    flat_bb.Expand(i.GetFlatLocation());
 
   flat_bb.ExpandByOne(); // add 1 to fix rounding
 }
@@ -31,6 +31,8 @@
 #include "Geo/Flat/FlatBoundingBox.hpp"
 #include "Util/Compiler.h"
 
+#include <vector>
+
 struct TaskBehaviour;
 struct OrderedTaskSettings;
 class FlatProjection;
@@ -73,6 +75,14 @@ private:
   OrderedTaskPoint* tp_previous;
   FlatBoundingBox flat_bb;
 
+  /**
+   * Distances (m) from each boundary point to each boundary point of
+   * the next task point, in row-major order, for #TaskDijkstra.
+   * Empty if there is no next task point or if one of the two
+   * boundaries has changed since UpdateBoundaryDistances().
+   */
+  std::vector<unsigned> boundary_distances;
+
 public:
   /**
    * Constructor.
@@ -111,7 +121,7 @@ public:
    * Update observation zone geometry (or other internal data) when
    * previous/next turnpoint changes.
    */
-  void UpdateGeometry();
+  virtual void UpdateGeometry();
 
   /** Is it possible to insert a task point before this one? */
   bool IsPredecessorAllowed() const {
@@ -224,6 +234,22 @@ public:
 
   void UpdateOZ(const FlatProjection &projection);
 
+  /**
+   * Calculate the distances from the boundary of this task point to
+   * the boundary of the next one.  Call this after UpdateOZ() has
+   * been called on both.
+   */
+  void UpdateBoundaryDistances();
+
+  /**
+   * Returns the distance table calculated by
+   * UpdateBoundaryDistances(), see TaskDijkstra::SetLegDistances(),
+   * or nullptr if it is not available.
+   */
+  const unsigned *GetBoundaryDistances() const {
+    return boundary_distances.empty() ? nullptr : boundary_distances.data();
+  }
+
   /**
    * Update the bounding box in flat projected coordinates
    */
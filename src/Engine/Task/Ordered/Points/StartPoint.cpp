@@ -22,7 +22,7 @@
 
 #include "StartPoint.hpp"
 #include "Task/Ordered/Settings.hpp"
-#include "Task/ObservationZones/Boundary.hpp"
+#include "Geo/SearchPointVector.hpp"
 #include "Task/TaskBehaviour.hpp"
 #include "Geo/Math.hpp"
 
@@ -76,7 +76,8 @@ StartPoint::find_best_start(const AircraftState &state,
   /* check which boundary point results in the smallest distance to
      fly */
 
-  const OZBoundary boundary = GetBoundary();
+  /* the boundary points were calculated by UpdateOZ() already */
+  const SearchPointVector &boundary = GetBoundaryPoints();
   assert(!boundary.empty());
 
   const auto end = boundary.end();
@@ -85,18 +86,20 @@ StartPoint::find_best_start(const AircraftState &state,
 
   const GeoPoint &next_location = next.GetLocationRemaining();
 
-  GeoPoint best_location = *i;
-  auto best_distance = ::DoubleDistance(state.location, *i, next_location);
+  auto best = i;
+  auto best_distance = ::DoubleDistance(state.location, i->GetLocation(),
+                                        next_location);
 
   for (++i; i != end; ++i) {
-    auto distance = ::DoubleDistance(state.location, *i, next_location);
+    auto distance = ::DoubleDistance(state.location, i->GetLocation(),
+                                     next_location);
     if (distance < best_distance) {
-      best_location = *i;
+      best = i;
       best_distance = distance;
     }
   }
 
-  SetSearchMin(SearchPoint(best_location, projection));
+  SetSearchMin(SearchPoint(best->GetLocation(), projection));
 }
 
 bool
@@ -49,6 +49,16 @@ TaskDijkstra::AddEdges(const ScanTaskPoint curNode) noexcept
   ScanTaskPoint destination(curNode.GetStageNumber() + 1, 0);
   const unsigned dsize = GetStageSize(destination.GetStageNumber());
 
+  const unsigned *distances = leg_distances[curNode.GetStageNumber()];
+  if (distances != nullptr) {
+    distances += curNode.GetPointIndex() * dsize;
+
+    for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
+         destination != end; destination.IncrementPointIndex())
+      Link(destination, curNode, distances[destination.GetPointIndex()]);
+    return;
+  }
+
   for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
        destination != end; destination.IncrementPointIndex())
     Link(destination, curNode, CalcDistance(curNode, destination));
@@ -26,6 +26,8 @@
 #include "PathSolvers/NavDijkstra.hpp"
 #include "Geo/SearchPoint.hpp"
 
+#include <algorithm>
+
 #include <cassert>
 
 class OrderedTask;
@@ -55,6 +57,12 @@ class TaskDijkstra : protected NavDijkstra
 {
   const SearchPointVector *boundaries[MAX_STAGES];
 
+  /**
+   * Optional precomputed distances from each point of a stage to
+   * each point of the following stage, see SetLegDistances().
+   */
+  const unsigned *leg_distances[MAX_STAGES];
+
   const bool is_min;
 
 public:
@@ -67,12 +75,37 @@ public:
 
   void SetTaskSize(unsigned size) noexcept {
     SetStageCount(size);
+    std::fill_n(leg_distances, size, nullptr);
   }
 
   void SetBoundary(unsigned idx, const SearchPointVector &boundary) noexcept {
     assert(idx < num_stages);
 
     boundaries[idx] = &boundary;
+
+    /* the distance tables referring to this stage are obsolete */
+    leg_distances[idx] = nullptr;
+    if (idx > 0)
+      leg_distances[idx - 1] = nullptr;
+  }
+
+  /**
+   * Supply the distances between the points of a stage and the
+   * points of the following stage, so they need not be calculated
+   * again in each search.  Call this after SetBoundary().  The table
+   * is ignored unless the two stages were set to the given vectors.
+   *
+   * @param distances the distance (m, as calculated by
+   * CalcDistance()) from each point of #from to each point of #to,
+   * in row-major order; it must remain valid during the search
+   */
+  void SetLegDistances(unsigned idx, const SearchPointVector &from,
+                       const SearchPointVector &to,
+                       const unsigned *distances) noexcept {
+    assert(idx + 1 < num_stages);
+
+    if (boundaries[idx] == &from && boundaries[idx + 1] == &to)
+      leg_distances[idx] = distances;
   }
 
   /**
@@ -68,6 +68,13 @@ public:
              const AircraftState &_aircraft,
              const GlideSettings &settings, const GlidePolar &_gp);
 
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(GlideResultCache *cache) {
+    tm.set_cache(cache);
+  }
+
   /**
    * Search for best MC.  If fails (MC=0 is below final glide), returns
    * default value.
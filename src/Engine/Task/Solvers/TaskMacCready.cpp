@@ -24,6 +24,8 @@
 #include "TaskSolution.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "GlideSolvers/GlideResultCache.hpp"
+#include "GlideSolvers/MacCready.hpp"
 
 #include <algorithm>
 
@@ -83,3 +85,11 @@ TaskMacCready::glide_sink(const AircraftState &aircraft, const double S) const
 
   return acc_gr;
 }
+
+GlideResult
+TaskMacCready::SolveGlide(const GlideState &state) const
+{
+  return cache != nullptr
+    ? cache->Solve(settings, glide_polar, state)
+    : MacCready::Solve(settings, glide_polar, state);
+}
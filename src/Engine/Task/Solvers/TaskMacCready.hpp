@@ -31,6 +31,8 @@
 
 struct AircraftState;
 struct GlideSettings;
+struct GlideState;
+class GlideResultCache;
 class TaskPoint;
 class OrderedTaskPoint;
 
@@ -80,6 +82,11 @@ protected:
    */
   GlidePolar glide_polar;
 
+  /**
+   * Optional cache for the leg solutions, see set_cache().
+   */
+  GlideResultCache *cache = nullptr;
+
 public:
   /**
    * Constructor for ordered task points
@@ -130,6 +137,14 @@ public:
   gcc_pure
   GlideResult glide_sink(const AircraftState &aircraft, double S) const;
 
+  /**
+   * Look up leg solutions in the given cache (may be nullptr)
+   * instead of always calculating them.
+   */
+  void set_cache(GlideResultCache *_cache) {
+    cache = _cache;
+  }
+
   /**
    * Adjust MacCready value of internal glide polar
    *
@@ -160,6 +175,13 @@ public:
     return leg_solutions[active_index];
   }
 
+protected:
+  /**
+   * Solve a leg with the #glide_polar, looking it up in the #cache
+   * first if there is one.
+   */
+  GlideResult SolveGlide(const GlideState &state) const;
+
 private:
 
   /**
@@ -186,7 +208,6 @@ private:
    *
    * @return Glide result for segment
    */
-  gcc_pure
   virtual GlideResult SolvePoint(const TaskPoint &tp,
                                  const AircraftState &state,
                                  double minH) const = 0;
@@ -22,10 +22,11 @@
 
 #include "TaskMacCreadyRemaining.hpp"
 #include "GlideSolvers/GlideState.hpp"
-#include "GlideSolvers/MacCready.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/AATPoint.hpp"
 
+#include <algorithm>
+
 GlideResult
 TaskMacCreadyRemaining::SolvePoint(const TaskPoint &tp,
                                    const AircraftState &aircraft,
@@ -33,13 +34,37 @@ TaskMacCreadyRemaining::SolvePoint(const TaskPoint &tp,
 {
   GlideState gs = GlideState::Remaining(tp, aircraft, minH);
 
+  if (!override_targets.empty()) {
+    const unsigned i = std::distance(points.begin(),
+                                     std::find(points.begin(), points.end(),
+                                               &tp));
+    assert(i < points.size());
+
+    const GeoPoint &target = override_targets[i];
+    const GeoPoint &previous = i > 0
+      ? override_targets[i - 1]
+      : GeoPoint::Invalid();
+
+    if (target.IsValid() || previous.IsValid()) {
+      const GeoPoint origin = i == 0
+        ? aircraft.location
+        : (previous.IsValid()
+           ? previous
+           : points[i - 1]->GetLocationRemaining());
+      gs.vector = GeoVector(origin,
+                            target.IsValid()
+                            ? target
+                            : tp.GetLocationRemaining());
+    }
+  }
+
   if (!include_travel_to_start && active_index == 0 &&
       tp.GetType() == TaskPointType::START &&
       !((const OrderedTaskPoint &)tp).HasEntered())
     /* ignore the travel to the start point */
     gs.vector.distance = 0;
 
-  return MacCready::Solve(settings, glide_polar, gs);
+  return SolveGlide(gs);
 }
 
 
@@ -89,26 +114,53 @@ TaskMacCreadyRemaining::set_range(const double tp, const bool force_current)
   }
 }
 
-void
-TaskMacCreadyRemaining::target_save()
+GlideResult
+TaskMacCreadyRemaining::glide_solution_target(const AircraftState &aircraft,
+                                              const TaskPoint &tp,
+                                              const GeoPoint &target)
 {
-  auto saved = saved_targets.begin();
-  for (TaskPoint *point : points)
-    *saved++ = point->HasTarget()
-      ? ((AATPoint *)point)->GetTarget()
-      : GeoPoint::Invalid();
+  const auto i = std::find(points.begin(), points.end(), &tp);
+  assert(i != points.end());
+
+  override_targets = StaticArray<GeoPoint, MAX_SIZE>(points.size(),
+                                                     GeoPoint::Invalid());
+  override_targets[std::distance(points.begin(), i)] = target;
+
+  const auto result = glide_solution(aircraft);
+  override_targets.clear();
+  return result;
 }
 
-void
-TaskMacCreadyRemaining::target_restore()
+GlideResult
+TaskMacCreadyRemaining::glide_solution_range(const AircraftState &aircraft,
+                                             const double tp,
+                                             const bool force_current)
 {
-  auto saved = saved_targets.cbegin();
-  for (TaskPoint *point : points) {
-    if (saved->IsValid()) {
-      assert(point->HasTarget());
-      ((AATPoint *)point)->SetTarget(*saved, true);
+  override_targets = StaticArray<GeoPoint, MAX_SIZE>(points.size(),
+                                                     GeoPoint::Invalid());
+
+  /* the same rules as in set_range() */
+  bool modified = force_current;
+  for (unsigned i = 0; i < points.size(); ++i) {
+    if (points[i]->HasTarget()) {
+      override_targets[i] =
+        ((const AATPoint *)points[i])->GetRangeTarget(tp, false);
+      modified |= override_targets[i].IsValid();
     }
+  }
 
-    ++saved;
+  if (!force_current && !modified) {
+    for (unsigned i = 0; i < points.size(); ++i) {
+      if (points[i]->HasTarget()) {
+        override_targets[i] =
+          ((const AATPoint *)points[i])->GetRangeTarget(tp, true);
+        if (override_targets[i].IsValid())
+          break;
+      }
+    }
   }
+
+  const auto result = glide_solution(aircraft);
+  override_targets.clear();
+  return result;
 }
@@ -35,9 +35,12 @@ class TaskMacCreadyRemaining final : public TaskMacCready {
   const bool include_travel_to_start;
 
   /**
-   * Storage used by target_save() and target_restore().
+   * If not empty, one element per element of #points: the legs to
+   * and from each point with a valid location are calculated for
+   * that location instead of the point's target, see
+   * glide_solution_target() and glide_solution_range().
    */
-  std::array<GeoPoint, MAX_SIZE> saved_targets;
+  StaticArray<GeoPoint, MAX_SIZE> override_targets;
 
 public:
   /**
@@ -83,13 +86,26 @@ public:
   bool has_targets() const;
 
   /**
-   * Save targets in case optimisation fails
+   * Calculate the glide solution as if the target of the given
+   * (current active) task point was at the given location, without
+   * modifying the task points.  Only the legs to and from this point
+   * are recalculated, the others are taken from the last
+   * ScanDistanceRemaining() call.
+   *
+   * This allows evaluating target candidates independently.
    */
-  void target_save();
+  GlideResult glide_solution_target(const AircraftState &aircraft,
+                                    const TaskPoint &tp,
+                                    const GeoPoint &target);
+
   /**
-   * Restore target from copy
+   * Calculate the glide solution as if set_range() had been called
+   * with the given parameters, without modifying the task points.
+   * Only the legs to and from the moved targets are recalculated, the
+   * others are taken from the last ScanDistanceRemaining() call.
    */
-  void target_restore();
+  GlideResult glide_solution_range(const AircraftState &aircraft,
+                                   double tp, bool force_current);
 
 private:
   /* virtual methods from class TaskMacCready */
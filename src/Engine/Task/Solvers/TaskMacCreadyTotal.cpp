@@ -21,9 +21,12 @@
  */
 
 #include "TaskMacCreadyTotal.hpp"
-#include "TaskSolution.hpp"
+#include "GlideSolvers/GlideState.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Navigation/Aircraft.hpp"
+
+#include <algorithm>
 
 GlideResult
 TaskMacCreadyTotal::SolvePoint(const TaskPoint &tp,
@@ -33,8 +36,11 @@ TaskMacCreadyTotal::SolvePoint(const TaskPoint &tp,
   assert(tp.GetType() != TaskPointType::UNORDERED);
   const OrderedTaskPoint &otp = (const OrderedTaskPoint &)tp;
 
-  return TaskSolution::GlideSolutionPlanned(otp, aircraft,
-                                            settings, glide_polar, minH);
+  assert(aircraft.location.IsValid());
+  const GlideState gs(otp.GetVectorPlanned(),
+                      std::max(minH, otp.GetElevation()),
+                      aircraft.altitude, aircraft.wind);
+  return SolveGlide(gs);
 }
 
 AircraftState
@@ -21,11 +21,13 @@
  */
 
 #include "TaskMacCreadyTravelled.hpp"
-#include "TaskSolution.hpp"
+#include "GlideSolvers/GlideState.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Navigation/Aircraft.hpp"
 
+#include <algorithm>
+
 GlideResult
 TaskMacCreadyTravelled::SolvePoint(const TaskPoint &tp,
                                    const AircraftState &aircraft,
@@ -34,8 +36,11 @@ TaskMacCreadyTravelled::SolvePoint(const TaskPoint &tp,
   assert(tp.GetType() != TaskPointType::UNORDERED);
   const OrderedTaskPoint &otp = (const OrderedTaskPoint &)tp;
 
-  return TaskSolution::GlideSolutionTravelled(otp, aircraft,
-                                              settings, glide_polar, minH);
+  assert(aircraft.location.IsValid());
+  const GlideState gs(otp.GetVectorTravelled(),
+                      std::max(minH, otp.GetElevation()),
+                      aircraft.altitude, aircraft.wind);
+  return SolveGlide(gs);
 }
 
 AircraftState
@@ -43,13 +43,16 @@ TaskMinTarget::TaskMinTarget(const std::vector<OrderedTaskPoint*>& tps,
 
 }
 
+inline void
+TaskMinTarget::Solve(const double p)
+{
+  res = tm.glide_solution_range(aircraft, p, force_current);
+}
+
 double
 TaskMinTarget::f(const double p)
 {
-  // set task targets
-  set_range(p);
-
-  res = tm.glide_solution(aircraft);
+  Solve(p);
   return res.time_elapsed - t_remaining;
 }
 
@@ -57,8 +60,8 @@ TaskMinTarget::f(const double p)
 bool
 TaskMinTarget::valid(const double tp)
 {
-  //  const double ff = f(tp);
-  return res.IsOk(); // && (ff>= -tolerance*2);
+  Solve(tp);
+  return res.IsOk();
 }
 
 double
@@ -68,15 +71,20 @@ TaskMinTarget::search(const double tp)
     // don't bother if nothing to adjust
     return tp;
 
+  /* the candidates only modify the legs to and from the targets;
+     scan the others once */
+  tp_start->ScanDistanceRemaining(aircraft.location);
+
   force_current = false;
   /// @todo if search fails, force current
-  const auto p = find_zero(tp);
-  if (valid(p)) {
-    return p;
-  } else {
+  auto p = find_zero(tp);
+  if (!valid(p)) {
     force_current = true;
-    return find_zero(tp);
+    p = find_zero(tp);
   }
+
+  set_range(p);
+  return p;
 }
 
 void
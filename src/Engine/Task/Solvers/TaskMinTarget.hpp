@@ -79,6 +79,13 @@ private:
   bool valid(double p);
 
 public:
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(GlideResultCache *cache) {
+    tm.set_cache(cache);
+  }
+
   /**
    * Search for target range to produce remaining time equal to
    * value specified in constructor.
@@ -92,6 +99,15 @@ public:
   double search(double p);
 
 private:
+  /**
+   * Solve the remaining task for the given range parameter into
+   * #res, without moving the targets.
+   */
+  void Solve(double p);
+
+  /**
+   * Move the targets to the given range parameter.
+   */
   void set_range(double p);
 };
 
@@ -26,6 +26,8 @@
 #include "Util/Tolerances.hpp"
 #include "Util/Clamp.hpp"
 
+#include <cassert>
+
 TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
                              const unsigned activeTaskPoint,
                              const AircraftState &_aircraft,
@@ -41,25 +43,22 @@ TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
    aircraft(_aircraft),
    tp_start(_ts),
    tp_current(_tp_current),
-   iso(_tp_current, projection)
+   iso(_tp_current.GetIsolineSegment(projection))
 {
+  assert(tp_current.IsCurrent());
 }
 
 double
 TaskOptTarget::f(const double p)
 {
-  // set task targets
-  SetTarget(p);
-
-  res = tm.glide_solution(aircraft);
-
+  Solve(p);
   return res.time_elapsed;
 }
 
 bool
 TaskOptTarget::valid(const double tp)
 {
-  f(tp);
+  Solve(tp);
   return res.IsOk();
 }
 
@@ -71,13 +70,16 @@ TaskOptTarget::search(const double tp)
     return -1;
   }
   if (iso.IsValid()) {
-    tm.target_save();
+    /* the candidates only modify the legs to and from the target;
+       scan the others once */
+    tp_start->ScanDistanceRemaining(aircraft.location);
+
     const auto t = find_min(tp);
     if (!valid(t)) {
-      // invalid, so restore old value
-      tm.target_restore();
+      // invalid, so keep the old target
       return -1;
     } else {
+      SetTarget(t);
       return t;
     }
   } else {
@@ -88,7 +90,13 @@ TaskOptTarget::search(const double tp)
 void
 TaskOptTarget::SetTarget(const double p)
 {
-  const GeoPoint loc = iso.Parametric(Clamp(p, xmin, xmax));
-  tp_current.SetTarget(loc);
+  tp_current.SetIsolineTarget(Clamp(p, xmin, xmax));
   tp_start->ScanDistanceRemaining(aircraft.location);
 }
+
+inline void
+TaskOptTarget::Solve(const double p)
+{
+  res = tm.glide_solution_target(aircraft, tp_current,
+                                 iso.Parametric(Clamp(p, xmin, xmax)));
+}
@@ -51,8 +51,8 @@ class TaskOptTarget final : public ZeroFinder
   StartPoint *tp_start;
   /** Active AATPoint */
   AATPoint &tp_current;
-  /** Isoline for active AATPoint target */
-  AATIsolineSegment iso;
+  /** Isoline for active AATPoint target, cached by the AATPoint */
+  const AATIsolineSegment &iso;
 
 public:
   /**
@@ -84,6 +84,13 @@ public:
    */
   virtual bool valid(double p);
 
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(GlideResultCache *cache) {
+    tm.set_cache(cache);
+  }
+
   /**
    * Search for active task point's target isoline to minimise elapsed time
    * to finish.
@@ -99,6 +106,12 @@ public:
 private:
   /** Sets target location along isoline */
   void SetTarget(double p);
+
+  /**
+   * Calculate the glide solution for a target candidate without
+   * moving the target.
+   */
+  void Solve(double p);
 };
 
 
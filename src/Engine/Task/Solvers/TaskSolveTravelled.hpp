@@ -65,6 +65,13 @@ protected:
   double time_error();
 
 public:
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(GlideResultCache *cache) {
+    tm.set_cache(cache);
+  }
+
   /**
    * Search for parameter value.
    *
@@ -45,6 +45,7 @@ UnorderedTask::CalcBestMC(const AircraftState &aircraft,
   }
 
   TaskBestMc bmc(tp, aircraft, task_behaviour.glide, glide_polar);
+  bmc.set_cache(&glide_cache);
   return bmc.search(glide_polar.GetMC(), best);
 }
 
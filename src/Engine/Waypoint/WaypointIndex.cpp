@@ -0,0 +1,180 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "WaypointIndex.hpp"
+#include "Waypoint.hpp"
+
+#include <numeric>
+
+#include <math.h>
+
+/** Bits of the X coordinate in a Morton code */
+static constexpr uint64_t MORTON_X_MASK = 0x5555555555555555ull;
+
+static constexpr uint64_t
+SpreadBits(uint64_t x)
+{
+  x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+  x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x << 2)) & 0x3333333333333333ull;
+  x = (x | (x << 1)) & MORTON_X_MASK;
+  return x;
+}
+
+uint64_t
+WaypointIndex::MortonCode(uint32_t x, uint32_t y)
+{
+  return SpreadBits(x) | (SpreadBits(y) << 1);
+}
+
+/**
+ * Returns a mask of the bits below @a bit which belong to the same
+ * dimension.
+ */
+static constexpr uint64_t
+LowerDimensionBits(unsigned bit)
+{
+  return (MORTON_X_MASK << (bit & 1)) & ((uint64_t(1) << bit) - 1);
+}
+
+/**
+ * Set the bit, and clear all lower bits of the same dimension.
+ */
+static constexpr uint64_t
+Load1000(uint64_t code, unsigned bit)
+{
+  return (code & ~LowerDimensionBits(bit)) | (uint64_t(1) << bit);
+}
+
+/**
+ * Clear the bit, and set all lower bits of the same dimension.
+ */
+static constexpr uint64_t
+Load0111(uint64_t code, unsigned bit)
+{
+  return (code | LowerDimensionBits(bit)) & ~(uint64_t(1) << bit);
+}
+
+uint64_t
+WaypointIndex::NextInBox(uint64_t code, uint64_t zmin, uint64_t zmax)
+{
+  uint64_t result = zmax;
+
+  for (unsigned bit = 64; bit-- > 0;) {
+    const uint64_t mask = uint64_t(1) << bit;
+    const bool c = code & mask, lo = zmin & mask, hi = zmax & mask;
+
+    if (!c && !lo && hi) {
+      result = Load1000(zmin, bit);
+      zmax = Load0111(zmax, bit);
+    } else if (!c && lo && hi) {
+      return zmin;
+    } else if (c && !lo && !hi) {
+      return result;
+    } else if (c && !lo && hi) {
+      zmin = Load1000(zmin, bit);
+    }
+
+    /* the remaining combinations either do not change anything
+       (000, 111) or cannot occur because zmin <= zmax (010, 110) */
+  }
+
+  return result;
+}
+
+void
+WaypointIndex::Clear()
+{
+  codes.clear();
+  xs.clear();
+  ys.clear();
+  flags.clear();
+  waypoints.clear();
+}
+
+void
+WaypointIndex::Add(const WaypointPtr &wp)
+{
+  uint8_t f = 0;
+  if (wp->IsLandable())
+    f |= LANDABLE;
+  if (wp->IsAirport())
+    f |= AIRPORT;
+  if (wp->IsTurnpoint())
+    f |= TURNPOINT;
+
+  xs.push_back(wp->flat_location.x);
+  ys.push_back(wp->flat_location.y);
+  flags.push_back(f);
+  waypoints.push_back(wp);
+}
+
+template<typename T>
+static void
+Permute(std::vector<T> &v, const std::vector<unsigned> &order)
+{
+  std::vector<T> result;
+  result.reserve(v.size());
+  for (unsigned i : order)
+    result.push_back(std::move(v[i]));
+  v = std::move(result);
+}
+
+void
+WaypointIndex::Sort()
+{
+  if (IsEmpty())
+    return;
+
+  left = *std::min_element(xs.begin(), xs.end());
+  right = *std::max_element(xs.begin(), xs.end());
+  bottom = *std::min_element(ys.begin(), ys.end());
+  top = *std::max_element(ys.begin(), ys.end());
+
+  const unsigned n = size();
+  std::vector<uint64_t> unsorted_codes;
+  unsorted_codes.reserve(n);
+  for (unsigned i = 0; i < n; ++i)
+    unsorted_codes.push_back(MortonCode(uint32_t(xs[i] - left),
+                                        uint32_t(ys[i] - bottom)));
+
+  std::vector<unsigned> order(n);
+  std::iota(order.begin(), order.end(), 0u);
+  std::sort(order.begin(), order.end(), [&unsorted_codes](unsigned a, unsigned b){
+      return unsorted_codes[a] < unsorted_codes[b];
+    });
+
+  codes.reserve(n);
+  for (unsigned i : order)
+    codes.push_back(unsorted_codes[i]);
+
+  Permute(xs, order);
+  Permute(ys, order);
+  Permute(flags, order);
+  Permute(waypoints, order);
+
+  /* twice the mean distance between waypoints if they were evenly
+     distributed over the bounding box */
+  const double area = (double(right) - left + 1) * (double(top) - bottom + 1);
+  spacing = std::max(unsigned(2 * sqrt(area / n)), 1u);
+}
@@ -0,0 +1,252 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_WAYPOINT_INDEX_HPP
+#define XCSOAR_WAYPOINT_INDEX_HPP
+
+#include "Ptr.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Util/Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * A read-only spatial index for waypoints.  The flat locations and
+ * a few flags are stored in contiguous arrays sorted by their Morton
+ * (Z-order) code, so range and nearest queries scan packed
+ * coordinates and dereference a #Waypoint only when it matches.
+ *
+ * The index is a snapshot; it must be rebuilt after waypoints have
+ * been added, removed or projected again.
+ */
+class WaypointIndex {
+public:
+  enum Flags : uint8_t {
+    LANDABLE = 0x1,
+    AIRPORT = 0x2,
+    TURNPOINT = 0x4,
+  };
+
+private:
+  /** Morton codes of the locations relative to #origin, ascending */
+  std::vector<uint64_t> codes;
+
+  /** Flat locations, in the order of #codes */
+  std::vector<int> xs, ys;
+
+  /** #Flags of each waypoint, in the order of #codes */
+  std::vector<uint8_t> flags;
+
+  /** The waypoints, in the order of #codes */
+  std::vector<WaypointPtr> waypoints;
+
+  /** The bounding box of all locations */
+  int left, bottom, right, top;
+
+  /**
+   * Typical distance between neighbouring waypoints; initial radius
+   * of nearest searches.
+   */
+  unsigned spacing;
+
+public:
+  WaypointIndex() = default;
+  WaypointIndex(const WaypointIndex &) = delete;
+  WaypointIndex(WaypointIndex &&) = default;
+  WaypointIndex &operator=(const WaypointIndex &) = delete;
+  WaypointIndex &operator=(WaypointIndex &&) = default;
+
+  void Clear();
+
+  /**
+   * Rebuild the index from the given range of #WaypointPtr.  All
+   * waypoints must have been projected.
+   */
+  template<typename I>
+  void Build(I begin, I end) {
+    Clear();
+
+    for (I i = begin; i != end; ++i)
+      Add(*i);
+
+    Sort();
+  }
+
+  bool IsEmpty() const {
+    return waypoints.empty();
+  }
+
+  unsigned size() const {
+    return waypoints.size();
+  }
+
+  /**
+   * Call the visitor for each waypoint within the specified distance.
+   */
+  template<typename V>
+  void VisitWithinRange(const FlatGeoPoint &location, unsigned range,
+                        V &&visitor) const {
+    const uint64_t square_range = uint64_t(range) * range;
+    VisitBox(location, range, [&](unsigned i){
+        if (GetSquareDistance(i, location) <= square_range)
+          visitor(waypoints[i]);
+      });
+  }
+
+  /**
+   * Find the nearest waypoint within the specified distance which
+   * has all of the specified #Flags.
+   *
+   * @return the waypoint or nullptr if there is none
+   */
+  gcc_pure
+  const WaypointPtr *FindNearest(const FlatGeoPoint &location, unsigned range,
+                                 uint8_t required_flags=0) const {
+    return FindNearestIndex(location, range, [this, required_flags](unsigned i){
+        return (flags[i] & required_flags) == required_flags;
+      });
+  }
+
+  /**
+   * Find the nearest waypoint within the specified distance which
+   * matches the predicate.
+   *
+   * @return the waypoint or nullptr if there is none
+   */
+  template<typename P>
+  gcc_pure
+  const WaypointPtr *FindNearestIf(const FlatGeoPoint &location,
+                                   unsigned range, P &&predicate) const {
+    return FindNearestIndex(location, range, [this, &predicate](unsigned i){
+        return predicate(*waypoints[i]);
+      });
+  }
+
+private:
+  void Add(const WaypointPtr &wp);
+  void Sort();
+
+  gcc_pure
+  uint64_t GetSquareDistance(unsigned i, const FlatGeoPoint &p) const {
+    const int64_t dx = int64_t(xs[i]) - p.x;
+    const int64_t dy = int64_t(ys[i]) - p.y;
+    return uint64_t(dx * dx) + uint64_t(dy * dy);
+  }
+
+  gcc_const
+  static uint64_t MortonCode(uint32_t x, uint32_t y);
+
+  /**
+   * Returns the smallest Morton code greater than @a code which is
+   * inside the box spanned by @a zmin and @a zmax ("BIGMIN", Tropf
+   * and Herzog 1981).  @a code must be between both and outside the
+   * box.
+   */
+  gcc_const
+  static uint64_t NextInBox(uint64_t code, uint64_t zmin, uint64_t zmax);
+
+  /**
+   * Call the function with the index of each waypoint in the square
+   * with the specified centre and half size, in Morton order.
+   */
+  template<typename F>
+  void VisitBox(const FlatGeoPoint &center, unsigned half_size,
+                F &&f) const {
+    if (IsEmpty())
+      return;
+
+    const int x0 = (int)std::max<int64_t>(int64_t(center.x) - half_size, left);
+    const int y0 = (int)std::max<int64_t>(int64_t(center.y) - half_size, bottom);
+    const int x1 = (int)std::min<int64_t>(int64_t(center.x) + half_size, right);
+    const int y1 = (int)std::min<int64_t>(int64_t(center.y) + half_size, top);
+    if (x0 > x1 || y0 > y1)
+      return;
+
+    const uint64_t zmin = MortonCode(uint32_t(x0 - left), uint32_t(y0 - bottom));
+    const uint64_t zmax = MortonCode(uint32_t(x1 - left), uint32_t(y1 - bottom));
+
+    const auto end = codes.end();
+    auto i = std::lower_bound(codes.begin(), end, zmin);
+
+    /* after this many consecutive codes outside the box, jump to the
+       next code inside the box with a binary search */
+    constexpr unsigned MAX_MISSES = 4;
+    unsigned misses = 0;
+
+    while (i != end && *i <= zmax) {
+      const unsigned index = i - codes.begin();
+      const int x = xs[index], y = ys[index];
+      if (x >= x0 && x <= x1 && y >= y0 && y <= y1) {
+        f(index);
+        misses = 0;
+        ++i;
+      } else if (++misses < MAX_MISSES) {
+        ++i;
+      } else {
+        i = std::lower_bound(i, end, NextInBox(*i, zmin, zmax));
+        misses = 0;
+      }
+    }
+  }
+
+  /**
+   * Search the nearest matching waypoint in growing squares, until
+   * the nearest match is inside the circle inscribed in the square.
+   *
+   * @return a pointer into #waypoints or nullptr
+   */
+  template<typename P>
+  gcc_pure
+  const WaypointPtr *FindNearestIndex(const FlatGeoPoint &location,
+                                      unsigned range, P &&predicate) const {
+    if (IsEmpty())
+      return nullptr;
+
+    uint64_t radius = std::min(spacing, range);
+    while (true) {
+      const uint64_t square_radius =
+        std::min(radius * radius, uint64_t(range) * range);
+
+      const WaypointPtr *nearest = nullptr;
+      uint64_t nearest_square_distance = square_radius;
+      VisitBox(location, (unsigned)radius, [&](unsigned i){
+          const uint64_t square_distance = GetSquareDistance(i, location);
+          if (square_distance <= nearest_square_distance && predicate(i) &&
+              (nearest == nullptr ||
+               square_distance < nearest_square_distance)) {
+            nearest = &waypoints[i];
+            nearest_square_distance = square_distance;
+          }
+        });
+
+      if (nearest != nullptr || radius >= range)
+        return nearest;
+
+      radius = std::min<uint64_t>(radius * 4, range);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,170 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+
+#include "WaypointNameIndex.hpp"
+#include "Waypoint.hpp"
+#include "Util/StringUtil.hpp"
+#include "Util/StringAPI.hxx"
+
+
+void
+WaypointNameIndex::Clear()
+{
+  text.clear();
+  starts.clear();
+  waypoints.clear();
+  suffixes.clear();
+}
+
+void
+WaypointNameIndex::Build(std::vector<WaypointPtr> &&src)
+{
+  Clear();
+
+  struct Item {
+    tstring name;
+    WaypointPtr waypoint;
+  };
+
+  std::vector<Item> items;
+  items.reserve(src.size());
+
+  size_t text_size = 0;
+  for (auto &i : src) {
+    TCHAR normalised[i->name.length() + 1];
+    NormalizeSearchString(normalised, i->name.c_str());
+    items.push_back({normalised, std::move(i)});
+    text_size += items.back().name.length() + 1;
+  }
+
+  std::sort(items.begin(), items.end(), [](const Item &a, const Item &b){
+      const int result = a.name.compare(b.name);
+      return result < 0 ||
+        (result == 0 && a.waypoint->id < b.waypoint->id);
+    });
+
+  text.reserve(text_size);
+  starts.reserve(items.size());
+  waypoints.reserve(items.size());
+  suffixes.reserve(text_size - items.size());
+
+  for (auto &i : items) {
+    const unsigned start = text.size();
+    starts.push_back(start);
+    waypoints.emplace_back(std::move(i.waypoint));
+
+    text.insert(text.end(), i.name.begin(), i.name.end());
+    text.push_back(_T('\0'));
+
+    for (unsigned j = 0; j < i.name.length(); ++j)
+      suffixes.push_back(start + j);
+  }
+
+  const TCHAR *const t = text.data();
+  std::sort(suffixes.begin(), suffixes.end(), [t](unsigned a, unsigned b){
+      return StringCompare(t + a, t + b) < 0;
+    });
+}
+
+WaypointNameIndex::Range
+WaypointNameIndex::Narrow(Range range, const TCHAR *normalised) const
+{
+  const size_t length = _tcslen(normalised);
+  const TCHAR *const t = text.data();
+
+  const auto begin = suffixes.begin() + range.begin;
+  const auto end = suffixes.begin() + range.end;
+
+  const auto lower =
+    std::lower_bound(begin, end, normalised,
+                     [t, length](unsigned offset, const TCHAR *s){
+                       return StringCompare(t + offset, s, length) < 0;
+                     });
+  const auto upper =
+    std::upper_bound(lower, end, normalised,
+                     [t, length](const TCHAR *s, unsigned offset){
+                       return StringCompare(s, t + offset, length) < 0;
+                     });
+
+  return {unsigned(lower - suffixes.begin()),
+          unsigned(upper - suffixes.begin())};
+}
+
+std::vector<unsigned>
+WaypointNameIndex::CollectContaining(Range range) const
+{
+  /* names with a match at their start get the key "index", all others
+     "n + index"; sorting the keys yields the desired order */
+  const unsigned n = waypoints.size();
+
+  std::vector<unsigned> keys;
+  keys.reserve(range.end - range.begin);
+  for (unsigned i = range.begin; i != range.end; ++i) {
+    const unsigned offset = suffixes[i];
+    const unsigned name = FindName(offset);
+    keys.push_back(offset == starts[name] ? name : n + name);
+  }
+
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  /* remove the second occurrence of names which match at their start
+     and elsewhere */
+  const auto middle = std::lower_bound(keys.begin(), keys.end(), n);
+  std::vector<unsigned> result(keys.begin(), middle);
+  for (auto i = middle; i != keys.end(); ++i)
+    if (!std::binary_search(keys.begin(), middle, *i - n))
+      result.push_back(*i - n);
+
+  return result;
+}
+
+TCHAR *
+WaypointNameIndex::Suggest(const TCHAR *normalised,
+                           TCHAR *dest, size_t max_length) const
+{
+  const size_t length = _tcslen(normalised);
+  const TCHAR *const t = text.data();
+
+  const Range range = Find(normalised);
+  if (range.empty() && length > 0)
+    return nullptr;
+
+  /* the suffixes in the range are sorted by the following character;
+     skip from one character to the next with a binary search */
+  TCHAR *p = dest, *const dest_end = dest + max_length - 1;
+  auto i = suffixes.begin() + range.begin;
+  const auto end = suffixes.begin() + range.end;
+  while (i != end && p != dest_end) {
+    const TCHAR ch = t[*i + length];
+    if (ch != _T('\0'))
+      *p++ = ch;
+
+    i = std::upper_bound(i, end, ch, [t, length](TCHAR c, unsigned offset){
+        return c < t[offset + length];
+      });
+  }
+
+  *p = _T('\0');
+  return dest;
+}
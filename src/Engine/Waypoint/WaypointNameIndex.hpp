@@ -0,0 +1,160 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+
+#ifndef XCSOAR_WAYPOINT_NAME_INDEX_HPP
+#define XCSOAR_WAYPOINT_NAME_INDEX_HPP
+
+#include "Ptr.hpp"
+#include "Util/Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <tchar.h>
+
+/**
+ * A read-only substring index for waypoint names.  The normalised
+ * names (see NormalizeSearchString()) are concatenated, and the
+ * positions of all their suffixes are sorted (a "suffix array").
+ * All occurrences of a search string are then adjacent, and can be
+ * found with two binary searches.  The characters which may follow
+ * a search string can be enumerated the same way.
+ *
+ * Like #WaypointIndex, this is a snapshot; it must be rebuilt after
+ * waypoints have been added, removed or renamed.
+ */
+class WaypointNameIndex {
+  /** Normalised names, each terminated by a null character */
+  std::vector<TCHAR> text;
+
+  /** Offset of each name in #text, ascending */
+  std::vector<unsigned> starts;
+
+  /** The waypoints, ordered by their normalised names and ids */
+  std::vector<WaypointPtr> waypoints;
+
+  /** Offsets of all non-empty suffixes in #text, sorted */
+  std::vector<unsigned> suffixes;
+
+public:
+  /**
+   * A range of #suffixes starting with a certain search string.
+   */
+  struct Range {
+    unsigned begin, end;
+
+    bool empty() const {
+      return begin == end;
+    }
+  };
+
+  WaypointNameIndex() = default;
+  WaypointNameIndex(const WaypointNameIndex &) = delete;
+  WaypointNameIndex(WaypointNameIndex &&) = default;
+  WaypointNameIndex &operator=(const WaypointNameIndex &) = delete;
+  WaypointNameIndex &operator=(WaypointNameIndex &&) = default;
+
+  void Clear();
+
+  /**
+   * Rebuild the index from the given range of #WaypointPtr.
+   */
+  template<typename I>
+  void Build(I begin, I end) {
+    std::vector<WaypointPtr> v(begin, end);
+    Build(std::move(v));
+  }
+
+  bool IsEmpty() const {
+    return waypoints.empty();
+  }
+
+  /**
+   * Find all occurrences of the given normalised string.
+   */
+  gcc_pure
+  Range Find(const TCHAR *normalised) const {
+    return Narrow({0, unsigned(suffixes.size())}, normalised);
+  }
+
+  /**
+   * Like Find(), but search only the given range.  This is used to
+   * refine a search incrementally: the range must be the result of a
+   * search for a prefix of @a normalised.
+   */
+  gcc_pure
+  Range Narrow(Range range, const TCHAR *normalised) const;
+
+  /**
+   * Call the visitor for each waypoint whose normalised name contains
+   * the given normalised string.  Names starting with the string are
+   * visited first, and within both groups, waypoints are visited in
+   * the order of their normalised names (and ids).
+   */
+  template<typename V>
+  void VisitContaining(const TCHAR *normalised, V &&visitor) const {
+    if (*normalised == _T('\0')) {
+      for (const auto &i : waypoints)
+        visitor(i);
+      return;
+    }
+
+    for (unsigned i : CollectContaining(Find(normalised)))
+      visitor(waypoints[i]);
+  }
+
+  /**
+   * Returns the set of characters which follow the given normalised
+   * string in at least one name.
+   *
+   * @param max_length the size of the buffer, including the trailing
+   * null character
+   * @return the destination buffer, or nullptr if the string does not
+   * occur in any name
+   */
+  TCHAR *Suggest(const TCHAR *normalised,
+                 TCHAR *dest, size_t max_length) const;
+
+private:
+  void Build(std::vector<WaypointPtr> &&src);
+
+  /**
+   * Determine the names (indices into #waypoints) which contain the
+   * suffixes in the given range, in the order described in
+   * VisitContaining().
+   */
+  gcc_pure
+  std::vector<unsigned> CollectContaining(Range range) const;
+
+  /**
+   * Returns the index of the name which contains the given offset
+   * of #text.
+   */
+  gcc_pure
+  unsigned FindName(unsigned offset) const {
+    return std::upper_bound(starts.begin(), starts.end(), offset)
+      - starts.begin() - 1;
+  }
+};
+
+#endif
@@ -23,6 +23,10 @@
 #include "Waypoints.hpp"
 #include "WaypointVisitor.hpp"
 #include "Util/StringUtil.hpp"
+#include "Util/StringAPI.hxx"
+
+#include <algorithm>
+#include <vector>
 
 // global, used for test harness
 unsigned n_queries = 0;
@@ -124,9 +128,22 @@ Waypoints::Waypoints()
 
 void
 Waypoints::Optimise()
+{
+  OptimiseTree();
+
+  if (waypoint_tree.IsEmpty() || IsIndexValid())
+    /* already optimised */
+    return;
+
+  PendingIndex pending;
+  BuildIndex(pending);
+  InstallIndex(pending);
+}
+
+void
+Waypoints::OptimiseTree()
 {
   if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
     return;
 
   task_projection.Update();
@@ -138,6 +155,32 @@ Waypoints::Optimise()
   }
 
   waypoint_tree.Optimise();
+
+  /* the flat coordinates in the old index are obsolete now */
+  index.Clear();
+  name_index.Clear();
+}
+
+void
+Waypoints::BuildIndex(PendingIndex &pending) const
+{
+  assert(waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds());
+
+  pending.index.Build(waypoint_tree.begin(), waypoint_tree.end());
+  pending.name_index.Build(waypoint_tree.begin(), waypoint_tree.end());
+  pending.serial = serial;
+}
+
+void
+Waypoints::InstallIndex(PendingIndex &pending)
+{
+  if (pending.serial != serial)
+    /* modified in the meantime; keep using the fallback */
+    return;
+
+  std::swap(index, pending.index);
+  std::swap(name_index, pending.name_index);
+  index_serial = serial;
 }
 
 void
@@ -171,8 +214,14 @@ Waypoints::GetNearest(const GeoPoint &loc, double range) const
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  if (IsIndexValid()) {
+    const WaypointPtr *found = index.FindNearest(flat_location, mrange);
+    return found != nullptr ? *found : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const auto found = waypoint_tree.FindNearest(point, mrange);
 
   if (found.first == waypoint_tree.end())
@@ -190,6 +239,14 @@ IsLandable(const Waypoint &wp)
 WaypointPtr
 Waypoints::GetNearestLandable(const GeoPoint &loc, double range) const
 {
+  if (IsIndexValid()) {
+    const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+    const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+    const WaypointPtr *found = index.FindNearest(flat_location, mrange,
+                                                 WaypointIndex::LANDABLE);
+    return found != nullptr ? *found : nullptr;
+  }
+
   return GetNearestIf(loc, range, IsLandable);
 }
 
@@ -201,8 +258,15 @@ Waypoints::GetNearestIf(const GeoPoint &loc, double range,
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  if (IsIndexValid()) {
+    const WaypointPtr *found = index.FindNearestIf(flat_location, mrange,
+                                                   predicate);
+    return found != nullptr ? *found : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const auto found = waypoint_tree.FindNearestIf(point, mrange,
                                                  [predicate](const WaypointPtr &ptr){
                                                    return predicate(*ptr);
@@ -278,11 +342,16 @@ Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
     return; // nothing to do
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
 
   WaypointEnvelopeVisitor wve(&visitor);
 
+  if (IsIndexValid()) {
+    index.VisitWithinRange(flat_location, mrange, wve);
+    return;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   waypoint_tree.VisitWithinRange(point, mrange, wve);
 }
 
@@ -293,6 +362,93 @@ Waypoints::VisitNamePrefix(const TCHAR *prefix,
   name_tree.VisitNormalisedPrefix(prefix, visitor);
 }
 
+void
+Waypoints::VisitNameContaining(const TCHAR *s,
+                               WaypointVisitor &visitor) const
+{
+  TCHAR normalized[_tcslen(s) + 1];
+  NormalizeSearchString(normalized, s);
+
+  VisitorAdapter adapter(visitor);
+
+  if (IsIndexValid()) {
+    name_index.VisitContaining(normalized, adapter);
+    return;
+  }
+
+  /* no index yet: scan all names, and sort the matches the way the
+     index would visit them (prefix matches first, then by normalised
+     name and id) */
+  struct Match {
+    bool prefix;
+    tstring name;
+    WaypointPtr waypoint;
+  };
+
+  std::vector<Match> matches;
+  for (const auto &i : waypoint_tree) {
+    TCHAR name[i->name.length() + 1];
+    NormalizeSearchString(name, i->name.c_str());
+
+    const TCHAR *p = StringFind(name, normalized);
+    if (p != nullptr)
+      matches.push_back({p == name, name, i});
+  }
+
+  std::sort(matches.begin(), matches.end(),
+            [](const Match &a, const Match &b){
+              if (a.prefix != b.prefix)
+                return a.prefix;
+
+              const int result = a.name.compare(b.name);
+              return result < 0 ||
+                (result == 0 && a.waypoint->id < b.waypoint->id);
+            });
+
+  for (const auto &i : matches)
+    adapter(i.waypoint);
+}
+
+TCHAR *
+Waypoints::SuggestNameContaining(const TCHAR *s,
+                                 TCHAR *dest, size_t max_length) const
+{
+  TCHAR normalized[_tcslen(s) + 1];
+  NormalizeSearchString(normalized, s);
+
+  if (IsIndexValid())
+    return name_index.Suggest(normalized, dest, max_length);
+
+  /* no index yet: scan all names */
+  const size_t length = _tcslen(normalized);
+  TCHAR *end = dest;
+  bool found = false;
+  for (const auto &i : waypoint_tree) {
+    TCHAR name[i->name.length() + 1];
+    NormalizeSearchString(name, i->name.c_str());
+
+    for (const TCHAR *p = name; (p = StringFind(p, normalized)) != nullptr;
+         ++p) {
+      found = true;
+
+      const TCHAR ch = p[length];
+      if (ch != _T('\0') && size_t(end - dest) < max_length - 1 &&
+          std::find(dest, end, ch) == end)
+        *end++ = ch;
+
+      if (ch == _T('\0'))
+        break;
+    }
+  }
+
+  if (!found)
+    return nullptr;
+
+  std::sort(dest, end);
+  *end = _T('\0');
+  return dest;
+}
+
 void
 Waypoints::Clear()
 {
@@ -300,6 +456,8 @@ Waypoints::Clear()
   home = nullptr;
   name_tree.Clear();
   waypoint_tree.clear();
+  index.Clear();
+  name_index.Clear();
   next_id = 1;
 }
 
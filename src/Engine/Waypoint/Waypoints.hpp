@@ -27,6 +27,8 @@
 #include "Util/Serial.hpp"
 #include "Ptr.hpp"
 #include "Waypoint.hpp"
+#include "WaypointIndex.hpp"
+#include "WaypointNameIndex.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 
 class WaypointVisitor;
@@ -76,6 +78,19 @@ class Waypoints {
 
   WaypointTree waypoint_tree;
   WaypointNameTree name_tree;
+
+  /**
+   * Flat copy of #waypoint_tree for fast spatial queries, built by
+   * Optimise().  It is only used while #index_serial equals #serial.
+   */
+  WaypointIndex index;
+  Serial index_serial;
+
+  /**
+   * Substring index of the names, built by Optimise() together with
+   * #index and valid under the same condition.
+   */
+  WaypointNameIndex name_index;
   TaskProjection task_projection;
 
   WaypointPtr home;
@@ -157,7 +172,7 @@ public:
   /**
    * Optimise the internal search tree after adding/removing elements.
    * Also performs projection to flat earth for new elements.
-   * This updates the task_projection.
+   * This updates the task_projection and rebuilds the spatial index.
    *
    * Note: currently this code doesn't check for task projections
    * being modified from multiple calls to Optimise() so it should
@@ -165,6 +180,41 @@ public:
    */
   void Optimise();
 
+  /**
+   * Like Optimise(), but leaves the flat indexes alone.  This is
+   * cheap after appending a few waypoints within the current bounds.
+   * Until InstallIndex() is called, queries fall back to the
+   * #QuadTree and to a linear name search.
+   */
+  void OptimiseTree();
+
+  /**
+   * Flat indexes built by BuildIndex(), to be installed by
+   * InstallIndex().
+   */
+  class PendingIndex {
+    friend class Waypoints;
+
+    WaypointIndex index;
+    WaypointNameIndex name_index;
+    Serial serial;
+  };
+
+  /**
+   * Build the flat indexes from the current store without installing
+   * them.  This only reads the store, so it may run while other
+   * threads are querying it, but not while it is being modified.
+   * OptimiseTree() must be called before.
+   */
+  void BuildIndex(PendingIndex &pending) const;
+
+  /**
+   * Install the indexes built by BuildIndex(), unless the store has
+   * been modified since.  The old indexes are moved to #pending, so
+   * the caller may free them outside of a critical section.
+   */
+  void InstallIndex(PendingIndex &pending);
+
   /**
    * Prepare and enable the next Optimise() call.
    */
@@ -313,6 +363,26 @@ public:
     return name_tree.SuggestNormalisedPrefix(prefix, dest, max_length);
   }
 
+  /**
+   * Call visitor function on waypoints whose name contains the
+   * specified string.  Like VisitNamePrefix(), the comparison ignores
+   * case and non-alphanumeric characters.  Names starting with the
+   * string are visited first, and within both groups, waypoints are
+   * visited in the order of their normalised names (and ids).
+   */
+  void VisitNameContaining(const TCHAR *s, WaypointVisitor &visitor) const;
+
+  /**
+   * Returns a set of possible characters following the specified
+   * string anywhere in a name.
+   *
+   * @return the destination buffer, or nullptr if no name contains
+   * the string
+   */
+  gcc_pure
+  TCHAR *SuggestNameContaining(const TCHAR *s,
+                               TCHAR *dest, size_t max_length) const;
+
   /**
    * Looks up nearest waypoint to the search location.
    * Performs search according to flat-earth internal representation,
@@ -353,6 +423,13 @@ public:
   WaypointPtr GetNearestIf(const GeoPoint &loc, double range,
                            bool (*predicate)(const Waypoint &)) const;
 
+private:
+  gcc_pure
+  bool IsIndexValid() const {
+    return index_serial == serial && !index.IsEmpty();
+  }
+
+public:
   /**
    * Access first waypoint in store, for use in iterators.
    *
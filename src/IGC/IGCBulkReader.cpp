@@ -0,0 +1,184 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCBulkReader.hpp"
+#include "IGCParser.hpp"
+#include "IGCExtensions.hpp"
+#include "OS/FileMapping.hpp"
+#include "OS/Path.hpp"
+
+#include <string.h>
+
+void
+IGCFixColumns::clear()
+{
+  dates.clear();
+  second_of_day.clear();
+  location.clear();
+  gps_valid.clear();
+  gps_altitude.clear();
+  pressure_altitude.clear();
+
+  for (auto *v : {&enl, &rpm, &hdm, &hdt, &trm, &trt, &gsp, &ias, &tas, &siu})
+    v->clear();
+}
+
+void
+IGCFixColumns::reserve(size_t n)
+{
+  second_of_day.reserve(n);
+  location.reserve(n);
+  gps_valid.reserve(n);
+  gps_altitude.reserve(n);
+  pressure_altitude.reserve(n);
+
+  for (auto *v : {&enl, &rpm, &hdm, &hdt, &trm, &trt, &gsp, &ias, &tas, &siu})
+    v->reserve(n);
+}
+
+void
+IGCFixColumns::push_back(const IGCFix &fix)
+{
+  second_of_day.push_back(fix.time.GetSecondOfDay());
+  location.push_back(fix.location);
+  gps_valid.push_back(fix.gps_valid);
+  gps_altitude.push_back(fix.gps_altitude);
+  pressure_altitude.push_back(fix.pressure_altitude);
+
+  enl.push_back(fix.enl);
+  rpm.push_back(fix.rpm);
+  hdm.push_back(fix.hdm);
+  hdt.push_back(fix.hdt);
+  trm.push_back(fix.trm);
+  trt.push_back(fix.trt);
+  gsp.push_back(fix.gsp);
+  ias.push_back(fix.ias);
+  tas.push_back(fix.tas);
+  siu.push_back(fix.siu);
+}
+
+IGCFix
+IGCFixColumns::operator[](size_t i) const
+{
+  IGCFix fix;
+  fix.time = BrokenTime::FromSecondOfDay(second_of_day[i]);
+  fix.location = location[i];
+  fix.gps_valid = gps_valid[i];
+  fix.gps_altitude = gps_altitude[i];
+  fix.pressure_altitude = pressure_altitude[i];
+
+  fix.enl = enl[i];
+  fix.rpm = rpm[i];
+  fix.hdm = hdm[i];
+  fix.hdt = hdt[i];
+  fix.trm = trm[i];
+  fix.trt = trt[i];
+  fix.gsp = gsp[i];
+  fix.ias = ias[i];
+  fix.tas = tas[i];
+  fix.siu = siu[i];
+  return fix;
+}
+
+/**
+ * Copy a line to a null-terminated buffer for the parsers which need
+ * one.
+ *
+ * @return false if the line is too long
+ */
+static bool
+CopyLine(char *dest, size_t dest_size, const char *src, size_t length)
+{
+  if (length >= dest_size)
+    return false;
+
+  memcpy(dest, src, length);
+  dest[length] = 0;
+  return true;
+}
+
+void
+IGCParseFixes(const char *data, size_t size, IGCFixColumns &columns)
+{
+  /* a typical "B" record with extensions and line terminator has
+     about 40 bytes; this over-estimates a bit, which is cheaper than
+     growing the columns */
+  columns.reserve(columns.size() + size / 36);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  const char *const end = data + size;
+  char copy[256];
+
+  while (data < end) {
+    const char *eol = (const char *)memchr(data, '\n', end - data);
+    const char *next;
+    if (eol == nullptr)
+      eol = next = end;
+    else
+      next = eol + 1;
+
+    size_t length = eol - data;
+    if (length > 0 && data[length - 1] == '\r')
+      --length;
+
+    if (length > 0) {
+      switch (data[0]) {
+      case 'B': {
+        IGCFix fix;
+        if (IGCParseFix(data, length, extensions, fix))
+          columns.push_back(fix);
+        break;
+      }
+
+      case 'H':
+        if (length > 5 && memcmp(data, "HFDTE", 5) == 0 &&
+            CopyLine(copy, sizeof(copy), data, length)) {
+          BrokenDate date;
+          if (IGCParseDateRecord(copy, date))
+            columns.dates.push_back({columns.size(), date});
+        }
+        break;
+
+      case 'I':
+        if (CopyLine(copy, sizeof(copy), data, length))
+          IGCParseExtensions(copy, extensions);
+        break;
+      }
+    }
+
+    data = next;
+  }
+}
+
+bool
+IGCReadFixes(Path path, IGCFixColumns &columns)
+{
+  FileMapping mapping(path);
+  if (mapping.error())
+    return false;
+
+  IGCParseFixes((const char *)mapping.data(), mapping.size(), columns);
+  return true;
+}
@@ -0,0 +1,103 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_BULK_READER_HPP
+#define XCSOAR_IGC_BULK_READER_HPP
+
+#include "IGCFix.hpp"
+#include "Time/BrokenDate.hpp"
+#include "Util/Compiler.h"
+
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Path;
+
+/**
+ * All "B" records of an IGC file, stored column by column.  This is
+ * more compact than an array of #IGCFix, and a loop which looks at
+ * only a few attributes (e.g. only altitudes) touches less memory.
+ */
+struct IGCFixColumns {
+  /**
+   * A "HFDTE" record.
+   */
+  struct Date {
+    /**
+     * The index of the first fix after this record.
+     */
+    size_t fix_index;
+
+    BrokenDate date;
+  };
+
+  std::vector<Date> dates;
+
+  std::vector<uint32_t> second_of_day;
+  std::vector<GeoPoint> location;
+  std::vector<uint8_t> gps_valid;
+  std::vector<int32_t> gps_altitude, pressure_altitude;
+
+  /* extensions; see #IGCFix */
+  std::vector<int16_t> enl, rpm, hdm, hdt, trm, trt, gsp, ias, tas, siu;
+
+  size_t size() const {
+    return second_of_day.size();
+  }
+
+  bool empty() const {
+    return second_of_day.empty();
+  }
+
+  void clear();
+  void reserve(size_t n);
+
+  void push_back(const IGCFix &fix);
+
+  /**
+   * Assemble the fix with the given index.
+   */
+  gcc_pure
+  IGCFix operator[](size_t i) const;
+};
+
+/**
+ * Parse all "B", "I" and "HFDTE" records from an IGC file which has
+ * been loaded into memory, and append the fixes to the given object.
+ * Invalid lines are skipped.
+ */
+void
+IGCParseFixes(const char *data, size_t size, IGCFixColumns &columns);
+
+/**
+ * Map the IGC file into memory and parse all fixes with
+ * IGCParseFixes().
+ *
+ * @return false if the file could not be mapped
+ */
+bool
+IGCReadFixes(Path path, IGCFixColumns &columns);
+
+#endif
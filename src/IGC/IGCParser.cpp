@@ -223,12 +223,109 @@ ParseExtensionValueN(const char *p, const char *end, size_t n,
     value_r = value;
 }
 
-bool
-IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
+/**
+ * The length of a "B" record without extensions.
+ */
+static constexpr size_t B_RECORD_LENGTH = 35;
+
+/**
+ * Marks the columns of a "B" record which must be decimal digits
+ * (BHHMMSSDDMMmmmNDDDMMmmmEVPPPPPGGGGG).
+ */
+static constexpr uint8_t b_record_digit_columns[B_RECORD_LENGTH] = {
+  0,
+  1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 0,
+  1, 1, 1, 1, 1, 1, 1, 1, 0,
+  0,
+  1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1,
+};
+
+/**
+ * Decode a fixed number of decimal digits which have already been
+ * verified.
+ */
+template<unsigned N>
+static inline unsigned
+DecodeDigits(const char *p)
 {
-  if (*buffer != 'B')
+  unsigned value = 0;
+  for (unsigned i = 0; i < N; ++i)
+    value = value * 10 + (p[i] - '0');
+  return value;
+}
+
+/**
+ * Parse the fixed part of a "B" record with all columns at their
+ * standard offsets.  All digit columns are verified at once with a
+ * branch-free loop over a constant mask (which the compiler can
+ * vectorise), and then decoded without further checks.
+ *
+ * @return false if the record is not in the canonical form (e.g. a
+ * negative altitude); the caller should then fall back to
+ * ParseFixGeneric()
+ */
+static bool
+ParseFixFast(const char *buffer, size_t length, IGCFix &fix)
+{
+  if (length < B_RECORD_LENGTH)
+    return false;
+
+  const uint8_t *p = (const uint8_t *)buffer;
+  unsigned bad = 0;
+  for (unsigned i = 0; i < B_RECORD_LENGTH; ++i)
+    bad |= b_record_digit_columns[i] & (uint8_t(p[i] - '0') > 9);
+
+  if (bad != 0)
+    return false;
+
+  const BrokenTime time(DecodeDigits<2>(buffer + 1),
+                        DecodeDigits<2>(buffer + 3),
+                        DecodeDigits<2>(buffer + 5));
+  if (!time.IsPlausible())
     return false;
 
+  const unsigned lat_degrees = DecodeDigits<2>(buffer + 7);
+  const unsigned lat_minutes = DecodeDigits<5>(buffer + 9);
+  const char lat_char = buffer[14];
+  const unsigned lon_degrees = DecodeDigits<3>(buffer + 15);
+  const unsigned lon_minutes = DecodeDigits<5>(buffer + 18);
+  const char lon_char = buffer[23];
+  const char valid_char = buffer[24];
+
+  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
+      (lat_char != 'N' && lat_char != 'S') ||
+      lon_degrees >= 180 || lon_minutes >= 60000 ||
+      (lon_char != 'E' && lon_char != 'W') ||
+      (valid_char != 'A' && valid_char != 'V'))
+    return false;
+
+  fix.time = time;
+
+  fix.location.latitude = Angle::Degrees(lat_degrees +
+                                         lat_minutes / 60000.);
+  if (lat_char == 'S')
+    fix.location.latitude.Flip();
+
+  fix.location.longitude = Angle::Degrees(lon_degrees +
+                                          lon_minutes / 60000.);
+  if (lon_char == 'W')
+    fix.location.longitude.Flip();
+
+  fix.gps_valid = valid_char == 'A';
+  fix.pressure_altitude = DecodeDigits<5>(buffer + 25);
+  fix.gps_altitude = DecodeDigits<5>(buffer + 30);
+  return true;
+}
+
+/**
+ * Parse the fixed part of a "B" record with sscanf().  This accepts
+ * more variations than ParseFixFast().
+ */
+static bool
+ParseFixGeneric(const char *buffer, IGCFix &fix)
+{
   BrokenTime time;
   if (!IGCParseTime(buffer + 1, time))
     return false;
@@ -254,10 +351,27 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
     return false;
 
   fix.time = time;
+  return true;
+}
 
+/**
+ * Pack a three-letter extension code into an integer, so the
+ * extension columns of each fix can be dispatched with a switch
+ * instead of a chain of string comparisons.
+ */
+static constexpr uint32_t
+PackExtensionCode(const char *code)
+{
+  return uint8_t(code[0]) | (uint8_t(code[1]) << 8) |
+    (uint32_t(uint8_t(code[2])) << 16);
+}
+
+static void
+ParseFixExtensions(const char *buffer, size_t line_length,
+                   const IGCExtensions &extensions, IGCFix &fix)
+{
   fix.ClearExtensions();
 
-  const size_t line_length = strlen(buffer);
   for (auto i = extensions.begin(), end = extensions.end(); i != end; ++i) {
     const IGCExtension &extension = *i;
     assert(extension.start > 0);
@@ -270,28 +384,86 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
     const char *start = buffer + extension.start - 1;
     const char *finish = buffer + extension.finish;
 
-    if (StringIsEqual(extension.code, "ENL"))
+    switch (PackExtensionCode(extension.code)) {
+    case PackExtensionCode("ENL"):
       ParseExtensionValue(start, finish, fix.enl);
-    else if (StringIsEqual(extension.code, "RPM"))
+      break;
+
+    case PackExtensionCode("RPM"):
       ParseExtensionValue(start, finish, fix.rpm);
-    else if (StringIsEqual(extension.code, "HDM"))
+      break;
+
+    case PackExtensionCode("HDM"):
       ParseExtensionValue(start, finish, fix.hdm);
-    else if (StringIsEqual(extension.code, "HDT"))
+      break;
+
+    case PackExtensionCode("HDT"):
       ParseExtensionValue(start, finish, fix.hdt);
-    else if (StringIsEqual(extension.code, "TRM"))
+      break;
+
+    case PackExtensionCode("TRM"):
       ParseExtensionValue(start, finish, fix.trm);
-    else if (StringIsEqual(extension.code, "TRT"))
+      break;
+
+    case PackExtensionCode("TRT"):
       ParseExtensionValue(start, finish, fix.trt);
-    else if (StringIsEqual(extension.code, "GSP"))
+      break;
+
+    case PackExtensionCode("GSP"):
       ParseExtensionValueN(start, finish, 3, fix.gsp);
-    else if (StringIsEqual(extension.code, "IAS"))
+      break;
+
+    case PackExtensionCode("IAS"):
       ParseExtensionValueN(start, finish, 3, fix.ias);
-    else if (StringIsEqual(extension.code, "TAS"))
+      break;
+
+    case PackExtensionCode("TAS"):
       ParseExtensionValueN(start, finish, 3, fix.tas);
-    else if (StringIsEqual(extension.code, "SIU"))
+      break;
+
+    case PackExtensionCode("SIU"):
       ParseExtensionValue(start, finish, fix.siu);
+      break;
+    }
+  }
+}
+
+bool
+IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
+{
+  if (*buffer != 'B')
+    return false;
+
+  const size_t line_length = strlen(buffer);
+  if (!ParseFixFast(buffer, line_length, fix) &&
+      !ParseFixGeneric(buffer, fix))
+    return false;
+
+  ParseFixExtensions(buffer, line_length, extensions, fix);
+  return true;
+}
+
+bool
+IGCParseFix(const char *buffer, size_t length,
+            const IGCExtensions &extensions, IGCFix &fix)
+{
+  if (length == 0 || *buffer != 'B')
+    return false;
+
+  if (!ParseFixFast(buffer, length, fix)) {
+    /* the generic parser needs a null-terminated string */
+    char copy[256];
+    if (length >= sizeof(copy))
+      return false;
+
+    memcpy(copy, buffer, length);
+    copy[length] = 0;
+
+    if (!ParseFixGeneric(copy, fix))
+      return false;
   }
 
+  ParseFixExtensions(buffer, length, extensions, fix);
   return true;
 }
 
@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_IGC_PARSER_HPP
 #define XCSOAR_IGC_PARSER_HPP
 
+#include <stddef.h>
+
 struct IGCFix;
 struct IGCHeader;
 struct IGCExtensions;
@@ -73,6 +75,18 @@ IGCParseLocation(const char *buffer, GeoPoint &location);
 bool
 IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix);
 
+/**
+ * Parse an IGC "B" record which is not null-terminated (e.g. inside
+ * a memory-mapped file).
+ *
+ * @param length the length of the line, excluding the line
+ * terminator
+ * @return true on success, false if the line was not recognized
+ */
+bool
+IGCParseFix(const char *buffer, size_t length,
+            const IGCExtensions &extensions, IGCFix &fix);
+
 /**
  * Parse a time in IGC file format (HHMMSS).
  *
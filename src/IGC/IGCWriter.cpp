@@ -35,13 +35,21 @@ IGCWriter::IGCWriter(Path path)
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   async(file, 64 * 1024),
+   buffered(async)
 {
   fix.Clear();
 
   grecord.Initialize();
 }
 
+void
+IGCWriter::Close()
+{
+  buffered.Flush();
+  async.Close();
+}
+
 void
 IGCWriter::CommitLine(char *line)
 {
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "Logger/GRecord.hpp"
 #include "IGCFix.hpp"
+#include "Logger/AsyncOutputStream.hpp"
 #include "IO/FileOutputStream.hxx"
 #include "IO/BufferedOutputStream.hxx"
 
@@ -43,6 +44,13 @@ class IGCWriter {
   };
 
   FileOutputStream file;
+
+  /**
+   * Decouples the caller from the file system: all writes go to a
+   * ring buffer which is written (and synced) by a separate thread.
+   */
+  AsyncOutputStream async;
+
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -57,12 +65,24 @@ public:
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Submit all buffered lines to the I/O thread.  This does not wait
+   * for the file system.
+   */
   void Flush() {
     buffered.Flush();
   }
 
   void Sign();
 
+  /**
+   * Write all pending data to the file, sync it and stop the I/O
+   * thread.  After this call, no more records may be written.
+   *
+   * Throws std::exception on error.
+   */
+  void Close();
+
 private:
   /**
    * Begin writing a new line.  The returned buffer has #MAX_IGC_BUFF
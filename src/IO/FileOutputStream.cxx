@@ -112,6 +112,16 @@ FileOutputStream::Write(const void *data, size_t size)
 				      GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (!FlushFileBuffers(handle))
+		throw FormatLastError("Failed to sync %s",
+				      GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -209,6 +219,15 @@ FileOutputStream::Write(const void *data, size_t size)
 				  GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (fsync(fd.Get()) < 0)
+		throw FormatErrno("Failed to sync %s", GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -1083,6 +1083,14 @@ static constexpr MetaData meta_data[] = {
     IBFHelper<InfoBoxContentStandbyRadioFrequency>::Create,
   },
 
+  {
+    N_("Glide computer load"),
+    N_("Calc CPU"),
+    N_("CPU time consumed by the glide computer calculations, and the subsystem which needs most of it.  Measuring must be enabled in the InfoBox panel first."),
+    UpdateInfoBoxComputerLoad,
+    computer_timers_infobox_panels,
+  },
+
 };
 
 static_assert(ARRAY_SIZE(meta_data) == NUM_TYPES,
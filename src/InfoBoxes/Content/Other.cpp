@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "InfoBoxes/Content/Other.hpp"
 #include "InfoBoxes/Data.hpp"
+#include "InfoBoxes/Panel/Panel.hpp"
+#include "InfoBoxes/Panel/ComputerTimers.hpp"
 #include "Interface.hpp"
 #include "Renderer/HorizonRenderer.hpp"
 #include "Hardware/Battery.hpp"
@@ -146,6 +148,29 @@ UpdateInfoBoxFreeRAM(InfoBoxData &data)
   data.SetInvalid();
 }
 
+#ifdef __clang__
+/* gcc gives "redeclaration differs in 'constexpr'" */
+constexpr
+#endif
+const InfoBoxPanel computer_timers_infobox_panels[] = {
+  { N_("Timers"), LoadComputerTimersPanel },
+  { nullptr, nullptr }
+};
+
+void
+UpdateInfoBoxComputerLoad(InfoBoxData &data)
+{
+  const ComputerTimers &timers = CommonInterface::Calculated().computer_timers;
+  const double load = timers.GetLoad();
+  if (load < 0) {
+    data.SetInvalid();
+    return;
+  }
+
+  data.SetValueFromPercent(load * 100);
+  data.SetComment(ComputerTimers::GetLabel(timers.GetMostExpensive()));
+}
+
 void
 InfoBoxContentHorizon::OnCustomPaint(Canvas &canvas, const PixelRect &rc)
 {
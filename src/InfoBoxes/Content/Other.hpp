@@ -44,6 +44,11 @@ UpdateInfoBoxCPULoad(InfoBoxData &data);
 void
 UpdateInfoBoxFreeRAM(InfoBoxData &data);
 
+extern const struct InfoBoxPanel computer_timers_infobox_panels[];
+
+void
+UpdateInfoBoxComputerLoad(InfoBoxData &data);
+
 void
 UpdateInfoBoxNbrSat(InfoBoxData &data);
 
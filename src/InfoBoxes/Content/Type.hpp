@@ -168,6 +168,8 @@ namespace InfoBoxFactory
 
     e_StandbyRadio, /* Standby Radio Frequency */
 
+    e_ComputerLoad, /* CPU time consumed by the glide computer subsystems */
+
     e_NUM_TYPES /* Last item */
   };
 
@@ -0,0 +1,165 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ComputerTimers.hpp"
+#include "Interface.hpp"
+#include "Widget/RowFormWidget.hpp"
+#include "Form/ActionListener.hpp"
+#include "Form/Button.hpp"
+#include "UIGlobals.hpp"
+#include "Language/Language.hpp"
+#include "Blackboard/BlackboardListener.hpp"
+#include "Computer/ComputerTimers.hpp"
+#include "Util/StringFormat.hpp"
+#include "Util/Macros.hpp"
+
+enum Controls {
+  TOTAL = unsigned(ComputerTimers::Subsystem::COUNT),
+  ENABLE,
+};
+
+/**
+ * Shows the #ComputerTimers of each #GlideComputer subsystem and
+ * allows switching the measurement on and off.
+ */
+class ComputerTimersPanel final
+  : public RowFormWidget, ActionListener, NullBlackboardListener {
+  Button *enable_button;
+
+public:
+  ComputerTimersPanel()
+    :RowFormWidget(UIGlobals::GetDialogLook()) {}
+
+  void UpdateValues();
+
+  /* virtual methods from Widget */
+  void Prepare(ContainerWindow &parent, const PixelRect &rc) override;
+  void Show(const PixelRect &rc) override;
+  void Hide() override;
+
+private:
+  /* virtual methods from class ActionListener */
+  void OnAction(int id) noexcept override;
+
+  /* virtual methods from class BlackboardListener */
+  void OnCalculatedUpdate(const MoreData &basic,
+                          const DerivedInfo &calculated) override;
+};
+
+static void
+FormatTimer(TCHAR *buffer, size_t size,
+            const ComputerTimers::Timer &timer, uint64_t elapsed_us)
+{
+  if (timer.count == 0) {
+    StringFormat(buffer, size, _T("---"));
+    return;
+  }
+
+  StringFormat(buffer, size, _T("%u us avg, %.1f ms max, %.2f%%"),
+               unsigned(timer.cpu_us / timer.count),
+               timer.max_wall_us / 1000.,
+               elapsed_us > 0 ? timer.cpu_us * 100. / elapsed_us : 0.);
+}
+
+void
+ComputerTimersPanel::UpdateValues()
+{
+  const bool enabled =
+    CommonInterface::GetComputerSettings().computer_timers_enabled;
+  enable_button->SetCaption(enabled ? _("Disable") : _("Enable"));
+
+  const ComputerTimers &timers = CommonInterface::Calculated().computer_timers;
+  const auto elapsed = timers.GetElapsed();
+
+  TCHAR buffer[64];
+  for (unsigned i = 0; i < unsigned(ComputerTimers::Subsystem::COUNT); ++i) {
+    FormatTimer(buffer, ARRAY_SIZE(buffer), timers.timers[i], elapsed);
+    SetText(i, buffer);
+  }
+
+  const double load = timers.GetLoad();
+  if (load >= 0)
+    StringFormat(buffer, ARRAY_SIZE(buffer), _T("%.2f%% of %u s"),
+                 load * 100, unsigned(elapsed / 1000000));
+  else
+    StringFormat(buffer, ARRAY_SIZE(buffer), _T("---"));
+  SetText(TOTAL, buffer);
+}
+
+void
+ComputerTimersPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
+{
+  RowFormWidget::Prepare(parent, rc);
+
+  for (unsigned i = 0; i < unsigned(ComputerTimers::Subsystem::COUNT); ++i)
+    AddReadOnly(ComputerTimers::GetLabel(ComputerTimers::Subsystem(i)));
+
+  AddReadOnly(_("Total"));
+
+  enable_button = AddButton(_("Enable"), *this, ENABLE);
+
+  UpdateValues();
+}
+
+void
+ComputerTimersPanel::Show(const PixelRect &rc)
+{
+  UpdateValues();
+  RowFormWidget::Show(rc);
+
+  CommonInterface::GetLiveBlackboard().AddListener(*this);
+}
+
+void
+ComputerTimersPanel::Hide()
+{
+  CommonInterface::GetLiveBlackboard().RemoveListener(*this);
+
+  RowFormWidget::Hide();
+}
+
+void
+ComputerTimersPanel::OnAction(int id) noexcept
+{
+  switch (id) {
+  case ENABLE: {
+    bool &enabled = CommonInterface::SetComputerSettings().computer_timers_enabled;
+    enabled = !enabled;
+    UpdateValues();
+  }
+    break;
+  }
+}
+
+void
+ComputerTimersPanel::OnCalculatedUpdate(const MoreData &basic,
+                                        const DerivedInfo &calculated)
+{
+  UpdateValues();
+}
+
+Widget *
+LoadComputerTimersPanel(unsigned id)
+{
+  return new ComputerTimersPanel();
+}
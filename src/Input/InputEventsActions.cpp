@@ -125,14 +125,32 @@ trigger_redraw()
 /**
  * Wrapper for #ScopeSuspendAllThreads and Waypoints::Append().
  *
+ * The flat waypoint indexes are rebuilt while the other threads are
+ * running; until they are installed, queries use the #QuadTree.
+ *
  * @return a reference to the #Waypoint stored in #Waypoints
  */
 static WaypointPtr
 SuspendAppendWaypoint(Waypoint &&wp)
 {
-  ScopeSuspendAllThreads suspend;
-  auto ptr = way_points.Append(std::move(wp));
-  way_points.Optimise();
+  WaypointPtr ptr;
+
+  {
+    ScopeSuspendAllThreads suspend;
+    ptr = way_points.Append(std::move(wp));
+    way_points.OptimiseTree();
+  }
+
+  /* only this thread modifies the waypoints, so it may read them
+     without suspending the others */
+  Waypoints::PendingIndex pending;
+  way_points.BuildIndex(pending);
+
+  {
+    ScopeSuspendAllThreads suspend;
+    way_points.InstallIndex(pending);
+  }
+
   return ptr;
 }
 
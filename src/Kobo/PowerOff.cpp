@@ -33,8 +33,7 @@ Copyright_License {
 #include "Screen/Layout.hpp"
 #include "Renderer/FlightListRenderer.hpp"
 #include "FlightInfo.hpp"
-#include "Logger/FlightParser.hpp"
-#include "IO/FileLineReader.hpp"
+#include "Logger/FlightIndex.hpp"
 #include "Resources.hpp"
 #include "Model.hpp"
 
@@ -42,6 +41,7 @@ Copyright_License {
 #include <stdexcept>
 
 #include <stdio.h>
+#include <unistd.h>
 
 static void
 DrawBanner(Canvas &canvas, PixelRect &rc)
@@ -95,13 +95,12 @@ DrawBanner(Canvas &canvas, PixelRect &rc)
 static void
 DrawFlights(Canvas &canvas, const PixelRect &rc)
 try {
-  FileLineReaderA file(Path("/mnt/onboard/XCSoarData/flights.log"));
+  const FlightIndex index(Path("/mnt/onboard/XCSoarData/flights.log"));
+  index.Update();
 
   FlightListRenderer renderer(normal_font, bold_font);
 
-  FlightParser parser(file);
-  FlightInfo flight;
-  while (parser.Read(flight))
+  for (const auto &flight : index.ReadRecent(FlightListRenderer::MAX_FLIGHTS))
     renderer.AddFlight(flight);
 
   renderer.Draw(canvas, rc);
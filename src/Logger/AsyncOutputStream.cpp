@@ -0,0 +1,196 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AsyncOutputStream.hpp"
+#include "IO/FileOutputStream.hxx"
+
+#include <algorithm>
+#include <cassert>
+
+#include <string.h>
+
+AsyncOutputStream::AsyncOutputStream(FileOutputStream &_file,
+                                     size_t _capacity,
+                                     Duration _write_interval,
+                                     Duration _sync_interval)
+  :Thread("LogWriter"),
+   file(_file),
+   write_interval(_write_interval), sync_interval(_sync_interval),
+   capacity(_capacity), ring(new uint8_t[_capacity])
+{
+  assert(capacity > 0);
+  assert((capacity & (capacity - 1)) == 0);
+
+  Start();
+}
+
+AsyncOutputStream::~AsyncOutputStream() noexcept
+{
+  if (IsDefined()) {
+    try {
+      Close();
+    } catch (...) {
+    }
+  }
+}
+
+void
+AsyncOutputStream::Close()
+{
+  assert(IsDefined());
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop = true;
+    cond.notify_all();
+  }
+
+  Join();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+inline void
+AsyncOutputStream::Push(const uint8_t *data, size_t size) noexcept
+{
+  assert(size <= GetFreeSpace());
+
+  const size_t position = write_position.load(std::memory_order_relaxed);
+  const size_t offset = position & (capacity - 1);
+  const size_t first = std::min(size, capacity - offset);
+
+  memcpy(ring.get() + offset, data, first);
+  memcpy(ring.get(), data + first, size - first);
+
+  /* publish the data to the thread */
+  write_position.store(position + size, std::memory_order_release);
+}
+
+void
+AsyncOutputStream::WaitForSpace() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  /* let the thread write what we have and wake us up when done */
+  cond.notify_all();
+  cond.wait(lock, [this]{ return GetFreeSpace() > 0 || stop; });
+}
+
+void
+AsyncOutputStream::Write(const void *_data, size_t size)
+{
+  assert(!stop);
+
+  const uint8_t *data = (const uint8_t *)_data;
+
+  while (size > 0) {
+    size_t n = std::min(size, GetFreeSpace());
+    if (n == 0) {
+      /* the file system cannot keep up; this is the only case where
+         the producer blocks */
+      WaitForSpace();
+      continue;
+    }
+
+    Push(data, n);
+    data += n;
+    size -= n;
+  }
+
+  if (GetFreeSpace() < capacity / 2) {
+    /* more than half full: wake up the thread early */
+    const std::lock_guard<Mutex> lock(mutex);
+    cond.notify_all();
+  }
+}
+
+bool
+AsyncOutputStream::WritePending()
+{
+  const size_t end = write_position.load(std::memory_order_acquire);
+  size_t position = read_position.load(std::memory_order_relaxed);
+  if (position == end)
+    return false;
+
+  while (position != end) {
+    const size_t offset = position & (capacity - 1);
+    const size_t n = std::min(end - position, capacity - offset);
+
+    if (!error) {
+      try {
+        file.Write(ring.get() + offset, n);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    position += n;
+    read_position.store(position, std::memory_order_release);
+  }
+
+  return true;
+}
+
+void
+AsyncOutputStream::Run() noexcept
+{
+  auto last_sync = std::chrono::steady_clock::now();
+  bool dirty = false;
+
+  std::unique_lock<Mutex> lock(mutex);
+
+  while (true) {
+    const bool stopping = stop;
+
+    lock.unlock();
+
+    if (WritePending())
+      dirty = true;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (dirty && (stopping || now - last_sync >= sync_interval)) {
+      if (!error) {
+        try {
+          file.Sync();
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+
+      last_sync = now;
+      dirty = false;
+    }
+
+    lock.lock();
+
+    /* wake up a producer waiting for space */
+    cond.notify_all();
+
+    if (stopping)
+      break;
+
+    if (!stop)
+      cond.wait_for(lock, write_interval);
+  }
+}
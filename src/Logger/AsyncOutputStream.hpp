@@ -0,0 +1,153 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ASYNC_OUTPUT_STREAM_HPP
+#define XCSOAR_ASYNC_OUTPUT_STREAM_HPP
+
+#include "IO/OutputStream.hxx"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hxx"
+#include "Thread/Cond.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+
+#include <stdint.h>
+
+class FileOutputStream;
+
+/**
+ * An #OutputStream which copies all data into a lock-free ring
+ * buffer.  A dedicated thread writes the buffered data to a
+ * #FileOutputStream in batches and calls FileOutputStream::Sync()
+ * periodically (group commit), so the thread which produces the data
+ * never waits for the file system.
+ *
+ * There may be only one producer thread at a time (calling Write()
+ * and Close()).
+ */
+class AsyncOutputStream final : public OutputStream, Thread {
+  typedef std::chrono::steady_clock::duration Duration;
+
+  FileOutputStream &file;
+
+  /**
+   * How long the thread waits for more data before writing a batch
+   * to the file.
+   */
+  const Duration write_interval;
+
+  /**
+   * The minimum interval between two FileOutputStream::Sync() calls.
+   */
+  const Duration sync_interval;
+
+  /** the size of #ring, a power of two */
+  const size_t capacity;
+
+  const std::unique_ptr<uint8_t[]> ring;
+
+  /**
+   * The total number of bytes submitted.  Modified only by the
+   * producer.
+   */
+  std::atomic<size_t> write_position{0};
+
+  /**
+   * The total number of bytes written to the file.  Modified only by
+   * the thread.
+   */
+  std::atomic<size_t> read_position{0};
+
+  /**
+   * Protects #stop and #error, and is used by the producer and the
+   * thread to wait for each other.  The data path does not lock it.
+   */
+  Mutex mutex;
+  Cond cond;
+
+  bool stop = false;
+
+  /**
+   * The first error which occurred in the thread.  All data after
+   * that is discarded.
+   */
+  std::exception_ptr error;
+
+public:
+  /**
+   * Start the thread.
+   *
+   * @param capacity the size of the ring buffer, a power of two
+   */
+  AsyncOutputStream(FileOutputStream &_file, size_t capacity,
+                    Duration _write_interval=std::chrono::seconds(1),
+                    Duration _sync_interval=std::chrono::seconds(10));
+
+  /**
+   * Stops the thread, ignoring errors.  Call Close() to check for
+   * errors.
+   */
+  ~AsyncOutputStream() noexcept;
+
+  /**
+   * Returns the number of bytes which can be submitted without
+   * blocking.
+   */
+  size_t GetFreeSpace() const noexcept {
+    return capacity - (write_position.load(std::memory_order_relaxed) -
+                       read_position.load(std::memory_order_acquire));
+  }
+
+  /**
+   * Write all pending data, sync the file and stop the thread.
+   *
+   * Throws the first error which occurred in the thread.
+   */
+  void Close();
+
+  /* virtual methods from class OutputStream */
+
+  /**
+   * Submit data.  This blocks only if the ring buffer is full.
+   */
+  void Write(const void *data, size_t size) override;
+
+private:
+  void Push(const uint8_t *data, size_t size) noexcept;
+  void WaitForSpace() noexcept;
+
+  /**
+   * Write all data which is currently in the ring buffer.
+   *
+   * @return true if data was written
+   */
+  bool WritePending();
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
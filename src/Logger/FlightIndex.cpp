@@ -0,0 +1,399 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FlightIndex.hpp"
+#include "FlightParser.hpp"
+#include "FlightInfo.hpp"
+#include "IO/LineReader.hpp"
+#include "IO/FileReader.hxx"
+#include "IO/FileOutputStream.hxx"
+#include "OS/FileUtil.hpp"
+#include "OS/ByteOrder.hpp"
+#include "Util/CRC.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include <string.h>
+
+static constexpr char INDEX_MAGIC[8] = {
+  'X', 'C', 'S', 'F', 'L', 'I', 'D', 'X',
+};
+
+static constexpr uint32_t INDEX_VERSION = 2;
+
+/**
+ * The checksum of a record covers at most this many bytes of the
+ * line before its text file offset.
+ */
+static constexpr size_t MAX_CRC_LINE = 256;
+
+/**
+ * Splits a buffer into lines, null-terminating them in place.  An
+ * unterminated last line is ignored, because it may still be in the
+ * process of being written.
+ */
+class BufferLineReader final : public NLineReader {
+  char *position;
+  char *const end;
+
+public:
+  BufferLineReader(char *data, size_t size)
+    :position(data), end(data + size) {}
+
+  /**
+   * Returns the position after the last line returned by
+   * ReadLine().
+   */
+  const char *GetPosition() const {
+    return position;
+  }
+
+  /* virtual methods from class NLineReader */
+  char *ReadLine() override {
+    char *eol = (char *)memchr(position, '\n', end - position);
+    if (eol == nullptr)
+      return nullptr;
+
+    char *line = position;
+    position = eol + 1;
+
+    if (eol > line && eol[-1] == '\r')
+      --eol;
+    *eol = 0;
+    return line;
+  }
+};
+
+static void
+ReadFull(FileReader &file, void *_data, size_t size)
+{
+  uint8_t *data = (uint8_t *)_data;
+  while (size > 0) {
+    size_t nbytes = file.Read(data, size);
+    if (nbytes == 0)
+      throw std::runtime_error("Unexpected end of file");
+
+    data += nbytes;
+    size -= nbytes;
+  }
+}
+
+/**
+ * Load the part of the text file after the given offset.
+ */
+static std::unique_ptr<char[]>
+ReadTail(FileReader &file, uint64_t offset, size_t size)
+{
+  std::unique_ptr<char[]> buffer(new char[size]);
+  file.Seek(offset);
+  ReadFull(file, buffer.get(), size);
+  return buffer;
+}
+
+/**
+ * Calculate the CRC of the line which ends at @a end, but not before
+ * @a begin.
+ */
+gcc_pure
+static uint16_t
+LineCRC(const char *begin, const char *end)
+{
+  begin = std::max(begin, end - MAX_CRC_LINE);
+
+  const char *line = end;
+  if (line > begin)
+    /* skip the line's own newline character */
+    --line;
+
+  while (line > begin && line[-1] != '\n')
+    --line;
+
+  return UpdateCRC16CCITT(line, end - line, 0);
+}
+
+/**
+ * Open the index file and check its header.
+ *
+ * @return the number of records, 0 if the file is invalid
+ */
+static uint64_t
+OpenIndex(FileReader &file, size_t header_size, size_t record_size)
+{
+  const uint64_t size = file.GetSize();
+  if (size < header_size || (size - header_size) % record_size != 0)
+    /* truncated, maybe by a crash during Update() */
+    return 0;
+
+  char magic[sizeof(INDEX_MAGIC)];
+  uint32_t version, file_record_size;
+  ReadFull(file, magic, sizeof(magic));
+  ReadFull(file, &version, sizeof(version));
+  ReadFull(file, &file_record_size, sizeof(file_record_size));
+
+  if (memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+      FromLE32(version) != INDEX_VERSION ||
+      FromLE32(file_record_size) != record_size)
+    return 0;
+
+  return (size - header_size) / record_size;
+}
+
+FlightIndex::FlightIndex(Path _log_path)
+  :log_path(_log_path), index_path(log_path + _T(".idx")) {}
+
+uint64_t
+FlightIndex::ReadLastRecord(Record &record) const
+{
+  if (!File::Exists(index_path))
+    return 0;
+
+  FileReader file(index_path);
+  const uint64_t n = OpenIndex(file, sizeof(Header), sizeof(Record));
+  if (n > 0) {
+    file.Seek(sizeof(Header) + (n - 1) * sizeof(Record));
+    ReadFull(file, &record, sizeof(record));
+  }
+
+  return n;
+}
+
+bool
+FlightIndex::CheckRecord(FileReader &log, uint64_t log_size,
+                         const Record &record)
+{
+  const uint32_t offset = FromLE32(record.log_offset);
+  if (offset > log_size)
+    /* the text file has been truncated */
+    return false;
+
+  const size_t size = std::min<size_t>(offset, MAX_CRC_LINE);
+  const auto line = ReadTail(log, offset - size, size);
+  return LineCRC(line.get(), line.get() + size) == FromLE16(record.line_crc);
+}
+
+FlightInfo
+FlightIndex::ToFlightInfo(const Record &record)
+{
+  FlightInfo flight;
+  flight.date = BrokenDate(FromLE16(record.year), record.month, record.day);
+  flight.start_time = BrokenTime(record.start_hour, record.start_minute,
+                                 record.start_second);
+  flight.end_time = BrokenTime(record.end_hour, record.end_minute,
+                               record.end_second);
+  return flight;
+}
+
+void
+FlightIndex::Update() const
+{
+  FileReader log(log_path);
+  const uint64_t log_size = log.GetSize();
+  const uint64_t log_mtime = File::GetLastModification(log_path);
+
+  Record last;
+  uint64_t n_records = ReadLastRecord(last);
+  if (n_records > 0) {
+    if (FromLE32(last.log_offset) == log_size &&
+        FromLE64(last.log_mtime) == log_mtime)
+      /* not modified since the last update */
+      return;
+
+    if (!CheckRecord(log, log_size, last))
+      /* the text file has been truncated or replaced: rebuild */
+      n_records = 0;
+  }
+
+  uint32_t offset = 0;
+  Statistics totals{0, 0};
+  DayStatistics day;
+  day.date = BrokenDate::Invalid();
+  day.flights = day.duration = 0;
+
+  if (n_records > 0) {
+    offset = FromLE32(last.log_offset);
+    totals.flights = FromLE32(last.total_flights);
+    totals.duration = FromLE32(last.total_duration);
+    day.date = ToFlightInfo(last).date;
+    day.flights = FromLE16(last.day_flights);
+    day.duration = FromLE32(last.day_duration);
+
+    if (offset == log_size)
+      /* nothing new */
+      return;
+  }
+
+  const size_t tail_size = log_size - offset;
+  const auto tail = ReadTail(log, offset, tail_size);
+
+  /* BufferLineReader null-terminates the lines in place; the
+     checksums are calculated from an unmodified copy, to match
+     CheckRecord() */
+  const std::unique_ptr<char[]> raw(new char[tail_size]);
+  std::copy_n(tail.get(), tail_size, raw.get());
+
+  BufferLineReader reader(tail.get(), tail_size);
+  FlightParser parser(reader);
+
+  std::vector<Record> records;
+  FlightInfo flight;
+  while (parser.Read(flight)) {
+    const char *end = parser.GetPendingLine();
+    if (end == nullptr) {
+      if (!flight.end_time.IsPlausible())
+        /* still flying: this flight will be indexed after the
+           landing has been logged */
+        break;
+
+      end = reader.GetPosition();
+    }
+
+    const int duration = std::max(flight.Duration(), 0);
+
+    if (flight.date.IsPlausible() && flight.date == day.date) {
+      ++day.flights;
+      day.duration += duration;
+    } else {
+      day.date = flight.date;
+      day.flights = 1;
+      day.duration = duration;
+    }
+
+    ++totals.flights;
+    totals.duration += duration;
+
+    Record record;
+    memset(&record, 0, sizeof(record));
+    record.log_offset = ToLE32(offset + (end - tail.get()));
+    record.year = ToLE16(flight.date.year);
+    record.month = flight.date.month;
+    record.day = flight.date.day;
+    record.start_hour = flight.start_time.hour;
+    record.start_minute = flight.start_time.minute;
+    record.start_second = flight.start_time.second;
+    record.end_hour = flight.end_time.hour;
+    record.end_minute = flight.end_time.minute;
+    record.end_second = flight.end_time.second;
+    record.day_flights = ToLE16(day.flights);
+    record.day_duration = ToLE32(day.duration);
+    record.total_flights = ToLE32(totals.flights);
+    record.total_duration = ToLE32(totals.duration);
+    record.line_crc = ToLE16(LineCRC(raw.get(),
+                                     raw.get() + (end - tail.get())));
+    record.log_mtime = ToLE64(log_mtime);
+    records.push_back(record);
+  }
+
+  if (n_records > 0) {
+    if (records.empty())
+      return;
+
+    FileOutputStream file(index_path,
+                          FileOutputStream::Mode::APPEND_EXISTING);
+    file.Write(records.data(), records.size() * sizeof(Record));
+    file.Commit();
+  } else {
+    Header header;
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = ToLE32(INDEX_VERSION);
+    header.record_size = ToLE32(sizeof(Record));
+
+    FileOutputStream file(index_path);
+    file.Write(&header, sizeof(header));
+    file.Write(records.data(), records.size() * sizeof(Record));
+    file.Commit();
+  }
+}
+
+std::vector<FlightInfo>
+FlightIndex::ReadRecent(unsigned max) const
+{
+  std::vector<FlightInfo> flights;
+
+  uint64_t offset = 0;
+
+  if (File::Exists(index_path)) {
+    FileReader file(index_path);
+    const uint64_t n = OpenIndex(file, sizeof(Header), sizeof(Record));
+    const unsigned count = std::min<uint64_t>(n, max);
+    if (count > 0) {
+      std::unique_ptr<Record[]> records(new Record[count]);
+      file.Seek(sizeof(Header) + (n - count) * sizeof(Record));
+      ReadFull(file, records.get(), count * sizeof(Record));
+
+      flights.reserve(count + 1);
+      for (unsigned i = 0; i < count; ++i)
+        flights.push_back(ToFlightInfo(records[i]));
+
+      offset = FromLE32(records[count - 1].log_offset);
+    }
+  }
+
+  /* the flight which is not yet in the index */
+  FileReader log(log_path);
+  const uint64_t log_size = log.GetSize();
+  if (offset < log_size) {
+    const size_t tail_size = log_size - offset;
+    const auto tail = ReadTail(log, offset, tail_size);
+
+    BufferLineReader reader(tail.get(), tail_size);
+    FlightParser parser(reader);
+    FlightInfo flight;
+    while (parser.Read(flight))
+      flights.push_back(flight);
+  }
+
+  if (flights.size() > max)
+    flights.erase(flights.begin(), flights.end() - max);
+
+  return flights;
+}
+
+FlightIndex::Statistics
+FlightIndex::GetTotals() const
+{
+  Record last;
+  if (ReadLastRecord(last) == 0)
+    return {0, 0};
+
+  return {FromLE32(last.total_flights), FromLE32(last.total_duration)};
+}
+
+FlightIndex::DayStatistics
+FlightIndex::GetLastDay() const
+{
+  DayStatistics day;
+
+  Record last;
+  if (ReadLastRecord(last) == 0) {
+    day.date = BrokenDate::Invalid();
+    day.flights = day.duration = 0;
+    return day;
+  }
+
+  day.date = ToFlightInfo(last).date;
+  day.flights = FromLE16(last.day_flights);
+  day.duration = FromLE32(last.day_duration);
+  return day;
+}
@@ -0,0 +1,170 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLIGHT_INDEX_HPP
+#define XCSOAR_FLIGHT_INDEX_HPP
+
+#include "OS/Path.hpp"
+#include "Time/BrokenDate.hpp"
+
+#include <vector>
+
+#include <stdint.h>
+
+struct FlightInfo;
+class FileReader;
+
+/**
+ * A binary index for the text file written by #FlightLogger.  It is
+ * stored next to the text file (with the suffix ".idx") and consists
+ * of a header followed by one fixed-size record per flight.  Records
+ * are only appended: Update() parses just the part of the text file
+ * which was written after the last indexed flight.
+ *
+ * Each record also contains running totals for its day and for the
+ * whole log, so statistics can be obtained from the last record
+ * without looking at older flights.
+ */
+class FlightIndex {
+public:
+  struct Statistics {
+    unsigned flights;
+
+    /**
+     * The total duration of all flights with a plausible duration
+     * [s].
+     */
+    unsigned duration;
+  };
+
+  struct DayStatistics : Statistics {
+    BrokenDate date;
+  };
+
+private:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+  };
+
+  /**
+   * An on-disk record.  All integers are little-endian.
+   */
+  struct Record {
+    /**
+     * The offset in the text file after the last line which belongs
+     * to this flight.
+     */
+    uint32_t log_offset;
+
+    uint16_t year;
+    uint8_t month, day;
+    uint8_t start_hour, start_minute, start_second;
+    uint8_t end_hour, end_minute, end_second;
+
+    /**
+     * The number of flights on this day up to and including this
+     * one.
+     */
+    uint16_t day_flights;
+
+    uint32_t day_duration;
+    uint32_t total_flights, total_duration;
+
+    /**
+     * CRC of the text line which ends at #log_offset, to detect a
+     * text file which has been replaced by a different one.
+     */
+    uint16_t line_crc;
+
+    uint16_t reserved;
+
+    /**
+     * The modification time of the text file when this record was
+     * written (see File::GetLastModification()).
+     */
+    uint64_t log_mtime;
+  };
+
+  static_assert(sizeof(Header) == 16, "Wrong size");
+  static_assert(sizeof(Record) == 40, "Wrong size");
+
+  const AllocatedPath log_path, index_path;
+
+public:
+  explicit FlightIndex(Path _log_path);
+
+  /**
+   * Index all complete flights which were appended to the text file
+   * since the last call.  Nothing is parsed if the size and the
+   * modification time of the text file are the same as after the
+   * last call.  The index is rebuilt if it is missing or invalid, or
+   * if the text file has been truncated or replaced.
+   *
+   * Throws std::runtime_error on error.
+   */
+  void Update() const;
+
+  /**
+   * Load the most recent flights, oldest first.  This includes a
+   * flight which has started but not landed yet.  It reads only the
+   * last #max records of the index, so it does not get slower with
+   * the number of flights.  Call Update() before.
+   *
+   * Throws std::runtime_error on error.
+   */
+  std::vector<FlightInfo> ReadRecent(unsigned max) const;
+
+  /**
+   * Returns the totals of all indexed flights.  Call Update()
+   * before.
+   */
+  Statistics GetTotals() const;
+
+  /**
+   * Returns the totals of the most recent day with an indexed
+   * flight.  Call Update() before.
+   */
+  DayStatistics GetLastDay() const;
+
+private:
+  /**
+   * Read the last record.
+   *
+   * @return the number of records, 0 if the index is empty, missing
+   * or invalid
+   */
+  uint64_t ReadLastRecord(Record &record) const;
+
+  /**
+   * Does the text file still contain the flight described by this
+   * record, at the same position?
+   */
+  static bool CheckRecord(FileReader &log, uint64_t log_size,
+                          const Record &record);
+
+  static FlightInfo ToFlightInfo(const Record &record);
+};
+
+#endif
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "FlightLogger.hpp"
+#include "FlightIndex.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "IO/FileOutputStream.hxx"
@@ -54,6 +55,8 @@ try {
 
   writer.Flush();
   file.Commit();
+
+  FlightIndex(path).Update();
 } catch (...) {
   LogError(std::current_exception());
 }
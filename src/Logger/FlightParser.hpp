@@ -46,6 +46,14 @@ public:
    */
   bool Read(FlightInfo &flight);
 
+  /**
+   * Returns the line which was read but not consumed by the last
+   * Read() call (it belongs to the next flight), or nullptr.
+   */
+  const char *GetPendingLine() const {
+    return last;
+  }
+
 private:
   char *ReadLine();
   char *ReadLine(BrokenDateTime &dt);
@@ -98,7 +98,11 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (!simulator)
     writer->Sign();
 
-  writer->Flush();
+  try {
+    writer->Close();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to write IGC file");
+  }
 
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
@@ -22,17 +22,28 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "IO/TextWriter.hpp"
+#include "Logger/AsyncOutputStream.hpp"
+#include "IO/FileOutputStream.hxx"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "Time/BrokenDateTime.hpp"
 #include "Thread/Mutex.hxx"
 #include "OS/Path.hpp"
 #include "Util/StaticString.hxx"
 
+#include <string.h>
+
 namespace NMEALogger
 {
   static Mutex mutex;
-  static TextWriter *writer;
+  static FileOutputStream *file;
+  static AsyncOutputStream *stream;
+
+  /**
+   * The number of lines which were discarded because the I/O thread
+   * could not keep up.
+   */
+  static unsigned n_dropped;
 
   bool enabled = false;
 
@@ -42,7 +53,7 @@ namespace NMEALogger
 bool
 NMEALogger::Start()
 {
-  if (writer != nullptr)
+  if (stream != nullptr)
     return true;
 
   BrokenDateTime dt = BrokenDateTime::NowUTC();
@@ -56,23 +67,42 @@ NMEALogger::Start()
   const auto logs_path = MakeLocalPath(_T("logs"));
 
   const auto path = AllocatedPath::Build(logs_path, name);
-  writer = new TextWriter(path, false);
-  if (writer == nullptr)
-    return false;
 
-  if (!writer->IsOpen()) {
-    delete writer;
-    writer = nullptr;
+  try {
+    file = new FileOutputStream(path,
+                                FileOutputStream::Mode::CREATE_VISIBLE);
+  } catch (...) {
     return false;
   }
 
+  stream = new AsyncOutputStream(*file, 64 * 1024);
   return true;
 }
 
 void
 NMEALogger::Shutdown()
 {
-  delete writer;
+  if (stream == nullptr)
+    return;
+
+  try {
+    stream->Close();
+
+    /* without this, ~FileOutputStream() would delete the file on
+       Windows */
+    file->Commit();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to write NMEA log");
+  }
+
+  if (n_dropped > 0)
+    LogFormat("NMEA logger dropped %u lines", n_dropped);
+
+  delete stream;
+  stream = nullptr;
+
+  delete file;
+  file = nullptr;
 }
 
 void
@@ -81,7 +111,25 @@ NMEALogger::Log(const char *text)
   if (!enabled)
     return;
 
+#ifdef HAVE_POSIX
+  static constexpr char newline[] = "\n";
+#else
+  static constexpr char newline[] = "\r\n";
+#endif
+
+  const size_t length = strlen(text);
+
   std::lock_guard<Mutex> lock(mutex);
-  if (Start())
-    writer->WriteLine(text);
+  if (!Start())
+    return;
+
+  if (stream->GetFreeSpace() < length + sizeof(newline) - 1) {
+    /* never block the caller (the device I/O thread); better lose a
+       line than stall the input */
+    ++n_dropped;
+    return;
+  }
+
+  stream->Write(text, length);
+  stream->Write(newline, sizeof(newline) - 1);
 }
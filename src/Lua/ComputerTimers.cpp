@@ -0,0 +1,122 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ComputerTimers.hpp"
+#include "Util.hxx"
+#include "Util/StringAPI.hxx"
+#include "Interface.hpp"
+#include "Computer/ComputerTimers.hpp"
+
+extern "C" {
+#include <lauxlib.h>
+}
+
+static void
+PushTimer(lua_State *L, const ComputerTimers::Timer &timer)
+{
+  lua_newtable(L);
+  Lua::SetField(L, -2, "count", int(timer.count));
+  Lua::SetField(L, -2, "cpu", timer.cpu_us / 1000000.);
+  Lua::SetField(L, -2, "wall", timer.wall_us / 1000000.);
+  Lua::SetField(L, -2, "max", timer.max_wall_us / 1000000.);
+}
+
+static int
+l_computer_timers_index(lua_State *L)
+{
+  const ComputerTimers &timers = CommonInterface::Calculated().computer_timers;
+
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr)
+    return 0;
+  else if (StringIsEqual(name, "enabled")) {
+    Lua::Push(L, CommonInterface::GetComputerSettings().computer_timers_enabled);
+    return 1;
+  } else if (StringIsEqual(name, "elapsed")) {
+    // Wall clock time covered by the timers [s]
+    Lua::Push(L, timers.GetElapsed() / 1000000.);
+    return 1;
+  } else if (StringIsEqual(name, "load")) {
+    // Share of CPU time consumed by all subsystems [0..1]
+    const double load = timers.GetLoad();
+    if (load >= 0)
+      Lua::Push(L, load);
+    else
+      lua_pushnil(L);
+    return 1;
+  }
+
+  for (unsigned i = 0; i < unsigned(ComputerTimers::Subsystem::COUNT); ++i) {
+    if (StringIsEqual(name,
+                      ComputerTimers::GetName(ComputerTimers::Subsystem(i)))) {
+      PushTimer(L, timers.timers[i]);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static int
+l_computer_timers_enable(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  CommonInterface::SetComputerSettings().computer_timers_enabled = true;
+  return 0;
+}
+
+static int
+l_computer_timers_disable(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  CommonInterface::SetComputerSettings().computer_timers_enabled = false;
+  return 0;
+}
+
+static constexpr struct luaL_Reg computer_timers_funcs[] = {
+  {"enable", l_computer_timers_enable},
+  {"disable", l_computer_timers_disable},
+  {nullptr, nullptr}
+};
+
+void
+Lua::InitComputerTimers(lua_State *L)
+{
+  lua_getglobal(L, "xcsoar");
+
+  lua_newtable(L);
+
+  lua_newtable(L);
+  SetField(L, -2, "__index", l_computer_timers_index);
+  lua_setmetatable(L, -2);
+
+  luaL_setfuncs(L, computer_timers_funcs, 0);
+
+  lua_setfield(L, -2, "computer_timers");
+
+  lua_pop(L, 1);
+}
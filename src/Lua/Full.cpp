@@ -42,6 +42,7 @@ Copyright_License {
 #include "Logger.hpp"
 #include "Tracking.hpp"
 #include "Replay.hpp"
+#include "ComputerTimers.hpp"
 #include "InputEvent.hpp"
 
 lua_State *
@@ -63,6 +64,7 @@ Lua::NewFullState()
   InitLogger(L);
   InitTracking(L);
   InitReplay(L);
+  InitComputerTimers(L);
   InitInputEvent(L);
 
   {
@@ -128,11 +128,8 @@ GlueMapWindow::ExchangeBlackboard()
 {
   /* copy device_blackboard to MapWindow */
 
-  {
-    const std::lock_guard<Mutex> lock(device_blackboard->mutex);
-    ReadBlackboard(device_blackboard->Basic(),
-                   device_blackboard->Calculated());
-  }
+  ReadBlackboard(*device_blackboard->GetBasicSnapshot(),
+                 *device_blackboard->GetCalculatedSnapshot());
 
 #ifndef ENABLE_OPENGL
   {
@@ -29,6 +29,7 @@ Copyright_License {
 #include "Profile/Profile.hpp"
 #include "Screen/Layout.hpp"
 #include "Util/Clamp.hpp"
+#include "Geo/SpeedVector.hpp"
 
 void
 OffsetHistory::Reset()
@@ -115,8 +116,17 @@ GlueMapWindow::UpdateScreenBounds()
 
   if (topography_thread != nullptr &&
       visible_projection.IsValid() &&
-      CommonInterface::GetMapSettings().topography_enabled)
-    topography_thread->Trigger(visible_projection);
+      CommonInterface::GetMapSettings().topography_enabled) {
+    /* predict the area ahead of the aircraft only while the map
+       follows it */
+    const NMEAInfo &basic = CommonInterface::Basic();
+    const SpeedVector motion = follow_mode == FOLLOW_SELF &&
+      basic.track_available && basic.MovementDetected()
+      ? SpeedVector(basic.track, basic.ground_speed)
+      : SpeedVector::Zero();
+
+    topography_thread->Trigger(visible_projection, motion);
+  }
 
   /* always service terrain even if it's not used by the map, because
      it's used by other calculations, therefore don't check if terrain
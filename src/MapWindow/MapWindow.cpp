@@ -78,6 +78,10 @@ MapWindow::FlushCaches()
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
+
+#ifndef ENABLE_OPENGL
+  background_cache.Invalidate();
+#endif
 }
 
 /**
@@ -157,6 +161,10 @@ MapWindow::SetTopography(TopographyStore *_topography)
   topography_renderer = topography != nullptr
     ? new CachedTopographyRenderer(*topography, look.topography)
     : nullptr;
+
+#ifndef ENABLE_OPENGL
+  background_cache.Invalidate();
+#endif
 }
 
 void
@@ -164,6 +172,10 @@ MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+
+#ifndef ENABLE_OPENGL
+  background_cache.Invalidate();
+#endif
 }
 
 void
@@ -35,10 +35,16 @@ Copyright_License {
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
+#include "Renderer/TransparentRendererCache.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
 #include "Util/Compiler.h"
 #include "Weather/Features.hpp"
+#ifndef ENABLE_OPENGL
+#include "Terrain/TerrainSettings.hpp"
+#include "Util/Serial.hpp"
+#include "Projection/CompareProjection.hpp"
+#endif
 #include "Tracking/SkyLines/Features.hpp"
 
 #include <memory>
@@ -174,6 +180,38 @@ protected:
    * zooming and panning, to give instant visual feedback.
    */
   unsigned scale_buffer = 0;
+
+  /**
+   * The attributes of the static background layers (terrain and
+   * topography) which are not covered by the projection check of
+   * #background_cache.
+   */
+  struct BackgroundKey {
+    Serial terrain_serial;
+    unsigned topography_serial;
+    TerrainRendererSettings terrain_settings;
+    Angle shading_angle;
+    bool topography_enabled;
+
+    gcc_pure
+    bool Compare(const BackgroundKey &other) const;
+  };
+
+  /**
+   * A composite of the static background layers.  It is copied to
+   * the buffer instead of drawing these layers again when only
+   * dynamic items (aircraft, traffic, trail, ...) have changed since
+   * the previous frame.
+   */
+  TransparentRendererCache background_cache;
+
+  BackgroundKey background_key;
+
+  /**
+   * The projection of the previous frame.  #background_cache is
+   * filled only if it has not changed.
+   */
+  CompareProjection background_projection;
 #endif
 
   /**
@@ -339,6 +377,21 @@ protected:
   virtual void OnPaintBuffer(Canvas& canvas) override;
 
 private:
+  /**
+   * Renders the layers below the topography labels which do not
+   * depend on the aircraft state (terrain, RASP, topography).  On
+   * platforms without OpenGL, they are composited into
+   * #background_cache and redrawn only when the projection or one
+   * of these layers has changed.
+   * @param canvas The drawing canvas
+   */
+  void RenderBackground(Canvas &canvas);
+
+#ifndef ENABLE_OPENGL
+  gcc_pure
+  BackgroundKey GetBackgroundKey() const;
+#endif
+
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
@@ -27,6 +27,8 @@ Copyright_License {
 #include "Weather/Rasp/RaspRenderer.hpp"
 #include "Weather/Rasp/RaspCache.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Terrain/RasterTerrain.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 #include "Operation/Operation.hpp"
@@ -102,6 +104,97 @@ MapWindow::RenderTopographyLabels(Canvas &canvas)
     topography_renderer->DrawLabels(canvas, render_projection, label_block);
 }
 
+#ifndef ENABLE_OPENGL
+
+bool
+MapWindow::BackgroundKey::Compare(const BackgroundKey &other) const
+{
+  return terrain_serial == other.terrain_serial &&
+    topography_serial == other.topography_serial &&
+    terrain_settings == other.terrain_settings &&
+    /* same tolerance as TerrainRenderer::Generate() */
+    shading_angle.CompareRoughly(other.shading_angle) &&
+    topography_enabled == other.topography_enabled;
+}
+
+MapWindow::BackgroundKey
+MapWindow::GetBackgroundKey() const
+{
+  const auto &settings = GetMapSettings();
+
+  BackgroundKey key;
+  key.terrain_settings = settings.terrain;
+  key.terrain_serial = terrain != nullptr && settings.terrain.enable
+    ? terrain->GetSerial()
+    : Serial();
+  key.shading_angle = background.GetShadingAngle();
+  key.topography_enabled = settings.topography_enabled;
+  key.topography_serial = topography != nullptr && settings.topography_enabled
+    ? topography->GetSerial()
+    : 0;
+  return key;
+}
+
+#endif
+
+inline void
+MapWindow::RenderBackground(Canvas &canvas)
+{
+#ifndef ENABLE_OPENGL
+  /* the RASP layer is generated for each frame, and is drawn between
+     terrain and topography; don't cache while it is visible */
+  if (rasp_store == nullptr || GetUIState().weather.map < 0) {
+    background.SetShadingAngle(render_projection, GetMapSettings().terrain,
+                               Calculated());
+
+    const BackgroundKey key = GetBackgroundKey();
+
+    /* filling the cache costs a full-screen copy on top of drawing
+       the layers, which is wasted if the projection changes with the
+       next frame again, e.g. while the map follows the aircraft;
+       therefore fill it only when the projection has not changed
+       since the previous frame */
+    const bool stable =
+      background_projection.CompareAndUpdate(render_projection);
+
+    const bool valid = background_cache.Check(render_projection) &&
+      key.Compare(background_key);
+    if (!valid && stable) {
+      Canvas &buffer = background_cache.Begin(canvas, render_projection);
+
+      draw_sw.Mark("RenderTerrain");
+      RenderTerrain(buffer);
+
+      /* draws nothing, but disposes the RASP renderer */
+      RenderRasp(buffer);
+
+      draw_sw.Mark("RenderTopography");
+      RenderTopography(buffer);
+
+      background_cache.Commit(canvas, render_projection);
+      background_key = key;
+    }
+
+    if (valid || stable) {
+      draw_sw.Mark("CopyBackground");
+      background_cache.CopyTo(canvas, render_projection);
+      return;
+    }
+  }
+
+  background_cache.Invalidate();
+#endif
+
+  draw_sw.Mark("RenderTerrain");
+  RenderTerrain(canvas);
+
+  draw_sw.Mark("RenderRasp");
+  RenderRasp(canvas);
+
+  draw_sw.Mark("RenderTopography");
+  RenderTopography(canvas);
+}
+
 inline void
 MapWindow::RenderOverlays(Canvas &canvas)
 {
@@ -210,14 +303,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// items on ground
 
   // Render terrain, groundline and topography
-  draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderRasp");
-  RenderRasp(canvas);
-
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  RenderBackground(canvas);
 
   draw_sw.Mark("RenderOverlays");
   RenderOverlays(canvas);
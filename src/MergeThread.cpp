@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "Device/IngestionTrace.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread", 50, 20, 10),
@@ -50,10 +51,14 @@ MergeThread::Process()
 
   computer.Fill(device_blackboard.SetMoreData(), settings_computer);
   computer.Compute(device_blackboard.SetMoreData(), last_any, last_fix,
-                   device_blackboard.Calculated());
+                   *device_blackboard.GetCalculatedSnapshot());
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
+
+  device_blackboard.PublishBasic();
+
+  ingestion_trace.Merged();
 }
 
 void
@@ -67,7 +72,7 @@ MergeThread::Tick() noexcept
 #endif
 
   {
-    std::lock_guard<Mutex> lock(device_blackboard.mutex);
+    std::lock_guard<InstrumentedMutex> lock(device_blackboard.mutex);
 
     Process();
 
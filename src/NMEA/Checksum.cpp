@@ -23,17 +23,114 @@ Copyright_License {
 
 #include "NMEA/Checksum.hpp"
 
+#include "Util/CharUtil.hxx"
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
 #include <cstdint>
 
+/**
+ * Combine all bytes of the buffer with XOR.  Since XOR is
+ * associative, the buffer is folded in 16 byte vectors (or machine
+ * words if no SIMD instruction set is available), and only the lanes
+ * of the accumulator are combined at the end.
+ */
+gcc_pure
+static uint8_t
+XorBytes(const uint8_t *p, size_t length)
+{
+  uint8_t result = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+  if (length >= 16) {
+    uint8x16_t acc = vdupq_n_u8(0);
+    for (; length >= 16; p += 16, length -= 16)
+      acc = veorq_u8(acc, vld1q_u8(p));
+
+    uint64_t x = vgetq_lane_u64(vreinterpretq_u64_u8(acc), 0) ^
+      vgetq_lane_u64(vreinterpretq_u64_u8(acc), 1);
+    x ^= x >> 32;
+    x ^= x >> 16;
+    x ^= x >> 8;
+    result = uint8_t(x);
+  }
+#elif defined(__SSE2__)
+  if (length >= 16) {
+    __m128i acc = _mm_setzero_si128();
+    for (; length >= 16; p += 16, length -= 16)
+      acc = _mm_xor_si128(acc, _mm_loadu_si128((const __m128i *)p));
+
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 4));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 2));
+    acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 1));
+    result = uint8_t(_mm_cvtsi128_si32(acc));
+  }
+#endif
+
+  if (length >= sizeof(uint32_t)) {
+    uint32_t acc = 0;
+    for (; length >= sizeof(acc); p += sizeof(acc), length -= sizeof(acc)) {
+      uint32_t word;
+      memcpy(&word, p, sizeof(word));
+      acc ^= word;
+    }
+
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    result ^= uint8_t(acc);
+  }
+
+  for (; length > 0; --length)
+    result ^= *p++;
+
+  return result;
+}
+
+uint8_t
+NMEAChecksum(const char *p, unsigned length)
+{
+  /* skip the dollar sign at the beginning (the exclamation mark is
+     used by CAI302 */
+  if (length > 0 && (*p == '$' || *p == '!')) {
+    ++p;
+    --length;
+  }
+
+  return XorBytes((const uint8_t *)p, length);
+}
+
+static constexpr unsigned
+ParseHexDigit(char ch)
+{
+  return IsDigitASCII(ch)
+    ? unsigned(ch - '0')
+    : unsigned((ch | 0x20) - 'a' + 10);
+}
+
 bool
 VerifyNMEAChecksum(const char *p)
 {
   assert(p != NULL);
 
+  const size_t length = strlen(p);
+
+  /* fast path: the usual "*XX" suffix */
+  if (length >= 3 && p[length - 3] == '*' &&
+      IsHexDigit(p[length - 2]) && IsHexDigit(p[length - 1])) {
+    const unsigned read_checksum = (ParseHexDigit(p[length - 2]) << 4) |
+      ParseHexDigit(p[length - 1]);
+    return NMEAChecksum(p, length - 3) == read_checksum;
+  }
+
   const char *asterisk = strrchr(p, '*');
   if (asterisk == NULL)
     return false;
@@ -27,56 +27,30 @@ Copyright_License {
 #include "Util/Compiler.h"
 
 #include <cstdint>
+#include <cstring>
 
 /**
  * Calculates the checksum for the specified line (without the
  * asterisk and the newline character).
  *
- * @param p a NULL terminated string
+ * @param p a string
+ * @param length the number of characters in the string
  */
 gcc_pure
-static inline uint8_t
-NMEAChecksum(const char *p)
-{
-  uint8_t checksum = 0;
-
-  /* skip the dollar sign at the beginning (the exclamation mark is
-     used by CAI302 */
-  if (*p == '$' || *p == '!')
-    ++p;
-
-  while (*p != 0)
-    checksum ^= *p++;
-
-  return checksum;
-}
+uint8_t
+NMEAChecksum(const char *p, unsigned length);
 
 /**
  * Calculates the checksum for the specified line (without the
  * asterisk and the newline character).
  *
- * @param p a string
- * @param length the number of characters in the string
+ * @param p a NULL terminated string
  */
 gcc_pure
 static inline uint8_t
-NMEAChecksum(const char *p, unsigned length)
+NMEAChecksum(const char *p)
 {
-  uint8_t checksum = 0;
-
-  unsigned i = 0;
-
-  /* skip the dollar sign at the beginning (the exclamation mark is
-     used by CAI302 */
-  if (length > 0 && (*p == '$' || *p == '!')) {
-    ++i;
-    ++p;
-  }
-
-  for (; i < length; ++i)
-    checksum ^= *p++;
-
-  return checksum;
+  return NMEAChecksum(p, strlen(p));
 }
 
 /**
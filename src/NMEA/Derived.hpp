@@ -45,6 +45,7 @@ Copyright_License {
 #include "Atmosphere/Pressure.hpp"
 #include "Engine/Route/Route.hpp"
 #include "Computer/WaveResult.hpp"
+#include "Computer/ComputerTimers.hpp"
 #include "Util/TypeTraits.hpp"
 
 /** Derived terrain altitude information, including glide range */
@@ -256,6 +257,9 @@ struct DerivedInfo:
    */
   double next_leg_eq_thermal;
 
+  /** Copy of the #GlideComputer timers */
+  ComputerTimers computer_timers;
+
   /**
    * @todo Reset to cleared state
    */
@@ -138,6 +138,34 @@ MonotonicClockFloat()
 #endif /* !HAVE_POSIX */
 }
 
+uint64_t
+ThreadCPUClockUS()
+{
+#if defined(HAVE_POSIX) && !defined(__CYGWIN__)
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) < 0)
+    return 0;
+
+  return uint64_t(ts.tv_sec) * 1000000 + uint64_t(ts.tv_nsec) / 1000;
+#else
+  return 0;
+#endif
+#else /* !HAVE_POSIX */
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time,
+                        &kernel_time, &user_time))
+    return 0;
+
+  /* FILETIME counts 100 ns units */
+  const uint64_t kernel = kernel_time.dwLowDateTime |
+    (uint64_t(kernel_time.dwHighDateTime) << 32);
+  const uint64_t user = user_time.dwLowDateTime |
+    (uint64_t(user_time.dwHighDateTime) << 32);
+  return (kernel + user) / 10;
+#endif /* !HAVE_POSIX */
+}
+
 int
 GetSystemUTCOffset()
 {
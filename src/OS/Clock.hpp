@@ -50,6 +50,15 @@ gcc_pure
 double
 MonotonicClockFloat();
 
+/**
+ * Returns the CPU time consumed by the calling thread in
+ * microseconds (user and kernel).  Returns 0 if the platform does
+ * not provide a per-thread CPU clock.
+ */
+gcc_pure
+uint64_t
+ThreadCPUClockUS();
+
 /**
  * Query the UTC offset from the OS.
  *
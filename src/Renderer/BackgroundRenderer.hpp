@@ -62,6 +62,15 @@ public:
   void SetShadingAngle(const WindowProjection &projection,
                        const TerrainRendererSettings &settings,
                        const DerivedInfo &calculated);
+
+  /**
+   * Returns the shading angle determined by the last
+   * SetShadingAngle() call.
+   */
+  Angle GetShadingAngle() const {
+    return shading_angle;
+  }
+
   void SetTerrain(const RasterTerrain *terrain);
 
 private:
@@ -167,7 +167,17 @@ TaskPointRenderer::DrawIsoline(const AATPoint &tp)
   if (!tp.valid() || !IsTargetVisible(tp))
     return;
 
-  AATIsolineSegment seg(tp, flat_projection);
+  /* reuse the isoline built by the target optimiser if possible */
+  const AATIsolineSegment *cached = tp.GetCachedIsolineSegment();
+  if (cached != nullptr)
+    DrawIsoline(*cached);
+  else
+    DrawIsoline(AATIsolineSegment(tp, flat_projection));
+}
+
+inline void
+TaskPointRenderer::DrawIsoline(const AATIsolineSegment &seg)
+{
   if (!seg.IsValid())
     return;
 
@@ -35,6 +35,7 @@ class OZRenderer;
 class TaskPoint;
 class OrderedTaskPoint;
 class AATPoint;
+class AATIsolineSegment;
 class FlatProjection;
 struct TaskLook;
 
@@ -131,6 +132,7 @@ private:
   void DrawTarget(const TaskPoint &tp);
   void DrawTaskLine(const GeoPoint &start, const GeoPoint &end);
   void DrawIsoline(const AATPoint &tp);
+  void DrawIsoline(const AATIsolineSegment &seg);
   void DrawOZBackground(Canvas &canvas, const OrderedTaskPoint &tp,
                         int offset);
   void DrawOZForeground(const OrderedTaskPoint &tp, int offset);
@@ -69,6 +69,18 @@ TransparentRendererCache::Commit(Canvas &canvas,
   empty = false;
 }
 
+void
+TransparentRendererCache::CopyTo(Canvas &canvas,
+                                 const WindowProjection &projection) const
+{
+  if (empty)
+    return;
+
+  canvas.Copy(0, 0,
+              projection.GetScreenWidth(), projection.GetScreenHeight(),
+              buffer, 0, 0);
+}
+
 void
 TransparentRendererCache::CopyAndTo(Canvas &canvas,
                                     const WindowProjection &projection) const
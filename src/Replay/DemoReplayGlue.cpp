@@ -38,15 +38,17 @@ DemoReplayGlue::DemoReplayGlue(ProtectedTaskManager &_task_manager)
   DemoReplay::Start(ta, device_blackboard->Basic().location);
 
   // get wind from aircraft
-  aircraft.GetState().wind = device_blackboard->Calculated().GetWindOrZero();
+  aircraft.GetState().wind =
+    device_blackboard->GetCalculatedSnapshot()->GetWindOrZero();
 }
 
 bool
 DemoReplayGlue::Update(NMEAInfo &data)
 {
   double floor_alt = 300;
-  if (device_blackboard->Calculated().terrain_valid) {
-    floor_alt += device_blackboard->Calculated().terrain_altitude;
+  const auto calculated = device_blackboard->GetCalculatedSnapshot();
+  if (calculated->terrain_valid) {
+    floor_alt += calculated->terrain_altitude;
   }
 
   bool retval;
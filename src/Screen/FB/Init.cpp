@@ -26,6 +26,7 @@ Copyright_License {
 #include "Event/Queue.hpp"
 #include "Screen/Debug.hpp"
 #include "Screen/Font.hpp"
+#include "Screen/Memory/BandPool.hpp"
 #include "DisplayOrientation.hpp"
 #include "Asset.hpp"
 
@@ -36,6 +37,7 @@ Copyright_License {
 ScreenGlobalInit::ScreenGlobalInit()
 {
   Font::Initialise();
+  BandPool::Initialise();
 
   event_queue = new EventQueue();
 
@@ -52,6 +54,7 @@ ScreenGlobalInit::~ScreenGlobalInit()
   delete event_queue;
   event_queue = nullptr;
 
+  BandPool::Deinitialise();
   Font::Deinitialise();
 
   ScreenDeinitialized();
@@ -46,6 +46,18 @@ public:
     return size;
   }
 
+  /**
+   * The position of the icon's hot spot relative to its top left
+   * corner.
+   */
+  const PixelPoint &GetOrigin() const {
+    return origin;
+  }
+
+  const Bitmap &GetBitmap() const {
+    return bitmap;
+  }
+
   bool IsDefined() const {
     return bitmap.IsDefined();
   }
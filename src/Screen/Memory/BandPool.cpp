@@ -0,0 +1,189 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "BandPool.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hxx"
+#include "Thread/Cond.hxx"
+#include "OS/ProcessorCount.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace BandPool {
+
+class Worker final : public Thread {
+public:
+  Worker():Thread("BandPool") {}
+
+protected:
+  void Run() noexcept override;
+};
+
+/**
+ * Held by the thread which owns the current job.  The pool draws
+ * only one primitive at a time; concurrent callers (e.g. the
+ * DrawThread and the main thread) fall back to serial drawing.
+ */
+static Mutex busy;
+
+/**
+ * Protects the job variables below.
+ */
+static Mutex mutex;
+
+/**
+ * Signalled when a new job is available or when the workers shall
+ * exit.
+ */
+static Cond work_cond;
+
+/**
+ * Signalled when the last band of a job has been drawn.
+ */
+static Cond done_cond;
+
+static const Function *function;
+static int job_top, job_bottom;
+static unsigned band_rows, n_bands, next_band, pending_bands;
+static bool stop;
+
+static std::array<Worker, MAX_THREADS> workers;
+static unsigned n_workers;
+
+/**
+ * Draw bands of the current job until there are none left.  The
+ * caller must hold the mutex.
+ */
+static void
+DrawBands()
+{
+  while (next_band < n_bands) {
+    const unsigned band = next_band++;
+    const int top = job_top + int(band * band_rows);
+    const int bottom = band == n_bands - 1
+      ? job_bottom
+      : top + int(band_rows);
+    const Function &f = *function;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      f(top, bottom);
+    }
+
+    if (--pending_bands == 0)
+      done_cond.notify_one();
+  }
+}
+
+void
+Worker::Run() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+  while (!stop) {
+    if (next_band < n_bands)
+      DrawBands();
+    else
+      work_cond.wait(lock);
+  }
+}
+
+void
+Initialise()
+{
+  Initialise(GetProcessorCount() - 1);
+}
+
+void
+Initialise(unsigned n_threads)
+{
+  assert(n_workers == 0);
+
+  n_threads = std::min(n_threads, MAX_THREADS);
+
+  stop = false;
+  while (n_workers < n_threads && workers[n_workers].Start())
+    ++n_workers;
+}
+
+void
+Deinitialise()
+{
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop = true;
+    work_cond.notify_all();
+  }
+
+  for (unsigned i = 0; i < n_workers; ++i)
+    workers[i].Join();
+
+  n_workers = 0;
+}
+
+bool
+CanSplit(unsigned rows, unsigned width)
+{
+  return n_workers > 0 && rows >= 2 * MIN_BAND_ROWS &&
+    rows * width >= MIN_PIXELS;
+}
+
+void
+RunParallel(int top, int bottom, const Function &f)
+{
+  assert(top < bottom);
+
+  std::unique_lock<Mutex> busy_lock(busy, std::try_to_lock);
+  if (!busy_lock.owns_lock() || n_workers == 0) {
+    f(top, bottom);
+    return;
+  }
+
+  const unsigned rows = bottom - top;
+
+  /* two bands per thread: the pixels of a polygon are rarely
+     distributed evenly, and whoever finishes first picks up the
+     next band */
+  const unsigned n = std::max(std::min((n_workers + 1) * 2,
+                                       rows / MIN_BAND_ROWS),
+                              1u);
+
+  std::unique_lock<Mutex> lock(mutex);
+  function = &f;
+  job_top = top;
+  job_bottom = bottom;
+  band_rows = rows / n;
+  n_bands = n;
+  next_band = 0;
+  pending_bands = n;
+  work_cond.notify_all();
+
+  DrawBands();
+  done_cond.wait(lock, []{ return pending_bands == 0; });
+
+  n_bands = next_band = 0;
+  function = nullptr;
+}
+
+} // namespace BandPool
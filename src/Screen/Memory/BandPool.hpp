@@ -0,0 +1,107 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_MEMORY_BAND_POOL_HPP
+#define XCSOAR_SCREEN_MEMORY_BAND_POOL_HPP
+
+#include "Util/Compiler.h"
+
+#include <functional>
+
+/**
+ * A pool of worker threads which draw large software rendering
+ * primitives in parallel.  A primitive is split into horizontal
+ * bands, and each band is drawn into the shared frame buffer by
+ * another thread.  The bands do not overlap, and Run() returns only
+ * after all of them have been drawn, therefore the order of
+ * primitives is preserved.
+ */
+namespace BandPool {
+  /**
+   * Draw the rows [top, bottom).  The function must not write to
+   * other rows.
+   */
+  typedef std::function<void(int top, int bottom)> Function;
+
+  /**
+   * Primitives smaller than this number of pixels are not split,
+   * because waking up the worker threads would cost more than it
+   * saves.
+   */
+  static constexpr unsigned MIN_PIXELS = 64 * 1024;
+
+  static constexpr unsigned MIN_BAND_ROWS = 16;
+
+  /**
+   * The maximum number of worker threads; the calling thread draws
+   * bands, too.
+   */
+  static constexpr unsigned MAX_THREADS = 7;
+
+  /**
+   * Start one worker thread per additional processor.  On a single
+   * core machine, no thread is started, and Run() draws everything
+   * in the calling thread.
+   */
+  void Initialise();
+
+  /**
+   * Start the specified number of worker threads (clipped to
+   * #MAX_THREADS).
+   */
+  void Initialise(unsigned n_threads);
+
+  void Deinitialise();
+
+  /**
+   * Is it worth splitting a primitive of this size?
+   */
+  gcc_pure
+  bool CanSplit(unsigned rows, unsigned width);
+
+  /**
+   * Split the rows [top, bottom) into bands and draw them in
+   * parallel.  Returns after all bands have been drawn.
+   *
+   * If another thread is using the pool already, the function is
+   * called once for all rows in the current thread.
+   */
+  void RunParallel(int top, int bottom, const Function &f);
+
+  /**
+   * Draw the rows [top, bottom) of a primitive which is at most
+   * #width pixels wide, in parallel if it is large enough.
+   */
+  template<typename F>
+  void Run(int top, int bottom, unsigned width, F &&f) {
+    if (top >= bottom)
+      return;
+
+    if (CanSplit(bottom - top, width))
+      RunParallel(top, bottom, Function(f));
+    else
+      f(top, bottom);
+  }
+}
+
+#endif
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Screen/Util.hpp"
 #include "Optimised.hpp"
 #include "RasterCanvas.hpp"
+#include "BandPool.hpp"
 #include "Screen/Custom/Cache.hpp"
 #include "Math/Angle.hpp"
 #include "Util/TStringView.hxx"
@@ -76,9 +77,14 @@ Canvas::DrawFilledRectangle(int left, int top, int right, int bottom,
   if (left >= right || top >= bottom)
     return;
 
-  SDLRasterCanvas canvas(buffer);
-  canvas.FillRectangle(left, top, right, bottom,
-                       canvas.Import(color));
+  const auto c = SDLRasterCanvas::Import(color);
+  BandPool::Run(std::max(top, 0), std::min(bottom, int(buffer.height)),
+                std::min(unsigned(right - left), buffer.width),
+                [this, left, right, c](int band_top, int band_bottom){
+                  SDLRasterCanvas canvas(buffer);
+                  canvas.FillRectangle(left, band_top, right, band_bottom,
+                                       c);
+                });
 }
 
 void
@@ -118,20 +124,41 @@ Canvas::DrawPolygon(const BulkPixelPoint *lppt, unsigned cPoints)
   if (brush.IsHollow() && !pen.IsDefined())
     return;
 
-  SDLRasterCanvas canvas(buffer);
+  if (!brush.IsHollow() && cPoints > 0) {
+    int min_x = lppt[0].x, max_x = lppt[0].x;
+    int min_y = lppt[0].y, max_y = lppt[0].y;
+    for (unsigned i = 1; i < cPoints; ++i) {
+      min_x = std::min(min_x, lppt[i].x);
+      max_x = std::max(max_x, lppt[i].x);
+      min_y = std::min(min_y, lppt[i].y);
+      max_y = std::max(max_y, lppt[i].y);
+    }
 
-  if (!brush.IsHollow()) {
-    const auto color = canvas.Import(brush.GetColor());
-    if (brush.GetColor().IsOpaque())
-      canvas.FillPolygon(lppt, cPoints, color);
-    else
-      canvas.FillPolygon(lppt, cPoints, color,
-                         AlphaPixelOperations<ActivePixelTraits>(brush.GetColor().Alpha()));
+    const auto color = SDLRasterCanvas::Import(brush.GetColor());
+    const bool opaque = brush.GetColor().IsOpaque();
+    const uint8_t alpha = brush.GetColor().Alpha();
+
+    BandPool::Run(std::max(min_y, 0),
+                  std::min(max_y + 1, int(buffer.height)),
+                  std::min(unsigned(max_x - min_x + 1), buffer.width),
+                  [this, lppt, cPoints, color, opaque, alpha](int band_top,
+                                                             int band_bottom){
+                    SDLRasterCanvas canvas(buffer);
+                    if (opaque)
+                      canvas.FillPolygon(lppt, cPoints, color,
+                                         band_top, band_bottom);
+                    else
+                      canvas.FillPolygon(lppt, cPoints, color,
+                                         AlphaPixelOperations<ActivePixelTraits>(alpha),
+                                         band_top, band_bottom);
+                  });
   }
 
-  if (IsPenOverBrush())
+  if (IsPenOverBrush()) {
+    SDLRasterCanvas canvas(buffer);
     ::DrawPolyline(canvas, ActivePixelTraits(), pen,
                    lppt, cPoints, true);
+  }
 }
 
 void
@@ -389,9 +416,16 @@ Canvas::Copy(int dest_x, int dest_y,
       !Clip(dest_y, dest_height, GetHeight(), src_y))
     return;
 
-  SDLRasterCanvas canvas(buffer);
-  canvas.CopyRectangle(dest_x, dest_y, dest_width, dest_height,
-                       src.At(src_x, src_y), src.pitch);
+  BandPool::Run(dest_y, dest_y + dest_height, dest_width,
+                [this, dest_x, dest_y, dest_width, src, src_x,
+                 src_y](int band_top, int band_bottom){
+                  const int skip = band_top - dest_y;
+                  SDLRasterCanvas canvas(buffer);
+                  canvas.CopyRectangle(dest_x, band_top,
+                                       dest_width, band_bottom - band_top,
+                                       src.At(src_x, src_y + skip),
+                                       src.pitch);
+                });
 }
 
 void
@@ -495,10 +529,19 @@ Canvas::Stretch(int dest_x, int dest_y,
     /* paranoid sanity check; shouldn't ever happen */
     return;
 
-  SDLRasterCanvas canvas(buffer);
-
-  canvas.ScaleRectangle(dest_x, dest_y, dest_width, dest_height,
-                        src.At(src_x, src_y), src.pitch, src_width, src_height);
+  /* ScaleRectangle() clips against the whole buffer in each band,
+     which keeps the source row mapping identical to a serial call */
+  BandPool::Run(std::max(dest_y, 0),
+                std::min(dest_y + int(dest_height), int(buffer.height)),
+                std::min(dest_width, buffer.width),
+                [&](int band_top, int band_bottom){
+                  SDLRasterCanvas canvas(buffer);
+                  canvas.ScaleRectangle(dest_x, dest_y,
+                                        dest_width, dest_height,
+                                        src.At(src_x, src_y), src.pitch,
+                                        src_width, src_height,
+                                        band_top, band_bottom);
+                });
 }
 
 void
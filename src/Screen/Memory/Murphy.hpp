@@ -25,8 +25,10 @@ Copyright_License {
 #define XCSOAR_MURPHY_HPP
 
 #include "Bresenham.hpp"
+#include "Screen/Point.hpp"
 
 #include <algorithm>
+#include <cassert>
 
 #include <math.h>
 #include <cstdint>
@@ -31,8 +31,11 @@ Copyright_License {
 #include "Util/AllocatedArray.hxx"
 #include "Util/Compiler.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include <stdint.h>
+
 /*
   line_masks:
    -1               SOLID
@@ -470,9 +473,16 @@ public:
 
   }
 
+  /**
+   * Fill only the rows [top, bottom) of the polygon.  The geometry is
+   * still calculated for the whole polygon, which makes the result
+   * identical to the corresponding rows of a full fill; this allows
+   * splitting a large polygon into bands which are drawn in parallel.
+   */
   template<typename PixelOperations>
   void FillPolygonFast(const PixelPoint *points, unsigned n, color_type color,
-                       PixelOperations operations) {
+                       PixelOperations operations,
+                       int top, int bottom) {
 
     assert(points != nullptr);
 
@@ -515,7 +525,11 @@ public:
     // sort array by y value (top best), then x value (left best)
     std::sort(edge_start, edge_end, BresenhamIterator::CompareVerticalHorizontal);
 
-    // perform scans
+    // perform scans, skipping rows which would not be drawn anyway;
+    // AdvanceTo() catches up with the first visible row
+
+    miny = std::max(miny, top);
+    maxy = std::min(maxy, bottom - 1);
 
     for (int y = miny; y <= maxy; y++) {
 
@@ -569,9 +583,20 @@ public:
 
   }
 
+  template<typename PixelOperations>
+  void FillPolygonFast(const PixelPoint *points, unsigned n, color_type color,
+                       PixelOperations operations) {
+    FillPolygonFast(points, n, color, operations, 0, buffer.height);
+  }
+
+  /**
+   * Fill only the rows [top, bottom) of the polygon.
+   *
+   * @see FillPolygonFast()
+   */
   template<typename PixelOperations>
   void FillPolygon(const PixelPoint *points, unsigned n, color_type color,
-                   PixelOperations operations) {
+                   PixelOperations operations, int top, int bottom) {
     assert(points != nullptr);
 
     if (n < 3)
@@ -592,8 +617,11 @@ public:
         maxy = points[i].y;
     }
 
-    // Draw, scanning y
-    for (int y = miny; y <= maxy; y++) {
+    // Draw, scanning y; the "y == maxy" check below needs the
+    // unclipped maximum
+    const int first_y = std::max(miny, top);
+    const int last_y = std::min(maxy, bottom - 1);
+    for (int y = first_y; y <= last_y; y++) {
       unsigned n_ints = 0;
       for (unsigned i = 0; i < n; i++) {
         unsigned ind1, ind2;
@@ -637,6 +665,12 @@ public:
     }
   }
 
+  template<typename PixelOperations>
+  void FillPolygon(const PixelPoint *points, unsigned n, color_type color,
+                   PixelOperations operations) {
+    FillPolygon(points, n, color, operations, 0, buffer.height);
+  }
+
   void FillPolygon(const PixelPoint *points, unsigned n, color_type color) {
     FillPolygonFast(points, n, color,
                     GetPixelTraits());
@@ -644,6 +678,17 @@ public:
 //                GetPixelTraits());
   }
 
+  /**
+   * Fill only the rows [top, bottom) of the polygon.
+   *
+   * @see FillPolygonFast()
+   */
+  void FillPolygon(const PixelPoint *points, unsigned n, color_type color,
+                   int top, int bottom) {
+    FillPolygonFast(points, n, color,
+                    GetPixelTraits(), top, bottom);
+  }
+
   template<typename PixelOperations>
   void DrawCircle(int x, int y, unsigned rad, color_type color,
                   PixelOperations operations) {
@@ -868,24 +913,43 @@ public:
     }
   }
 
+  /**
+   * Scale only the destination rows [top, bottom) of the rectangle.
+   * Clipping and the source row of each destination row are
+   * calculated for the whole rectangle, which makes the result
+   * identical to the corresponding rows of a full ScaleRectangle()
+   * call, as long as the #PixelOperations do not depend on the
+   * previous destination contents.
+   */
   template<typename PixelOperations, typename SPT=PixelTraits>
   void ScaleRectangle(int dest_x, int dest_y,
                       unsigned dest_width, unsigned dest_height,
                       typename SPT::const_rpointer src, unsigned src_pitch,
                       unsigned src_width, unsigned src_height,
-                      PixelOperations operations) {
+                      PixelOperations operations,
+                      int top, int bottom) {
     unsigned src_x = 0, src_y = 0;
     if (!ClipScaleAxis(dest_x, dest_width, buffer.width, src_x, src_width) ||
         !ClipScaleAxis(dest_y, dest_height, buffer.height, src_y, src_height))
       return;
 
+    const int first_row = std::max(top - dest_y, 0);
+    const int end_row = std::min(bottom - dest_y, int(dest_height));
+    if (first_row >= end_row)
+      return;
+
+    /* skip the rows above the band, using the same integer arithmetic
+       as the loop below */
+    const uint64_t skip = uint64_t(first_row) * src_height;
+    src_y += skip / dest_height;
+    unsigned j = skip % dest_height;
+
     src = SPT::At(src, src_pitch, src_x, src_y);
 
     typename SPT::const_rpointer old_src = nullptr;
 
-    unsigned j = 0;
-    rpointer dest = At(dest_x, dest_y);
-    for (unsigned i = dest_height; i > 0; --i,
+    rpointer dest = At(dest_x, dest_y + first_row);
+    for (unsigned i = end_row - first_row; i > 0; --i,
            dest = PixelTraits::NextRow(dest, buffer.pitch, 1)) {
       if (src == old_src) {
         /* the previous iteration has already scaled this row: copy
@@ -908,6 +972,19 @@ public:
     }
   }
 
+  template<typename PixelOperations, typename SPT=PixelTraits>
+  void ScaleRectangle(int dest_x, int dest_y,
+                      unsigned dest_width, unsigned dest_height,
+                      typename SPT::const_rpointer src, unsigned src_pitch,
+                      unsigned src_width, unsigned src_height,
+                      PixelOperations operations) {
+    ScaleRectangle<PixelOperations, SPT>(dest_x, dest_y,
+                                         dest_width, dest_height,
+                                         src, src_pitch,
+                                         src_width, src_height,
+                                         operations, 0, buffer.height);
+  }
+
   void ScaleRectangle(int dest_x, int dest_y,
                       unsigned dest_width, unsigned dest_height,
                       const_rpointer src, unsigned src_pitch,
@@ -916,6 +993,16 @@ public:
                    src, src_pitch, src_width, src_height,
                    GetPixelTraits());
   }
+
+  void ScaleRectangle(int dest_x, int dest_y,
+                      unsigned dest_width, unsigned dest_height,
+                      const_rpointer src, unsigned src_pitch,
+                      unsigned src_width, unsigned src_height,
+                      int top, int bottom) {
+    ScaleRectangle(dest_x, dest_y, dest_width, dest_height,
+                   src, src_pitch, src_width, src_height,
+                   GetPixelTraits(), top, bottom);
+  }
 };
 
 #endif
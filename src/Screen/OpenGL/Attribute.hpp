@@ -35,6 +35,7 @@ namespace OpenGL {
     static constexpr GLuint POSITION = 1;
     static constexpr GLuint TEXCOORD = 2;
     static constexpr GLuint COLOR = 3;
+    static constexpr GLuint OFFSET = 4;
   };
 };
 
@@ -89,6 +89,13 @@ public:
     glBufferData(target, size, data, usage);
   }
 
+  /**
+   * Replaces a portion of the (bound) buffer.
+   */
+  static void SubData(GLintptr offset, GLsizeiptr size, const GLvoid *data) {
+    glBufferSubData(target, offset, size, data);
+  }
+
   void Load(GLsizeiptr size, const GLvoid *data) {
     Bind();
     Data(size, data);
@@ -153,4 +160,8 @@ public:
 class GLArrayBuffer : public GLBuffer<GL_ARRAY_BUFFER, GL_STATIC_DRAW> {
 };
 
+class GLElementArrayBuffer
+  : public GLBuffer<GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW> {
+};
+
 #endif
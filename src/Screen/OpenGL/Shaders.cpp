@@ -44,6 +44,9 @@ namespace OpenGL {
 
   GLProgram *combine_texture_shader;
   GLint combine_texture_projection, combine_texture_texture;
+
+  GLProgram *icon_shader;
+  GLint icon_projection, icon_modelview, icon_texture;
 }
 
 #ifdef HAVE_GLES
@@ -90,6 +93,21 @@ static constexpr char texture_vertex_shader[] =
   "  colorvar = color;"
   "}";
 
+static constexpr char icon_vertex_shader[] =
+  GLSL_VERSION
+  "uniform mat4 projection;"
+  "uniform mat4 modelview;"
+  "attribute vec4 translate;"
+  "attribute vec4 position;"
+  "attribute vec2 offset;"
+  "attribute vec2 texcoord;"
+  "varying vec2 texcoordvar;"
+  "void main() {"
+  "  gl_Position = projection * (modelview * position + translate"
+  "                              + vec4(offset, 0, 0));"
+  "  texcoordvar = texcoord;"
+  "}";
+
 static constexpr char texture_fragment_shader[] =
   GLSL_VERSION
   GLSL_PRECISION
@@ -99,6 +117,8 @@ static constexpr char texture_fragment_shader[] =
   "  gl_FragColor = texture2D(texture, texcoordvar);"
   "}";
 
+static const char *const icon_fragment_shader = texture_fragment_shader;
+
 static const char *const invert_vertex_shader = texture_vertex_shader;
 static constexpr char invert_fragment_shader[] =
   GLSL_VERSION
@@ -248,6 +268,22 @@ OpenGL::InitShaders()
   combine_texture_shader->Use();
   glUniform1i(combine_texture_texture, 0);
 
+  icon_shader = CompileProgram(icon_vertex_shader, icon_fragment_shader);
+  icon_shader->BindAttribLocation(Attribute::TRANSLATE, "translate");
+  icon_shader->BindAttribLocation(Attribute::POSITION, "position");
+  icon_shader->BindAttribLocation(Attribute::OFFSET, "offset");
+  icon_shader->BindAttribLocation(Attribute::TEXCOORD, "texcoord");
+  LinkProgram(*icon_shader);
+
+  icon_projection = icon_shader->GetUniformLocation("projection");
+  icon_modelview = icon_shader->GetUniformLocation("modelview");
+  icon_texture = icon_shader->GetUniformLocation("texture");
+
+  icon_shader->Use();
+  glUniform1i(icon_texture, 0);
+  glUniformMatrix4fv(icon_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+
   glVertexAttrib4f(Attribute::TRANSLATE, 0, 0, 0, 0);
 }
 
@@ -280,4 +316,8 @@ OpenGL::UpdateShaderProjectionMatrix()
   combine_texture_shader->Use();
   glUniformMatrix4fv(combine_texture_projection, 1, GL_FALSE,
                      glm::value_ptr(projection_matrix));
+
+  icon_shader->Use();
+  glUniformMatrix4fv(icon_projection, 1, GL_FALSE,
+                     glm::value_ptr(projection_matrix));
 }
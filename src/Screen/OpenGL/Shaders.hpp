@@ -61,6 +61,15 @@ namespace OpenGL {
   extern GLProgram *combine_texture_shader;
   extern GLint combine_texture_projection, combine_texture_texture;
 
+  /**
+   * A shader that copies the texture to a position transformed by
+   * the "modelview" matrix, plus a pixel offset
+   * (#Attribute::OFFSET) which is not transformed.  It draws many
+   * icons at map locations with one call.
+   */
+  extern GLProgram *icon_shader;
+  extern GLint icon_projection, icon_modelview, icon_texture;
+
   void InitShaders();
   void DeinitShaders();
 
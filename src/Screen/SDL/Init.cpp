@@ -32,6 +32,10 @@ Copyright_License {
 #include "Screen/OpenGL/Init.hpp"
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+#include "Screen/Memory/BandPool.hpp"
+#endif
+
 #include <SDL.h>
 #include <SDL_hints.h>
 
@@ -70,6 +74,10 @@ ScreenGlobalInit::ScreenGlobalInit()
   OpenGL::Initialise();
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+  BandPool::Initialise();
+#endif
+
 #ifdef USE_FREETYPE
   Font::Initialise();
 #endif
@@ -88,6 +96,10 @@ ScreenGlobalInit::~ScreenGlobalInit()
   OpenGL::Deinitialise();
 #endif
 
+#ifdef USE_MEMORY_CANVAS
+  BandPool::Deinitialise();
+#endif
+
 #ifdef USE_FREETYPE
   Font::Deinitialise();
 #endif
@@ -329,7 +329,7 @@ Startup()
   LoadConfiguredTopography(*topography, operation);
 
   // Read the waypoint files
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+  WaypointGlue::LoadWaypoints(way_points, terrain, file_cache, operation);
 
   // Read and parse the airfield info file
   WaypointDetails::ReadFileFromProfile(way_points, operation);
@@ -356,7 +356,7 @@ Startup()
   {
     const AircraftState aircraft_state =
       ToAircraftState(device_blackboard->Basic(),
-                      device_blackboard->Calculated());
+                      *device_blackboard->GetCalculatedSnapshot());
     ProtectedAirspaceWarningManager::ExclusiveLease lease(glide_computer->GetAirspaceWarnings());
     lease->Reset(aircraft_state);
   }
@@ -607,6 +607,20 @@ Shutdown()
 
   delete devices;
   devices = nullptr;
+
+  {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const auto stats = device_blackboard->mutex.GetStatistics();
+    LogFormat("DeviceBlackboard mutex: %lu locks, wait %lld/%lld us, hold %lld/%lld us (total/max)",
+              stats.n_locks,
+              (long long)duration_cast<microseconds>(stats.wait).count(),
+              (long long)duration_cast<microseconds>(stats.max_wait).count(),
+              (long long)duration_cast<microseconds>(stats.hold).count(),
+              (long long)duration_cast<microseconds>(stats.max_hold).count());
+  }
+
   delete device_blackboard;
   device_blackboard = nullptr;
 
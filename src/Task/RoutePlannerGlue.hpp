@@ -73,6 +73,10 @@ public:
     return planner.GetSolution();
   }
 
+  const RoutePlanner::SolveStats &GetSolveStats() const {
+    return planner.GetSolveStats();
+  }
+
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   int h_ceiling, bool do_solve);
 
@@ -0,0 +1,67 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_FUNCTION_THREAD_HPP
+#define XCSOAR_THREAD_FUNCTION_THREAD_HPP
+
+#include "Thread/Thread.hpp"
+
+#include <functional>
+
+/**
+ * A thread which runs one function and then exits.  It is used to
+ * split short-lived work (e.g. parsing a file) among processors.
+ */
+class FunctionThread final : public Thread {
+  const std::function<void()> function;
+
+public:
+  explicit FunctionThread(std::function<void()> &&_function,
+                          const char *_name=nullptr)
+    :Thread(_name), function(std::move(_function)) {}
+
+  /**
+   * Start the thread.  If that fails, the function is invoked
+   * synchronously in the calling thread.
+   */
+  void StartOrRun() {
+    if (!Start())
+      function();
+  }
+
+  /**
+   * Wait for the function to finish.  It is safe to call this after
+   * StartOrRun() has fallen back to synchronous execution.
+   */
+  void Wait() {
+    if (IsDefined())
+      Join();
+  }
+
+protected:
+  void Run() noexcept override {
+    function();
+  }
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_INSTRUMENTED_MUTEX_HPP
+#define XCSOAR_THREAD_INSTRUMENTED_MUTEX_HPP
+
+#include "Mutex.hxx"
+
+#include <chrono>
+
+/**
+ * A #Mutex which measures how long its callers wait for it and how
+ * long they hold it.  It can be used with std::lock_guard.
+ */
+class InstrumentedMutex {
+public:
+  typedef std::chrono::steady_clock::duration Duration;
+
+  struct Statistics {
+    unsigned long n_locks;
+
+    /** total and maximum time spent waiting in lock() */
+    Duration wait, max_wait;
+
+    /** total and maximum time between lock() and unlock() */
+    Duration hold, max_hold;
+  };
+
+private:
+  Mutex mutex;
+
+  /** protected by #mutex */
+  Statistics statistics{};
+
+  /** the time the current owner has obtained the lock */
+  std::chrono::steady_clock::time_point locked_since;
+
+public:
+  void lock() {
+    const auto start = std::chrono::steady_clock::now();
+    mutex.lock();
+    locked_since = std::chrono::steady_clock::now();
+
+    const auto wait = locked_since - start;
+    ++statistics.n_locks;
+    statistics.wait += wait;
+    if (wait > statistics.max_wait)
+      statistics.max_wait = wait;
+  }
+
+  bool try_lock() {
+    if (!mutex.try_lock())
+      return false;
+
+    locked_since = std::chrono::steady_clock::now();
+    ++statistics.n_locks;
+    return true;
+  }
+
+  void unlock() {
+    const auto hold = std::chrono::steady_clock::now() - locked_since;
+    statistics.hold += hold;
+    if (hold > statistics.max_hold)
+      statistics.max_hold = hold;
+
+    mutex.unlock();
+  }
+
+  /**
+   * Returns the statistics collected since construction.  The caller
+   * must not hold the lock.
+   */
+  Statistics GetStatistics() {
+    const std::lock_guard<Mutex> lock(mutex);
+    return statistics;
+  }
+};
+
+#endif
@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_SNAPSHOT_HPP
+#define XCSOAR_THREAD_SNAPSHOT_HPP
+
+#include "Mutex.hxx"
+
+#include <atomic>
+#include <memory>
+
+/**
+ * Publishes copies of a (large) value from one producer thread to
+ * any number of consumer threads.  Consumers obtain a reference to
+ * the latest immutable copy with Get() and may read it as long as
+ * they like; the producer never waits for them.
+ *
+ * The internal mutex protects only the pointer, it is never held
+ * while a value is being copied.  A copy which is no longer referenced
+ * by any consumer is recycled by the next Publish() call, so in the
+ * steady state no memory is allocated.
+ */
+template<typename T>
+class SnapshotPublisher {
+  mutable Mutex mutex;
+
+  /** the latest snapshot; protected by #mutex */
+  std::shared_ptr<T> current;
+
+  /**
+   * The previous snapshot, to be recycled.  Only accessed by the
+   * producer.
+   */
+  std::shared_ptr<T> spare;
+
+public:
+  /**
+   * The initial snapshot is a default-constructed value; call
+   * Publish() before the first Get() if that is not meaningful.
+   */
+  SnapshotPublisher()
+    :current(std::make_shared<T>()) {}
+
+  SnapshotPublisher(const SnapshotPublisher &) = delete;
+  SnapshotPublisher &operator=(const SnapshotPublisher &) = delete;
+
+  /**
+   * Publish a copy of the given value.  This may only be called by
+   * one thread at a time.
+   */
+  void Publish(const T &value) {
+    std::shared_ptr<T> p = std::move(spare);
+    if (p != nullptr && p.use_count() == 1) {
+      /* no consumer holds a reference anymore, and none can obtain a
+         new one; make sure their reads are complete before
+         overwriting */
+      std::atomic_thread_fence(std::memory_order_acquire);
+      *p = value;
+    } else
+      p = std::make_shared<T>(value);
+
+    {
+      const std::lock_guard<Mutex> lock(mutex);
+      current.swap(p);
+    }
+
+    spare = std::move(p);
+  }
+
+  /**
+   * Obtain the latest snapshot.  It remains valid and unmodified as
+   * long as the caller holds the returned reference.
+   */
+  std::shared_ptr<const T> Get() const {
+    const std::lock_guard<Mutex> lock(mutex);
+    return current;
+  }
+};
+
+#endif
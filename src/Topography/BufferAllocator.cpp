@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "BufferAllocator.hpp"
+
+#include <cassert>
+
+void
+BufferAllocator::Reset(unsigned _capacity)
+{
+  capacity = _capacity;
+  used = 0;
+
+  free_ranges.clear();
+  if (capacity > 0)
+    free_ranges.emplace(0, capacity);
+}
+
+unsigned
+BufferAllocator::Allocate(unsigned size)
+{
+  assert(size > 0);
+
+  for (auto i = free_ranges.begin(); i != free_ranges.end(); ++i) {
+    if (i->second < size)
+      continue;
+
+    const unsigned offset = i->first;
+    const unsigned remaining = i->second - size;
+    free_ranges.erase(i);
+    if (remaining > 0)
+      free_ranges.emplace(offset + size, remaining);
+
+    used += size;
+    return offset;
+  }
+
+  return NONE;
+}
+
+void
+BufferAllocator::Free(unsigned offset, unsigned size)
+{
+  assert(size > 0);
+  assert(offset + size <= capacity);
+  assert(used >= size);
+
+  used -= size;
+
+  auto next = free_ranges.lower_bound(offset);
+  assert(next == free_ranges.end() || next->first >= offset + size);
+
+  /* merge with the following range */
+  if (next != free_ranges.end() && next->first == offset + size) {
+    size += next->second;
+    next = free_ranges.erase(next);
+  }
+
+  /* merge with the preceding range */
+  if (next != free_ranges.begin()) {
+    auto previous = std::prev(next);
+    assert(previous->first + previous->second <= offset);
+
+    if (previous->first + previous->second == offset) {
+      previous->second += size;
+      return;
+    }
+  }
+
+  free_ranges.emplace_hint(next, offset, size);
+}
@@ -0,0 +1,78 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_BUFFER_ALLOCATOR_HPP
+#define XCSOAR_TOPOGRAPHY_BUFFER_ALLOCATOR_HPP
+
+#include "Util/Compiler.h"
+
+#include <map>
+
+/**
+ * Manages the ranges of a fixed-size buffer (e.g. an OpenGL vertex
+ * buffer object), so shapes can be added and removed without
+ * uploading the whole buffer again.  All sizes are in elements, not
+ * bytes.
+ *
+ * This is a first-fit allocator; adjacent free ranges are merged.
+ */
+class BufferAllocator {
+  unsigned capacity = 0, used = 0;
+
+  /**
+   * The free ranges: offset to size.
+   */
+  std::map<unsigned, unsigned> free_ranges;
+
+public:
+  static constexpr unsigned NONE = ~0u;
+
+  unsigned GetCapacity() const {
+    return capacity;
+  }
+
+  /**
+   * Returns the number of allocated elements.
+   */
+  unsigned GetUsed() const {
+    return used;
+  }
+
+  /**
+   * Discard all allocations and change the capacity.
+   */
+  void Reset(unsigned _capacity);
+
+  /**
+   * @return the offset of the new range or #NONE if there is no free
+   * range which is large enough
+   */
+  unsigned Allocate(unsigned size);
+
+  /**
+   * Free a range which was returned by Allocate().
+   */
+  void Free(unsigned offset, unsigned size);
+};
+
+#endif
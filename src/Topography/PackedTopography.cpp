@@ -0,0 +1,192 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/PackedTopography.hpp"
+#include "OS/ByteOrder.hpp"
+#include "OS/Path.hpp"
+#include "Util/StringAPI.hxx"
+#include "shapelib/mapserver.h"
+
+#include <stdexcept>
+
+#include <string.h>
+
+const char PackedTopography::MAGIC[8] = {
+  'X', 'C', 'S', 'T', 'O', 'P', 'O', '1',
+};
+
+GeoBounds
+PackedTopography::Layer::ToGeoBounds(const Bounds &bounds) const
+{
+  const GeoPoint center = GetCenter();
+  return GeoBounds(GeoPoint(center.longitude + Angle::Radians(bounds.west),
+                            center.latitude + Angle::Radians(bounds.north)),
+                   GeoPoint(center.longitude + Angle::Radians(bounds.east),
+                            center.latitude + Angle::Radians(bounds.south)));
+}
+
+PackedTopography::Bounds
+PackedTopography::Layer::ToBounds(const GeoBounds &bounds) const
+{
+  const GeoPoint center = GetCenter();
+
+  Bounds result;
+  result.west = (bounds.GetWest() - center.longitude).Radians();
+  result.south = (bounds.GetSouth() - center.latitude).Radians();
+  result.east = (bounds.GetEast() - center.longitude).Radians();
+  result.north = (bounds.GetNorth() - center.latitude).Radians();
+  return result;
+}
+
+/**
+ * Check whether the given section fits into the mapping and return a
+ * pointer to it.
+ */
+template<typename T>
+static const T *
+GetSection(const FileMapping &mapping, uint32_t offset, uint32_t n)
+{
+  if (offset % alignof(T) != 0 || offset > mapping.size() ||
+      n > (mapping.size() - offset) / sizeof(T))
+    throw std::runtime_error("Malformed topography file");
+
+  return (const T *)mapping.at(offset);
+}
+
+static void
+CheckLayer(const PackedTopography::LayerHeader &header)
+{
+  if (memchr(header.name, 0, sizeof(header.name)) == nullptr)
+    throw std::runtime_error("Malformed topography file");
+}
+
+/**
+ * Returns the number of uint16_t values occupied by an index array
+ * (the counts followed by the indices), or 0 if it does not fit into
+ * the given buffer.
+ */
+static uint32_t
+GetIndexArraySize(const PackedTopography::ShapeRecord &shape,
+                  const uint16_t *p, uint32_t available)
+{
+  if (shape.type == MS_SHAPE_POLYGON) {
+    if (available < 1 || p[0] > available - 1)
+      return 0;
+
+    return 1 + p[0];
+  } else {
+    if (shape.num_lines > available)
+      return 0;
+
+    uint32_t size = shape.num_lines;
+    for (unsigned i = 0; i < shape.num_lines; ++i)
+      size += p[i];
+
+    return size <= available ? size : 0;
+  }
+}
+
+static void
+CheckShape(const PackedTopography::LayerHeader &header,
+           const uint16_t *lines, const uint16_t *indices,
+           const PackedTopography::ShapeRecord &shape)
+{
+  if (shape.type > MS_SHAPE_POLYGON ||
+      shape.first_line > header.n_lines ||
+      shape.num_lines > header.n_lines - shape.first_line ||
+      shape.first_point > header.n_points ||
+      (shape.label != PackedTopography::NONE &&
+       shape.label >= header.labels_size))
+    throw std::runtime_error("Malformed topography file");
+
+  uint32_t n_points = 0;
+  for (unsigned i = 0; i < shape.num_lines; ++i)
+    n_points += lines[shape.first_line + i];
+
+  if (n_points > header.n_points - shape.first_point)
+    throw std::runtime_error("Malformed topography file");
+
+  for (auto i : shape.indices)
+    if (i != PackedTopography::NONE &&
+        (i >= header.n_indices ||
+         GetIndexArraySize(shape, indices + i, header.n_indices - i) == 0))
+      throw std::runtime_error("Malformed topography file");
+}
+
+PackedTopography::PackedTopography(Path path)
+  :mapping(path)
+{
+  if (mapping.error())
+    throw std::runtime_error("Failed to map topography file");
+
+  if (IsBigEndian())
+    throw std::runtime_error("Topography file not supported on this CPU");
+
+  const Header &header = *GetSection<Header>(mapping, 0, 1);
+  if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION)
+    throw std::runtime_error("Not a topography file");
+
+  const LayerHeader *layer_headers =
+    GetSection<LayerHeader>(mapping, sizeof(header), header.n_layers);
+
+  layers.reserve(header.n_layers);
+  for (unsigned i = 0; i < header.n_layers; ++i) {
+    const LayerHeader &lh = layer_headers[i];
+    CheckLayer(lh);
+
+    Layer layer;
+    layer.header = &lh;
+    layer.shapes = GetSection<ShapeRecord>(mapping, lh.shapes_offset,
+                                           lh.n_shapes);
+    layer.buckets = GetSection<Bounds>(mapping, lh.buckets_offset,
+                                       GetBucketCount(lh.n_shapes));
+    layer.lines = GetSection<uint16_t>(mapping, lh.lines_offset,
+                                       lh.n_lines);
+    layer.points = GetSection<ShapePoint>(mapping, lh.points_offset,
+                                          lh.n_points);
+    layer.indices = GetSection<uint16_t>(mapping, lh.indices_offset,
+                                         lh.n_indices);
+    layer.labels = GetSection<char>(mapping, lh.labels_offset,
+                                    lh.labels_size);
+
+    /* the labels must be null-terminated */
+    if (lh.labels_size > 0 && layer.labels[lh.labels_size - 1] != 0)
+      throw std::runtime_error("Malformed topography file");
+
+    for (unsigned j = 0; j < lh.n_shapes; ++j)
+      CheckShape(lh, layer.lines, layer.indices, layer.shapes[j]);
+
+    layers.push_back(layer);
+  }
+}
+
+const PackedTopography::Layer *
+PackedTopography::Find(const char *name) const
+{
+  for (const auto &i : layers)
+    if (StringIsEqual(i.GetName(), name))
+      return &i;
+
+  return nullptr;
+}
@@ -0,0 +1,297 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef TOPOGRAPHY_PACKED_TOPOGRAPHY_HPP
+#define TOPOGRAPHY_PACKED_TOPOGRAPHY_HPP
+
+#include "Topography/XShapePoint.hpp"
+#include "OS/FileMapping.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Util/ConstBuffer.hxx"
+#include "Util/Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdint.h>
+
+class Path;
+
+/**
+ * A preprocessed topography container, created from the shapefiles
+ * of a map file by the "PackTopography" program and mapped into
+ * memory at runtime.  It is stored next to the map file, with the
+ * extension ".xct".
+ *
+ * For each shapefile (a "layer"), it contains the points of all
+ * shapes in #ShapePoint format (relative to the layer center), the
+ * index arrays of all thinning levels (see XShape::GetIndices()), the
+ * labels and a packed spatial index: the shapes are sorted along a
+ * Z-order curve and grouped into buckets of #BUCKET_SIZE shapes, each
+ * with the union of their bounds.
+ *
+ * The display attributes (colours, thresholds) are still read from
+ * "topology.tpl" in the map file.
+ *
+ * All values are in the little-endian byte order of the target CPUs;
+ * the file is rejected on big-endian hosts.
+ */
+class PackedTopography {
+public:
+  static constexpr uint32_t VERSION = 1;
+
+  static constexpr unsigned THINNING_LEVELS = 4;
+
+  static constexpr unsigned BUCKET_SIZE = 32;
+
+  /**
+   * Marks a missing label or index array.
+   */
+  static constexpr uint32_t NONE = 0xffffffff;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t n_layers;
+  };
+
+  /**
+   * A rectangle relative to the layer center [radians].
+   */
+  struct Bounds {
+    float west, south, east, north;
+
+    bool Overlaps(const Bounds &other) const {
+      return west <= other.east && east >= other.west &&
+        south <= other.north && north >= other.south;
+    }
+  };
+
+  struct LayerHeader {
+    /**
+     * The shapefile name without directory and extension,
+     * null-terminated.
+     */
+    char name[32];
+
+    /**
+     * The center of the shapefile bounds [radians].  All points and
+     * bounds are relative to it.
+     */
+    double center_longitude, center_latitude;
+
+    /**
+     * The minimum point distance (in #ShapePoint units) which was
+     * used to build the index arrays of each thinning level.  They
+     * are only used if the renderer asks for the same distance.
+     */
+    float min_distance[THINNING_LEVELS];
+
+    uint32_t n_shapes, n_lines, n_points, n_indices, labels_size;
+
+    /**
+     * File offsets of the #ShapeRecord array, the #Bounds array of
+     * the buckets, the uint16_t line lengths, the #ShapePoint array,
+     * the uint16_t index arrays and the null-terminated UTF-8
+     * labels.
+     */
+    uint32_t shapes_offset, buckets_offset, lines_offset,
+      points_offset, indices_offset, labels_offset;
+
+    uint32_t reserved;
+  };
+
+  struct ShapeRecord {
+    Bounds bounds;
+
+    /**
+     * The #MS_SHAPE_TYPE.
+     */
+    uint8_t type;
+
+    uint8_t num_lines;
+
+    uint16_t reserved;
+
+    /**
+     * Index of the first line length in the layer's line array.
+     */
+    uint32_t first_line;
+
+    /**
+     * Index of the first point in the layer's point array.
+     */
+    uint32_t first_point;
+
+    /**
+     * Offset in the layer's label buffer or #NONE.
+     */
+    uint32_t label;
+
+    /**
+     * For each thinning level: offset of the index array in the
+     * layer's index buffer (in the layout returned by
+     * XShape::GetIndices(), i.e. the counts followed by the indices)
+     * or #NONE.
+     */
+    uint32_t indices[THINNING_LEVELS];
+  };
+
+  static_assert(sizeof(Header) == 16, "Wrong size");
+  static_assert(sizeof(Bounds) == 16, "Wrong size");
+  static_assert(sizeof(LayerHeader) == 112, "Wrong size");
+  static_assert(sizeof(ShapeRecord) == 48, "Wrong size");
+  static_assert(sizeof(ShapePoint) == 8, "Wrong size");
+
+  static const char MAGIC[8];
+
+  /**
+   * One layer of a mapped file.  All pointers refer to the file
+   * mapping.
+   */
+  class Layer {
+    friend class PackedTopography;
+
+    const LayerHeader *header;
+
+    const ShapeRecord *shapes;
+    const Bounds *buckets;
+    const uint16_t *lines;
+    const ShapePoint *points;
+    const uint16_t *indices;
+    const char *labels;
+
+  public:
+    const char *GetName() const {
+      return header->name;
+    }
+
+    gcc_pure
+    GeoPoint GetCenter() const {
+      return GeoPoint(Angle::Radians(header->center_longitude),
+                      Angle::Radians(header->center_latitude));
+    }
+
+    /**
+     * Returns the minimum point distances which were used to build
+     * the index arrays, one for each thinning level.
+     */
+    const float *GetMinimumPointDistances() const {
+      return header->min_distance;
+    }
+
+    unsigned size() const {
+      return header->n_shapes;
+    }
+
+    const ShapeRecord &GetShape(unsigned i) const {
+      return shapes[i];
+    }
+
+    ConstBuffer<uint16_t> GetLines(const ShapeRecord &shape) const {
+      return { lines + shape.first_line, shape.num_lines };
+    }
+
+    const ShapePoint *GetPoints(const ShapeRecord &shape) const {
+      return points + shape.first_point;
+    }
+
+    /**
+     * @return the index array of the given thinning level or nullptr
+     */
+    const uint16_t *GetIndices(const ShapeRecord &shape,
+                               unsigned level) const {
+      return shape.indices[level] != NONE
+        ? indices + shape.indices[level]
+        : nullptr;
+    }
+
+    /**
+     * @return the UTF-8 label or nullptr
+     */
+    const char *GetLabel(const ShapeRecord &shape) const {
+      return shape.label != NONE
+        ? labels + shape.label
+        : nullptr;
+    }
+
+    gcc_pure
+    GeoBounds ToGeoBounds(const Bounds &bounds) const;
+
+    gcc_pure
+    Bounds ToBounds(const GeoBounds &bounds) const;
+
+    /**
+     * Invoke the given function with the index of each shape whose
+     * bounds overlap the given rectangle.
+     */
+    template<typename F>
+    void VisitShapes(const GeoBounds &_bounds, F &&f) const {
+      const Bounds bounds = ToBounds(_bounds);
+
+      const unsigned n_shapes = size();
+      for (unsigned b = 0, i = 0; i < n_shapes; ++b, i += BUCKET_SIZE) {
+        if (!buckets[b].Overlaps(bounds))
+          continue;
+
+        const unsigned end = std::min(i + BUCKET_SIZE, n_shapes);
+        for (unsigned j = i; j < end; ++j)
+          if (shapes[j].bounds.Overlaps(bounds))
+            f(j);
+      }
+    }
+  };
+
+private:
+  FileMapping mapping;
+
+  std::vector<Layer> layers;
+
+public:
+  /**
+   * Map the given file and check its structure.
+   *
+   * Throws std::runtime_error on error.
+   */
+  explicit PackedTopography(Path path);
+
+  PackedTopography(const PackedTopography &) = delete;
+  PackedTopography &operator=(const PackedTopography &) = delete;
+
+  /**
+   * Look up a layer by its shapefile name.
+   *
+   * @return the layer or nullptr if there is no such layer
+   */
+  gcc_pure
+  const Layer *Find(const char *name) const;
+
+  /**
+   * Returns the number of buckets for the given number of shapes.
+   */
+  static constexpr unsigned GetBucketCount(unsigned n_shapes) {
+    return (n_shapes + BUCKET_SIZE - 1) / BUCKET_SIZE;
+  }
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Prefetch.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/FAISphere.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+void
+TopographyPrefetch::UpdateZoom(double time, double map_scale)
+{
+  if (map_scale <= 0)
+    return;
+
+  if (last_time >= 0 && time >= last_time) {
+    const double max_trend = log(MAX_ZOOM_FACTOR);
+
+    zoom_trend *= exp((last_time - time) / ZOOM_TREND_TAU);
+    zoom_trend += log(map_scale / last_scale);
+    zoom_trend = std::max(std::min(zoom_trend, max_trend), -max_trend);
+  } else
+    /* first call or the clock went backwards */
+    zoom_trend = 0;
+
+  last_time = time;
+  last_scale = map_scale;
+}
+
+double
+TopographyPrefetch::GetZoomFactor() const
+{
+  return fabs(zoom_trend) >= log(MIN_ZOOM_FACTOR)
+    ? exp(zoom_trend)
+    : 1.;
+}
+
+TopographyPrefetch::Area
+TopographyPrefetch::Predict(const GeoBounds &screen, double map_scale,
+                            const SpeedVector &motion) const
+{
+  if (!screen.IsValid())
+    return Area::Undefined();
+
+  const double zoom_factor = GetZoomFactor();
+  double distance = motion.norm * LOOKAHEAD;
+  if (zoom_factor == 1 && distance <= 0)
+    return Area::Undefined();
+
+  Area area;
+  area.bounds = screen.Scale(zoom_factor);
+  area.map_scale = map_scale * zoom_factor;
+
+  if (distance > 0) {
+    /* never look further ahead than one screen height; at close zoom
+       levels, the screen would be moved further before the aircraft
+       gets there */
+    const Angle height = area.bounds.GetHeight();
+    distance = std::min(distance, FAISphere::AngleToEarthDistance(height));
+
+    const Angle latitude = area.bounds.GetCenter().latitude;
+    const auto sc = motion.bearing.SinCos();
+    const Angle dlat = FAISphere::EarthDistanceToAngle(distance * sc.second);
+    const Angle dlon = FAISphere::EarthDistanceToAngle(distance * sc.first)
+      / std::max(latitude.cos(), 0.01);
+
+    area.bounds = GeoBounds(GeoPoint(area.bounds.GetWest() + dlon,
+                                     area.bounds.GetNorth() + dlat),
+                            GeoPoint(area.bounds.GetEast() + dlon,
+                                     area.bounds.GetSouth() + dlat));
+  }
+
+  return area;
+}
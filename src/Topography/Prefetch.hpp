@@ -0,0 +1,131 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_PREFETCH_HPP
+#define XCSOAR_TOPOGRAPHY_PREFETCH_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "Util/Compiler.h"
+
+struct SpeedVector;
+
+/**
+ * Predicts which area the map will show in the near future, based on
+ * the aircraft's ground track and speed and on the zoom trend, so
+ * #TopographyThread can load the shapes before they become visible.
+ */
+class TopographyPrefetch {
+public:
+  /**
+   * How far ahead [s] the aircraft's motion is extrapolated.
+   */
+  static constexpr double LOOKAHEAD = 60;
+
+  /**
+   * The time constant [s] of the zoom trend decay.
+   */
+  static constexpr double ZOOM_TREND_TAU = 10;
+
+  /**
+   * The maximum zoom factor (in both directions) which is predicted.
+   */
+  static constexpr double MAX_ZOOM_FACTOR = 4;
+
+  /**
+   * Zoom trends below this factor are ignored.
+   */
+  static constexpr double MIN_ZOOM_FACTOR = 1.1;
+
+  struct Area {
+    /**
+     * The predicted screen bounds; invalid if nothing needs to be
+     * prefetched.
+     */
+    GeoBounds bounds;
+
+    /**
+     * The predicted map scale.
+     */
+    double map_scale;
+
+    bool IsDefined() const {
+      return bounds.IsValid();
+    }
+
+    static Area Undefined() {
+      return Area{GeoBounds::Invalid(), 0};
+    }
+  };
+
+private:
+  /**
+   * The time stamp of the last UpdateZoom() call; negative if there
+   * was none yet.
+   */
+  double last_time;
+
+  double last_scale;
+
+  /**
+   * The natural logarithm of the recent zoom factor, decaying with
+   * #ZOOM_TREND_TAU.  Positive when zooming out.
+   */
+  double zoom_trend;
+
+public:
+  TopographyPrefetch() {
+    Reset();
+  }
+
+  void Reset() {
+    last_time = -1;
+    zoom_trend = 0;
+  }
+
+  /**
+   * Feed the current map scale into the zoom trend.
+   *
+   * @param time a monotonic time stamp [s]
+   */
+  void UpdateZoom(double time, double map_scale);
+
+  /**
+   * Returns the predicted zoom factor (greater than 1 when zooming
+   * out).
+   */
+  gcc_pure
+  double GetZoomFactor() const;
+
+  /**
+   * Predict the area which will be visible soon.
+   *
+   * @param screen the current screen bounds
+   * @param motion the aircraft's ground speed vector; zero if the
+   * map does not follow the aircraft
+   */
+  gcc_pure
+  Area Predict(const GeoBounds &screen, double map_scale,
+               const SpeedVector &motion) const;
+};
+
+#endif
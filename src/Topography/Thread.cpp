@@ -23,41 +23,101 @@ Copyright_License {
 
 #include "Thread.hpp"
 #include "TopographyStore.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "OS/Clock.hpp"
+
+/**
+ * The minimum time between two evaluations of the predicted area.
+ * This limits the rate of prefetch loads while the prediction moves
+ * along with the aircraft.
+ */
+static constexpr std::chrono::seconds PREFETCH_INTERVAL(1);
+
+/**
+ * The predicted area is enlarged by this factor before it is
+ * submitted, so the next few predictions are still inside.
+ */
+static constexpr double PREFETCH_MARGIN = 1.5;
 
 TopographyThread::TopographyThread(TopographyStore &_store,
                                    std::function<void()> &&_callback)
   :StandbyThread("Topography"),
    store(_store),
    callback(std::move(_callback)),
-   last_bounds(GeoBounds::Invalid()) {}
+   next_prefetch(TopographyPrefetch::Area::Undefined()),
+   last_bounds(GeoBounds::Invalid()),
+   last_prefetch(TopographyPrefetch::Area::Undefined()) {}
 
 TopographyThread::~TopographyThread()
 {
 }
 
+bool
+TopographyThread::UpdatePrefetch(const GeoBounds &screen, double map_scale,
+                                 const SpeedVector &motion)
+{
+  TopographyPrefetch::Area area = prefetch.Predict(screen, map_scale, motion);
+  if (!area.IsDefined()) {
+    if (!last_prefetch.IsDefined())
+      return false;
+
+    /* cancel the prefetch */
+    last_prefetch = area;
+    return true;
+  }
+
+  if (last_prefetch.IsDefined() &&
+      last_prefetch.bounds.IsInside(area.bounds) &&
+      (prefetch_threshold < 0 || area.map_scale >= prefetch_threshold))
+    /* the predicted area is still covered */
+    return false;
+
+  area.bounds = area.bounds.Scale(PREFETCH_MARGIN);
+  last_prefetch = area;
+  prefetch_threshold = store.GetNextScaleThreshold(area.map_scale);
+  return true;
+}
+
 void
-TopographyThread::Trigger(const WindowProjection &_projection)
+TopographyThread::Trigger(const WindowProjection &_projection,
+                          const SpeedVector &motion)
 {
   assert(_projection.IsValid());
 
   const GeoBounds new_bounds = _projection.GetScreenBounds();
+  const double map_scale = _projection.GetMapScale();
+
+  prefetch.UpdateZoom(MonotonicClockFloat(), map_scale);
+
+  bool update = true;
   if (last_bounds.IsValid() && last_bounds.IsInside(new_bounds)) {
     /* still inside cache bounds - now check if we crossed a scale
        threshold for at least one file, which would mean we have to
        update a file which was not updated for the current cache
        bounds */
-    if (scale_threshold < 0 ||
-        _projection.GetMapScale() >= scale_threshold)
+    if (scale_threshold < 0 || map_scale >= scale_threshold)
       /* the cache is still fresh */
-      return;
+      update = false;
   }
 
-  last_bounds = new_bounds.Scale(1.1);
-  scale_threshold = store.GetNextScaleThreshold(_projection.GetMapScale());
+  if (update) {
+    last_bounds = new_bounds.Scale(1.1);
+    scale_threshold = store.GetNextScaleThreshold(map_scale);
+  }
+
+  /* a visible update re-evaluates the prediction immediately, to
+     follow zoom changes without delay */
+  if ((update || prefetch_clock.CheckUpdate(PREFETCH_INTERVAL)) &&
+      UpdatePrefetch(new_bounds, map_scale, motion))
+    update = true;
+
+  if (!update)
+    return;
 
   {
     const std::lock_guard<Mutex> lock(mutex);
     next_projection = _projection;
+    next_prefetch = last_prefetch;
     StandbyThread::Trigger();
   }
 }
@@ -68,12 +128,16 @@ TopographyThread::Tick() noexcept
   // TODO: call only once
   SetIdlePriority();
 
+  /* one file per iteration; a new Trigger() call replaces (or
+     cancels) the prefetch area before the next one */
   bool again = true;
   while (next_projection.IsValid() && again && !IsStopped()) {
     const WindowProjection projection = next_projection;
+    const TopographyPrefetch::Area area = next_prefetch;
 
     const ScopeUnlock unlock(mutex);
-    again = store.ScanVisibility(projection, 1) > 0;
+    again = store.ScanVisibility(projection, area.bounds, area.map_scale,
+                                 1) > 0;
   }
 
   /* notify the client that we have updated the topography cache */
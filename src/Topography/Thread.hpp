@@ -27,13 +27,20 @@ Copyright_License {
 #include "Thread/StandbyThread.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Geo/GeoBounds.hpp"
+#include "Prefetch.hpp"
+#include "Time/PeriodClock.hpp"
 
 #include <functional>
 
 class TopographyStore;
+struct SpeedVector;
 
 /**
  * A thread that loads topography files asynchronously.
+ *
+ * After the visible area has been loaded, it loads the area which is
+ * predicted by #TopographyPrefetch, so the shapes are already in
+ * memory when the aircraft gets there or when the user zooms.
  */
 class TopographyThread final : private StandbyThread {
   TopographyStore &store;
@@ -42,18 +49,52 @@ class TopographyThread final : private StandbyThread {
 
   WindowProjection next_projection;
 
+  /**
+   * The area to be prefetched by the thread; undefined if there is
+   * nothing to prefetch.  Protected by the mutex.
+   */
+  TopographyPrefetch::Area next_prefetch;
+
   GeoBounds last_bounds;
   double scale_threshold;
 
+  TopographyPrefetch prefetch;
+
+  /**
+   * Limits how often the predicted area is evaluated.
+   */
+  PeriodClock prefetch_clock;
+
+  /**
+   * The area which was last submitted for prefetching (enlarged, so
+   * small changes of the prediction don't trigger a reload).
+   */
+  TopographyPrefetch::Area last_prefetch;
+  double prefetch_threshold;
+
 public:
   TopographyThread(TopographyStore &_store, std::function<void()> &&_callback);
   ~TopographyThread();
 
   using StandbyThread::LockStop;
 
-  void Trigger(const WindowProjection &_projection);
+  /**
+   * @param motion the aircraft's ground speed vector used to predict
+   * the area to be prefetched; zero if the map does not follow the
+   * aircraft
+   */
+  void Trigger(const WindowProjection &_projection,
+               const SpeedVector &motion);
 
 private:
+  /**
+   * Update #last_prefetch from the current prediction.
+   *
+   * @return true if the prefetch area has changed
+   */
+  bool UpdatePrefetch(const GeoBounds &screen, double map_scale,
+                      const SpeedVector &motion);
+
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
 };
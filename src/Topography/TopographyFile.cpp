@@ -25,11 +25,33 @@ Copyright_License {
 #include "Topography/XShape.hpp"
 #include "Convert.hpp"
 #include "Projection/WindowProjection.hpp"
+#include "Compatibility/path.h"
 
 #include <zzip/lib.h>
 
 #include <algorithm>
 
+#include <string.h>
+
+/**
+ * Extract the shapefile name without directory and extension.
+ */
+static void
+CopyBaseName(NarrowString<32> &dest, const char *path)
+{
+  const char *slash = strrchr(path, DIR_SEPARATOR);
+  if (slash != nullptr)
+    path = slash + 1;
+
+  /* ZIP archives always use the slash */
+  slash = strrchr(path, '/');
+  if (slash != nullptr)
+    path = slash + 1;
+
+  const char *dot = strrchr(path, '.');
+  dest.SetASCII(path, dot != nullptr ? dot : path + strlen(path));
+}
+
 TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                double _threshold,
                                double _label_threshold,
@@ -38,7 +60,7 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                int _label_field,
                                ResourceId _icon, ResourceId _big_icon,
                                unsigned _pen_width)
-  :dir(_dir), first(nullptr),
+  :dir(_dir), packed(nullptr), first(nullptr),
    label_field(_label_field), icon(_icon), big_icon(_big_icon),
    pen_width(_pen_width),
    color(_color), scale_threshold(_threshold),
@@ -46,6 +68,8 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
    important_label_threshold(_important_label_threshold),
    cache_bounds(GeoBounds::Invalid())
 {
+  CopyBaseName(name, filename);
+
   if (msShapefileOpen(&file, "rb", dir, filename, 0) == -1)
     return;
 
@@ -72,12 +96,44 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
   ++serial;
 }
 
+TopographyFile::TopographyFile(const PackedTopography::Layer &layer,
+                               double _threshold,
+                               double _label_threshold,
+                               double _important_label_threshold,
+                               const Color _color,
+                               ResourceId _icon, ResourceId _big_icon,
+                               unsigned _pen_width)
+  :name(layer.GetName()),
+   dir(nullptr), packed(&layer),
+   center(layer.GetCenter()),
+   first(nullptr),
+   label_field(-1), icon(_icon), big_icon(_big_icon),
+   pen_width(_pen_width),
+   color(_color), scale_threshold(_threshold),
+   label_threshold(_label_threshold),
+   important_label_threshold(_important_label_threshold),
+   cache_bounds(GeoBounds::Invalid())
+{
+  if (layer.size() == 0)
+    return;
+
+  shapes.ResizeDiscard(layer.size());
+  std::fill(shapes.begin(), shapes.end(), ShapeList(nullptr));
+  packed_status.ResizeDiscard(layer.size());
+
+  ++serial;
+}
+
 TopographyFile::~TopographyFile()
 {
   if (IsEmpty())
     return;
 
   ClearCache();
+
+  if (packed != nullptr)
+    return;
+
   msShapefileClose(&file);
 
   if (dir != nullptr) {
@@ -97,30 +153,59 @@ TopographyFile::ClearCache()
   first = nullptr;
 }
 
-static XShape *
-LoadShape(shapefileObj *file, const GeoPoint &center, int i,
-          int label_field)
+XShape *
+TopographyFile::LoadShape(unsigned i)
 {
-  return new XShape(file, center, i, label_field);
+  if (packed != nullptr)
+    return new XShape(*packed, i);
+
+  return new XShape(&file, center, i, label_field);
 }
 
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::Update(const WindowProjection &map_projection,
+                       const GeoBounds &prefetch_bounds,
+                       double prefetch_scale)
 {
   if (IsEmpty())
     return false;
 
-  if (map_projection.GetMapScale() > scale_threshold)
+  const bool visible = IsVisible(map_projection.GetMapScale());
+  const bool prefetch = prefetch_bounds.IsValid() &&
+    IsVisible(prefetch_scale);
+  if (!visible && !prefetch)
     /* not visible, don't update cache now */
     return false;
 
   const GeoBounds screenRect =
     map_projection.GetScreenBounds();
-  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect))
+  if (cache_bounds.IsValid() &&
+      (!visible || cache_bounds.IsInside(screenRect)) &&
+      (!prefetch || cache_bounds.IsInside(prefetch_bounds)))
     /* the cache is still fresh */
     return false;
 
-  cache_bounds = screenRect.Scale(2);
+  if (visible) {
+    cache_bounds = screenRect.Scale(2);
+
+    if (prefetch) {
+      cache_bounds.Extend(prefetch_bounds.GetNorthWest());
+      cache_bounds.Extend(prefetch_bounds.GetSouthEast());
+    }
+  } else
+    cache_bounds = prefetch_bounds;
+
+  if (packed != nullptr) {
+    std::fill(packed_status.begin(), packed_status.end(), false);
+    packed->VisitShapes(cache_bounds, [this](unsigned i){
+        packed_status[i] = true;
+      });
+
+    UpdateCache([this](unsigned i){
+        return packed_status[i];
+      });
+    return true;
+  }
 
   rectObj deg_bounds = ConvertRect(cache_bounds);
 
@@ -141,11 +226,21 @@ TopographyFile::Update(const WindowProjection &map_projection)
 
   assert(file.status != nullptr);
 
+  UpdateCache([this](unsigned i){
+      return msGetBit(file.status, i);
+    });
+  return true;
+}
+
+template<typename P>
+void
+TopographyFile::UpdateCache(P is_inside)
+{
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
   auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
-    if (!msGetBit(file.status, i)) {
+  for (unsigned i = 0; i < shapes.size(); ++i, ++it) {
+    if (!is_inside(i)) {
       // If the shape is outside the bounds
       // delete the shape from the cache
       if (it->shape != nullptr) {
@@ -169,7 +264,7 @@ TopographyFile::Update(const WindowProjection &map_projection)
         assert(*current != it);
 
         // shape isn't cached yet -> cache the shape
-        it->shape = LoadShape(&file, center, i, label_field);
+        it->shape = LoadShape(i);
         it->next = *current;
 
         /* insert into linked list (protected) */
@@ -185,8 +280,6 @@ TopographyFile::Update(const WindowProjection &map_projection)
   }
   // end of list marker
   assert(*current == nullptr);
-
-  return true;
 }
 
 void
@@ -195,10 +288,10 @@ TopographyFile::LoadAll()
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
   auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
+  for (unsigned i = 0; i < shapes.size(); ++i, ++it) {
     if (it->shape == nullptr)
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(&file, center, i, label_field);
+      it->shape = LoadShape(i);
     // update list pointer
     *current = it;
     current = &it->next;
@@ -26,8 +26,10 @@ Copyright_License {
 #define TOPOGRAPHY_HPP
 
 #include "shapelib/mapserver.h"
+#include "Topography/PackedTopography.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Util/AllocatedArray.hxx"
+#include "Util/StaticString.hxx"
 #include "Util/Serial.hpp"
 #include "Screen/Color.hpp"
 #include "ResourceId.hpp"
@@ -58,10 +60,27 @@ class TopographyFile {
    */
   Serial serial;
 
+  /**
+   * The shapefile name without directory and extension.
+   */
+  NarrowString<32> name;
+
   zzip_dir *const dir;
 
+  /**
+   * If not nullptr, then the shapes are loaded from this
+   * #PackedTopography layer instead of #file.
+   */
+  const PackedTopography::Layer *const packed;
+
   shapefileObj file;
 
+  /**
+   * The result of the last PackedTopography::Layer::VisitShapes()
+   * call, indexed like #shapes.
+   */
+  AllocatedArray<bool> packed_status;
+
   /**
    * The center of shapefileObj::bounds.
    */
@@ -171,6 +190,19 @@ public:
                  ResourceId big_icon=ResourceId::Null(),
                  unsigned pen_width=1);
 
+  /**
+   * Load the shapes from a #PackedTopography layer, which must
+   * outlive this object.  The other parameters are the same as
+   * above; the labels were picked by the converter.
+   */
+  TopographyFile(const PackedTopography::Layer &layer,
+                 double threshold, double label_threshold,
+                 double important_label_threshold,
+                 const Color color,
+                 ResourceId icon=ResourceId::Null(),
+                 ResourceId big_icon=ResourceId::Null(),
+                 unsigned pen_width=1);
+
   TopographyFile(const TopographyFile &) = delete;
 
   /**
@@ -182,6 +214,10 @@ public:
     return serial;
   }
 
+  const char *GetName() const {
+    return name;
+  }
+
   const GeoPoint &GetCenter() const {
     return center;
   }
@@ -190,6 +226,25 @@ public:
     return shapes.empty();
   }
 
+  /**
+   * Returns the number of shapes in the file (loaded or not).
+   */
+  unsigned GetShapeCount() const {
+    return shapes.size();
+  }
+
+  /**
+   * Returns the index of the shape in the file.  It identifies the
+   * shape even after it has been removed from the cache and loaded
+   * again.
+   */
+  gcc_pure
+  unsigned GetShapeIndex(const_iterator i) const {
+    assert(i.current != nullptr);
+
+    return i.current - shapes.begin();
+  }
+
   bool IsVisible(double map_scale) const {
     return map_scale <= scale_threshold;
   }
@@ -274,7 +329,20 @@ public:
   /**
    * @return true if new data from the topography file has been loaded
    */
-  bool Update(const WindowProjection &map_projection);
+  bool Update(const WindowProjection &map_projection) {
+    return Update(map_projection, GeoBounds::Invalid(), 0);
+  }
+
+  /**
+   * Like Update(const WindowProjection &), but additionally make sure
+   * the cache contains the shapes inside the given prefetch area if
+   * this file will be visible at the given map scale.
+   *
+   * @param prefetch_bounds the prefetch area or GeoBounds::Invalid()
+   * @return true if new data from the topography file has been loaded
+   */
+  bool Update(const WindowProjection &map_projection,
+              const GeoBounds &prefetch_bounds, double prefetch_scale);
 
   /**
    * Load all shapes into memory.  For debugging purposes.
@@ -283,6 +351,16 @@ public:
 
 protected:
   void ClearCache();
+
+private:
+  XShape *LoadShape(unsigned i);
+
+  /**
+   * Load the shapes for which the given predicate returns true, and
+   * delete all others.
+   */
+  template<typename P>
+  void UpdateCache(P is_inside);
 };
 
 #endif
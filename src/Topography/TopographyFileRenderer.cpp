@@ -39,7 +39,8 @@ Copyright_License {
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/VertexPointer.hpp"
 #include "Screen/OpenGL/Buffer.hpp"
-#include "Screen/OpenGL/Dynamic.hpp"
+#include "Screen/OpenGL/Texture.hpp"
+#include "Screen/OpenGL/Scope.hpp"
 #include "Screen/OpenGL/Geo.hpp"
 
 #include "Screen/OpenGL/Program.hpp"
@@ -52,12 +53,16 @@ Copyright_License {
 #include <numeric>
 #include <set>
 
+#include <stddef.h>
+
 TopographyFileRenderer::TopographyFileRenderer(const TopographyFile &_file,
                                                const TopographyLook &_look)
   :file(_file), look(_look),
    pen(Layout::ScaleFinePenWidth(file.GetPenWidth()), file.GetColor()),
 #ifdef ENABLE_OPENGL
-   array_buffer(nullptr)
+   array_buffer(nullptr),
+   element_buffer(nullptr),
+   icon_buffer(nullptr), n_icon_vertices(0)
 #else
    brush(file.GetColor())
 #endif
@@ -76,7 +81,7 @@ TopographyFileRenderer::~TopographyFileRenderer()
 #ifdef ENABLE_OPENGL
   RemoveSurfaceListener(*this);
 
-  delete array_buffer;
+  DeleteBuffers();
 #endif
 }
 
@@ -93,13 +98,15 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
   visible_bounds = projection.GetScreenBounds().Scale(1.2);
   visible_shapes.clear();
   visible_labels.clear();
+  ++visible_generation;
 
-  for (const XShape &shape : file) {
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    const XShape &shape = *i;
     if (!visible_bounds.Overlaps(shape.get_bounds()))
       continue;
 
     if (shape.get_type() != MS_SHAPE_NULL)
-      visible_shapes.push_back(&shape);
+      visible_shapes.push_back({&shape, file.GetShapeIndex(i)});
 
     if (shape.GetLabel() != nullptr)
       visible_labels.push_back(&shape);
@@ -108,65 +115,344 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
 
 #ifdef ENABLE_OPENGL
 
-inline void
-TopographyFileRenderer::UpdateArrayBuffer()
+/**
+ * The minimum capacity of the vertex buffer [points].
+ */
+static constexpr unsigned MIN_ARRAY_BUFFER_CAPACITY = 4096;
+
+/**
+ * A vertex of OpenGL::icon_shader.
+ */
+struct IconVertex {
+  ShapePoint position;
+  GLfloat offset[2];
+  GLfloat texcoord[2];
+};
+
+gcc_pure
+static unsigned
+GetPointCount(const XShape &shape)
+{
+  const auto lines = shape.GetLines();
+  return std::accumulate(lines.begin(), lines.end(), 0u);
+}
+
+void
+TopographyFileRenderer::RebuildArrayBuffer()
 {
   if (array_buffer == nullptr)
     array_buffer = new GLArrayBuffer();
-  else if (file.GetSerial() == array_buffer_serial)
-    return;
 
-  array_buffer_serial = file.GetSerial();
+  slots.assign(file.GetShapeCount(), Slot{BufferAllocator::NONE, 0});
 
   unsigned n = 0;
-  for (auto &shape : file) {
-    shape.SetOffset(n);
+  for (const auto &shape : file)
+    n += GetPointCount(shape);
 
-    const auto lines = shape.GetLines();
-    n = std::accumulate(lines.begin(), lines.end(), n);
-  }
+  /* leave room for shapes which will be loaded later */
+  const unsigned capacity = std::max(n * 2, MIN_ARRAY_BUFFER_CAPACITY);
+  allocator.Reset(capacity);
 
   ShapePoint *p = (ShapePoint *)
-    array_buffer->BeginWrite(n * sizeof(*p));
+    array_buffer->BeginWrite(capacity * sizeof(*p));
   assert (p != nullptr);
 
-  for (const auto &shape : file) {
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    const unsigned size = GetPointCount(*i);
+    if (size == 0)
+      continue;
+
+    const unsigned offset = allocator.Allocate(size);
+    assert(offset != BufferAllocator::NONE);
+
+    slots[file.GetShapeIndex(i)] = Slot{offset, size};
+    std::copy_n(i->GetPoints(), size, p + offset);
+  }
+
+  array_buffer->CommitWrite(capacity * sizeof(*p), p);
+
+  ++array_buffer_generation;
+}
+
+inline void
+TopographyFileRenderer::UpdateArrayBuffer()
+{
+  if (array_buffer == nullptr) {
+    array_buffer_serial = file.GetSerial();
+    RebuildArrayBuffer();
+    return;
+  } else if (file.GetSerial() == array_buffer_serial)
+    return;
+
+  array_buffer_serial = file.GetSerial();
+
+  /* free the slots of the shapes which were removed from the
+     cache */
+
+  std::vector<bool> cached(slots.size(), false);
+  for (auto i = file.begin(), end = file.end(); i != end; ++i)
+    cached[file.GetShapeIndex(i)] = true;
+
+  for (unsigned i = 0; i < slots.size(); ++i) {
+    Slot &slot = slots[i];
+    if (slot.IsDefined() && !cached[i]) {
+      allocator.Free(slot.offset, slot.size);
+      slot.offset = BufferAllocator::NONE;
+    }
+  }
+
+  if (allocator.GetCapacity() > MIN_ARRAY_BUFFER_CAPACITY &&
+      allocator.GetUsed() < allocator.GetCapacity() / 4) {
+    /* mostly empty: shrink */
+    RebuildArrayBuffer();
+    return;
+  }
+
+  /* upload only the new shapes */
+
+  array_buffer->Bind();
+
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    Slot &slot = slots[file.GetShapeIndex(i)];
+    if (slot.IsDefined())
+      continue;
+
+    const unsigned size = GetPointCount(*i);
+    if (size == 0)
+      continue;
+
+    const unsigned offset = allocator.Allocate(size);
+    if (offset == BufferAllocator::NONE) {
+      /* full or fragmented: start over with a larger buffer */
+      GLArrayBuffer::Unbind();
+      RebuildArrayBuffer();
+      return;
+    }
+
+    slot = Slot{offset, size};
+    GLArrayBuffer::SubData(offset * sizeof(ShapePoint),
+                           size * sizeof(ShapePoint), i->GetPoints());
+  }
+
+  GLArrayBuffer::Unbind();
+}
+
+/**
+ * Helper for TopographyFileRenderer::UpdateDrawList() which appends
+ * indices to a list of batches.
+ */
+class BatchBuilder {
+  std::vector<GLushort> &indices;
+  std::vector<TopographyFileRenderer::Batch> &batches;
+
+  /**
+   * Converts the shape's indices to the current batch.
+   */
+  unsigned delta;
+
+public:
+  BatchBuilder(std::vector<GLushort> &_indices,
+               std::vector<TopographyFileRenderer::Batch> &_batches)
+    :indices(_indices), batches(_batches) {}
+
+  /**
+   * Prepare for adding the indices of a shape.  Start a new batch if
+   * the shape cannot be addressed by the current one.
+   */
+  void BeginShape(GLenum mode, unsigned offset, unsigned size) {
+    size = std::min(size, 0x10000u);
+
+    if (batches.empty() || batches.back().mode != mode ||
+        offset < batches.back().base ||
+        offset + size - batches.back().base > 0x10000)
+      batches.push_back({mode, offset, unsigned(indices.size()), 0});
+
+    delta = offset - batches.back().base;
+  }
+
+  void Add(unsigned i) {
+    indices.push_back(delta + i);
+    ++batches.back().count;
+  }
+};
+
+void
+TopographyFileRenderer::UpdateDrawList(unsigned level,
+                                       ShapeScalar min_distance)
+{
+  if (element_buffer != nullptr &&
+      draw_visible_generation == visible_generation &&
+      draw_array_buffer_generation == array_buffer_generation &&
+      draw_level == level)
+    return;
+
+  if (element_buffer == nullptr)
+    element_buffer = new GLElementArrayBuffer();
+
+  draw_visible_generation = visible_generation;
+  draw_array_buffer_generation = array_buffer_generation;
+  draw_level = level;
+
+  /* sort by buffer position, so the batches cover the buffer
+     sequentially */
+  std::vector<std::pair<Slot, const XShape *>> shapes;
+  for (const auto &i : visible_shapes) {
+    const Slot &slot = slots[i.index];
+    const auto type = i.shape->get_type();
+    if (slot.IsDefined() &&
+        (type == MS_SHAPE_LINE || type == MS_SHAPE_POLYGON))
+      shapes.emplace_back(slot, i.shape);
+  }
+
+  std::sort(shapes.begin(), shapes.end(),
+            [](const std::pair<Slot, const XShape *> &a,
+               const std::pair<Slot, const XShape *> &b){
+              return a.first.offset < b.first.offset;
+            });
+
+  std::vector<GLushort> indices;
+  batches.clear();
+  BatchBuilder builder(indices, batches);
+
+  /* polygons first, so lines are painted on top of them */
+
+  for (const auto &i : shapes) {
+    const XShape &shape = *i.second;
+    if (shape.get_type() != MS_SHAPE_POLYGON)
+      continue;
+
+    const GLushort *index_count;
+    const GLushort *strip = shape.GetIndices(level, min_distance,
+                                             index_count);
+    if (strip == nullptr)
+      continue;
+
+    builder.BeginShape(GL_TRIANGLES, i.first.offset, i.first.size);
+
+    /* convert the triangle strip to separate triangles, dropping the
+       degenerate ones which join the strips */
+    const unsigned n = *index_count;
+    for (unsigned j = 2; j < n; ++j) {
+      const unsigned a = strip[j - 2], b = strip[j - 1], c = strip[j];
+      if (a == b || b == c || a == c)
+        continue;
+
+      builder.Add(a);
+      builder.Add(b);
+      builder.Add(c);
+    }
+  }
+
+  for (const auto &i : shapes) {
+    const XShape &shape = *i.second;
+    if (shape.get_type() != MS_SHAPE_LINE)
+      continue;
+
+    builder.BeginShape(GL_LINES, i.first.offset, i.first.size);
+
     const auto lines = shape.GetLines();
-    const ShapePoint *src = shape.GetPoints();
-    for (const auto n_points : lines) {
-      p = std::copy_n(src, n_points, p);
-      src += n_points;
+    const GLushort *line_indices, *count;
+    if (level == 0 ||
+        (line_indices = shape.GetIndices(level, min_distance,
+                                         count)) == nullptr) {
+      unsigned offset = 0;
+      for (unsigned n : lines) {
+        for (unsigned j = 1; j < n; ++j) {
+          builder.Add(offset + j - 1);
+          builder.Add(offset + j);
+        }
+
+        offset += n;
+      }
+    } else {
+      for (unsigned n : ConstBuffer<GLushort>(count, lines.size)) {
+        for (unsigned j = 1; j < n; ++j) {
+          builder.Add(line_indices[j - 1]);
+          builder.Add(line_indices[j]);
+        }
+
+        line_indices += n;
+      }
     }
   }
 
-  array_buffer->CommitWrite(n * sizeof(*p), p - n);
+  element_buffer->Load(indices.size() * sizeof(indices.front()),
+                       indices.data());
+
+  UpdateIconBuffer();
 }
 
-inline void
-TopographyFileRenderer::PaintPoint(Canvas &canvas,
-                                   const WindowProjection &projection,
-                                   const XShape &shape,
-                                   const float *opengl_matrix) const
+void
+TopographyFileRenderer::UpdateIconBuffer()
 {
+  n_icon_vertices = 0;
+
   if (!icon.IsDefined())
     return;
 
-  // TODO: for now i assume there is only one point for point-XShapes
+  const GLTexture &texture = *icon.GetBitmap().GetNative();
+  const PixelSize allocated = texture.GetAllocatedSize();
+  const GLfloat x1 = GLfloat(texture.GetWidth()) / allocated.cx;
+  const GLfloat y1 = GLfloat(texture.GetHeight()) / allocated.cy;
+  const GLfloat top = texture.IsFlipped() ? y1 : 0;
+  const GLfloat bottom = texture.IsFlipped() ? 0 : y1;
+
+  const PixelPoint origin = icon.GetOrigin();
+  const PixelSize size = icon.GetSize();
+  const GLfloat left_offset = -origin.x, top_offset = -origin.y;
+  const GLfloat right_offset = left_offset + size.cx;
+  const GLfloat bottom_offset = top_offset + size.cy;
+
+  std::vector<IconVertex> vertices;
+  for (const auto &i : visible_shapes) {
+    const XShape &shape = *i.shape;
+    if (shape.get_type() != MS_SHAPE_POINT)
+      continue;
+
+    const ShapePoint *points = shape.GetPoints();
+    const ShapePoint *end = points + GetPointCount(shape);
+    for (; points != end; ++points) {
+      const IconVertex top_left{*points, {left_offset, top_offset},
+          {0, top}};
+      const IconVertex top_right{*points, {right_offset, top_offset},
+          {x1, top}};
+      const IconVertex bottom_left{*points, {left_offset, bottom_offset},
+          {0, bottom}};
+      const IconVertex bottom_right{*points, {right_offset, bottom_offset},
+          {x1, bottom}};
+
+      vertices.push_back(top_left);
+      vertices.push_back(top_right);
+      vertices.push_back(bottom_left);
+      vertices.push_back(top_right);
+      vertices.push_back(bottom_right);
+      vertices.push_back(bottom_left);
+    }
+  }
 
-  PixelPoint sc;
-  if (!projection.GeoToScreenIfVisible(file.ToGeoPoint(shape.GetPoints()[0]),
-                                       sc))
+  if (vertices.empty())
     return;
 
-#ifndef HAVE_GLES
-  glPushMatrix();
-  glLoadMatrixf(opengl_matrix);
-#endif
+  if (icon_buffer == nullptr)
+    icon_buffer = new GLArrayBuffer();
 
-  icon.Draw(canvas, sc);
-#ifndef HAVE_GLES
-  glPopMatrix();
-#endif
+  icon_buffer->Load(vertices.size() * sizeof(vertices.front()),
+                    vertices.data());
+  n_icon_vertices = vertices.size();
+}
+
+void
+TopographyFileRenderer::DeleteBuffers()
+{
+  delete array_buffer;
+  array_buffer = nullptr;
+
+  delete element_buffer;
+  element_buffer = nullptr;
+
+  delete icon_buffer;
+  icon_buffer = nullptr;
+  n_icon_vertices = 0;
 }
 
 #else
@@ -193,6 +479,8 @@ TopographyFileRenderer::PaintPoint(Canvas &canvas,
 
 #endif
 
+#ifdef ENABLE_OPENGL
+
 void
 TopographyFileRenderer::Paint(Canvas &canvas,
                               const WindowProjection &projection)
@@ -211,107 +499,141 @@ TopographyFileRenderer::Paint(Canvas &canvas,
   if (visible_shapes.empty())
     return;
 
-#ifdef ENABLE_OPENGL
-  OpenGL::solid_shader->Use();
+  // get drawing info
+
+  const unsigned level = file.GetThinningLevel(map_scale);
+  const ShapeScalar min_distance =
+    ShapeScalar(file.GetMinimumPointDistance(level))
+    / (Layout::Scale(1) * FAISphere::REARTH);
 
+  /* all geometry stays in buffer objects; as long as the visible
+     shapes don't change, painting only updates the modelview
+     matrix */
   UpdateArrayBuffer();
-  array_buffer->Bind();
-  const ShapePoint *const buffer = nullptr;
+  UpdateDrawList(level, min_distance);
+
+  const glm::mat4 modelview = ToGLM(projection, file.GetCenter());
+
+  if (!batches.empty()) {
+    OpenGL::solid_shader->Use();
+
+    pen.Bind();
+
+    if (!pen.GetColor().IsOpaque()) {
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
 
-  pen.Bind();
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(modelview));
 
-  if (!pen.GetColor().IsOpaque()) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    array_buffer->Bind();
+    element_buffer->Bind();
+
+    const ShapePoint *const buffer = nullptr;
+    const GLushort *const first_index = nullptr;
+
+    ScopeVertexPointer vp;
+    for (const auto &batch : batches) {
+      vp.Update(GL_FLOAT, buffer + batch.base);
+      glDrawElements(batch.mode, batch.count, GL_UNSIGNED_SHORT,
+                     first_index + batch.first);
+    }
+
+    GLElementArrayBuffer::Unbind();
+    GLArrayBuffer::Unbind();
+
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(glm::mat4(1)));
+    if (!pen.GetColor().IsOpaque())
+      glDisable(GL_BLEND);
+
+    pen.Unbind();
   }
-#else
-  shape_renderer.Configure(&pen, &brush);
-#endif
 
-  // get drawing info
+  if (n_icon_vertices > 0) {
+    /* all point symbols with a single draw call */
+    OpenGL::icon_shader->Use();
+    glUniformMatrix4fv(OpenGL::icon_modelview, 1, GL_FALSE,
+                       glm::value_ptr(modelview));
 
-#ifdef ENABLE_OPENGL
-  const unsigned level = file.GetThinningLevel(map_scale);
-  const ShapeScalar min_distance =
-    ShapeScalar(file.GetMinimumPointDistance(level))
-    / (Layout::Scale(1) * FAISphere::REARTH);
+    const ScopeAlphaBlend alpha_blend;
+    icon.GetBitmap().GetNative()->Bind();
+
+    icon_buffer->Bind();
+
+    glEnableVertexAttribArray(OpenGL::Attribute::POSITION);
+    glVertexAttribPointer(OpenGL::Attribute::POSITION, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(IconVertex),
+                          (const GLvoid *)offsetof(IconVertex, position));
+
+    glEnableVertexAttribArray(OpenGL::Attribute::OFFSET);
+    glVertexAttribPointer(OpenGL::Attribute::OFFSET, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(IconVertex),
+                          (const GLvoid *)offsetof(IconVertex, offset));
+
+    glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+    glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(IconVertex),
+                          (const GLvoid *)offsetof(IconVertex, texcoord));
+
+    glDrawArrays(GL_TRIANGLES, 0, n_icon_vertices);
+
+    glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+    glDisableVertexAttribArray(OpenGL::Attribute::OFFSET);
+    glDisableVertexAttribArray(OpenGL::Attribute::POSITION);
+
+    GLArrayBuffer::Unbind();
+
+    OpenGL::solid_shader->Use();
+  }
+}
 
-#ifdef HAVE_GLES
-  const float *const opengl_matrix = nullptr;
 #else
-  float opengl_matrix[16];
-  glGetFloatv(GL_MODELVIEW_MATRIX, opengl_matrix);
-#endif
 
-  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
-                     glm::value_ptr(ToGLM(projection, file.GetCenter())));
-#else // !ENABLE_OPENGL
+void
+TopographyFileRenderer::Paint(Canvas &canvas,
+                              const WindowProjection &projection)
+{
+  const std::lock_guard<Mutex> lock(file.mutex);
+
+  if (file.IsEmpty())
+    return;
+
+  const auto map_scale = projection.GetMapScale();
+  if (!file.IsVisible(map_scale))
+    return;
+
+  UpdateVisibleShapes(projection);
+
+  if (visible_shapes.empty())
+    return;
+
+  shape_renderer.Configure(&pen, &brush);
+
+  // get drawing info
+
   const GeoClip clip(projection.GetScreenBounds().Scale(1.1));
   AllocatedArray<GeoPoint> geo_points;
 
   int iskip = file.GetSkipSteps(map_scale);
-#endif
-
-#ifdef ENABLE_OPENGL
-  ScopeVertexPointer vp;
-
-#ifdef GL_EXT_multi_draw_arrays
-  std::vector<GLsizei> polygon_counts;
-  std::vector<GLshort> polygon_indices;
-#endif
-#endif
 
-  for (const XShape *shape_p : visible_shapes) {
-    const XShape &shape = *shape_p;
+  for (const auto &visible : visible_shapes) {
+    const XShape &shape = *visible.shape;
 
     const auto lines = shape.GetLines();
-#ifdef ENABLE_OPENGL
-    const ShapePoint *points = buffer + shape.GetOffset();
-#else // !ENABLE_OPENGL
     const GeoPoint *points = shape.GetPoints();
-#endif
 
     switch (shape.get_type()) {
     case MS_SHAPE_NULL:
       break;
 
     case MS_SHAPE_POINT:
-#ifdef ENABLE_OPENGL
-      /* disable the ScopeVertexPointer instance because PaintPoint()
-         uses that attribute */
-      glDisableVertexAttribArray(OpenGL::Attribute::POSITION);
-
-      PaintPoint(canvas, projection, shape, opengl_matrix);
-
-      /* reenable the ScopeVertexPointer instance because PaintPoint()
-         left it disabled */
-      glEnableVertexAttribArray(OpenGL::Attribute::POSITION);
-#else // !ENABLE_OPENGL
       PaintPoint(canvas, projection, lines.begin(), lines.end(), points);
-#endif
       break;
 
     case MS_SHAPE_LINE:
-      {
-#ifdef ENABLE_OPENGL
-        vp.Update(GL_FLOAT, points);
-
-        const GLushort *indices, *count;
-        if (level == 0 ||
-            (indices = shape.GetIndices(level, min_distance, count)) == nullptr) {
-          unsigned offset = 0;
-          for (unsigned n : lines) {
-            glDrawArrays(GL_LINE_STRIP, offset, n);
-            offset += n;
-          }
-        } else {
-          for (unsigned n : ConstBuffer<GLushort>(count, lines.size)) {
-            glDrawElements(GL_LINE_STRIP, n, GL_UNSIGNED_SHORT, indices);
-            indices += n;
-          }
-        }
-#else // !ENABLE_OPENGL
-        for (unsigned msize : lines) {
+      for (unsigned msize : lines) {
         shape_renderer.Begin(msize);
 
         const GeoPoint *end = points + msize - 1;
@@ -323,37 +645,9 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
         shape_renderer.FinishPolyline(canvas);
       }
-#endif
-      }
       break;
 
     case MS_SHAPE_POLYGON:
-#ifdef ENABLE_OPENGL
-      {
-        const GLushort *index_count;
-        const GLushort *triangles = shape.GetIndices(level, min_distance,
-                                                     index_count);
-        const unsigned n = *index_count;
-
-#ifdef GL_EXT_multi_draw_arrays
-        const unsigned offset = shape.GetOffset();
-        if (GLExt::HaveMultiDrawElements() && offset + n < 0x10000) {
-          /* postpone, draw many polygons with a single
-             glMultiDrawElements() call */
-          polygon_counts.push_back(n);
-          const size_t size = polygon_indices.size();
-          polygon_indices.resize(size + n, offset);
-          for (unsigned i = 0; i < n; ++i)
-            polygon_indices[size + i] += triangles[i];
-          break;
-        }
-#endif
-
-        vp.Update(GL_FLOAT, points);
-        glDrawElements(GL_TRIANGLE_STRIP, n, GL_UNSIGNED_SHORT,
-                       triangles);
-      }
-#else // !ENABLE_OPENGL
       {
         const GeoPoint *src = &points[0];
         for (const unsigned n : lines) {
@@ -384,45 +678,15 @@ TopographyFileRenderer::Paint(Canvas &canvas,
           src += n;
         }
       }
-#endif
       break;
     }
   }
-#ifdef ENABLE_OPENGL
-
-#ifdef GL_EXT_multi_draw_arrays
-  if (!polygon_indices.empty()) {
-    assert(GLExt::HaveMultiDrawElements());
-
-    std::vector<const GLshort *> polygon_pointers;
-    unsigned i = 0;
-    for (auto count : polygon_counts) {
-      polygon_pointers.push_back(polygon_indices.data() + i);
-      i += count;
-    }
-
-    vp.Update(GL_FLOAT, nullptr);
-
-    GLExt::MultiDrawElements(GL_TRIANGLE_STRIP, polygon_counts.data(),
-                             GL_UNSIGNED_SHORT,
-                             (const GLvoid **)polygon_pointers.data(),
-                             polygon_counts.size());
-  }
-#endif
-
-  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
-                     glm::value_ptr(glm::mat4(1)));
-  if (!pen.GetColor().IsOpaque())
-    glDisable(GL_BLEND);
-
-  pen.Unbind();
 
-  array_buffer->Unbind();
-#else
   shape_renderer.Commit();
-#endif
 }
 
+#endif
+
 void
 TopographyFileRenderer::PaintLabels(Canvas &canvas,
                                     const WindowProjection &projection,
@@ -525,8 +789,7 @@ TopographyFileRenderer::SurfaceCreated()
 void
 TopographyFileRenderer::SurfaceDestroyed()
 {
-  delete array_buffer;
-  array_buffer = nullptr;
+  DeleteBuffers();
 }
 
 #endif
@@ -31,6 +31,9 @@ Copyright_License {
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Surface.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Topography/BufferAllocator.hpp"
+#include "Topography/XShapePoint.hpp"
 #else
 #include "Screen/Brush.hpp"
 #include "Topography/ShapeRenderer.hpp"
@@ -41,6 +44,7 @@ Copyright_License {
 class TopographyFile;
 class Canvas;
 class GLArrayBuffer;
+class GLElementArrayBuffer;
 class WindowProjection;
 class LabelBlock;
 class XShape;
@@ -74,11 +78,87 @@ class TopographyFileRenderer final
   Serial visible_serial;
   GeoBounds visible_bounds;
 
-  std::vector<const XShape *> visible_shapes, visible_labels;
+  struct VisibleShape {
+    const XShape *shape;
+
+    /**
+     * @see TopographyFile::GetShapeIndex()
+     */
+    unsigned index;
+  };
+
+  std::vector<VisibleShape> visible_shapes;
+  std::vector<const XShape *> visible_labels;
+
+  /**
+   * Incremented each time #visible_shapes is rebuilt.
+   */
+  unsigned visible_generation = 0;
 
 #ifdef ENABLE_OPENGL
+  /**
+   * The position of a shape's points in #array_buffer.
+   */
+  struct Slot {
+    unsigned offset, size;
+
+    bool IsDefined() const {
+      return offset != BufferAllocator::NONE;
+    }
+  };
+
+  /**
+   * The points of all shapes in the file's cache.  When the cache
+   * changes, only the new shapes are uploaded; the slots of removed
+   * shapes are reused.
+   */
   GLArrayBuffer *array_buffer;
   Serial array_buffer_serial;
+  BufferAllocator allocator;
+
+  /**
+   * Indexed by TopographyFile::GetShapeIndex().
+   */
+  std::vector<Slot> slots;
+
+  /**
+   * Incremented each time existing slots are moved, i.e. when
+   * #array_buffer is rebuilt from scratch.
+   */
+  unsigned array_buffer_generation = 0;
+
+  /**
+   * A range of #element_buffer which is drawn with one
+   * glDrawElements() call.  The 16 bit indices are relative to
+   * #base, which allows buffers with more than 65536 points.
+   */
+  struct Batch {
+    GLenum mode;
+    unsigned base, first, count;
+  };
+
+  friend class BatchBuilder;
+
+  /**
+   * The indices of all visible lines (GL_LINES) and polygons
+   * (GL_TRIANGLES) at the current thinning level.
+   */
+  GLElementArrayBuffer *element_buffer;
+  std::vector<Batch> batches;
+
+  /**
+   * Two triangles for each visible point symbol, see
+   * OpenGL::icon_shader.
+   */
+  GLArrayBuffer *icon_buffer;
+  unsigned n_icon_vertices;
+
+  /**
+   * The state which #element_buffer and #icon_buffer were built
+   * for.
+   */
+  unsigned draw_visible_generation, draw_array_buffer_generation;
+  unsigned draw_level;
 #endif
 
 public:
@@ -111,10 +191,26 @@ private:
   void UpdateVisibleShapes(const WindowProjection &projection);
 
 #ifdef ENABLE_OPENGL
+  /**
+   * Copy the points of all shapes into #array_buffer, which is
+   * (re)allocated with room for more.
+   */
+  void RebuildArrayBuffer();
+
+  /**
+   * Synchronise #array_buffer with the file's cache.
+   */
   void UpdateArrayBuffer();
 
-  void PaintPoint(Canvas &canvas, const WindowProjection &projection,
-                  const XShape &shape, const float *opengl_matrix) const;
+  /**
+   * Rebuild #element_buffer and #icon_buffer if the visible shapes,
+   * the thinning level or #array_buffer have changed.
+   */
+  void UpdateDrawList(unsigned level, ShapeScalar min_distance);
+
+  void UpdateIconBuffer();
+
+  void DeleteBuffers();
 
   virtual void SurfaceCreated() override;
   virtual void SurfaceDestroyed() override;
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Topography/TopographyGlue.hpp"
 #include "Topography/TopographyStore.hpp"
+#include "Topography/PackedTopography.hpp"
 #include "Language/Language.hpp"
 #include "Profile/Profile.hpp"
 #include "LogFile.hpp"
@@ -30,6 +31,33 @@ Copyright_License {
 #include "IO/MapFile.hpp"
 #include "IO/ZipArchive.hpp"
 #include "IO/ZipLineReader.hpp"
+#include "OS/FileUtil.hpp"
+#include "OS/Path.hpp"
+
+/**
+ * Open the preprocessed topography which was created from the map
+ * file by "PackTopography".  It is ignored if it is older than the
+ * map file.
+ *
+ * @return the object or nullptr if there is none (or on error)
+ */
+static PackedTopography *
+OpenPackedTopography()
+try {
+  const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+  if (map_path.IsNull())
+    return nullptr;
+
+  const auto path = map_path.WithExtension(_T(".xct"));
+  if (!File::Exists(path) ||
+      File::GetLastModification(path) < File::GetLastModification(map_path))
+    return nullptr;
+
+  return new PackedTopography(path);
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load packed topography");
+  return nullptr;
+}
 
 /**
  * Load topography from the map file (ZIP), load the other files from
@@ -44,7 +72,8 @@ try {
     return false;
 
   ZipLineReaderA reader(archive->get(), "topology.tpl");
-  store.Load(operation, reader, nullptr, archive->get());
+  store.Load(operation, reader, nullptr, archive->get(),
+             OpenPackedTopography());
   return true;
 } catch (...) {
   LogError(std::current_exception(), "No topography in map file");
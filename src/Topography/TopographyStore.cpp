@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyFile.hpp"
+#include "Topography/PackedTopography.hpp"
+#include "Projection/WindowProjection.hpp"
 #include "Util/StringAPI.hxx"
 #include "Util/StringCompare.hxx"
 #include "Util/ConvertString.hpp"
@@ -107,19 +109,31 @@ TopographyStore::GetNextScaleThreshold(double map_scale) const
 
 unsigned
 TopographyStore::ScanVisibility(const WindowProjection &m_projection,
-                              unsigned max_update)
+                                const GeoBounds &prefetch_bounds,
+                                double prefetch_scale,
+                                unsigned max_update)
 {
   // check if any needs to have cache updates because wasnt
   // visible previously when bounds moved
 
+  const double map_scale = m_projection.GetMapScale();
+
   // we will make sure we update at least one cache per call
   // to make sure eventually everything gets refreshed
   unsigned num_updated = 0;
-  for (auto *file : files) {
-    if (file->Update(m_projection)) {
-      ++num_updated;
-      if (num_updated >= max_update)
-        break;
+
+  /* first pass: the files which are visible now; second pass: the
+     files which will only be visible in the prefetch area */
+  for (unsigned pass = 0; pass < 2 && num_updated < max_update; ++pass) {
+    for (auto *file : files) {
+      if (file->IsVisible(map_scale) != (pass == 0))
+        continue;
+
+      if (file->Update(m_projection, prefetch_bounds, prefetch_scale)) {
+        ++num_updated;
+        if (num_updated >= max_update)
+          break;
+      }
     }
   }
 
@@ -136,6 +150,9 @@ TopographyStore::LoadAll()
   }
 }
 
+TopographyStore::TopographyStore()
+  :serial(0) {}
+
 TopographyStore::~TopographyStore()
 {
   Reset();
@@ -143,10 +160,13 @@ TopographyStore::~TopographyStore()
 
 void
 TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
-                      const TCHAR *directory, struct zzip_dir *zdir)
+                      const TCHAR *directory, struct zzip_dir *zdir,
+                      PackedTopography *_packed)
 {
   Reset();
 
+  packed.reset(_packed);
+
   // Create buffer for the shape filenames
   // (shape_filename will be modified with the shape_filename_end pointer)
   char shape_filename[MAX_PATH];
@@ -195,9 +215,10 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
     }
 
     // Extract filename and append it to the shape_filename buffer
-    memcpy(shape_filename_end, line, p - line);
+    const size_t shape_name_length = p - line;
+    memcpy(shape_filename_end, line, shape_name_length);
     // Append ".shp" file extension to the shape_filename buffer
-    strcpy(shape_filename_end + (p - line), ".shp");
+    strcpy(shape_filename_end + shape_name_length, ".shp");
 
     // Parse shape range
     auto shape_range = strtod(p + 1, &p) * 1000;
@@ -279,8 +300,25 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
 #endif
     }
 
+    /* prefer the preprocessed layer; null-terminate the name at the
+       extension for the lookup */
+    shape_filename_end[shape_name_length] = 0;
+    const PackedTopography::Layer *layer = packed != nullptr
+      ? packed->Find(shape_filename_end)
+      : nullptr;
+    shape_filename_end[shape_name_length] = '.';
+
     // Create TopographyFile instance from parsed line
-    TopographyFile *file = new TopographyFile(zdir, shape_filename,
+    TopographyFile *file = layer != nullptr
+      ? new TopographyFile(*layer, shape_range, label_range,
+                           labelImportantRange,
+#ifdef ENABLE_OPENGL
+                           Color(red, green, blue, alpha),
+#else
+                           Color(red, green, blue),
+#endif
+                           icon, big_icon, pen_width)
+      : new TopographyFile(zdir, shape_filename,
                                               shape_range, label_range,
                                               labelImportantRange,
 #ifdef ENABLE_OPENGL
@@ -309,4 +347,7 @@ TopographyStore::Reset()
     delete file;
 
   files.clear();
+
+  /* after the files, which refer to it */
+  packed.reset();
 }
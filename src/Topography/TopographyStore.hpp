@@ -27,11 +27,15 @@ Copyright_License {
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hxx"
 #include "Util/Compiler.h"
+#include "Geo/GeoBounds.hpp"
+
+#include <memory>
 
 #include <tchar.h>
 
 class WindowProjection;
 class TopographyFile;
+class PackedTopography;
 class NLineReader;
 class OperationEnvironment;
 struct zzip_dir;
@@ -47,13 +51,18 @@ public:
 private:
   StaticArray<TopographyFile *, MAXTOPOGRAPHY> files;
 
+  /**
+   * The preprocessed shapes of (some of) the #files, if available.
+   */
+  std::unique_ptr<PackedTopography> packed;
+
   /**
    * This number is incremented each time this object is modified.
    */
   unsigned serial;
 
 public:
-  TopographyStore():serial(0) {}
+  TopographyStore();
   ~TopographyStore();
 
   /**
@@ -84,6 +93,22 @@ public:
    * @return the number of files which were updated
    */
   unsigned ScanVisibility(const WindowProjection &m_projection,
+                          unsigned max_update=1024) {
+    return ScanVisibility(m_projection, GeoBounds::Invalid(), 0,
+                          max_update);
+  }
+
+  /**
+   * Like ScanVisibility(const WindowProjection &, unsigned), but
+   * additionally load the shapes inside the given prefetch area.
+   * Files which are visible at the current map scale are updated
+   * first.
+   *
+   * @see TopographyFile::Update()
+   */
+  unsigned ScanVisibility(const WindowProjection &m_projection,
+                          const GeoBounds &prefetch_bounds,
+                          double prefetch_scale,
                           unsigned max_update=1024);
 
   /**
@@ -92,8 +117,17 @@ public:
    */
   void LoadAll();
 
+  /**
+   * Load the layers listed in "topology.tpl".
+   *
+   * @param _packed an optional #PackedTopography created from the
+   * same map file (ownership is transferred to this object); layers
+   * which are found in it are loaded from there instead of the
+   * shapefile
+   */
   void Load(OperationEnvironment &operation, NLineReader &reader,
-            const TCHAR *directory, struct zzip_dir *zdir = nullptr);
+            const TCHAR *directory, struct zzip_dir *zdir = nullptr,
+            PackedTopography *_packed = nullptr);
   void Reset();
 };
 
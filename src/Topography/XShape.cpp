@@ -94,6 +94,9 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
 #ifdef ENABLE_OPENGL
   std::fill_n(index_count, THINNING_LEVELS, nullptr);
   std::fill_n(indices, THINNING_LEVELS, nullptr);
+  packed_min_distance = nullptr;
+  mapped_indices = 0;
+  mapped_points = false;
 #endif
 
   shapeObj shape;
@@ -136,8 +139,8 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
   /* OpenGL: convert GeoPoints to ShapePoints, make them relative to
      the map's boundary center */
 
-  points = new ShapePoint[num_points];
-  ShapePoint *p = points;
+  ShapePoint *p = new ShapePoint[num_points];
+  points = p;
 #else // !ENABLE_OPENGL
   /* convert all points of all lines to GeoPoints */
 
@@ -167,13 +170,76 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
   }
 }
 
+XShape::XShape(const PackedTopography::Layer &layer, unsigned i)
+  :label(nullptr)
+{
+  const auto &shape = layer.GetShape(i);
+
+  bounds = layer.ToGeoBounds(shape.bounds);
+  type = shape.type;
+
+  const auto src_lines = layer.GetLines(shape);
+  num_lines = std::min(src_lines.size, size_t(MAX_LINES));
+  std::copy_n(src_lines.data, num_lines, lines);
+
+  const ShapePoint *src = layer.GetPoints(shape);
+
+#ifdef ENABLE_OPENGL
+  /* the points are already relative to the layer center, and the
+     index arrays have been built by the converter */
+
+  points = src;
+  mapped_points = true;
+
+  packed_min_distance = layer.GetMinimumPointDistances();
+  mapped_indices = 0;
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+    const uint16_t *p = layer.GetIndices(shape, level);
+    if (p == nullptr) {
+      index_count[level] = indices[level] = nullptr;
+      continue;
+    }
+
+    index_count[level] = const_cast<uint16_t *>(p);
+    indices[level] = index_count[level] +
+      (type == MS_SHAPE_POLYGON ? 1 : num_lines);
+    mapped_indices |= 1 << level;
+  }
+#else
+  unsigned num_points = 0;
+  for (unsigned l = 0; l < num_lines; ++l)
+    num_points += lines[l];
+
+  const GeoPoint center = layer.GetCenter();
+
+  points = new GeoPoint[num_points];
+  for (unsigned j = 0; j < num_points; ++j)
+    points[j] = GeoPoint(center.longitude + Angle::Native(src[j].x),
+                         center.latitude + Angle::Native(src[j].y));
+#endif
+
+  const char *src_label = layer.GetLabel(shape);
+  if (src_label != nullptr) {
+#ifdef _UNICODE
+    label = AllocatedString<TCHAR>::Donate(ConvertUTF8ToWide(src_label));
+#else
+    label = AllocatedString<TCHAR>::Duplicate(src_label);
+#endif
+  }
+}
+
 XShape::~XShape()
 {
-  delete[] points;
 #ifdef ENABLE_OPENGL
+  if (!mapped_points)
+    delete[] points;
+
   // Note: index_count and indices share one buffer
   for (unsigned i = 0; i < THINNING_LEVELS; i++)
-    delete[] index_count[i];
+    if ((mapped_indices & (1 << i)) == 0)
+      delete[] index_count[i];
+#else
+  delete[] points;
 #endif
 }
 
@@ -249,10 +315,25 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance)
   }
 }
 
+void
+XShape::DiscardMappedIndices(unsigned thinning_level)
+{
+  assert(mapped_indices & (1 << thinning_level));
+
+  index_count[thinning_level] = indices[thinning_level] = nullptr;
+  mapped_indices &= ~(1 << thinning_level);
+}
+
 const uint16_t *
 XShape::GetIndices(int thinning_level, ShapeScalar min_distance,
                    const uint16_t *&count) const
 {
+  if ((mapped_indices & (1 << thinning_level)) &&
+      packed_min_distance[thinning_level] != min_distance)
+    /* the precomputed indices were built for a different display
+       resolution; build new ones */
+    const_cast<XShape &>(*this).DiscardMappedIndices(thinning_level);
+
   if (indices[thinning_level] == nullptr) {
     XShape &deconst = const_cast<XShape &>(*this);
     if (!deconst.BuildIndices(thinning_level, min_distance))
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Util/ConstBuffer.hxx"
 #include "Util/AllocatedString.hxx"
 #include "Geo/GeoBounds.hpp"
+#include "Topography/PackedTopography.hpp"
 #include "shapelib/mapserver.h"
 #include "shapelib/mapshape.h"
 #ifdef ENABLE_OPENGL
@@ -43,6 +44,9 @@ class XShape {
   static constexpr unsigned MAX_LINES = 32;
 #ifdef ENABLE_OPENGL
   static constexpr unsigned THINNING_LEVELS = 4;
+
+  static_assert(THINNING_LEVELS == PackedTopography::THINNING_LEVELS,
+                "Wrong number of thinning levels");
 #endif
 
   GeoBounds bounds;
@@ -65,7 +69,7 @@ class XShape {
    * All points of all lines.
    */
 #ifdef ENABLE_OPENGL
-  ShapePoint *points;
+  const ShapePoint *points;
 
   /**
    * Indices of polygon triangles or lines with reduced number of vertices.
@@ -81,10 +85,22 @@ class XShape {
   uint16_t *index_count[THINNING_LEVELS];
 
   /**
-   * The start offset in the #GLArrayBuffer (vertex buffer object).
-   * It is managed by #TopographyFileRenderer.
+   * If this shape was loaded from a #PackedTopography: the minimum
+   * point distance which was used to build the #indices of each
+   * level; nullptr otherwise.
    */
-  mutable unsigned offset;
+  const float *packed_min_distance;
+
+  /**
+   * A bit mask of #indices which point into the #PackedTopography
+   * file mapping and must not be freed.
+   */
+  uint8_t mapped_indices;
+
+  /**
+   * Do the #points point into the #PackedTopography file mapping?
+   */
+  bool mapped_points;
 #else // !ENABLE_OPENGL
   GeoPoint *points;
 #endif
@@ -95,22 +111,27 @@ public:
   XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
          int label_field=-1);
 
+  /**
+   * Load a shape from a #PackedTopography.  With OpenGL, the points
+   * and the precomputed index arrays are used directly from the file
+   * mapping, which must outlive this object.
+   */
+  XShape(const PackedTopography::Layer &layer, unsigned i);
+
   XShape(const XShape &) = delete;
 
   ~XShape();
 
 #ifdef ENABLE_OPENGL
-  void SetOffset(unsigned _offset) const {
-    offset = _offset;
-  }
-
-  unsigned GetOffset() const {
-    return offset;
-  }
-
 protected:
   bool BuildIndices(unsigned thinning_level, ShapeScalar min_distance);
 
+  /**
+   * Forget the precomputed index array of the given level, because
+   * it was made for a different minimum point distance.
+   */
+  void DiscardMappedIndices(unsigned thinning_level);
+
 public:
   const uint16_t *GetIndices(int thinning_level,
                              ShapeScalar min_distance,
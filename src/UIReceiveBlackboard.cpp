@@ -28,6 +28,7 @@ Copyright_License {
 #include "ApplyExternalSettings.hpp"
 #include "InfoBoxes/InfoBoxManager.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "Device/IngestionTrace.hpp"
 #include "Input/TaskEventObserver.hpp"
 #include "Task/ProtectedTaskManager.hpp"
 #include "Components.hpp"
@@ -62,6 +63,7 @@ UIReceiveCalculatedData()
 
   ActionInterface::UpdateDisplayMode();
   ActionInterface::SendUIState();
+  ingestion_trace.Displayed();
 
   if (devices != nullptr)
     devices->NotifyCalculatedUpdate(CommonInterface::Basic(),
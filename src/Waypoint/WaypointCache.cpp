@@ -0,0 +1,269 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointCache.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "IO/FileCache.hpp"
+
+#include <iterator>
+#include <cstdint>
+#include <string.h>
+
+namespace {
+
+struct CacheHeader {
+  static constexpr unsigned VERSION = 1;
+
+  uint32_t version;
+  uint32_t key_length;
+  uint32_t n_waypoints;
+};
+
+/**
+ * The fixed-size part of a #Waypoint.  Identifiers and projected
+ * locations are not stored, they are assigned by #Waypoints.
+ */
+struct CachedWaypoint {
+  GeoPoint location;
+  double elevation;
+  uint32_t original_id;
+  Runway runway;
+  RadioFrequency radio_frequency;
+  Waypoint::Type type;
+  Waypoint::Flags flags;
+  WaypointOrigin origin;
+
+  uint8_t n_files_embed, n_files_external;
+};
+
+}
+
+static bool
+WriteString(FILE *file, const TCHAR *value, size_t length)
+{
+  const uint32_t length32 = length;
+  return fwrite(&length32, sizeof(length32), 1, file) == 1 &&
+    fwrite(value, sizeof(*value), length, file) == length;
+}
+
+static bool
+WriteString(FILE *file, const tstring &value)
+{
+  return WriteString(file, value.data(), value.length());
+}
+
+static bool
+ReadString(FILE *file, tstring &value)
+{
+  uint32_t length;
+  if (fread(&length, sizeof(length), 1, file) != 1 ||
+      /* plausibility check against corrupt files */
+      length > 1024 * 1024)
+    return false;
+
+  value.resize(length);
+  return fread(&value[0], sizeof(value[0]), length, file) == length;
+}
+
+template<typename L>
+static unsigned
+CountFiles(const L &list)
+{
+  return std::distance(list.begin(), list.end());
+}
+
+static bool
+WriteFiles(FILE *file, const std::forward_list<tstring> &list)
+{
+  for (const auto &i : list)
+    if (!WriteString(file, i))
+      return false;
+
+  return true;
+}
+
+static bool
+ReadFiles(FILE *file, unsigned n, std::forward_list<tstring> &list)
+{
+  std::vector<tstring> files(n);
+  for (auto &i : files)
+    if (!ReadString(file, i))
+      return false;
+
+  /* restore the original order */
+  for (auto i = files.rbegin(); i != files.rend(); ++i)
+    list.emplace_front(std::move(*i));
+
+  return true;
+}
+
+static bool
+WriteWaypoint(FILE *file, const Waypoint &waypoint)
+{
+  CachedWaypoint c;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&c, 0, sizeof(c));
+
+  const unsigned n_files_embed = CountFiles(waypoint.files_embed);
+#ifdef HAVE_RUN_FILE
+  const unsigned n_files_external = CountFiles(waypoint.files_external);
+#else
+  const unsigned n_files_external = 0;
+#endif
+  if (n_files_embed > 0xff || n_files_external > 0xff)
+    return false;
+
+  c.location = waypoint.location;
+  c.elevation = waypoint.elevation;
+  c.original_id = waypoint.original_id;
+  c.runway = waypoint.runway;
+  c.radio_frequency = waypoint.radio_frequency;
+  c.type = waypoint.type;
+  c.flags = waypoint.flags;
+  c.origin = waypoint.origin;
+  c.n_files_embed = n_files_embed;
+  c.n_files_external = n_files_external;
+
+  return fwrite(&c, sizeof(c), 1, file) == 1 &&
+    WriteString(file, waypoint.name) &&
+    WriteString(file, waypoint.comment) &&
+    WriteString(file, waypoint.details) &&
+    WriteFiles(file, waypoint.files_embed)
+#ifdef HAVE_RUN_FILE
+    && WriteFiles(file, waypoint.files_external)
+#endif
+    ;
+}
+
+static bool
+ReadWaypoint(FILE *file, std::vector<Waypoint> &waypoints)
+{
+  CachedWaypoint c;
+  if (fread(&c, sizeof(c), 1, file) != 1 ||
+      !c.location.Check())
+    return false;
+
+  waypoints.emplace_back(c.location);
+  Waypoint &waypoint = waypoints.back();
+  waypoint.elevation = c.elevation;
+  waypoint.original_id = c.original_id;
+  waypoint.runway = c.runway;
+  waypoint.radio_frequency = c.radio_frequency;
+  waypoint.type = c.type;
+  waypoint.flags = c.flags;
+  waypoint.origin = c.origin;
+
+  if (!ReadString(file, waypoint.name) ||
+      !ReadString(file, waypoint.comment) ||
+      !ReadString(file, waypoint.details) ||
+      !ReadFiles(file, c.n_files_embed, waypoint.files_embed))
+    return false;
+
+#ifdef HAVE_RUN_FILE
+  return ReadFiles(file, c.n_files_external, waypoint.files_external);
+#else
+  std::forward_list<tstring> files_external;
+  return ReadFiles(file, c.n_files_external, files_external);
+#endif
+}
+
+static bool
+LoadWaypointCache(FILE *file, const TCHAR *key,
+                  std::vector<Waypoint> &waypoints)
+{
+  CacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.version != CacheHeader::VERSION ||
+      header.key_length != _tcslen(key))
+    return false;
+
+  tstring old_key;
+  if (!ReadString(file, old_key) || old_key != key)
+    return false;
+
+  waypoints.reserve(waypoints.size() + header.n_waypoints);
+  for (unsigned i = 0; i < header.n_waypoints; ++i)
+    if (!ReadWaypoint(file, waypoints))
+      return false;
+
+  return true;
+}
+
+bool
+LoadWaypointCache(FileCache &cache, const TCHAR *name,
+                  Path original_path, const TCHAR *key,
+                  std::vector<Waypoint> &waypoints)
+{
+  FILE *file = cache.Load(name, original_path);
+  if (file == nullptr)
+    return false;
+
+  const size_t old_size = waypoints.size();
+  bool success = LoadWaypointCache(file, key, waypoints);
+  fclose(file);
+
+  if (!success) {
+    waypoints.erase(waypoints.begin() + old_size, waypoints.end());
+    cache.Flush(name);
+  }
+
+  return success;
+}
+
+static bool
+SaveWaypointCache(FILE *file, const TCHAR *key,
+                  const std::vector<Waypoint> &waypoints)
+{
+  CacheHeader header;
+  header.version = CacheHeader::VERSION;
+  header.key_length = _tcslen(key);
+  header.n_waypoints = waypoints.size();
+
+  if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+      !WriteString(file, key, header.key_length))
+    return false;
+
+  for (const auto &i : waypoints)
+    if (!WriteWaypoint(file, i))
+      return false;
+
+  return true;
+}
+
+bool
+SaveWaypointCache(FileCache &cache, const TCHAR *name,
+                  Path original_path, const TCHAR *key,
+                  const std::vector<Waypoint> &waypoints)
+{
+  FILE *file = cache.Save(name, original_path);
+  if (file == nullptr)
+    return false;
+
+  if (!SaveWaypointCache(file, key, waypoints)) {
+    cache.Cancel(name, file);
+    return false;
+  }
+
+  return cache.Commit(name, file);
+}
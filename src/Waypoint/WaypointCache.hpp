@@ -0,0 +1,64 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_CACHE_HPP
+#define XCSOAR_WAYPOINT_CACHE_HPP
+
+#include <vector>
+
+#include <tchar.h>
+
+struct Waypoint;
+class FileCache;
+class Path;
+
+/**
+ * Load a binary snapshot of a parsed waypoint file from the
+ * #FileCache.  This is much faster than parsing the file again.
+ *
+ * @param name the name of the cache file
+ * @param original_path the file which was parsed; the snapshot is
+ * discarded if it has been modified
+ * @param key an arbitrary string describing everything else the
+ * parser result depends on (e.g. the terrain used for missing
+ * elevations); the snapshot is ignored if it was saved with a
+ * different key
+ * @param waypoints the waypoints are appended to this vector; it is
+ * left unmodified on error
+ * @return true on success, false if there was no valid snapshot
+ */
+bool
+LoadWaypointCache(FileCache &cache, const TCHAR *name,
+                  Path original_path, const TCHAR *key,
+                  std::vector<Waypoint> &waypoints);
+
+/**
+ * Save a binary snapshot of a parsed waypoint file to the #FileCache.
+ * See LoadWaypointCache() for a description of the parameters.
+ */
+bool
+SaveWaypointCache(FileCache &cache, const TCHAR *name,
+                  Path original_path, const TCHAR *key,
+                  const std::vector<Waypoint> &waypoints);
+
+#endif
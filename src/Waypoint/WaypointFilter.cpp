@@ -24,6 +24,8 @@ Copyright_License {
 #include "WaypointFilter.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
+#include "Util/StringUtil.hpp"
+#include "Util/StringAPI.hxx"
 
 inline bool
 WaypointFilter::CompareType(const Waypoint &waypoint, TypeFilter type,
@@ -101,13 +103,19 @@ WaypointFilter::CompareDirection(const Waypoint &waypoint,
   return CompareDirection(waypoint, direction, location);
 }
 
-inline bool
+bool
 WaypointFilter::CompareName(const Waypoint &waypoint, const TCHAR *name)
 {
-  return StringIsEqualIgnoreCase(waypoint.name.c_str(), name, _tcslen(name));
+  TCHAR normalized[_tcslen(name) + 1];
+  NormalizeSearchString(normalized, name);
+
+  TCHAR normalized_name[waypoint.name.length() + 1];
+  NormalizeSearchString(normalized_name, waypoint.name.c_str());
+
+  return StringFind(normalized_name, normalized) != nullptr;
 }
 
-inline bool
+bool
 WaypointFilter::CompareName(const Waypoint &waypoint) const
 {
   return CompareName(waypoint, name);
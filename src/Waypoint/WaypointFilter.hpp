@@ -71,6 +71,15 @@ struct WaypointFilter
   bool Matches(const Waypoint &waypoint, GeoPoint location,
                const FAITrianglePointValidator &triangle_validator) const;
 
+  /**
+   * Does the name of the waypoint contain the #name filter?  This
+   * ignores case and non-alphanumeric characters.
+   */
+  gcc_pure
+  bool MatchesName(const Waypoint &waypoint) const {
+    return CompareName(waypoint);
+  }
+
 private:
   static bool CompareType(const Waypoint &waypoint, TypeFilter type,
                           const FAITrianglePointValidator &triangle_validator);
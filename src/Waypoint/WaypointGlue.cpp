@@ -32,106 +32,248 @@ Copyright_License {
 #include "LocalPath.hpp"
 #include "Operation/Operation.hpp"
 #include "OS/Path.hpp"
-#include "IO/MapFile.hpp"
+#include "OS/FileUtil.hpp"
 #include "IO/ZipArchive.hpp"
+#include "WaypointCache.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Thread/FunctionThread.hpp"
+#include "Util/StringFormat.hpp"
+#include "Util/Macros.hpp"
 
-static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+#include <list>
+#include <vector>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * One waypoint file to be loaded by WaypointGlue::LoadWaypoints().
+ * Jobs do not touch shared state, so they can run concurrently.
+ */
+struct WaypointFileJob {
+  /** the waypoint file, or the map file which contains it */
+  AllocatedPath path;
+
+  /** the name of the waypoint file inside the map file, or nullptr */
+  const char *entry;
+
+  WaypointFileType file_type;
+  WaypointOrigin origin;
+
+  /** the name of the #FileCache entry for this file */
+  const TCHAR *cache_name;
+
+  std::vector<Waypoint> waypoints;
+
+  bool success = false;
+
+  WaypointFileJob(Path _path, const char *_entry,
+                  WaypointFileType _file_type, WaypointOrigin _origin,
+                  const TCHAR *_cache_name)
+    :path(_path), entry(_entry),
+     file_type(_file_type), origin(_origin),
+     cache_name(_cache_name) {}
+
+  void Run(const RasterTerrain *terrain, FileCache *cache,
+           const tstring &terrain_key);
+
+private:
+  bool Parse(const RasterTerrain *terrain);
+};
+
+}
+
+/**
+ * Build the part of the #FileCache key which identifies the terrain
+ * (used for missing elevations).  The terrain is loaded from the map
+ * file, so its name, modification time and size are used; these
+ * survive a restart, unlike the terrain's in-process serial.
+ *
+ * @return an empty string if there is no terrain
+ */
+static tstring
+MakeTerrainKey(const RasterTerrain *terrain)
 {
-  if (!ReadWaypointFile(path, file_type, waypoints,
-                        WaypointFactory(origin, terrain),
-                        operation)) {
-    LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
-    return false;
-  }
+  if (terrain == nullptr)
+    return tstring();
+
+  const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+  if (map_path.IsNull())
+    return tstring();
 
-  return true;
+  tstring key(_T("|"));
+  key += map_path.c_str();
+
+  TCHAR buffer[64];
+  StringFormat(buffer, ARRAY_SIZE(buffer), _T("|%llu,%llu"),
+               (unsigned long long)File::GetLastModification(map_path),
+               (unsigned long long)File::GetSize(map_path));
+  key += buffer;
+  return key;
 }
 
-static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+/**
+ * Build the key which invalidates the #FileCache entry if the file
+ * name or the terrain has changed.
+ */
+static tstring
+MakeCacheKey(Path path, const tstring &terrain_key)
+{
+  tstring key(path.c_str());
+  key += terrain_key;
+  return key;
+}
+
+inline bool
+WaypointFileJob::Parse(const RasterTerrain *terrain)
+try {
+  /* progress is reported by the calling thread */
+  NullOperationEnvironment operation;
+  const WaypointFactory factory(origin, terrain);
+
+  if (entry == nullptr)
+    return ReadWaypointFile(path, file_type, waypoints, factory, operation);
+
+  /* each job opens the archive, because a ZZIP_DIR must not be
+     shared between threads */
+  ZipArchive archive(path);
+  return ReadWaypointFile(archive.get(), entry, file_type, waypoints,
+                          factory, operation);
+} catch (const std::runtime_error &) {
+  return false;
+}
+
+void
+WaypointFileJob::Run(const RasterTerrain *terrain, FileCache *cache,
+                     const tstring &terrain_key)
 {
-  if (!ReadWaypointFile(path, waypoints,
-                        WaypointFactory(origin, terrain),
-                        operation)) {
-    LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
-    return false;
+  const tstring key = MakeCacheKey(path, terrain_key);
+
+  if (cache != nullptr &&
+      LoadWaypointCache(*cache, cache_name, path, key.c_str(), waypoints)) {
+    success = true;
+    return;
   }
 
-  return true;
+  success = Parse(terrain);
+  if (success && cache != nullptr)
+    SaveWaypointCache(*cache, cache_name, path, key.c_str(), waypoints);
 }
 
+/**
+ * Run all jobs concurrently and append their waypoints in the order
+ * of the list, so waypoint ids do not depend on thread scheduling.
+ *
+ * @return true if at least one job has succeeded
+ */
 static bool
-LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+RunWaypointFileJobs(std::list<WaypointFileJob> &jobs, Waypoints &way_points,
+                    const RasterTerrain *terrain, FileCache *cache,
+                    const tstring &terrain_key,
+                    OperationEnvironment &operation)
 {
-  if (!ReadWaypointFile(dir, path, file_type, waypoints,
-                        WaypointFactory(origin, terrain),
-                        operation)) {
-    LogFormat("Failed to read waypoint file: %s", path);
-    return false;
+  std::list<FunctionThread> threads;
+  for (auto &job : jobs)
+    threads.emplace_back([&job, terrain, cache, &terrain_key](){
+        job.Run(terrain, cache, terrain_key);
+      }, "WaypointLoader");
+
+  for (auto &thread : threads)
+    thread.StartOrRun();
+
+  operation.SetProgressRange(jobs.size());
+
+  bool found = false;
+  unsigned n = 0;
+  auto thread = threads.begin();
+  for (auto &job : jobs) {
+    thread->Wait();
+    ++thread;
+
+    operation.SetProgressPosition(++n);
+
+    if (!job.success) {
+      if (job.entry != nullptr)
+        LogFormat("Failed to read waypoint file: %s", job.entry);
+      else
+        LogFormat(_T("Failed to read waypoint file: %s"), job.path.c_str());
+      continue;
+    }
+
+    /* "user.cup" does not count, that file is optional */
+    if (job.origin != WaypointOrigin::USER)
+      found = true;
+
+    for (auto &i : job.waypoints)
+      way_points.Append(std::move(i));
   }
 
-  return true;
+  return found;
+}
+
+static void
+AddProfileJob(std::list<WaypointFileJob> &jobs, const char *key,
+              WaypointOrigin origin, const TCHAR *cache_name)
+{
+  const auto path = Profile::GetPath(key);
+  if (!path.IsNull())
+    jobs.emplace_back(path, nullptr, DetermineWaypointFileType(path),
+                      origin, cache_name);
 }
 
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
                             const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogFormat("ReadWaypoints");
   operation.SetText(_("Loading Waypoints..."));
 
-  bool found = false;
-
   // Delete old waypoints
   way_points.Clear();
 
-  LoadWaypointFile(way_points, LocalPath(_T("user.cup")),
-                   WaypointFileType::SEEYOU,
-                   WaypointOrigin::USER, terrain, operation);
+  /* the files are independent of each other; they are loaded
+     concurrently */
+  std::list<WaypointFileJob> jobs;
+
+  const tstring terrain_key = MakeTerrainKey(terrain);
+
+  jobs.emplace_back(LocalPath(_T("user.cup")), nullptr,
+                    WaypointFileType::SEEYOU, WaypointOrigin::USER,
+                    _T("waypoints_user"));
 
   // ### FIRST FILE ###
-  auto path = Profile::GetPath(ProfileKeys::WaypointFile);
-  if (!path.IsNull())
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::PRIMARY,
-                              terrain, operation);
+  AddProfileJob(jobs, ProfileKeys::WaypointFile, WaypointOrigin::PRIMARY,
+                _T("waypoints_primary"));
 
   // ### SECOND FILE ###
-  path = Profile::GetPath(ProfileKeys::AdditionalWaypointFile);
-  if (!path.IsNull())
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::ADDITIONAL,
-                              terrain, operation);
+  AddProfileJob(jobs, ProfileKeys::AdditionalWaypointFile,
+                WaypointOrigin::ADDITIONAL, _T("waypoints_additional"));
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
-  path = Profile::GetPath(ProfileKeys::WatchedWaypointFile);
-  if (!path.IsNull())
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::WATCHED,
-                              terrain, operation);
+  AddProfileJob(jobs, ProfileKeys::WatchedWaypointFile,
+                WaypointOrigin::WATCHED, _T("waypoints_watched"));
+
+  bool found = RunWaypointFileJobs(jobs, way_points, terrain, cache,
+                                   terrain_key, operation);
 
   // ### MAP/FOURTH FILE ###
 
   // If no waypoint file found yet
   if (!found) {
-    auto archive = OpenMapFile();
-    if (archive) {
-      found |= LoadWaypointFile(way_points, archive->get(), "waypoints.xcw",
-                                WaypointFileType::WINPILOT,
-                                WaypointOrigin::MAP,
-                                terrain, operation);
-
-      found |= LoadWaypointFile(way_points, archive->get(), "waypoints.cup",
-                                WaypointFileType::SEEYOU,
-                                WaypointOrigin::MAP,
-                                terrain, operation);
+    const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+    if (!map_path.IsNull()) {
+      jobs.clear();
+      jobs.emplace_back(map_path, "waypoints.xcw",
+                        WaypointFileType::WINPILOT, WaypointOrigin::MAP,
+                        _T("waypoints_map_xcw"));
+      jobs.emplace_back(map_path, "waypoints.cup",
+                        WaypointFileType::SEEYOU, WaypointOrigin::MAP,
+                        _T("waypoints_map_cup"));
+
+      found = RunWaypointFileJobs(jobs, way_points, terrain, cache,
+                                  terrain_key, operation);
     }
   }
 
@@ -28,6 +28,7 @@ Copyright_License {
 
 class Waypoints;
 class RasterTerrain;
+class FileCache;
 class OperationEnvironment;
 struct PlacesOfInterestSettings;
 struct TeamCodeSettings;
@@ -101,9 +102,12 @@ namespace WaypointGlue {
    * specified waypoint list
    * @param way_points The waypoint list to fill
    * @param terrain RasterTerrain (for automatic waypoint height)
+   * @param cache an optional #FileCache for binary snapshots of the
+   * parsed files, which speed up the next start
    */
   bool LoadWaypoints(Waypoints &way_points,
                      const RasterTerrain *terrain,
+                     FileCache *cache,
                      OperationEnvironment &operation);
 
   /**
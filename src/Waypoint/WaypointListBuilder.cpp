@@ -25,12 +25,18 @@ Copyright_License {
 #include "WaypointList.hpp"
 #include "WaypointFilter.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "Util/StringUtil.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/StringAPI.hxx"
+
+#include <algorithm>
+#include <iterator>
 
 void WaypointListBuilder::Visit(const Waypoints &waypoints) {
   if (filter.distance > 0)
     waypoints.VisitWithinRange(location, filter.distance, *this);
   else
-    waypoints.VisitNamePrefix(filter.name, *this);
+    waypoints.VisitNameContaining(filter.name, *this);
 }
 
 void
@@ -39,3 +45,68 @@ WaypointListBuilder::Visit(const WaypointPtr &waypoint)
   if (filter.Matches(*waypoint, location, triangle_validator))
     list.emplace_back(waypoint);
 }
+
+/**
+ * Does the normalised name of the waypoint start with the given
+ * normalised string?
+ */
+gcc_pure
+static bool
+NameStartsWith(const Waypoint &waypoint, const TCHAR *normalized)
+{
+  TCHAR name[waypoint.name.length() + 1];
+  NormalizeSearchString(name, waypoint.name.c_str());
+  return StringStartsWith(name, normalized);
+}
+
+gcc_pure
+static bool
+CompareNormalisedNames(const WaypointListItem &a, const WaypointListItem &b)
+{
+  TCHAR name_a[a.waypoint->name.length() + 1];
+  NormalizeSearchString(name_a, a.waypoint->name.c_str());
+
+  TCHAR name_b[b.waypoint->name.length() + 1];
+  NormalizeSearchString(name_b, b.waypoint->name.c_str());
+
+  const int result = StringCompare(name_a, name_b);
+  return result < 0 || (result == 0 && a.waypoint->id < b.waypoint->id);
+}
+
+void
+RefineWaypointList(WaypointList &list, const WaypointFilter &filter,
+                   const TCHAR *old_name, bool sorted_by_name)
+{
+  list.erase(std::remove_if(list.begin(), list.end(),
+                            [&filter](const WaypointListItem &i){
+                              return !filter.MatchesName(*i.waypoint);
+                            }),
+             list.end());
+
+  if (!sorted_by_name)
+    return;
+
+  /* names starting with the filter come first; some of those which
+     started with the old filter don't start with the new one, and
+     must be merged into the rest */
+  TCHAR normalized[filter.name.length() + 1];
+  NormalizeSearchString(normalized, filter.name);
+
+  TCHAR old_normalized[_tcslen(old_name) + 1];
+  NormalizeSearchString(old_normalized, old_name);
+
+  const auto old_prefix_end =
+    std::partition_point(list.begin(), list.end(),
+                         [&old_normalized](const WaypointListItem &i){
+                           return NameStartsWith(*i.waypoint, old_normalized);
+                         });
+
+  const auto prefix_end =
+    std::stable_partition(list.begin(), old_prefix_end,
+                          [&normalized](const WaypointListItem &i){
+                            return NameStartsWith(*i.waypoint, normalized);
+                          });
+
+  std::inplace_merge(prefix_end, old_prefix_end, list.end(),
+                     CompareNormalisedNames);
+}
@@ -28,6 +28,8 @@ Copyright_License {
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
 #include "Engine/Waypoint/WaypointVisitor.hpp"
 
+#include <tchar.h>
+
 struct WaypointFilter;
 class WaypointList;
 class Waypoints;
@@ -51,6 +53,21 @@ public:
   void Visit(const WaypointPtr &waypoint) override;
 };
 
+/**
+ * Apply a longer name filter to a list which was built by
+ * #WaypointListBuilder, instead of building it again.  The new
+ * #WaypointFilter must differ from the old one only by characters
+ * appended to its name.  The result is the same as with a new
+ * #WaypointListBuilder.
+ *
+ * @param old_name the name filter the list was built with
+ * @param sorted_by_name true if the list has the order of
+ * Waypoints::VisitNameContaining() (i.e. it was not sorted by
+ * distance)
+ */
+void
+RefineWaypointList(WaypointList &list, const WaypointFilter &filter,
+                   const TCHAR *old_name, bool sorted_by_name);
 
 
 #endif
@@ -31,9 +31,31 @@ Copyright_License {
 #include "WaypointFileType.hpp"
 #include "IO/ZipLineReader.hpp"
 #include "IO/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "Thread/FunctionThread.hpp"
+#include "OS/ProcessorCount.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
 
+#include <algorithm>
+#include <list>
 #include <memory>
 
+/**
+ * Files smaller than this (in bytes) are always parsed in the calling
+ * thread.
+ */
+static constexpr long PARALLEL_MIN_SIZE = 256 * 1024;
+
+/**
+ * Do not split a file into chunks with fewer lines than this.
+ */
+static constexpr size_t PARALLEL_MIN_CHUNK_LINES = 4096;
+
+/**
+ * The maximum number of threads parsing one file by default.
+ */
+static constexpr unsigned PARALLEL_MAX_THREADS = 8;
+
 static WaypointReaderBase *
 CreateWaypointReader(WaypointFileType type, WaypointFactory factory)
 {
@@ -63,10 +85,156 @@ CreateWaypointReader(WaypointFileType type, WaypointFactory factory)
   return nullptr;
 }
 
-bool
-ReadWaypointFile(Path path, WaypointFileType file_type,
-                 Waypoints &way_points,
-                 WaypointFactory factory, OperationEnvironment &operation)
+/**
+ * The lines of a file, stored in one contiguous buffer.
+ */
+class LineBuffer {
+  std::vector<TCHAR> buffer;
+  std::vector<size_t> offsets;
+
+public:
+  /**
+   * Read all remaining lines from the given reader.
+   */
+  void Load(TLineReader &reader, OperationEnvironment &operation) {
+    const long filesize = std::max(reader.GetSize(), 1l);
+    buffer.reserve(filesize);
+
+    const TCHAR *line;
+    for (unsigned i = 0; (line = reader.ReadLine()) != nullptr; i++) {
+      offsets.push_back(buffer.size());
+      buffer.insert(buffer.end(), line, line + _tcslen(line) + 1);
+
+      if ((i & 0x3ff) == 0)
+        operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+    }
+  }
+
+  size_t size() const {
+    return offsets.size();
+  }
+
+  const TCHAR *operator[](size_t i) const {
+    return buffer.data() + offsets[i];
+  }
+};
+
+/**
+ * Parse the lines in the range [begin, end) of the given buffer.
+ */
+static void
+ParseLines(WaypointReaderBase &reader, const LineBuffer &lines,
+           size_t begin, size_t end, std::vector<Waypoint> &waypoints)
+{
+  for (size_t i = begin; i != end && !reader.IsFinished(); ++i)
+    reader.ParseLine(lines[i], waypoints);
+}
+
+void
+ParseWaypointFile(WaypointReaderBase &reader, TLineReader &line_reader,
+                  std::vector<Waypoint> &waypoints, unsigned max_threads,
+                  OperationEnvironment &operation)
+{
+  if (max_threads < 2 || line_reader.GetSize() < PARALLEL_MIN_SIZE) {
+    reader.Parse(waypoints, line_reader, operation);
+    return;
+  }
+
+  /* the header is parsed in this thread, it may change the state of
+     the reader */
+  const TCHAR *header = line_reader.ReadLine();
+  if (header == nullptr)
+    return;
+
+  reader.ParseLine(header, waypoints);
+
+  std::unique_ptr<WaypointReaderBase> probe(reader.Fork());
+  if (!probe) {
+    reader.Parse(waypoints, line_reader, operation);
+    return;
+  }
+
+  operation.SetProgressRange(100);
+
+  LineBuffer lines;
+  lines.Load(line_reader, operation);
+
+  const unsigned n_chunks =
+    std::max(std::min(size_t(max_threads),
+                      lines.size() / PARALLEL_MIN_CHUNK_LINES),
+             size_t(1));
+  const size_t chunk_size = (lines.size() + n_chunks - 1) / n_chunks;
+
+  struct Chunk {
+    std::unique_ptr<WaypointReaderBase> reader;
+    std::vector<Waypoint> waypoints;
+  };
+
+  /* the first chunk is parsed by this thread with the original
+     reader; the others by copies, which must be created before the
+     original reader continues */
+  std::list<Chunk> chunks;
+  std::list<FunctionThread> threads;
+  for (unsigned i = 1; i < n_chunks; ++i) {
+    const size_t begin = i * chunk_size;
+    const size_t end = std::min(begin + chunk_size, lines.size());
+
+    chunks.emplace_back();
+    Chunk &chunk = chunks.back();
+    chunk.reader.reset(i == 1 ? probe.release() : reader.Fork());
+
+    threads.emplace_back([&chunk, &lines, begin, end](){
+        ParseLines(*chunk.reader, lines, begin, end, chunk.waypoints);
+      }, "WaypointParser");
+  }
+
+  for (auto &thread : threads)
+    thread.StartOrRun();
+
+  ParseLines(reader, lines, 0, std::min(chunk_size, lines.size()), waypoints);
+
+  for (auto &thread : threads)
+    thread.Wait();
+
+  /* concatenate the results in file order; after a chunk which
+     reached the end of the waypoint list, all others are garbage */
+  bool finished = reader.IsFinished();
+  for (auto &chunk : chunks) {
+    if (finished)
+      break;
+
+    waypoints.insert(waypoints.end(),
+                     std::make_move_iterator(chunk.waypoints.begin()),
+                     std::make_move_iterator(chunk.waypoints.end()));
+    finished = chunk.reader->IsFinished();
+  }
+}
+
+static void
+ParseWaypointFile(WaypointReaderBase &reader, TLineReader &line_reader,
+                  std::vector<Waypoint> &waypoints,
+                  OperationEnvironment &operation)
+{
+  ParseWaypointFile(reader, line_reader, waypoints,
+                    std::min(GetProcessorCount(), PARALLEL_MAX_THREADS),
+                    operation);
+}
+
+static void
+ParseWaypointFile(WaypointReaderBase &reader, TLineReader &line_reader,
+                  Waypoints &way_points, OperationEnvironment &operation)
+{
+  std::vector<Waypoint> parsed;
+  ParseWaypointFile(reader, line_reader, parsed, operation);
+
+  for (auto &i : parsed)
+    way_points.Append(std::move(i));
+}
+
+template<typename W>
+static bool
+ReadWaypointFileT(Path path, WaypointFileType file_type, W &way_points,
+                  WaypointFactory factory, OperationEnvironment &operation)
 try {
   std::unique_ptr<WaypointReaderBase> reader(CreateWaypointReader(file_type,
                                                                   factory));
@@ -74,12 +242,46 @@ try {
     return false;
 
   FileLineReader line_reader(path, Charset::AUTO);
-  reader->Parse(way_points, line_reader, operation);
+  ParseWaypointFile(*reader, line_reader, way_points, operation);
+  return true;
+} catch (...) {
+  return false;
+}
+
+template<typename W>
+static bool
+ReadWaypointFileT(struct zzip_dir *dir, const char *path,
+                  WaypointFileType file_type, W &way_points,
+                  WaypointFactory factory, OperationEnvironment &operation)
+try {
+  std::unique_ptr<WaypointReaderBase> reader(CreateWaypointReader(file_type,
+                                                                  factory));
+  if (!reader)
+    return false;
+
+  ZipLineReader line_reader(dir, path, Charset::AUTO);
+  ParseWaypointFile(*reader, line_reader, way_points, operation);
   return true;
 } catch (...) {
   return false;
 }
 
+bool
+ReadWaypointFile(Path path, WaypointFileType file_type,
+                 Waypoints &way_points,
+                 WaypointFactory factory, OperationEnvironment &operation)
+{
+  return ReadWaypointFileT(path, file_type, way_points, factory, operation);
+}
+
+bool
+ReadWaypointFile(Path path, WaypointFileType file_type,
+                 std::vector<Waypoint> &waypoints,
+                 WaypointFactory factory, OperationEnvironment &operation)
+{
+  return ReadWaypointFileT(path, file_type, waypoints, factory, operation);
+}
+
 bool
 ReadWaypointFile(Path path, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation)
@@ -92,15 +294,17 @@ bool
 ReadWaypointFile(struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation)
-try {
-  std::unique_ptr<WaypointReaderBase> reader(CreateWaypointReader(file_type,
-                                                                  factory));
-  if (!reader)
-    return false;
+{
+  return ReadWaypointFileT(dir, path, file_type, way_points,
+                           factory, operation);
+}
 
-  ZipLineReader line_reader(dir, path, Charset::AUTO);
-  reader->Parse(way_points, line_reader, operation);
-  return true;
-} catch (...) {
-  return false;
+bool
+ReadWaypointFile(struct zzip_dir *dir, const char *path,
+                 WaypointFileType file_type,
+                 std::vector<Waypoint> &waypoints,
+                 WaypointFactory factory, OperationEnvironment &operation)
+{
+  return ReadWaypointFileT(dir, path, file_type, waypoints,
+                           factory, operation);
 }
@@ -25,20 +25,47 @@ Copyright_License {
 #ifndef WAYPOINT_READER_HPP
 #define WAYPOINT_READER_HPP
 
+#include <vector>
 #include <cstdint>
 
 enum class WaypointFileType: uint8_t;
 struct zzip_dir;
+struct Waypoint;
 class Path;
+class TLineReader;
+class WaypointReaderBase;
 class Waypoints;
 class WaypointFactory;
 class OperationEnvironment;
 
+/**
+ * Parse a whole file.  If it is large and its format allows it (see
+ * WaypointReaderBase::Fork()), the lines after the header are split
+ * into chunks which are parsed concurrently.  The resulting list is
+ * the same as with WaypointReaderBase::Parse().
+ *
+ * @param max_threads the maximum number of threads (including the
+ * calling thread) to be used
+ */
+void
+ParseWaypointFile(WaypointReaderBase &reader, TLineReader &line_reader,
+                  std::vector<Waypoint> &waypoints, unsigned max_threads,
+                  OperationEnvironment &operation);
+
 bool
 ReadWaypointFile(Path path, WaypointFileType file_type,
                  Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation);
 
+/**
+ * Parse a waypoint file into a vector, without touching a shared
+ * #Waypoints instance.  This may be called in a worker thread.
+ */
+bool
+ReadWaypointFile(Path path, WaypointFileType file_type,
+                 std::vector<Waypoint> &waypoints,
+                 WaypointFactory factory, OperationEnvironment &operation);
+
 bool
 ReadWaypointFile(Path path, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation);
@@ -48,4 +75,10 @@ ReadWaypointFile(struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation);
 
+bool
+ReadWaypointFile(struct zzip_dir *dir, const char *path,
+                 WaypointFileType file_type,
+                 std::vector<Waypoint> &waypoints,
+                 WaypointFactory factory, OperationEnvironment &operation);
+
 #endif
@@ -24,10 +24,23 @@ Copyright_License {
 #include "WaypointReaderBase.hpp"
 #include "Operation/Operation.hpp"
 #include "IO/LineReader.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
 
 void
 WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
                           OperationEnvironment &operation)
+{
+  std::vector<Waypoint> parsed;
+  Parse(parsed, reader, operation);
+
+  for (auto &i : parsed)
+    way_points.Append(std::move(i));
+}
+
+void
+WaypointReaderBase::Parse(std::vector<Waypoint> &way_points,
+                          TLineReader &reader,
+                          OperationEnvironment &operation)
 {
   const long filesize = std::max(reader.GetSize(), 1l);
   operation.SetProgressRange(100);
@@ -27,6 +27,8 @@ Copyright_License {
 
 #include "Factory.hpp"
 
+#include <vector>
+
 #include <tchar.h>
 
 class Waypoints;
@@ -53,16 +55,43 @@ public:
   void Parse(Waypoints &way_points, TLineReader &reader,
              OperationEnvironment &operation);
 
-protected:
+  /**
+   * Parses a waypoint file into the given vector.  Unlike the
+   * #Waypoints overload, this does not need any shared state and may
+   * be called in a worker thread.
+   */
+  void Parse(std::vector<Waypoint> &waypoints, TLineReader &reader,
+             OperationEnvironment &operation);
+
+  /**
+   * Create a copy of this object which continues parsing at the
+   * current position.  It is used to parse the rest of a large file
+   * in independent chunks after the header has been parsed.
+   *
+   * @return a new object or nullptr if this file format does not
+   * allow parsing lines out of order
+   */
+  virtual WaypointReaderBase *Fork() const {
+    return nullptr;
+  }
+
+  /**
+   * Have all waypoints been parsed, i.e. will all following lines
+   * be ignored?
+   */
+  virtual bool IsFinished() const {
+    return false;
+  }
+
   /**
    * Parse a file line
    * @param line The line to parse
-   * @param linenum The line number in the file
    * @param way_points The waypoint list to fill
    * @return True if the line was parsed correctly or ignored, False if
    * parsing error occured
    */
-  virtual bool ParseLine(const TCHAR* line, Waypoints &way_points) = 0;
+  virtual bool ParseLine(const TCHAR *line,
+                         std::vector<Waypoint> &way_points) = 0;
 };
 
 #endif
@@ -22,9 +22,10 @@ Copyright_License {
 */
 
 #include "WaypointReaderCompeGPS.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "IO/LineReader.hpp"
 #include "Geo/UTM.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/StringAPI.hxx"
 
 static bool
 ParseAngle(const TCHAR *&src, Angle &angle)
@@ -139,7 +140,8 @@ ParseAltitude(const TCHAR *&src, double &dest)
 }
 
 bool
-WaypointReaderCompeGPS::ParseLine(const TCHAR *line, Waypoints &waypoints)
+WaypointReaderCompeGPS::ParseLine(const TCHAR *line,
+                                  std::vector<Waypoint> &waypoints)
 {
   /*
    * G  WGS 84
@@ -226,7 +228,7 @@ WaypointReaderCompeGPS::ParseLine(const TCHAR *line, Waypoints &waypoints)
   // Parse waypoint name
   waypoint.comment.assign(line);
 
-  waypoints.Append(std::move(waypoint));
+  waypoints.emplace_back(std::move(waypoint));
   return true;
 }
 
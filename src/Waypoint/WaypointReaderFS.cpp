@@ -22,9 +22,10 @@ Copyright_License {
 */
 
 #include "WaypointReaderFS.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "Geo/UTM.hpp"
 #include "IO/LineReader.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/StringAPI.hxx"
 
 #include <stdlib.h>
 
@@ -145,7 +146,8 @@ ParseString(const TCHAR *src, tstring &dest, unsigned len = 0)
 }
 
 bool
-WaypointReaderFS::ParseLine(const TCHAR *line, Waypoints &way_points)
+WaypointReaderFS::ParseLine(const TCHAR *line,
+                            std::vector<Waypoint> &way_points)
 {
   //$FormatGEO
   //ACONCAGU  S 32 39 12.00    W 070 00 42.00  6962  Aconcagua
@@ -195,7 +197,7 @@ WaypointReaderFS::ParseLine(const TCHAR *line, Waypoints &way_points)
   if (len > (is_utm ? 38 : 47))
     ParseString(line + (is_utm ? 38 : 47), new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.emplace_back(std::move(new_waypoint));
   return true;
 }
 
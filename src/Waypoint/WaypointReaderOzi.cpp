@@ -22,12 +22,13 @@ Copyright_License {
 */
 
 #include "WaypointReaderOzi.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "IO/LineReader.hpp"
 #include "Units/System.hpp"
 #include "Util/Macros.hpp"
 #include "Util/ExtractParameters.hpp"
 #include "Util/StringStrip.hxx"
+#include "Util/StringCompare.hxx"
+#include "Util/StringAPI.hxx"
 
 #include <stdlib.h>
 
@@ -68,7 +69,8 @@ ParseString(const TCHAR *src, tstring &dest)
 }
 
 bool
-WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
+WaypointReaderOzi::ParseLine(const TCHAR *line,
+                             std::vector<Waypoint> &way_points)
 {
   if (line[0] == '\0')
     return true;
@@ -122,7 +124,7 @@ WaypointReaderOzi::ParseLine(const TCHAR *line, Waypoints &way_points)
   // Description
   ParseString(params[10], new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.emplace_back(std::move(new_waypoint));
   return true;
 }
 
@@ -23,9 +23,10 @@ Copyright_License {
 
 #include "WaypointReaderSeeYou.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
 #include "Util/ExtractParameters.hpp"
 #include "Util/Macros.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/StringAPI.hxx"
 
 #include <stdlib.h>
 
@@ -160,7 +161,8 @@ ParseStyle(const TCHAR* src, Waypoint::Type &type)
 }
 
 bool
-WaypointReaderSeeYou::ParseLine(const TCHAR* line, Waypoints &waypoints)
+WaypointReaderSeeYou::ParseLine(const TCHAR* line,
+                                std::vector<Waypoint> &waypoints)
 {
   enum {
     iName = 0,
@@ -291,6 +293,6 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, Waypoints &waypoints)
     new_waypoint.comment = params[iDescription];
   }
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.emplace_back(std::move(new_waypoint));
   return true;
 }
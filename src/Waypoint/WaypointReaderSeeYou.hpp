@@ -46,9 +46,18 @@ public:
   explicit WaypointReaderSeeYou(WaypointFactory _factory)
     :WaypointReaderBase(_factory) {}
 
-protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const TCHAR* line, Waypoints &way_points) override;
+  WaypointReaderBase *Fork() const override {
+    /* the header line must have been seen already */
+    return first ? nullptr : new WaypointReaderSeeYou(*this);
+  }
+
+  bool IsFinished() const override {
+    return ignore_following;
+  }
+
+  bool ParseLine(const TCHAR* line,
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
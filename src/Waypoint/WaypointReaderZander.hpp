@@ -33,7 +33,8 @@ public:
 
 protected:
   /* virtual methods from class WaypointReaderBase */
-  bool ParseLine(const TCHAR *line, Waypoints &way_points) override;
+  bool ParseLine(const TCHAR *line,
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
@@ -0,0 +1,152 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program compares the line-by-line IGC parser (FileLineReader
+ * and IGCParseFix()) with the memory-mapped bulk reader
+ * (IGCReadFixes()) and verifies that both produce the same fixes.
+ *
+ * Example: BenchmarkIGCParser test/data/*.igc
+ */
+
+#include "IGC/IGCBulkReader.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/Args.hpp"
+#include "OS/Path.hpp"
+#include "Util/PrintException.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** number of passes over each input file */
+static constexpr unsigned N_PASSES = 20;
+
+typedef std::chrono::steady_clock Clock;
+
+static void
+ReadLines(Path path, std::vector<IGCFix> &fixes)
+{
+  FileLineReaderA reader(path);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  const char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] == 'B') {
+      IGCFix fix;
+      if (IGCParseFix(line, extensions, fix))
+        fixes.push_back(fix);
+    } else if (line[0] == 'I')
+      IGCParseExtensions(line, extensions);
+  }
+}
+
+static bool
+Equals(const IGCFix &a, const IGCFix &b)
+{
+  return a.time == b.time && a.location == b.location &&
+    a.gps_valid == b.gps_valid &&
+    a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm &&
+    a.hdm == b.hdm && a.hdt == b.hdt && a.trm == b.trm && a.trt == b.trt &&
+    a.gsp == b.gsp && a.ias == b.ias && a.tas == b.tas &&
+    a.siu == b.siu;
+}
+
+static double
+ToMicroseconds(Clock::duration d)
+{
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+static bool
+Run(Path path)
+{
+  std::vector<IGCFix> expected;
+  ReadLines(path, expected);
+
+  IGCFixColumns columns;
+  if (!IGCReadFixes(path, columns)) {
+    fprintf(stderr, "Failed to map %s\n", path.c_str());
+    return false;
+  }
+
+  if (columns.size() != expected.size()) {
+    fprintf(stderr, "%s: %u fixes, expected %u\n", path.c_str(),
+            unsigned(columns.size()), unsigned(expected.size()));
+    return false;
+  }
+
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (!Equals(columns[i], expected[i])) {
+      fprintf(stderr, "%s: fix %u differs\n", path.c_str(), unsigned(i));
+      return false;
+    }
+  }
+
+  if (expected.empty()) {
+    printf("%-40s no fixes\n", path.c_str());
+    return true;
+  }
+
+  auto start = Clock::now();
+  for (unsigned pass = 0; pass < N_PASSES; ++pass) {
+    std::vector<IGCFix> fixes;
+    ReadLines(path, fixes);
+  }
+  const double lines_us = ToMicroseconds(Clock::now() - start);
+
+  start = Clock::now();
+  for (unsigned pass = 0; pass < N_PASSES; ++pass) {
+    IGCFixColumns fixes;
+    IGCReadFixes(path, fixes);
+  }
+  const double bulk_us = ToMicroseconds(Clock::now() - start);
+
+  const unsigned n = N_PASSES * expected.size();
+  printf("%-40s %6u fixes, lines %6.3f us, bulk %6.3f us per fix\n",
+         path.c_str(), unsigned(expected.size()), lines_us / n, bulk_us / n);
+  return true;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc...");
+
+  bool success = true;
+  do {
+    success = Run(args.ExpectNextPath()) && success;
+  } while (!args.IsEmpty());
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,155 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program feeds recorded NMEA logs through the same path as a
+ * device port (PortLineSplitter, checksum verification and
+ * NMEAParser) and measures how long each stage takes per line.
+ */
+
+#include "Device/Util/LineSplitter.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "IO/FileReader.hxx"
+#include "OS/Args.hpp"
+#include "OS/Path.hpp"
+#include "Util/PrintException.hxx"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** number of passes over all input files */
+static constexpr unsigned N_PASSES = 20;
+
+/** the size of the chunks passed to PortLineSplitter, similar to
+    what a serial port delivers at 115200 baud */
+static constexpr size_t CHUNK_SIZE = 64;
+
+typedef std::chrono::steady_clock Clock;
+
+class CollectLines final : public PortLineSplitter {
+public:
+  std::vector<std::string> *lines = nullptr;
+  unsigned n_lines = 0;
+
+protected:
+  /* virtual methods from class PortLineHandler */
+  bool LineReceived(const char *line) noexcept override {
+    ++n_lines;
+    if (lines != nullptr)
+      lines->emplace_back(line);
+    return true;
+  }
+};
+
+static void
+LoadFile(Path path, std::string &data)
+{
+  FileReader reader(path);
+
+  char buffer[4096];
+  size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    data.append(buffer, nbytes);
+}
+
+static void
+Split(CollectLines &splitter, const std::string &data)
+{
+  for (size_t i = 0; i < data.size(); i += CHUNK_SIZE)
+    splitter.DataReceived(data.data() + i,
+                          std::min(CHUNK_SIZE, data.size() - i));
+}
+
+static void
+PrintTiming(const char *name, unsigned n, Clock::duration duration)
+{
+  printf("%-10s %8u lines, %8.3f us per line\n", name, n,
+         std::chrono::duration<double, std::micro>(duration).count() / n);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE...");
+
+  std::string data;
+  do {
+    LoadFile(args.ExpectNextPath(), data);
+  } while (!args.IsEmpty());
+
+  /* split once to collect the lines for the following stages */
+  std::vector<std::string> lines;
+  {
+    CollectLines splitter;
+    splitter.lines = &lines;
+    Split(splitter, data);
+  }
+
+  if (lines.empty()) {
+    fprintf(stderr, "No lines found\n");
+    return EXIT_FAILURE;
+  }
+
+  CollectLines splitter;
+  auto start = Clock::now();
+  for (unsigned pass = 0; pass < N_PASSES; ++pass)
+    Split(splitter, data);
+  PrintTiming("split", splitter.n_lines, Clock::now() - start);
+
+  unsigned n_valid = 0;
+  start = Clock::now();
+  for (unsigned pass = 0; pass < N_PASSES; ++pass)
+    for (const auto &line : lines)
+      if (VerifyNMEAChecksum(line.c_str()))
+        ++n_valid;
+  PrintTiming("checksum", N_PASSES * lines.size(), Clock::now() - start);
+
+  NMEAParser parser;
+  NMEAInfo info;
+  info.Reset();
+  info.clock = 1;
+
+  unsigned n_parsed = 0;
+  start = Clock::now();
+  for (unsigned pass = 0; pass < N_PASSES; ++pass) {
+    parser.Reset();
+    for (const auto &line : lines) {
+      if (parser.ParseLine(line.c_str(), info))
+        ++n_parsed;
+      info.clock += 0.1;
+    }
+  }
+  PrintTiming("parse", N_PASSES * lines.size(), Clock::now() - start);
+
+  printf("%u of %u lines with valid checksum, %u parsed\n",
+         n_valid / N_PASSES, unsigned(lines.size()), n_parsed / N_PASSES);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program flies a synthetic flight through a 6-point task with
+ * all kinds of observation zones and measures how long
+ * OrderedTask::Update() takes per fix, before the start (where the
+ * best start point is searched on every fix) and on course.
+ */
+
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Settings.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/ASTPoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/SymmetricSectorZone.hpp"
+#include "Engine/Task/ObservationZones/KeyholeZone.hpp"
+#include "Engine/Task/ObservationZones/AnnularSectorZone.hpp"
+#include "Engine/Task/Points/TaskWaypoint.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** ground speed of the synthetic flight [m/s] */
+static constexpr double SPEED = 30;
+
+/** duration of the flight around the start before the start [s] */
+static constexpr unsigned PRE_START_TIME = 3600;
+
+/** number of passes over the whole flight */
+static constexpr unsigned N_PASSES = 10;
+
+typedef std::chrono::steady_clock Clock;
+
+static GeoPoint
+MakeGeoPoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude),
+                  Angle::Degrees(latitude));
+}
+
+static WaypointPtr
+MakeWaypointPtr(const GeoPoint &location)
+{
+  Waypoint wp(location);
+  wp.elevation = 50;
+  return WaypointPtr(new Waypoint(std::move(wp)));
+}
+
+static const GeoPoint locations[] = {
+  MakeGeoPoint(0, 45),
+  MakeGeoPoint(0.4, 45.8),
+  MakeGeoPoint(1.2, 45.6),
+  MakeGeoPoint(1.0, 44.9),
+  MakeGeoPoint(0.2, 44.8),
+  MakeGeoPoint(0, 45.05),
+};
+
+static constexpr unsigned N_POINTS =
+  sizeof(locations) / sizeof(locations[0]);
+
+static void
+MakeTask(OrderedTask &task, const TaskBehaviour &task_behaviour)
+{
+  const OrderedTaskSettings &settings = task.GetOrderedTaskSettings();
+
+  task.Append(StartPoint(new CylinderZone(locations[0], 5000),
+                         MakeWaypointPtr(locations[0]), task_behaviour,
+                         settings.start_constraints));
+  task.Append(ASTPoint(SymmetricSectorZone::CreateFAISectorZone(locations[1],
+                                                                false),
+                       MakeWaypointPtr(locations[1]), task_behaviour));
+  task.Append(ASTPoint(KeyholeZone::CreateDAeCKeyholeZone(locations[2]),
+                       MakeWaypointPtr(locations[2]), task_behaviour));
+  task.Append(ASTPoint(new AnnularSectorZone(locations[3], 5000,
+                                             Angle::Degrees(-45),
+                                             Angle::Degrees(200), 1000),
+                       MakeWaypointPtr(locations[3]), task_behaviour));
+  task.Append(ASTPoint(new CylinderZone(locations[4], 500),
+                       MakeWaypointPtr(locations[4]), task_behaviour));
+  task.Append(FinishPoint(new LineSectorZone(locations[5], 1000),
+                          MakeWaypointPtr(locations[5]), task_behaviour,
+                          settings.finish_constraints, false));
+
+  task.SetActiveTaskPoint(0);
+  task.UpdateGeometry();
+}
+
+struct Timing {
+  unsigned n_fixes = 0;
+  Clock::duration duration = Clock::duration::zero();
+
+  void Print(const char *name) const {
+    printf("%-10s %6u fixes, %8.2f us per fix\n", name, n_fixes,
+           std::chrono::duration<double, std::micro>(duration).count()
+           / n_fixes);
+  }
+};
+
+static void
+Update(OrderedTask &task, const AircraftState &state,
+       const AircraftState &last, const GlidePolar &glide_polar,
+       Timing &timing)
+{
+  const auto start = Clock::now();
+  task.Update(state, last, glide_polar);
+  timing.duration += Clock::now() - start;
+  ++timing.n_fixes;
+}
+
+static bool
+Run(Timing &pre_start, Timing &on_course)
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  const GlidePolar glide_polar(1.5);
+
+  OrderedTask task(task_behaviour);
+  MakeTask(task, task_behaviour);
+  if (!task.CheckTask()) {
+    fprintf(stderr, "invalid task\n");
+    return false;
+  }
+
+  AircraftState state;
+  state.Reset();
+  state.location = locations[0];
+  state.altitude = 1500;
+  state.time = 10 * 3600;
+  state.flying = true;
+  state.ground_speed = state.true_airspeed = SPEED;
+
+  /* circle inside the start zone */
+  for (unsigned i = 0; i < PRE_START_TIME; ++i) {
+    const AircraftState last = state;
+    state.time += 1;
+    state.track = Angle::Degrees(i * 2);
+    state.location = GeoVector(3000, state.track).EndPoint(locations[0]);
+    Update(task, state, last, glide_polar, pre_start);
+  }
+
+  /* fly through all turn points; advance manually, the benchmark
+     does not depend on the transition logic */
+  for (unsigned active = 1; active < N_POINTS; ++active) {
+    task.SetActiveTaskPoint(active);
+
+    const GeoPoint &target = locations[active];
+    while (true) {
+      const AircraftState last = state;
+      const GeoVector vector = state.location.DistanceBearing(target);
+      state.time += 1;
+      state.track = vector.bearing;
+      state.location = vector.distance <= SPEED
+        ? target
+        : state.location.IntermediatePoint(target, SPEED);
+
+      Update(task, state, last, glide_polar, on_course);
+
+      if (state.location == target)
+        break;
+    }
+  }
+
+  return true;
+}
+
+int
+main(int argc, char **argv)
+{
+  Timing pre_start, on_course;
+
+  for (unsigned i = 0; i < N_PASSES; ++i)
+    if (!Run(pre_start, on_course))
+      return EXIT_FAILURE;
+
+  pre_start.Print("pre-start");
+  on_course.Print("on course");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Usage: BenchmarkRasterBands [THREADS]
+ *
+ * Draws a sequence of map-like frames (a stretched terrain bitmap
+ * and large topography polygons) with the given number of
+ * #BandPool worker threads.  Compare the run time with "time"
+ * against THREADS=0.
+ */
+
+#include "Screen/Memory/RasterCanvas.hpp"
+#include "Screen/Memory/PixelTraits.hpp"
+#include "Screen/Memory/BandPool.hpp"
+
+#include <vector>
+
+#include <stdlib.h>
+
+typedef BGRAPixelTraits Traits;
+typedef RasterCanvas<Traits> BenchmarkCanvas;
+
+static constexpr unsigned WIDTH = 800, HEIGHT = 480;
+
+int main(int argc, char **argv)
+{
+  BandPool::Initialise(argc > 1 ? strtoul(argv[1], nullptr, 10) : 0);
+
+  WritableImageBuffer<Traits> frame;
+  frame.Allocate(WIDTH, HEIGHT);
+
+  /* the terrain renderer draws at half resolution */
+  std::vector<BGRA8Color> terrain((WIDTH / 2) * (HEIGHT / 2));
+  for (auto &i : terrain)
+    i = BGRA8Color(rand(), rand(), rand());
+
+  std::vector<std::vector<PixelPoint>> polygons(20);
+  for (auto &polygon : polygons) {
+    polygon.resize(200);
+    for (auto &p : polygon) {
+      p.x = int(rand() % (2 * WIDTH)) - int(WIDTH / 2);
+      p.y = int(rand() % (2 * HEIGHT)) - int(HEIGHT / 2);
+    }
+  }
+
+  for (unsigned i = 0; i < 50; ++i) {
+    BandPool::Run(0, HEIGHT, WIDTH, [&](int top, int bottom){
+        BenchmarkCanvas canvas(frame);
+        canvas.ScaleRectangle(0, 0, WIDTH, HEIGHT,
+                              terrain.data(),
+                              (WIDTH / 2) * sizeof(BGRA8Color),
+                              WIDTH / 2, HEIGHT / 2,
+                              top, bottom);
+      });
+
+    for (const auto &polygon : polygons) {
+      const BGRA8Color color(rand(), rand(), rand());
+      BandPool::Run(0, HEIGHT, WIDTH, [&](int top, int bottom){
+          BenchmarkCanvas canvas(frame);
+          canvas.FillPolygon(polygon.data(), polygon.size(), color,
+                             top, bottom);
+        });
+    }
+  }
+
+  frame.Free();
+  BandPool::Deinitialise();
+  return 0;
+}
@@ -0,0 +1,185 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+
+/*
+ * This program replays a flight and solves a terrain route back to
+ * the first fix every few seconds, once without and once with the
+ * terrain clearance cache, and compares the solve times.
+ */
+
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "IO/ZipArchive.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Args.hpp"
+#include "DebugReplay.hpp"
+#include "Util/PrintException.hxx"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+
+/** solve interval (s), same as RouteComputer::PERIOD */
+static constexpr double SOLVE_INTERVAL = 5;
+
+struct BenchmarkResult {
+  std::chrono::steady_clock::duration duration{};
+  std::vector<Route> solutions;
+  unsigned hits = 0, misses = 0;
+};
+
+static BenchmarkResult
+Run(const RasterMap &map, const AGeoPoint &home,
+    const std::vector<AGeoPoint> &fixes, bool cache)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::TERRAIN;
+  config.clearance_cache = cache;
+
+  GlidePolar polar(1);
+  const SpeedVector wind(Angle::Degrees(270), 5);
+
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, wind);
+  route.SetTerrain(&map);
+
+  BenchmarkResult result;
+  result.solutions.reserve(fixes.size());
+
+  for (const auto &fix : fixes) {
+    const auto start = std::chrono::steady_clock::now();
+    route.Solve(home, fix, config);
+    result.duration += std::chrono::steady_clock::now() - start;
+    result.solutions.push_back(route.GetSolution());
+  }
+
+  result.hits = route.GetClearanceCache().GetHits();
+  result.misses = route.GetClearanceCache().GetMisses();
+  return result;
+}
+
+static bool
+IsEqual(const Route &a, const Route &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (!(a[i] == b[i]) || a[i].altitude != b[i].altitude)
+      return false;
+
+  return true;
+}
+
+static void
+Print(const char *name, const BenchmarkResult &result)
+{
+  const auto us = std::chrono::duration_cast<std::chrono::microseconds>(result.duration).count();
+  printf("%s: %u solutions, total %ld us, %ld us per solution",
+         name, (unsigned)result.solutions.size(), (long)us,
+         result.solutions.empty() ? 0l : long(us / result.solutions.size()));
+  if (result.hits + result.misses > 0)
+    printf(", cache hits %u misses %u", result.hits, result.misses);
+  printf("\n");
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAP.xcm DRIVER FILE");
+  const auto map_path = args.ExpectNextPath();
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  std::vector<AGeoPoint> fixes;
+  double last_time = -1;
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.location_available || !basic.NavAltitudeAvailable())
+      continue;
+
+    if (last_time >= 0 && basic.time < last_time + SOLVE_INTERVAL)
+      continue;
+
+    last_time = basic.time;
+    fixes.emplace_back(basic.location, basic.nav_altitude);
+  }
+
+  if (fixes.empty()) {
+    fprintf(stderr, "No fixes\n");
+    return EXIT_FAILURE;
+  }
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+  NullOperationEnvironment operation;
+  if (!LoadTerrainOverview(archive.get(), map.GetTileCache(), operation)) {
+    fprintf(stderr, "Failed to load terrain\n");
+    return EXIT_FAILURE;
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+                       map.GetProjection(), fixes.front(), 100000);
+  } while (map.IsDirty());
+
+  /* route home to the first fix */
+  const AGeoPoint home(fixes.front(),
+                       map.GetHeight(fixes.front()).GetValueOr0() + 300);
+
+  const auto uncached = Run(map, home, fixes, false);
+  Print("uncached", uncached);
+
+  const auto cached = Run(map, home, fixes, true);
+  Print("cached", cached);
+
+  unsigned n_different = 0;
+  for (unsigned i = 0; i < fixes.size(); ++i)
+    if (!IsEqual(uncached.solutions[i], cached.solutions[i]))
+      ++n_different;
+
+  if (n_different > 0) {
+    fprintf(stderr, "%u solutions differ\n", n_different);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
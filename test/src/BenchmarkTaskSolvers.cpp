@@ -0,0 +1,211 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program flies a synthetic flight through a racing task and
+ * an AAT task and counts how many MacCready::Solve() calls the
+ * GlideResultCache saves the task solvers.
+ */
+
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Settings.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/ASTPoint.hpp"
+#include "Engine/Task/Ordered/Points/AATPoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/Factory/TaskFactoryType.hpp"
+#include "Engine/Task/Points/TaskWaypoint.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/GlideSolvers/GlideResultCache.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** ground speed of the synthetic flight [m/s] */
+static constexpr double SPEED = 30;
+
+/** the glider sinks between these altitudes, then climbs again */
+static constexpr double MAX_ALTITUDE = 2000, MIN_ALTITUDE = 700;
+
+static GeoPoint
+MakeGeoPoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude),
+                  Angle::Degrees(latitude));
+}
+
+static WaypointPtr
+MakeWaypointPtr(double longitude, double latitude)
+{
+  Waypoint wp(MakeGeoPoint(longitude, latitude));
+  wp.elevation = 50;
+  return WaypointPtr(new Waypoint(std::move(wp)));
+}
+
+static const GeoPoint locations[] = {
+  MakeGeoPoint(0, 45),
+  MakeGeoPoint(0.4, 45.8),
+  MakeGeoPoint(1.2, 45.6),
+  MakeGeoPoint(1.0, 44.9),
+  MakeGeoPoint(0.2, 44.8),
+  MakeGeoPoint(0, 45.05),
+};
+
+static void
+MakeTask(OrderedTask &task, const TaskBehaviour &task_behaviour,
+         bool aat)
+{
+  OrderedTaskSettings settings = task.GetOrderedTaskSettings();
+  if (aat)
+    settings.aat_min_time = 4 * 3600;
+  task.SetOrderedTaskSettings(settings);
+
+  const unsigned n = sizeof(locations) / sizeof(locations[0]);
+  for (unsigned i = 0; i < n; ++i) {
+    auto wp = MakeWaypointPtr(locations[i].longitude.Degrees(),
+                              locations[i].latitude.Degrees());
+    const GeoPoint location = wp->location;
+
+    if (i == 0)
+      task.Append(StartPoint(new LineSectorZone(location, 1000),
+                             std::move(wp), task_behaviour,
+                             settings.start_constraints));
+    else if (i == n - 1)
+      task.Append(FinishPoint(new LineSectorZone(location, 1000),
+                              std::move(wp), task_behaviour,
+                              settings.finish_constraints, false));
+    else if (aat)
+      task.Append(AATPoint(new CylinderZone(location, 15000),
+                           std::move(wp), task_behaviour));
+    else
+      task.Append(ASTPoint(new CylinderZone(location, 500),
+                           std::move(wp), task_behaviour));
+  }
+
+  task.SetActiveTaskPoint(0);
+  task.UpdateGeometry();
+}
+
+static bool
+Run(const char *name, bool aat)
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  task_behaviour.auto_mc = true;
+  task_behaviour.calc_cruise_efficiency = true;
+  task_behaviour.calc_effective_mc = true;
+  task_behaviour.calc_glide_required = true;
+
+  Waypoints waypoints;
+  TaskManager task_manager(task_behaviour, waypoints);
+  task_manager.SetGlidePolar(GlidePolar(1.5));
+
+  OrderedTask task(task_behaviour);
+  if (aat)
+    task.SetFactory(TaskFactoryType::AAT);
+  MakeTask(task, task_behaviour, aat);
+  if (!task.CheckTask() || !task_manager.Commit(task)) {
+    fprintf(stderr, "%s: invalid task\n", name);
+    return false;
+  }
+
+  AircraftState state;
+  state.Reset();
+  state.location = locations[0];
+  state.altitude = MAX_ALTITUDE;
+  state.time = 10 * 3600;
+  state.flying = true;
+  state.ground_speed = state.true_airspeed = SPEED;
+
+  AircraftState last = state;
+  bool climbing = false;
+  unsigned n_cycles = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned active = 0;
+       task_manager.GetActiveTaskPoint() != nullptr && n_cycles < 100000;
+       ++n_cycles) {
+    const GeoPoint target =
+      task_manager.GetActiveTaskPoint()->GetLocationRemaining();
+    const GeoVector vector = state.location.DistanceBearing(target);
+
+    last = state;
+    state.time += 1;
+
+    if (climbing) {
+      state.altitude += 2;
+      climbing = state.altitude < MAX_ALTITUDE;
+    } else if (vector.distance <= SPEED) {
+      state.location = target;
+      state.altitude -= 1;
+    } else {
+      state.location = state.location.IntermediatePoint(target, SPEED);
+      state.track = vector.bearing;
+      state.altitude -= 1;
+      climbing = state.altitude < MIN_ALTITUDE;
+    }
+
+    task_manager.Update(state, last);
+    task_manager.UpdateAutoMC(state, 1.5);
+    task_manager.UpdateIdle(state);
+
+    if (state.location == target) {
+      /* turn: advance manually, the benchmark does not care about
+         the observation zone logic */
+      if (++active >= task.TaskSize())
+        break;
+
+      task_manager.SetActiveTaskPoint(active);
+    }
+  }
+
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  const GlideResultCache &cache =
+    task_manager.GetOrderedTask().GetGlideResultCache();
+  const unsigned long calls = cache.GetHits() + cache.GetMisses();
+
+  printf("%-7s %u cycles, %.1f ms: %lu Solve() calls without cache, "
+         "%u with cache (%.1f%% saved)\n",
+         name, n_cycles,
+         std::chrono::duration<double, std::milli>(duration).count(),
+         calls, cache.GetMisses(),
+         calls > 0 ? 100. * cache.GetHits() / calls : 0.);
+  return true;
+}
+
+int
+main(int argc, char **argv)
+{
+  if (!Run("racing", false) || !Run("AAT", true))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
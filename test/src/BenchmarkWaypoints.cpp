@@ -0,0 +1,257 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program compares the spatial queries of the QuadTree which
+ * used to index all waypoints with the Morton ordered WaypointIndex,
+ * on a synthetic database of clustered waypoints.
+ */
+
+#include "Engine/Waypoint/WaypointIndex.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "Util/QuadTree.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct WaypointAccessor {
+  gcc_pure
+  int GetX(const WaypointPtr &wp) const {
+    return wp->flat_location.x;
+  }
+
+  gcc_pure
+  int GetY(const WaypointPtr &wp) const {
+    return wp->flat_location.y;
+  }
+};
+
+typedef QuadTree<WaypointPtr, WaypointAccessor> WaypointTree;
+
+/**
+ * Size of the area covered by the waypoints (flat units).  One unit
+ * of the task projection is 1/1000 degree, so this is about
+ * 1100 km.
+ */
+static constexpr int AREA_SIZE = 10000;
+
+/** range of VisitWithinRange() queries, like a zoomed-out map (~20 km) */
+static constexpr unsigned VISIT_RANGE = 180;
+
+/** range of nearest queries (~100 km) */
+static constexpr unsigned NEAREST_RANGE = 900;
+
+static constexpr unsigned N_QUERIES = 20000;
+
+static unsigned
+Random()
+{
+  static uint32_t state = 4711;
+  state = state * 1103515245u + 12345u;
+  return state >> 8;
+}
+
+static int
+RandomCoordinate(int size)
+{
+  return int(Random() % unsigned(size)) - size / 2;
+}
+
+/**
+ * Generate waypoints in clusters, like a turnpoint file merged with
+ * an outlanding database.
+ */
+static std::vector<WaypointPtr>
+GenerateWaypoints(unsigned n)
+{
+  std::vector<WaypointPtr> waypoints;
+  waypoints.reserve(n);
+
+  int cx = 0, cy = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    if (i % 200 == 0) {
+      cx = RandomCoordinate(AREA_SIZE);
+      cy = RandomCoordinate(AREA_SIZE);
+    }
+
+    Waypoint wp(GeoPoint(Angle::Zero(), Angle::Zero()));
+    wp.flat_location = FlatGeoPoint(cx + RandomCoordinate(AREA_SIZE / 20),
+                                    cy + RandomCoordinate(AREA_SIZE / 20));
+    wp.type = i % 4 == 0
+      ? Waypoint::Type::OUTLANDING
+      : Waypoint::Type::NORMAL;
+    waypoints.emplace_back(new Waypoint(std::move(wp)));
+  }
+
+  return waypoints;
+}
+
+static bool
+IsLandable(const Waypoint &wp)
+{
+  return wp.IsLandable();
+}
+
+struct Result {
+  std::chrono::steady_clock::duration visit{}, nearest{}, landable{};
+  unsigned long visited = 0;
+  std::vector<const Waypoint *> found;
+};
+
+static void
+Print(const char *name, const Result &result)
+{
+  printf("%-10s visit %6.1f ms  nearest %6.1f ms  landable %6.1f ms  (%lu visited)\n",
+         name,
+         std::chrono::duration<double, std::milli>(result.visit).count(),
+         std::chrono::duration<double, std::milli>(result.nearest).count(),
+         std::chrono::duration<double, std::milli>(result.landable).count(),
+         result.visited);
+}
+
+static double
+SquareDistance(const Waypoint *wp, const FlatGeoPoint &p)
+{
+  if (wp == nullptr)
+    return -1;
+
+  const double dx = double(wp->flat_location.x) - p.x;
+  const double dy = double(wp->flat_location.y) - p.y;
+  return dx * dx + dy * dy;
+}
+
+int
+main(int argc, char **argv)
+{
+  const unsigned n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 50000;
+  if (n == 0) {
+    fprintf(stderr, "Usage: %s [COUNT]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const auto waypoints = GenerateWaypoints(n);
+
+  std::vector<FlatGeoPoint> queries;
+  queries.reserve(N_QUERIES);
+  for (unsigned i = 0; i < N_QUERIES; ++i)
+    queries.emplace_back(RandomCoordinate(AREA_SIZE),
+                         RandomCoordinate(AREA_SIZE));
+
+  auto start = std::chrono::steady_clock::now();
+  WaypointTree tree;
+  for (const auto &wp : waypoints)
+    tree.Add(wp);
+  tree.Optimise();
+  const auto tree_build = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  WaypointIndex index;
+  index.Build(waypoints.begin(), waypoints.end());
+  const auto index_build = std::chrono::steady_clock::now() - start;
+
+  printf("%u waypoints, %u queries\n", n, N_QUERIES);
+  printf("build: QuadTree %.1f ms, WaypointIndex %.1f ms\n",
+         std::chrono::duration<double, std::milli>(tree_build).count(),
+         std::chrono::duration<double, std::milli>(index_build).count());
+
+  Result tree_result, index_result;
+  tree_result.found.reserve(2 * N_QUERIES);
+  index_result.found.reserve(2 * N_QUERIES);
+
+  auto count_tree = [&tree_result](const WaypointPtr &){
+    ++tree_result.visited;
+  };
+  auto count_index = [&index_result](const WaypointPtr &){
+    ++index_result.visited;
+  };
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries)
+    tree.VisitWithinRange(WaypointTree::Point(p.x, p.y), VISIT_RANGE,
+                          count_tree);
+  tree_result.visit = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries)
+    index.VisitWithinRange(p, VISIT_RANGE, count_index);
+  index_result.visit = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries) {
+    const auto found = tree.FindNearest(WaypointTree::Point(p.x, p.y),
+                                        NEAREST_RANGE);
+    tree_result.found.push_back(found.first != tree.end()
+                                ? found.first->get() : nullptr);
+  }
+  tree_result.nearest = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries) {
+    const WaypointPtr *found = index.FindNearest(p, NEAREST_RANGE);
+    index_result.found.push_back(found != nullptr ? found->get() : nullptr);
+  }
+  index_result.nearest = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries) {
+    const auto found =
+      tree.FindNearestIf(WaypointTree::Point(p.x, p.y), NEAREST_RANGE,
+                         [](const WaypointPtr &wp){
+                           return IsLandable(*wp);
+                         });
+    tree_result.found.push_back(found.first != tree.end()
+                                ? found.first->get() : nullptr);
+  }
+  tree_result.landable = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto &p : queries) {
+    const WaypointPtr *found = index.FindNearest(p, NEAREST_RANGE,
+                                                 WaypointIndex::LANDABLE);
+    index_result.found.push_back(found != nullptr ? found->get() : nullptr);
+  }
+  index_result.landable = std::chrono::steady_clock::now() - start;
+
+  Print("QuadTree", tree_result);
+  Print("Index", index_result);
+
+  /* equally distant waypoints may be chosen differently, so compare
+     the distances */
+  unsigned mismatches = tree_result.visited != index_result.visited;
+  for (unsigned i = 0; i < tree_result.found.size(); ++i) {
+    const FlatGeoPoint &p = queries[i % N_QUERIES];
+    if (SquareDistance(tree_result.found[i], p) !=
+        SquareDistance(index_result.found[i], p))
+      ++mismatches;
+  }
+
+  if (mismatches > 0) {
+    fprintf(stderr, "%u results differ\n", mismatches);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -22,8 +22,6 @@ Copyright_License {
 */
 
 #include "DebugReplayIGC.hpp"
-#include "IO/FileLineReader.hpp"
-#include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
 #include "Units/System.hpp"
 #include "OS/Path.hpp"
@@ -31,8 +29,13 @@ Copyright_License {
 DebugReplay*
 DebugReplayIGC::Create(Path input_file)
 {
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
-  return new DebugReplayIGC(reader);
+  DebugReplayIGC *replay = new DebugReplayIGC();
+  if (!IGCReadFixes(input_file, replay->fixes)) {
+    delete replay;
+    return nullptr;
+  }
+
+  return replay;
 }
 
 bool
@@ -40,26 +43,18 @@ DebugReplayIGC::Next()
 {
   last_basic = computed_basic;
 
-  const char *line;
-  while ((line = reader->ReadLine()) != NULL) {
-    if (line[0] == 'B') {
-      IGCFix fix;
-      if (IGCParseFix(line, extensions, fix)) {
-        CopyFromFix(fix);
-
-        Compute();
-        return true;
-      }
-    } else if (line[0] == 'H') {
-      BrokenDate date;
-      if (memcmp(line, "HFDTE", 5) == 0 &&
-          IGCParseDateRecord(line, date)) {
-        (BrokenDate &)raw_basic.date_time_utc = date;
-        raw_basic.time_available.Clear();
-      }
-    } else if (line[0] == 'I') {
-      IGCParseExtensions(line, extensions);
+  if (position < fixes.size()) {
+    for (; date_position < fixes.dates.size() &&
+           fixes.dates[date_position].fix_index <= position;
+         ++date_position) {
+      (BrokenDate &)raw_basic.date_time_utc = fixes.dates[date_position].date;
+      raw_basic.time_available.Clear();
     }
+
+    CopyFromFix(fixes[position++]);
+
+    Compute();
+    return true;
   }
 
   if (computed_basic.time_available)
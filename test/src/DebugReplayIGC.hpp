@@ -24,24 +24,43 @@ Copyright_License {
 #ifndef XCSOAR_DEBUG_REPLAY_IGC_HPP
 #define XCSOAR_DEBUG_REPLAY_IGC_HPP
 
-#include "DebugReplayFile.hpp"
-#include "IGC/IGCExtensions.hpp"
-#include "IO/FileLineReader.hpp"
+#include "DebugReplay.hpp"
+#include "IGC/IGCBulkReader.hpp"
 
-struct IGCFix;
+class Path;
 
-class DebugReplayIGC : public DebugReplayFile {
-  IGCExtensions extensions;
+class DebugReplayIGC : public DebugReplay {
+  /**
+   * All fixes of the file, loaded at once with IGCReadFixes().
+   */
+  IGCFixColumns fixes;
 
-private:
-  DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
-    extensions.clear();
-  }
+  /**
+   * The index of the next fix in #fixes.
+   */
+  size_t position = 0;
+
+  /**
+   * The next element of IGCFixColumns::dates.
+   */
+  size_t date_position = 0;
+
+  DebugReplayIGC() = default;
 
 public:
-  virtual bool Next();
+  long Size() const override {
+    return fixes.size();
+  }
+
+  long Tell() const override {
+    return position;
+  }
+
+  bool Next() override;
 
+  /**
+   * @return nullptr if the file could not be read
+   */
   static DebugReplay *Create(Path input_file);
 
 protected:
@@ -0,0 +1,401 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program converts the topography of a map file (the shapefiles
+ * listed in "topology.tpl") to a #PackedTopography file.  XCSoar
+ * loads it instead of the shapefiles if it is stored next to the map
+ * file with the extension ".xct".
+ *
+ * The index arrays of the thinning levels depend on the display
+ * resolution (Layout::Scale(1)); they are built for the value given
+ * with --layout-scale (default 1).  On other displays, XCSoar builds
+ * them at runtime, like it does for shapefiles.
+ *
+ * Example: PackTopography alps.xcm alps.xct
+ */
+
+#include "Topography/PackedTopography.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Geo/FAISphere.hpp"
+#include "OS/Args.hpp"
+#include "OS/Path.hpp"
+#include "IO/ZipArchive.hpp"
+#include "IO/ZipLineReader.hpp"
+#include "IO/FileOutputStream.hxx"
+#include "Operation/Operation.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/PrintException.hxx"
+
+#ifdef _UNICODE
+#include "Util/ConvertString.hpp"
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef PackedTopography::Bounds Bounds;
+
+static unsigned layout_scale = 1;
+
+/**
+ * Convert absolute bounds to #Bounds relative to the given center,
+ * rounded outwards.
+ */
+static Bounds
+ToBounds(const GeoBounds &bounds, const GeoPoint &center)
+{
+  Bounds result;
+  result.west = nextafterf((bounds.GetWest() - center.longitude).Radians(),
+                           -INFINITY);
+  result.south = nextafterf((bounds.GetSouth() - center.latitude).Radians(),
+                            -INFINITY);
+  result.east = nextafterf((bounds.GetEast() - center.longitude).Radians(),
+                           INFINITY);
+  result.north = nextafterf((bounds.GetNorth() - center.latitude).Radians(),
+                            INFINITY);
+  return result;
+}
+
+static void
+Extend(Bounds &a, const Bounds &b)
+{
+  a.west = std::min(a.west, b.west);
+  a.south = std::min(a.south, b.south);
+  a.east = std::max(a.east, b.east);
+  a.north = std::max(a.north, b.north);
+}
+
+/**
+ * Interleave the bits of two 16 bit values.
+ */
+static constexpr uint32_t
+Spread(uint32_t x)
+{
+  x &= 0xffff;
+  x = (x | (x << 8)) & 0x00ff00ff;
+  x = (x | (x << 4)) & 0x0f0f0f0f;
+  x = (x | (x << 2)) & 0x33333333;
+  x = (x | (x << 1)) & 0x55555555;
+  return x;
+}
+
+/**
+ * Returns the number of uint16_t values of the index array returned
+ * by XShape::GetIndices().
+ */
+static unsigned
+GetIndexArraySize(const XShape &shape, const uint16_t *count)
+{
+  if (shape.get_type() == MS_SHAPE_POLYGON)
+    return 1 + count[0];
+
+  const unsigned n_lines = shape.GetLines().size;
+  unsigned size = n_lines;
+  for (unsigned i = 0; i < n_lines; ++i)
+    size += count[i];
+  return size;
+}
+
+/**
+ * Collects the sections of one layer.
+ */
+struct LayerBuilder {
+  PackedTopography::LayerHeader header;
+
+  std::vector<PackedTopography::ShapeRecord> shapes;
+  std::vector<Bounds> buckets;
+  std::vector<uint16_t> lines;
+  std::vector<ShapePoint> points;
+  std::vector<uint16_t> indices;
+  std::vector<char> labels;
+
+  void AddShape(const XShape &shape, const GeoPoint &center,
+                const float *min_distance);
+
+  void AddLabel(PackedTopography::ShapeRecord &record, const TCHAR *label);
+
+  /**
+   * Sort the shapes along a Z-order curve and build the buckets.
+   */
+  void BuildIndex();
+};
+
+void
+LayerBuilder::AddLabel(PackedTopography::ShapeRecord &record,
+                       const TCHAR *label)
+{
+  if (label == nullptr) {
+    record.label = PackedTopography::NONE;
+    return;
+  }
+
+#ifdef _UNICODE
+  const WideToUTF8Converter utf8(label);
+  const char *value = utf8;
+#else
+  const char *value = label;
+#endif
+
+  record.label = labels.size();
+  labels.insert(labels.end(), value, value + strlen(value) + 1);
+}
+
+void
+LayerBuilder::AddShape(const XShape &shape, const GeoPoint &center,
+                       const float *min_distance)
+{
+  const auto shape_lines = shape.GetLines();
+  if (shape_lines.empty())
+    /* malformed or unsupported */
+    return;
+
+  PackedTopography::ShapeRecord record;
+  memset(&record, 0, sizeof(record));
+
+  record.bounds = ToBounds(shape.get_bounds(), center);
+  record.type = shape.get_type();
+  record.num_lines = shape_lines.size;
+  record.first_line = lines.size();
+  record.first_point = points.size();
+
+  unsigned n_points = 0;
+  for (auto n : shape_lines) {
+    lines.push_back(n);
+    n_points += n;
+  }
+
+  points.insert(points.end(), shape.GetPoints(),
+                shape.GetPoints() + n_points);
+
+  AddLabel(record, shape.GetLabel());
+
+  for (unsigned level = 0; level < PackedTopography::THINNING_LEVELS;
+       ++level) {
+    record.indices[level] = PackedTopography::NONE;
+
+    if (record.type == MS_SHAPE_POINT ||
+        (record.type == MS_SHAPE_LINE && level == 0))
+      /* not used by TopographyFileRenderer */
+      continue;
+
+    const uint16_t *count;
+    if (shape.GetIndices(level, min_distance[level], count) == nullptr)
+      continue;
+
+    record.indices[level] = indices.size();
+    indices.insert(indices.end(), count,
+                   count + GetIndexArraySize(shape, count));
+  }
+
+  shapes.push_back(record);
+}
+
+void
+LayerBuilder::BuildIndex()
+{
+  if (shapes.empty())
+    return;
+
+  Bounds total = shapes.front().bounds;
+  for (const auto &i : shapes)
+    Extend(total, i.bounds);
+
+  const float width = std::max(total.east - total.west, 1e-9f);
+  const float height = std::max(total.north - total.south, 1e-9f);
+
+  auto code = [&](const PackedTopography::ShapeRecord &shape){
+    const float x = (shape.bounds.west + shape.bounds.east) / 2;
+    const float y = (shape.bounds.south + shape.bounds.north) / 2;
+    const uint32_t qx = (x - total.west) / width * 0xffff;
+    const uint32_t qy = (y - total.south) / height * 0xffff;
+    return Spread(qx) | (Spread(qy) << 1);
+  };
+
+  std::stable_sort(shapes.begin(), shapes.end(),
+                   [&](const PackedTopography::ShapeRecord &a,
+                       const PackedTopography::ShapeRecord &b){
+                     return code(a) < code(b);
+                   });
+
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    if (i % PackedTopography::BUCKET_SIZE == 0)
+      buckets.push_back(shapes[i].bounds);
+    else
+      Extend(buckets.back(), shapes[i].bounds);
+  }
+}
+
+static void
+BuildLayer(LayerBuilder &builder, const TopographyFile &file)
+{
+  auto &header = builder.header;
+  memset(&header, 0, sizeof(header));
+
+  if (strlen(file.GetName()) >= sizeof(header.name)) {
+    fprintf(stderr, "Name too long: %s\n", file.GetName());
+    exit(EXIT_FAILURE);
+  }
+
+  strcpy(header.name, file.GetName());
+
+  const GeoPoint center = file.GetCenter();
+  header.center_longitude = center.longitude.Radians();
+  header.center_latitude = center.latitude.Radians();
+
+  /* the same formula as in TopographyFileRenderer::Paint() */
+  for (unsigned level = 0; level < PackedTopography::THINNING_LEVELS;
+       ++level)
+    header.min_distance[level] =
+      ShapeScalar(file.GetMinimumPointDistance(level))
+      / (layout_scale * FAISphere::REARTH);
+
+  const std::lock_guard<Mutex> lock(file.mutex);
+  for (const XShape &shape : file)
+    builder.AddShape(shape, center, header.min_distance);
+
+  builder.BuildIndex();
+
+  header.n_shapes = builder.shapes.size();
+  header.n_lines = builder.lines.size();
+  header.n_points = builder.points.size();
+  header.n_indices = builder.indices.size();
+  header.labels_size = builder.labels.size();
+}
+
+/**
+ * Append a section to the file buffer, aligned to 8 bytes.
+ *
+ * @return the file offset of the section
+ */
+template<typename T>
+static uint32_t
+AppendSection(std::vector<uint8_t> &buffer, const std::vector<T> &data)
+{
+  buffer.resize((buffer.size() + 7) & ~size_t(7));
+
+  const size_t offset = buffer.size();
+  const uint8_t *p = (const uint8_t *)data.data();
+  buffer.insert(buffer.end(), p, p + data.size() * sizeof(T));
+
+  if (buffer.size() > UINT32_MAX) {
+    fprintf(stderr, "Topography too large\n");
+    exit(EXIT_FAILURE);
+  }
+
+  return offset;
+}
+
+static void
+Write(Path path, std::vector<LayerBuilder> &layers)
+{
+  PackedTopography::Header header;
+  memcpy(header.magic, PackedTopography::MAGIC, sizeof(header.magic));
+  header.version = PackedTopography::VERSION;
+  header.n_layers = layers.size();
+
+  std::vector<uint8_t> buffer(sizeof(header) +
+                              layers.size() *
+                              sizeof(PackedTopography::LayerHeader));
+
+  for (auto &i : layers) {
+    auto &h = i.header;
+    h.shapes_offset = AppendSection(buffer, i.shapes);
+    h.buckets_offset = AppendSection(buffer, i.buckets);
+    h.lines_offset = AppendSection(buffer, i.lines);
+    h.points_offset = AppendSection(buffer, i.points);
+    h.indices_offset = AppendSection(buffer, i.indices);
+    h.labels_offset = AppendSection(buffer, i.labels);
+  }
+
+  memcpy(buffer.data(), &header, sizeof(header));
+  auto *dest = (PackedTopography::LayerHeader *)(buffer.data() + sizeof(header));
+  for (const auto &i : layers)
+    *dest++ = i.header;
+
+  FileOutputStream file(path);
+  file.Write(buffer.data(), buffer.size());
+  file.Commit();
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--layout-scale=N] MAPFILE.xcm OUTPUT.xct");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--layout-scale=")) != nullptr) {
+      layout_scale = strtoul(value, nullptr, 10);
+      if (layout_scale == 0)
+        args.UsageError();
+    } else
+      args.UsageError();
+  }
+
+  const auto map_path = args.ExpectNextPath();
+  const auto output_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+  ZipLineReaderA reader(archive.get(), "topology.tpl");
+
+  TopographyStore store;
+  NullOperationEnvironment operation;
+  store.Load(operation, reader, nullptr, archive.get());
+  store.LoadAll();
+
+  std::vector<LayerBuilder> layers(store.size());
+  for (unsigned i = 0; i < store.size(); ++i)
+    BuildLayer(layers[i], store[i]);
+
+  Write(output_path, layers);
+
+  /* verify the new file and print some statistics */
+  const PackedTopography packed(output_path);
+  for (const auto &i : layers) {
+    const auto *layer = packed.Find(i.header.name);
+    if (layer == nullptr || layer->size() != i.header.n_shapes) {
+      fprintf(stderr, "Verification failed: %s\n", i.header.name);
+      return EXIT_FAILURE;
+    }
+
+    printf("%-24s %7u shapes %8u points %8u indices %7u label bytes\n",
+           i.header.name, i.header.n_shapes, i.header.n_points,
+           i.header.n_indices, i.header.labels_size);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
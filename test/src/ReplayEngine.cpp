@@ -0,0 +1,200 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ReplayEngine.hpp"
+#include "DebugReplay.hpp"
+#include "Task/LoadFile.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Atmosphere/Pressure.hpp"
+#include "IO/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Path.hpp"
+
+#include <memory>
+
+void
+ReplayEngine::Result::Clear()
+{
+  for (auto &i : stages)
+    i.Clear();
+
+  n_fixes = 0;
+  duration = 0;
+  computer.Clear();
+}
+
+ReplayEngine::StageTime
+ReplayEngine::Result::GetTotal() const
+{
+  StageTime total;
+  total.Clear();
+
+  for (const auto &i : stages)
+    total += i;
+
+  return total;
+}
+
+ReplayEngine::Result &
+ReplayEngine::Result::operator+=(const Result &other)
+{
+  for (unsigned i = 0; i < stages.size(); ++i)
+    stages[i] += other.stages[i];
+
+  n_fixes += other.n_fixes;
+  duration += other.duration;
+
+  for (unsigned i = 0; i < computer.timers.size(); ++i)
+    computer.timers[i] += other.computer.timers[i];
+  return *this;
+}
+
+static ComputerSettings
+MakeComputerSettings()
+{
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+  settings.computer_timers_enabled = true;
+  return settings;
+}
+
+ReplayEngine::ReplayEngine()
+  :settings(MakeComputerSettings()),
+   task_manager(settings.task, waypoints),
+   protected_task_manager(task_manager, settings.task),
+   glide_computer(settings, waypoints, airspaces,
+                  protected_task_manager, task_events)
+{
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+  task_manager.SetTaskEvents(task_events);
+
+  glide_computer.SetContestIncremental(false);
+}
+
+ReplayEngine::~ReplayEngine()
+{
+}
+
+bool
+ReplayEngine::LoadTask(Path path)
+{
+  std::unique_ptr<OrderedTask> task(::LoadTask(path, settings.task,
+                                               &waypoints));
+  if (!task)
+    return false;
+
+  protected_task_manager.TaskCommit(*task);
+  return true;
+}
+
+bool
+ReplayEngine::LoadAirspaces(Path path)
+{
+  FileLineReader reader(path, Charset::AUTO);
+
+  AirspaceParser parser(airspaces);
+  NullOperationEnvironment operation;
+  if (!parser.Parse(reader, operation)) {
+    airspaces.Clear();
+    return false;
+  }
+
+  airspaces.Optimise();
+  airspaces.SetFlightLevels(AtmosphericPressure::Standard());
+  glide_computer.ClearAirspaces();
+  return true;
+}
+
+/**
+ * Measures the CPU and wall clock time of one stage invocation.
+ */
+class StageTimer {
+  ReplayEngine::StageTime &time;
+  const uint64_t start_cpu, start_wall;
+
+public:
+  explicit StageTimer(ReplayEngine::StageTime &_time)
+    :time(_time),
+     start_cpu(ThreadCPUClockUS()), start_wall(MonotonicClockUS()) {}
+
+  ~StageTimer() {
+    time.Add(ThreadCPUClockUS() - start_cpu,
+             MonotonicClockUS() - start_wall);
+  }
+};
+
+ReplayEngine::Result
+ReplayEngine::Run(DebugReplay &replay)
+{
+  Result result;
+  result.Clear();
+
+  glide_computer.Initialise();
+  idle_time.Reset();
+
+  double first_time = -1;
+
+  while (true) {
+    {
+      StageTimer timer(result[Stage::REPLAY]);
+      if (!replay.Next())
+        break;
+    }
+
+    const MoreData &basic = replay.Basic();
+    ++result.n_fixes;
+
+    {
+      StageTimer timer(result[Stage::GPS]);
+      glide_computer.ReadBlackboard(basic);
+      glide_computer.ProcessGPS();
+    }
+
+    if (!basic.time_available)
+      continue;
+
+    if (first_time < 0)
+      first_time = basic.time;
+    else if (basic.time > first_time)
+      result.duration = basic.time - first_time;
+
+    /* trigger ProcessIdle() by replay time, not by wall clock time
+       like the CalculationThread does, or it would hardly ever run
+       at replay speed */
+    if (idle_time.Update(basic.time, idle_interval, 0) != 0) {
+      StageTimer timer(result[Stage::IDLE]);
+      glide_computer.ProcessIdle();
+    }
+  }
+
+  {
+    StageTimer timer(result[Stage::EXHAUSTIVE]);
+    glide_computer.ProcessExhaustive();
+  }
+
+  result.computer = glide_computer.Calculated().computer_timers;
+  return result;
+}
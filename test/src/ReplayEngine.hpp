@@ -0,0 +1,231 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_REPLAY_ENGINE_HPP
+#define XCSOAR_REPLAY_ENGINE_HPP
+
+#include "Computer/Settings.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Time/DeltaTime.hpp"
+
+#include <array>
+#include <stdint.h>
+
+class Path;
+class DebugReplay;
+
+/**
+ * Feeds a #DebugReplay through the complete #GlideComputer pipeline
+ * (task, contest, airspace warnings, wind, thermal band, statistics)
+ * without a user interface and without handing data between
+ * threads, as fast as the CPU allows.
+ *
+ * Each instance owns all of its state, therefore several engines may
+ * run concurrently in different threads.
+ */
+class ReplayEngine {
+public:
+  enum class Stage : unsigned {
+    /**
+     * Parsing the input file, #BasicComputer and #FlyingComputer
+     * (DebugReplay::Next()).
+     */
+    REPLAY,
+
+    /**
+     * GlideComputer::ProcessGPS(), once per fix.
+     */
+    GPS,
+
+    /**
+     * GlideComputer::ProcessIdle(), periodically.
+     */
+    IDLE,
+
+    /**
+     * GlideComputer::ProcessExhaustive() after the last fix.
+     */
+    EXHAUSTIVE,
+
+    COUNT
+  };
+
+  /**
+   * Accumulated cost of one #Stage.
+   */
+  struct StageTime {
+    /**
+     * CPU time of the calling thread [us].
+     */
+    uint64_t cpu_us;
+
+    /**
+     * Wall clock time [us].
+     */
+    uint64_t wall_us;
+
+    /**
+     * The longest single invocation (wall clock) [us].
+     */
+    uint64_t max_wall_us;
+
+    /**
+     * Number of invocations.
+     */
+    unsigned count;
+
+    void Clear() {
+      cpu_us = wall_us = max_wall_us = 0;
+      count = 0;
+    }
+
+    void Add(uint64_t cpu, uint64_t wall) {
+      cpu_us += cpu;
+      wall_us += wall;
+      if (wall > max_wall_us)
+        max_wall_us = wall;
+      ++count;
+    }
+
+    StageTime &operator+=(const StageTime &other) {
+      cpu_us += other.cpu_us;
+      wall_us += other.wall_us;
+      if (other.max_wall_us > max_wall_us)
+        max_wall_us = other.max_wall_us;
+      count += other.count;
+      return *this;
+    }
+  };
+
+  struct Result {
+    std::array<StageTime, unsigned(Stage::COUNT)> stages;
+
+    /**
+     * Number of fixes delivered by the #DebugReplay.
+     */
+    unsigned n_fixes;
+
+    /**
+     * The replayed flight time, i.e. the time span between the first
+     * and the last fix with a time stamp [s].
+     */
+    double duration;
+
+    /**
+     * The #GlideComputer subsystem timers (see
+     * ComputerSettings::computer_timers_enabled).
+     */
+    ComputerTimers computer;
+
+    void Clear();
+
+    StageTime &operator[](Stage stage) {
+      return stages[unsigned(stage)];
+    }
+
+    const StageTime &operator[](Stage stage) const {
+      return stages[unsigned(stage)];
+    }
+
+    gcc_pure
+    StageTime GetTotal() const;
+
+    Result &operator+=(const Result &other);
+  };
+
+private:
+  ComputerSettings settings;
+
+  const Waypoints waypoints;
+  Airspaces airspaces;
+
+  TaskManager task_manager;
+  GlideComputerTaskEvents task_events;
+  ProtectedTaskManager protected_task_manager;
+
+  GlideComputer glide_computer;
+
+  /**
+   * Replay time between two GlideComputer::ProcessIdle() calls [s].
+   */
+  double idle_interval = 0.5;
+
+  DeltaTime idle_time;
+
+public:
+  ReplayEngine();
+  ~ReplayEngine();
+
+  ReplayEngine(const ReplayEngine &) = delete;
+  ReplayEngine &operator=(const ReplayEngine &) = delete;
+
+  /**
+   * Load an XCSoar/SeeYou/IGC task file and make it the active
+   * ordered task.  Must be called before Run().
+   *
+   * @return false if the file could not be loaded
+   */
+  bool LoadTask(Path path);
+
+  /**
+   * Load an OpenAir/TNP airspace file for the airspace warnings.
+   * Must be called before Run().  Throws on I/O error.
+   *
+   * @return false if the file could not be parsed
+   */
+  bool LoadAirspaces(Path path);
+
+  /**
+   * Change the amount of replay time between two
+   * GlideComputer::ProcessIdle() calls.  The default (0.5 s) matches
+   * the CalculationThread cadence during a live flight.
+   */
+  void SetIdleInterval(double _interval) {
+    idle_interval = _interval;
+  }
+
+  /**
+   * Run the whole replay through the #GlideComputer.  Blocks until
+   * the end of the input.
+   */
+  Result Run(DebugReplay &replay);
+
+  GlideComputer &GetGlideComputer() {
+    return glide_computer;
+  }
+
+  const GlideComputer &GetGlideComputer() const {
+    return glide_computer;
+  }
+
+  const Airspaces &GetAirspaces() const {
+    return airspaces;
+  }
+};
+
+#endif
@@ -0,0 +1,473 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program measures the latency between the arrival of a GPS fix
+ * and the end of GlideComputer::ProcessGPS(), comparing the old
+ * CalculationThread cadence (a #WorkerThread with 450/100/50 ms and
+ * all of ProcessIdle() every 500 ms) with the #IdleScheduler.
+ *
+ * The CalculationThread is simulated on a virtual time line: fixes
+ * arrive at their replay time (or at the rate given with --rate),
+ * and each GlideComputer call advances the time line by the CPU time
+ * it really needed, multiplied with --cpu-scale to emulate a slower
+ * device.
+ *
+ * Example: RunCalculationLatency --rate=10 --cpu-scale=20 test/data/0asljd01.igc
+ */
+
+#include "ReplayEngine.hpp"
+#include "DebugReplayIGC.hpp"
+#include "DebugReplayNMEA.hpp"
+#include "Computer/IdleScheduler.hpp"
+#include "OS/Args.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Path.hpp"
+#include "OS/PathName.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/PrintException.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+typedef IdleScheduler::Duration Duration;
+typedef IdleScheduler::TimePoint TimePoint;
+
+using std::chrono::milliseconds;
+using std::chrono::microseconds;
+
+/**
+ * The beginning of the virtual time line.
+ */
+static constexpr TimePoint EPOCH = TimePoint(std::chrono::hours(1));
+
+static AllocatedPath task_path = nullptr, airspace_path = nullptr;
+static tstring driver_name = _T("Generic");
+static double rate = 0, cpu_scale = 1;
+
+static AllocatedPath
+ToPath(const char *value)
+{
+#ifdef _UNICODE
+  return AllocatedPath(PathName(value));
+#else
+  return AllocatedPath(Path(value));
+#endif
+}
+
+static double
+ToMS(Duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+static DebugReplay *
+CreateReplay(Path path)
+{
+  return MatchesExtension(path.c_str(), _T(".igc"))
+    ? DebugReplayIGC::Create(path)
+    : DebugReplayNMEA::Create(path, driver_name);
+}
+
+/**
+ * Delivers the fixes of a #DebugReplay at their (virtual) arrival
+ * time.
+ */
+class FixSource {
+  DebugReplay &replay;
+
+  double first_time = -1;
+  unsigned n_fixes = 0;
+
+  bool has_next;
+  TimePoint next_arrival;
+
+  MoreData latest;
+
+public:
+  explicit FixSource(DebugReplay &_replay):replay(_replay) {
+    latest.Reset();
+    Read();
+  }
+
+  bool IsEmpty() const {
+    return !has_next;
+  }
+
+  TimePoint GetNextArrival() const {
+    return next_arrival;
+  }
+
+  /**
+   * Returns the most recent fix received by Receive().
+   */
+  const MoreData &GetLatest() const {
+    return latest;
+  }
+
+  /**
+   * Receive all fixes which have arrived until the given time, and
+   * append their arrival times to the given list.
+   */
+  void Receive(TimePoint now, std::vector<TimePoint> &arrivals) {
+    while (has_next && next_arrival <= now) {
+      latest = replay.Basic();
+      arrivals.push_back(next_arrival);
+      Read();
+    }
+  }
+
+private:
+  void Read() {
+    has_next = replay.Next();
+    if (!has_next)
+      return;
+
+    const MoreData &basic = replay.Basic();
+
+    double offset;
+    if (rate > 0)
+      offset = n_fixes / rate;
+    else if (basic.time_available) {
+      if (first_time < 0)
+        first_time = basic.time;
+      offset = std::max(basic.time - first_time, 0.);
+    } else
+      /* no time stamp: arrives together with the previous fix */
+      offset = std::chrono::duration<double>(next_arrival - EPOCH).count();
+
+    ++n_fixes;
+    next_arrival = EPOCH +
+      std::chrono::duration_cast<Duration>(std::chrono::duration<double>(offset));
+  }
+};
+
+struct Statistics {
+  /**
+   * The latency of each fix which was processed.
+   */
+  std::vector<Duration> latencies;
+
+  /**
+   * Number of fixes which were superseded by a newer one before
+   * ProcessGPS() was called.
+   */
+  unsigned skipped = 0;
+
+  unsigned gps_runs = 0, idle_runs = 0;
+
+  /**
+   * The virtual time the CalculationThread was busy.
+   */
+  Duration busy = Duration::zero();
+
+  void Print(const char *name);
+};
+
+void
+Statistics::Print(const char *name)
+{
+  if (latencies.empty()) {
+    printf("%-10s no fixes\n", name);
+    return;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  Duration sum = Duration::zero();
+  for (auto i : latencies)
+    sum += i;
+
+  printf("%-10s %6u fixes, %5u skipped, %6u gps, %6u idle,"
+         " busy %9.1f ms, latency mean %7.2f p95 %7.2f max %7.2f ms\n",
+         name, unsigned(latencies.size()), skipped,
+         gps_runs, idle_runs, ToMS(busy),
+         ToMS(sum / latencies.size()),
+         ToMS(latencies[latencies.size() * 95 / 100]),
+         ToMS(latencies.back()));
+}
+
+/**
+ * Simulates one CalculationThread on the virtual time line.
+ */
+class Simulation {
+  GlideComputer &glide_computer;
+  FixSource fixes;
+
+  TimePoint now = EPOCH;
+
+  /**
+   * The arrival times of fixes which were received but not yet
+   * processed.
+   */
+  std::vector<TimePoint> pending;
+
+public:
+  Statistics statistics;
+
+  Simulation(GlideComputer &_glide_computer, DebugReplay &replay)
+    :glide_computer(_glide_computer), fixes(replay) {
+    glide_computer.Initialise();
+  }
+
+  /**
+   * The old cadence: WorkerThread("CalcThread", 450, 100, 50) with
+   * ProcessIdle() inline after ProcessGPS() every 500 ms.
+   */
+  void RunWorkerThread();
+
+  /**
+   * The #IdleScheduler, like CalculationThread::Run().
+   */
+  void RunIdleScheduler();
+
+private:
+  void Receive() {
+    fixes.Receive(now, pending);
+  }
+
+  /**
+   * Sleep until the given time, receiving fixes meanwhile.
+   */
+  void SleepUntil(TimePoint t) {
+    if (t > now)
+      now = t;
+    Receive();
+  }
+
+  /**
+   * Run the given function and advance the virtual time line by its
+   * (scaled) CPU time.
+   */
+  template<typename F>
+  void Execute(F &&f) {
+    const auto start = ThreadCPUClockUS();
+    f();
+    const auto cpu = microseconds(uint64_t((ThreadCPUClockUS() - start)
+                                           * cpu_scale));
+    now += cpu;
+    statistics.busy += cpu;
+  }
+
+  void ProcessGPS() {
+    glide_computer.ReadBlackboard(fixes.GetLatest());
+    Execute([this](){ glide_computer.ProcessGPS(); });
+    ++statistics.gps_runs;
+
+    for (auto i : pending)
+      statistics.latencies.push_back(now - i);
+    statistics.skipped += pending.size() - 1;
+    pending.clear();
+  }
+};
+
+void
+Simulation::RunWorkerThread()
+{
+  TimePoint last_idle = now;
+
+  while (true) {
+    Receive();
+
+    /* wait for work */
+    if (pending.empty()) {
+      if (fixes.IsEmpty())
+        break;
+
+      SleepUntil(fixes.GetNextArrival());
+      continue;
+    }
+
+    /* delay */
+    SleepUntil(now + milliseconds(50));
+
+    const TimePoint start = now;
+    ProcessGPS();
+
+    if (now - last_idle >= milliseconds(500)) {
+      last_idle = now;
+      Execute([this](){ glide_computer.ProcessIdle(); });
+      ++statistics.idle_runs;
+    }
+
+    /* idle_min / period_min */
+    Duration idle = milliseconds(100);
+    if (now - start + idle < milliseconds(450))
+      idle = milliseconds(450) - (now - start);
+    SleepUntil(now + idle);
+  }
+}
+
+void
+Simulation::RunIdleScheduler()
+{
+  /* see CalculationThread::MIN_GPS_PERIOD */
+  constexpr Duration min_gps_period = milliseconds(100);
+
+  IdleScheduler scheduler;
+  GlideComputer::AddIdleJobs(scheduler);
+
+  TimePoint last_gps = now - min_gps_period;
+
+  while (true) {
+    Receive();
+
+    const TimePoint start = now;
+    const bool gps_ready = !pending.empty() &&
+      now >= last_gps + min_gps_period;
+    const int job = scheduler.Pick(now);
+
+    if (job >= 0 && (!gps_ready || scheduler.IsOverdue(job, now))) {
+      Execute([this, job](){
+          glide_computer.ProcessIdle(GlideComputer::IdleJob(job));
+        });
+      scheduler.Done(job, start);
+      ++statistics.idle_runs;
+    } else if (gps_ready) {
+      last_gps = now;
+      ProcessGPS();
+      scheduler.MarkDirty(start);
+    } else {
+      if (pending.empty() && fixes.IsEmpty())
+        break;
+
+      TimePoint wakeup = scheduler.GetNextRelease();
+      if (!pending.empty())
+        wakeup = std::min(wakeup, last_gps + min_gps_period);
+      if (!fixes.IsEmpty())
+        wakeup = std::min(wakeup, fixes.GetNextArrival());
+
+      SleepUntil(wakeup);
+    }
+  }
+}
+
+enum class Policy {
+  WORKER_THREAD,
+  IDLE_SCHEDULER,
+};
+
+static Statistics
+Simulate(Path path, Policy policy)
+{
+  std::unique_ptr<DebugReplay> replay(CreateReplay(path));
+  if (!replay) {
+    fprintf(stderr, "Failed to open %s\n", path.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  ReplayEngine engine;
+
+  if (task_path != nullptr && !engine.LoadTask(task_path)) {
+    fprintf(stderr, "Failed to load task %s\n", task_path.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  if (airspace_path != nullptr && !engine.LoadAirspaces(airspace_path)) {
+    fprintf(stderr, "Failed to parse airspace file %s\n",
+            airspace_path.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  Simulation simulation(engine.GetGlideComputer(), *replay);
+
+  switch (policy) {
+  case Policy::WORKER_THREAD:
+    simulation.RunWorkerThread();
+    break;
+
+  case Policy::IDLE_SCHEDULER:
+    simulation.RunIdleScheduler();
+    break;
+  }
+
+  return std::move(simulation.statistics);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--rate=HZ] [--cpu-scale=X] [--task=FILE] [--airspace=FILE]"
+            " [--driver=NAME] FILE\n\n"
+            "FILE may be an IGC file or a NMEA file which is parsed"
+            " with the given driver (default: Generic).\n"
+            "Without --rate, fixes arrive at their time stamps.");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--rate=")) != nullptr) {
+      rate = strtod(value, nullptr);
+      if (rate <= 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--cpu-scale=")) != nullptr) {
+      cpu_scale = strtod(value, nullptr);
+      if (cpu_scale <= 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      task_path = ToPath(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      airspace_path = ToPath(value);
+    } else if ((value = StringAfterPrefix(arg, "--driver=")) != nullptr) {
+      driver_name = ToPath(value).c_str();
+    } else
+      args.UsageError();
+  }
+
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  Simulate(path, Policy::WORKER_THREAD).Print("worker");
+  Simulate(path, Policy::IDLE_SCHEDULER).Print("scheduler");
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
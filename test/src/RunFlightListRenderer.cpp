@@ -34,8 +34,7 @@ Copyright_License {
 #include "Fonts.hpp"
 #include "Renderer/FlightListRenderer.hpp"
 #include "FlightInfo.hpp"
-#include "Logger/FlightParser.hpp"
-#include "IO/FileLineReader.hpp"
+#include "Logger/FlightIndex.hpp"
 
 #include <vector>
 
@@ -122,12 +121,9 @@ protected:
 static void
 ParseCommandLine(Args &args)
 {
-  const auto path = args.ExpectNextPath();
-  FileLineReaderA file(path);
-  FlightParser parser(file);
-  FlightInfo flight;
-  while (parser.Read(flight))
-    flights.push_back(flight);
+  const FlightIndex index(args.ExpectNextPath());
+  index.Update();
+  flights = index.ReadRecent(FlightListRenderer::MAX_FLIGHTS);
 }
 
 static void
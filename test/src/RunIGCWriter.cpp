@@ -56,6 +56,7 @@ int main(int argc, char **argv)
       writer.LogPoint(replay->Basic());
 
   writer.Flush();
+  writer.Close();
 
   delete replay;
 
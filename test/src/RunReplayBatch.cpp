@@ -0,0 +1,268 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * This program replays many IGC/NMEA files through the complete
+ * #GlideComputer pipeline with #ReplayEngine, several files
+ * concurrently, and reports how much CPU time each stage needed.
+ *
+ * Example: RunReplayBatch --jobs=4 --task=task.tsk test/data/*.igc
+ */
+
+#include "ReplayEngine.hpp"
+#include "DebugReplayIGC.hpp"
+#include "DebugReplayNMEA.hpp"
+#include "Thread/Mutex.hxx"
+#include "OS/Args.hpp"
+#include "OS/Clock.hpp"
+#include "OS/Path.hpp"
+#include "OS/PathName.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "OS/ProcessorCount.hpp"
+#include "Util/StringAPI.hxx"
+#include "Util/StringCompare.hxx"
+#include "Util/PrintException.hxx"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+static AllocatedPath task_path = nullptr, airspace_path = nullptr;
+static tstring driver_name = _T("Generic");
+
+static std::vector<AllocatedPath> input_files;
+
+static Mutex mutex;
+static ReplayEngine::Result total;
+static unsigned n_failed;
+
+static AllocatedPath
+ToPath(const char *value)
+{
+#ifdef _UNICODE
+  return AllocatedPath(PathName(value));
+#else
+  return AllocatedPath(Path(value));
+#endif
+}
+
+static double
+ToMS(uint64_t us)
+{
+  return us / 1000.;
+}
+
+static DebugReplay *
+CreateReplay(Path path)
+{
+  return MatchesExtension(path.c_str(), _T(".igc"))
+    ? DebugReplayIGC::Create(path)
+    : DebugReplayNMEA::Create(path, driver_name);
+}
+
+static void
+PrintResult(Path path, const ReplayEngine::Result &result,
+            const GlideComputer &glide_computer)
+{
+  typedef ReplayEngine::Stage Stage;
+
+  const auto wall = result.GetTotal().wall_us;
+  const ContestResult &contest =
+    glide_computer.Calculated().contest_stats.GetResult();
+
+  printf("%-32s %6u fixes %6.0f s %8.1f ms x%-7.0f"
+         " replay %7.1f gps %7.1f idle %7.1f exhaustive %7.1f ms cpu,"
+         " contest %6.1f pts\n",
+         path.c_str(), result.n_fixes, result.duration, ToMS(wall),
+         wall > 0 ? result.duration * 1000000. / wall : 0.,
+         ToMS(result[Stage::REPLAY].cpu_us),
+         ToMS(result[Stage::GPS].cpu_us),
+         ToMS(result[Stage::IDLE].cpu_us),
+         ToMS(result[Stage::EXHAUSTIVE].cpu_us),
+         contest.IsDefined() ? contest.score : 0.);
+}
+
+static bool
+ReplayFile(Path path)
+try {
+  std::unique_ptr<DebugReplay> replay(CreateReplay(path));
+  if (!replay)
+    return false;
+
+  ReplayEngine engine;
+
+  if (task_path != nullptr && !engine.LoadTask(task_path)) {
+    fprintf(stderr, "Failed to load task %s\n", task_path.c_str());
+    return false;
+  }
+
+  if (airspace_path != nullptr && !engine.LoadAirspaces(airspace_path)) {
+    fprintf(stderr, "Failed to parse airspace file %s\n",
+            airspace_path.c_str());
+    return false;
+  }
+
+  const auto result = engine.Run(*replay);
+
+  const std::lock_guard<Mutex> lock(mutex);
+  PrintResult(path, result, engine.GetGlideComputer());
+  total += result;
+  return true;
+} catch (...) {
+  PrintException(std::current_exception());
+  return false;
+}
+
+static void
+Worker(std::atomic<unsigned> &next)
+{
+  unsigned i;
+  while ((i = next++) < input_files.size()) {
+    if (!ReplayFile(input_files[i])) {
+      const std::lock_guard<Mutex> lock(mutex);
+      ++n_failed;
+    }
+  }
+}
+
+static void
+PrintTotal(uint64_t wall_us, unsigned n_jobs)
+{
+  typedef ReplayEngine::Stage Stage;
+
+  static constexpr const char *stage_names[unsigned(Stage::COUNT)] = {
+    "replay", "gps", "idle", "exhaustive",
+  };
+
+  const auto cpu_us = total.GetTotal().cpu_us;
+
+  printf("\n%u files, %u fixes, %.1f h flight time, %u jobs\n",
+         unsigned(input_files.size()) - n_failed, total.n_fixes,
+         total.duration / 3600., n_jobs);
+  printf("wall %.1f ms, cpu %.1f ms, %.0f fixes/s, x%.0f real time\n",
+         ToMS(wall_us), ToMS(cpu_us),
+         wall_us > 0 ? total.n_fixes * 1000000. / wall_us : 0.,
+         wall_us > 0 ? total.duration * 1000000. / wall_us : 0.);
+
+  for (unsigned i = 0; i < unsigned(Stage::COUNT); ++i) {
+    const auto &stage = total.stages[i];
+    printf("  %-10s %6u calls, cpu %9.1f ms (%5.1f%%), %7.2f us/call,"
+           " max %8.1f us\n",
+           stage_names[i], stage.count, ToMS(stage.cpu_us),
+           cpu_us > 0 ? stage.cpu_us * 100. / cpu_us : 0.,
+           stage.count > 0 ? double(stage.cpu_us) / stage.count : 0.,
+           double(stage.max_wall_us));
+  }
+
+  printf("\nGlideComputer subsystems:\n");
+  for (unsigned i = 0; i < unsigned(ComputerTimers::Subsystem::COUNT); ++i) {
+    const auto &timer = total.computer.timers[i];
+    printf("  %-13s %7u calls, cpu %9.1f ms (%5.1f%%), %7.2f us/call,"
+           " max %8.1f us\n",
+           ComputerTimers::GetName(ComputerTimers::Subsystem(i)),
+           unsigned(timer.count), ToMS(timer.cpu_us),
+           cpu_us > 0 ? timer.cpu_us * 100. / cpu_us : 0.,
+           timer.count > 0 ? double(timer.cpu_us) / timer.count : 0.,
+           double(timer.max_wall_us));
+  }
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--jobs=N] [--task=FILE] [--airspace=FILE] [--driver=NAME]"
+            " FILE...\n\n"
+            "FILE may be an IGC file or a NMEA file which is parsed"
+            " with the given driver (default: Generic).");
+
+  unsigned n_jobs = GetProcessorCount();
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      n_jobs = strtoul(value, nullptr, 10);
+      if (n_jobs == 0)
+        args.UsageError();
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      task_path = ToPath(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      airspace_path = ToPath(value);
+    } else if ((value = StringAfterPrefix(arg, "--driver=")) != nullptr) {
+      driver_name = ToPath(value).c_str();
+    } else
+      args.UsageError();
+  }
+
+  do {
+    input_files.emplace_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  if (n_jobs > input_files.size())
+    n_jobs = input_files.size();
+
+  total.Clear();
+
+  const auto start = MonotonicClockUS();
+
+  std::atomic<unsigned> next(0);
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < n_jobs; ++i)
+    threads.emplace_back(Worker, std::ref(next));
+
+  for (auto &i : threads)
+    i.join();
+
+  PrintTotal(MonotonicClockUS() - start, n_jobs);
+
+  return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
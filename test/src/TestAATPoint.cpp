@@ -26,7 +26,11 @@
 #include "Engine/Task/Ordered/Points/AATPoint.hpp"
 #include "Engine/Task/Ordered/Points/StartPoint.hpp"
 #include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/Ordered/AATIsolineSegment.hpp"
 #include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/Solvers/TaskMacCreadyRemaining.hpp"
+#include "Engine/Task/Solvers/TaskOptTarget.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "TestUtil.hpp"
 
@@ -66,9 +70,8 @@ static const auto wp2 = MakeWaypointPtr(0, 45.3, 50);
 static const auto wp3 = MakeWaypointPtr(0, 46, 50);
 
 static void
-TestAATPoint()
+MakeTask(OrderedTask &task)
 {
-  OrderedTask task(task_behaviour);
   task.Append(StartPoint(new CylinderZone(wp1->location, 500),
                          WaypointPtr(wp1),
                          task_behaviour,
@@ -82,6 +85,13 @@ TestAATPoint()
                           ordered_task_settings.finish_constraints));
   task.SetActiveTaskPoint(1);
   task.UpdateGeometry();
+}
+
+static void
+TestAATPoint()
+{
+  OrderedTask task(task_behaviour);
+  MakeTask(task);
   ok1(task.CheckTask());
 
   AATPoint &ap = (AATPoint &)task.GetPoint(1);
@@ -139,15 +149,109 @@ TestAATPoint()
   }
 }
 
+static void
+TestIsolineCache()
+{
+  OrderedTask task(task_behaviour);
+  MakeTask(task);
+
+  AATPoint &ap = (AATPoint &)task.GetPoint(1);
+  const FlatProjection &projection = task.GetTaskProjection();
+
+  /* keep the target off the line between the neighbours, where the
+     isoline degenerates */
+  ap.SetTarget(MakeGeoPoint(0.05, 45.3), true);
+
+  ok1(ap.GetCachedIsolineSegment() == nullptr);
+  const AATIsolineSegment &seg = ap.GetIsolineSegment(projection);
+  ok1(seg.IsValid());
+  ok1(ap.GetCachedIsolineSegment() == &seg);
+  ok1(&ap.GetIsolineSegment(projection) == &seg);
+
+  /* moving the target along the isoline keeps it */
+  ap.SetIsolineTarget(0.25);
+  ok1(ap.GetTargetLocation() == seg.Parametric(0.25));
+  ok1(ap.GetCachedIsolineSegment() == &seg);
+
+  /* moving the target elsewhere invalidates it */
+  ap.SetTarget(MakeGeoPoint(0.03, 45.31), true);
+  ok1(ap.GetCachedIsolineSegment() == nullptr);
+
+  ap.GetIsolineSegment(projection);
+  ok1(ap.GetCachedIsolineSegment() != nullptr);
+  task.UpdateGeometry();
+  ok1(ap.GetCachedIsolineSegment() == nullptr);
+}
+
+static void
+TestOptTarget()
+{
+  OrderedTask task(task_behaviour);
+  MakeTask(task);
+
+  AATPoint &ap = (AATPoint &)task.GetPoint(1);
+  StartPoint &start = (StartPoint &)task.GetPoint(0);
+  const FlatProjection &projection = task.GetTaskProjection();
+  const std::vector<OrderedTaskPoint *> points{
+    &task.GetPoint(0), &task.GetPoint(1), &task.GetPoint(2),
+  };
+
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = MakeGeoPoint(0.02, 45.1);
+  aircraft.altitude = 5000;
+
+  ap.SetTarget(MakeGeoPoint(0.05, 45.3), true);
+  const AATIsolineSegment &seg = ap.GetIsolineSegment(projection);
+  TaskMacCreadyRemaining tm(points.begin(), points.end(), 1,
+                            task_behaviour.glide, glide_polar, false);
+
+  /* evaluating a candidate must match moving the target there */
+  start.ScanDistanceRemaining(aircraft.location);
+  for (unsigned i = 0; i <= 4; ++i) {
+    const double p = i / 4.;
+    const GlideResult candidate =
+      tm.glide_solution_target(aircraft, ap, seg.Parametric(p));
+
+    ap.SetIsolineTarget(p);
+    start.ScanDistanceRemaining(aircraft.location);
+    const GlideResult moved = tm.glide_solution(aircraft);
+
+    ok1(candidate.IsOk());
+    ok1(candidate.vector.distance == moved.vector.distance);
+    ok1(candidate.time_elapsed == moved.time_elapsed);
+  }
+
+  /* the optimised target is the best candidate on the isoline */
+  TaskOptTarget tot(points, 1, aircraft, task_behaviour.glide,
+                    glide_polar, ap, projection, &start);
+  const double t = tot.search(0.5);
+  ok1(t >= 0 && t <= 1);
+  ok1(ap.GetCachedIsolineSegment() == &seg);
+  ok1(ap.GetTargetLocation() == seg.Parametric(t));
+
+  start.ScanDistanceRemaining(aircraft.location);
+  const double best = tm.glide_solution(aircraft).time_elapsed;
+  bool optimal = true;
+  for (unsigned i = 0; i <= 20; ++i)
+    if (tm.glide_solution_target(aircraft, ap,
+                                 seg.Parametric(i / 20.)).time_elapsed <
+        best - 1)
+      optimal = false;
+  ok1(optimal);
+}
+
 static void
 TestAll()
 {
   TestAATPoint();
+  TestIsolineCache();
+  TestOptTarget();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(717);
+  plan_tests(745);
 
   task_behaviour.SetDefaults();
   ordered_task_settings.SetDefaults();
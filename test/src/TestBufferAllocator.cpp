@@ -0,0 +1,94 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/BufferAllocator.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestBasic()
+{
+  BufferAllocator a;
+  ok1(a.GetCapacity() == 0);
+  ok1(a.Allocate(1) == BufferAllocator::NONE);
+
+  a.Reset(100);
+  ok1(a.GetCapacity() == 100);
+  ok1(a.Allocate(30) == 0);
+  ok1(a.Allocate(30) == 30);
+  ok1(a.Allocate(30) == 60);
+  ok1(a.GetUsed() == 90);
+  ok1(a.Allocate(11) == BufferAllocator::NONE);
+  ok1(a.Allocate(10) == 90);
+  ok1(a.GetUsed() == 100);
+  ok1(a.Allocate(1) == BufferAllocator::NONE);
+
+  a.Reset(50);
+  ok1(a.GetUsed() == 0);
+  ok1(a.Allocate(50) == 0);
+}
+
+static void
+TestFree()
+{
+  BufferAllocator a;
+  a.Reset(100);
+  const unsigned r1 = a.Allocate(20);
+  const unsigned r2 = a.Allocate(20);
+  const unsigned r3 = a.Allocate(20);
+  const unsigned r4 = a.Allocate(40);
+  ok1(a.GetUsed() == 100);
+
+  /* first fit: the hole is reused */
+  a.Free(r2, 20);
+  ok1(a.GetUsed() == 80);
+  ok1(a.Allocate(30) == BufferAllocator::NONE);
+  ok1(a.Allocate(10) == r2);
+  ok1(a.Allocate(10) == r2 + 10);
+
+  /* merge with the following range */
+  a.Free(r2 + 10, 10);
+  a.Free(r2, 10);
+  a.Free(r3, 20);
+  ok1(a.Allocate(40) == r2);
+  a.Free(r2, 40);
+
+  /* merge with the preceding range */
+  a.Free(r1, 20);
+  ok1(a.Allocate(60) == r1);
+  a.Free(r1, 60);
+
+  /* merge with both */
+  a.Free(r4, 40);
+  ok1(a.GetUsed() == 0);
+  ok1(a.Allocate(100) == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(22);
+
+  TestBasic();
+  TestFree();
+
+  return exit_status();
+}
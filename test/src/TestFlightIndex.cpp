@@ -0,0 +1,178 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/FlightIndex.hpp"
+#include "FlightInfo.hpp"
+#include "IO/FileOutputStream.hxx"
+#include "OS/FileUtil.hpp"
+#include "TestUtil.hpp"
+#include "Util/PrintException.hxx"
+
+#include <stdio.h>
+#include <string.h>
+
+static void
+WriteLog(Path path, const char *text,
+         FileOutputStream::Mode mode=FileOutputStream::Mode::APPEND_OR_CREATE)
+{
+  FileOutputStream file(path, mode);
+  file.Write(text, strlen(text));
+  file.Commit();
+}
+
+/**
+ * Offset of the reserved field of the first record, which is zero in
+ * an index written by FlightIndex.  A marker stored there survives
+ * an incremental update, but not a rebuild.
+ */
+static constexpr long MARKER_OFFSET = 16 + 30;
+
+static void
+SetMarker(Path path)
+{
+  FILE *file = _tfopen(path.c_str(), _T("r+b"));
+  fseek(file, MARKER_OFFSET, SEEK_SET);
+  fputc(0x42, file);
+  fclose(file);
+}
+
+static bool
+HasMarker(Path path)
+{
+  FILE *file = _tfopen(path.c_str(), _T("rb"));
+  fseek(file, MARKER_OFFSET, SEEK_SET);
+  const int value = fgetc(file);
+  fclose(file);
+  return value == 0x42;
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(38);
+
+  const Path path(_T("output/test/flights.log"));
+  const Path index_path(_T("output/test/flights.log.idx"));
+  File::Delete(path);
+  File::Delete(index_path);
+
+  WriteLog(path,
+           "2016-05-01T10:00:00 start\n"
+           "2016-05-01T11:30:00 landing\n"
+           "2016-05-01T13:00:00 start\n"
+           "2016-05-01T13:20:00 landing\n"
+           "2016-05-02T09:00:00 start\n"
+           "2016-05-02T09:10:00 landing\n");
+
+  const FlightIndex index(path);
+  index.Update();
+
+  ok1(File::GetSize(index_path) == 16 + 3 * 40);
+
+  auto totals = index.GetTotals();
+  ok1(totals.flights == 3);
+  ok1(totals.duration == (90 + 20 + 10) * 60);
+
+  auto day = index.GetLastDay();
+  ok1(day.date == BrokenDate(2016, 5, 2));
+  ok1(day.flights == 1);
+  ok1(day.duration == 10 * 60);
+
+  auto flights = index.ReadRecent(10);
+  ok1(flights.size() == 3);
+  ok1(flights[0].date == BrokenDate(2016, 5, 1));
+  ok1(flights[0].start_time == BrokenTime(10, 0, 0));
+  ok1(flights[0].end_time == BrokenTime(11, 30, 0));
+  ok1(flights[2].start_time == BrokenTime(9, 0, 0));
+
+  /* a flight which has not landed yet is not indexed, but it is
+     listed; the existing records are kept */
+  SetMarker(index_path);
+  WriteLog(path, "2016-05-02T12:00:00 start\n");
+  index.Update();
+  ok1(File::GetSize(index_path) == 16 + 3 * 40);
+  ok1(HasMarker(index_path));
+  ok1(index.GetTotals().flights == 3);
+
+  flights = index.ReadRecent(10);
+  ok1(flights.size() == 4);
+  ok1(flights[3].start_time == BrokenTime(12, 0, 0));
+  ok1(!flights[3].end_time.IsPlausible());
+
+  /* the landing completes it; only the new record is appended */
+  WriteLog(path, "2016-05-02T14:00:00 landing\n");
+  index.Update();
+  ok1(File::GetSize(index_path) == 16 + 4 * 40);
+  ok1(HasMarker(index_path));
+
+  totals = index.GetTotals();
+  ok1(totals.flights == 4);
+  ok1(totals.duration == (90 + 20 + 10 + 120) * 60);
+
+  day = index.GetLastDay();
+  ok1(day.date == BrokenDate(2016, 5, 2));
+  ok1(day.flights == 2);
+  ok1(day.duration == (10 + 120) * 60);
+
+  flights = index.ReadRecent(2);
+  ok1(flights.size() == 2);
+  ok1(flights[0].start_time == BrokenTime(9, 0, 0));
+  ok1(flights[1].end_time == BrokenTime(14, 0, 0));
+
+  /* a start without landing is indexed once the next start appears */
+  WriteLog(path,
+           "2016-05-03T08:00:00 start\n"
+           "2016-05-03T10:00:00 start\n"
+           "2016-05-03T10:30:00 landing\n");
+  index.Update();
+  ok1(index.GetTotals().flights == 6);
+  ok1(index.GetLastDay().flights == 2);
+  ok1(index.GetLastDay().duration == 30 * 60);
+  ok1(HasMarker(index_path));
+
+  /* a replaced (shorter) log rebuilds the index */
+  WriteLog(path,
+           "2016-06-01T10:00:00 start\n"
+           "2016-06-01T10:45:00 landing\n",
+           FileOutputStream::Mode::CREATE);
+  index.Update();
+  ok1(File::GetSize(index_path) == 16 + 40);
+  ok1(index.GetTotals().flights == 1);
+  ok1(index.GetTotals().duration == 45 * 60);
+
+  /* so does a log which was replaced by a larger one */
+  WriteLog(path,
+           "2016-07-01T10:00:00 start\n"
+           "2016-07-01T10:05:00 landing\n"
+           "2016-07-01T11:00:00 start\n"
+           "2016-07-01T12:00:00 landing\n",
+           FileOutputStream::Mode::CREATE);
+  index.Update();
+  ok1(File::GetSize(index_path) == 16 + 2 * 40);
+  ok1(index.GetTotals().flights == 2);
+  ok1(index.GetTotals().duration == (5 + 60) * 60);
+  ok1(index.GetLastDay().date == BrokenDate(2016, 7, 1));
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -24,6 +24,8 @@
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Units/System.hpp"
 
+#include <algorithm>
+
 #include <cstdio>
 
 class GlidePolarTest
@@ -39,6 +41,7 @@ private:
   void TestBallast();
   void TestBugs();
   void TestMC();
+  void TestSpeedToFly();
 };
 
 void
@@ -163,6 +166,62 @@ GlidePolarTest::TestMC()
   ok1(equals(polar.GetVBestLD(), 25.830434162));
 }
 
+/**
+ * Find the speed to fly by scanning the whole speed range, to verify
+ * the analytic solution.
+ */
+static double
+ScanSpeedToFly(const GlidePolar &polar, double net_sink_rate,
+               double head_wind)
+{
+  const double v_low = std::max(1 + head_wind, polar.GetVMin());
+
+  double best_v = v_low, best_f = 1e10;
+  for (double v = v_low; v <= polar.GetVMax(); v += 0.001) {
+    const double f = (polar.MSinkRate(v) + net_sink_rate) / (v - head_wind);
+    if (f < best_f) {
+      best_f = f;
+      best_v = v;
+    }
+  }
+
+  return best_v;
+}
+
+void
+GlidePolarTest::TestSpeedToFly()
+{
+  static constexpr double mcs[] = { 0, 1, 3 };
+  static constexpr double net_sink_rates[] = { -2, 0, 1.5, 4 };
+  static constexpr double head_winds[] = { -10, 0, 10 };
+
+  for (const double mc : mcs) {
+    polar.SetMC(mc);
+
+    for (const double net_sink_rate : net_sink_rates)
+      for (const double head_wind : head_winds)
+        ok1(equals(polar.SpeedToFly(net_sink_rate, head_wind),
+                   ScanSpeedToFly(polar, net_sink_rate, head_wind)));
+  }
+
+  /* without wind and netto vario, the speed to fly is the best L/D
+     speed */
+  polar.SetMC(2);
+  ok1(equals(polar.SpeedToFly(0, 0), polar.GetVBestLD()));
+
+  /* strong lift: slow down to the minimum sink speed */
+  ok1(equals(polar.SpeedToFly(-10, 0), std::max(1., polar.GetVMin())));
+
+  /* ballast and bugs change the polar */
+  polar.SetBallastLitres(100);
+  polar.SetBugs(0.8);
+  ok1(equals(polar.SpeedToFly(1, 5), ScanSpeedToFly(polar, 1, 5)));
+
+  polar.SetBallastLitres(0);
+  polar.SetBugs(1);
+  polar.SetMC(0);
+}
+
 void
 GlidePolarTest::Run()
 {
@@ -171,11 +230,12 @@ GlidePolarTest::Run()
   TestBallast();
   TestBugs();
   TestMC();
+  TestSpeedToFly();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(46);
+  plan_tests(85);
 
   GlidePolarTest test;
   test.Run();
@@ -21,6 +21,7 @@
 */
 
 #include "IGC/IGCParser.hpp"
+#include "IGC/IGCBulkReader.hpp"
 #include "IGC/IGCExtensions.hpp"
 #include "IGC/IGCFix.hpp"
 #include "IGC/IGCHeader.hpp"
@@ -190,6 +191,70 @@ TestFix()
   ok1(fix.gps_altitude == 7);
 }
 
+static void
+TestFixLength()
+{
+  IGCExtensions extensions;
+  extensions.clear();
+
+  IGCFix fix;
+
+  /* not null-terminated: the last digits must not be parsed */
+  const char *line = "B1122385103117N00742367EA00490004879999";
+  ok1(IGCParseFix(line, 35, extensions, fix));
+  ok1(fix.time == BrokenTime(11, 22, 38));
+  ok1(equals(fix.location, 51.05195, 7.70611667));
+  ok1(fix.gps_altitude == 487);
+
+  ok1(!IGCParseFix(line, 25, extensions, fix));
+
+  /* a negative altitude is handled by the generic parser */
+  ok1(IGCParseFix("B1122385103117N00742367EA-001200487", 35,
+                  extensions, fix));
+  ok1(fix.pressure_altitude == -12);
+  ok1(fix.gps_altitude == 487);
+}
+
+static void
+TestBulkReader()
+{
+  static constexpr char data[] =
+    "AXCSFOO\r\n"
+    "HFDTE040910\r\n"
+    "I023638ENL3941SIU\r\n"
+    "B1122385103117N00742367EA0049000487012003\r\n"
+    "B1122395103117N00742367XA0049000487012003\r\n"
+    "B1122405103117S00742367WV0049100488\n"
+    "B1122415103117N00742367EA0049200489";
+
+  IGCFixColumns columns;
+  IGCParseFixes(data, sizeof(data) - 1, columns);
+
+  ok1(columns.size() == 3);
+  ok1(columns.dates.size() == 1);
+  ok1(columns.dates[0].fix_index == 0);
+  ok1(columns.dates[0].date == BrokenDate(2010, 9, 4));
+
+  IGCFix fix = columns[0];
+  ok1(fix.time == BrokenTime(11, 22, 38));
+  ok1(equals(fix.location, 51.05195, 7.70611667));
+  ok1(fix.gps_valid);
+  ok1(fix.pressure_altitude == 490);
+  ok1(fix.enl == 12);
+  ok1(fix.siu == 3);
+
+  fix = columns[1];
+  ok1(fix.time == BrokenTime(11, 22, 40));
+  ok1(equals(fix.location, -51.05195, -7.70611667));
+  ok1(!fix.gps_valid);
+  ok1(fix.gps_altitude == 488);
+  ok1(fix.enl == -1);
+
+  fix = columns[2];
+  ok1(fix.time == BrokenTime(11, 22, 41));
+  ok1(fix.gps_altitude == 489);
+}
+
 static void
 TestFixTime()
 {
@@ -270,13 +335,15 @@ TestDeclarationTurnpoint()
 
 int main(int argc, char **argv)
 {
-  plan_tests(148);
+  plan_tests(173);
 
   TestHeader();
   TestDate();
   TestLocation();
   TestExtensions();
   TestFix();
+  TestFixLength();
+  TestBulkReader();
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
@@ -0,0 +1,115 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Computer/IdleScheduler.hpp"
+#include "TestUtil.hpp"
+
+using std::chrono::milliseconds;
+
+typedef IdleScheduler::TimePoint TimePoint;
+
+static constexpr TimePoint
+At(unsigned ms)
+{
+  return TimePoint(milliseconds(ms));
+}
+
+static void
+TestPriority()
+{
+  IdleScheduler s;
+  const unsigned a = s.Add(milliseconds(500), 1);
+  const unsigned b = s.Add(milliseconds(500), 0);
+  ok1(a == 0);
+  ok1(b == 1);
+
+  /* nothing is due before new data arrives */
+  ok1(s.Pick(At(1000)) == -1);
+  ok1(s.GetNextRelease() == TimePoint::max());
+
+  s.MarkDirty(At(1000));
+  ok1(s.GetNextRelease() == TimePoint());
+
+  /* the more important job first */
+  ok1(s.Pick(At(1000)) == int(b));
+  s.Done(b, At(1000));
+  ok1(s.Pick(At(1010)) == int(a));
+  s.Done(a, At(1010));
+  ok1(s.Pick(At(1020)) == -1);
+  ok1(s.GetNextRelease() == TimePoint::max());
+
+  /* new data, but the period has not elapsed yet */
+  s.MarkDirty(At(1100));
+  ok1(s.Pick(At(1100)) == -1);
+  ok1(s.GetNextRelease() == At(1500));
+  ok1(s.Pick(At(1500)) == int(b));
+  s.Done(b, At(1500));
+  ok1(s.GetNextRelease() == At(1510));
+  ok1(s.Pick(At(1510)) == int(a));
+}
+
+static void
+TestOverdue()
+{
+  IdleScheduler s;
+  const unsigned a = s.Add(milliseconds(500), 0);
+
+  s.MarkDirty(At(1000));
+  ok1(!s.IsOverdue(a, At(1000)));
+  ok1(!s.IsOverdue(a, At(1499)));
+  ok1(s.IsOverdue(a, At(1500)));
+  s.Done(a, At(1500));
+  ok1(!s.IsOverdue(a, At(5000)));
+
+  /* due since the release time, not since the first MarkDirty() */
+  s.MarkDirty(At(1600));
+  s.MarkDirty(At(1700));
+  ok1(!s.IsOverdue(a, At(2499)));
+  ok1(s.IsOverdue(a, At(2500)));
+}
+
+static void
+TestForce()
+{
+  IdleScheduler s;
+  const unsigned a = s.Add(milliseconds(500), 0);
+
+  s.MarkDirty(At(1000));
+  s.Done(a, At(1000));
+  ok1(s.Pick(At(1200)) == -1);
+
+  s.Force(At(1200));
+  ok1(s.Pick(At(1200)) == int(a));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(22);
+
+  TestPriority();
+  TestOverdue();
+  TestForce();
+
+  return exit_status();
+}
@@ -145,7 +145,7 @@ Run(IGCWriter &writer)
 
   writer.Flush();
   writer.Sign();
-  writer.Flush();
+  writer.Close();
 }
 
 static void
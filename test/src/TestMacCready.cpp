@@ -29,6 +29,8 @@
 
 #include "TestUtil.hpp"
 
+#include <cassert>
+
 static GlideSettings glide_settings;
 static GlidePolar glide_polar(0);
 
@@ -139,13 +141,61 @@ TestAll()
   TestWind(SpeedVector(Angle::Zero(), 30));
 }
 
+/**
+ * Verify the pure glide speed optimisation (MC zero) in cross wind
+ * and with reduced cruise efficiency against a scan of the whole
+ * speed range.
+ */
+static void
+TestOptimumGlide(const SpeedVector wind, const double cruise_efficiency)
+{
+  assert(glide_polar.GetMC() <= 0);
+
+  const MacCready mac(glide_settings, glide_polar, cruise_efficiency);
+
+  const GeoVector vector(10000, Angle::Zero());
+  const GlideState state(vector, 2000, 3000, wind);
+  const GlideResult result = mac.Solve(state);
+
+  double best_v = 0, best_height = 1e10;
+  for (double v = glide_polar.GetVMin(); v <= glide_polar.GetVMax();
+       v += 0.001) {
+    const GlideResult r = mac.SolveGlide(state, v);
+    if (r.IsOk() && r.height_glide < best_height) {
+      best_height = r.height_glide;
+      best_v = v;
+    }
+  }
+
+  ok1(result.IsOk());
+  ok1(equals(result.v_opt, best_v, 1000));
+  ok1(result.height_glide <= best_height);
+  ok1(equals(result.height_glide, best_height));
+}
+
+static void
+TestOptimumGlide()
+{
+  static constexpr double cruise_efficiencies[] = { 1, 0.8 };
+
+  for (const double cruise_efficiency : cruise_efficiencies) {
+    TestOptimumGlide(SpeedVector(Angle::Zero(), 0), cruise_efficiency);
+    TestOptimumGlide(SpeedVector(Angle::Zero(), 10), cruise_efficiency);
+    TestOptimumGlide(SpeedVector(Angle::HalfCircle(), 10), cruise_efficiency);
+    TestOptimumGlide(SpeedVector(Angle::Degrees(60), 8), cruise_efficiency);
+    TestOptimumGlide(SpeedVector(Angle::Degrees(90), 15), cruise_efficiency);
+    TestOptimumGlide(SpeedVector(Angle::Degrees(135), 20), cruise_efficiency);
+  }
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(2095);
+  plan_tests(2143);
 
   glide_settings.SetDefaults();
 
   TestAll();
+  TestOptimumGlide();
 
   glide_polar.SetMC(0.1);
   TestAll();
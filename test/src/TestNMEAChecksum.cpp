@@ -0,0 +1,144 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "NMEA/Checksum.hpp"
+#include "Device/Util/ControlCharacter.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+static uint8_t
+ReferenceChecksum(const char *p, unsigned length)
+{
+  uint8_t checksum = 0;
+  for (unsigned i = 0; i < length; ++i)
+    checksum ^= p[i];
+  return checksum;
+}
+
+static const char *
+ReferenceFindControlCharacter(const char *p, const char *end)
+{
+  for (; p != end; ++p)
+    if ((unsigned char)*p < 0x20)
+      return p;
+  return nullptr;
+}
+
+/**
+ * Compare the vectorised checksum with a byte loop, for all lengths
+ * and alignments which can hit the remainder code paths.
+ */
+static void
+TestChecksumKernel()
+{
+  char buffer[128];
+  for (unsigned i = 0; i < sizeof(buffer); ++i)
+    buffer[i] = char(0x20 + (i * 37) % 0x5f);
+
+  bool success = true;
+  for (unsigned offset = 1; offset < 17; ++offset)
+    for (unsigned length = 0; offset + length <= sizeof(buffer); ++length)
+      if (NMEAChecksum(buffer + offset, length) !=
+          ReferenceChecksum(buffer + offset, length))
+        success = false;
+
+  ok1(success);
+
+  /* the leading dollar sign / exclamation mark is skipped */
+  buffer[0] = '$';
+  ok1(NMEAChecksum(buffer, 80) == ReferenceChecksum(buffer + 1, 79));
+  buffer[0] = '!';
+  ok1(NMEAChecksum(buffer, 80) == ReferenceChecksum(buffer + 1, 79));
+  ok1(NMEAChecksum("", 0u) == 0);
+}
+
+static void
+TestVerify()
+{
+  ok1(VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38*1B"));
+  ok1(VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38*1b"));
+  ok1(!VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38*1C"));
+  ok1(!VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,39*1B"));
+  ok1(!VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38"));
+  ok1(!VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38*"));
+  ok1(!VerifyNMEAChecksum("$GPRMC,011458,A,3600.033,S,14620.717,E,0,38*1BX"));
+
+  /* unusual forms handled by the slow path */
+  ok1(VerifyNMEAChecksum("$PGRMZ,99,m*3F"));
+  ok1(VerifyNMEAChecksum("$PFOP*9"));
+  ok1(!VerifyNMEAChecksum("$PFOP*8"));
+  ok1(VerifyNMEAChecksum("$PFOO*016"));
+  ok1(!VerifyNMEAChecksum("$PFOO*116"));
+}
+
+static void
+TestFindControlCharacter()
+{
+  char buffer[80];
+  memset(buffer, 'x', sizeof(buffer));
+
+  ok1(FindControlCharacter(buffer, buffer + sizeof(buffer)) == nullptr);
+  ok1(FindControlCharacter(buffer, buffer) == nullptr);
+
+  /* 0x7f and bytes with the high bit set are not control
+     characters */
+  buffer[3] = 0x7f;
+  buffer[40] = char(0x80);
+  buffer[41] = char(0xff);
+  ok1(FindControlCharacter(buffer, buffer + sizeof(buffer)) == nullptr);
+
+  bool success = true;
+  for (unsigned offset = 0; offset < 17; ++offset) {
+    for (unsigned position = offset; position < sizeof(buffer); ++position) {
+      for (char ch : {'\0', '\r', '\x1f'}) {
+        const char old = buffer[position];
+        buffer[position] = ch;
+
+        const char *begin = buffer + offset, *end = buffer + sizeof(buffer);
+        if (FindControlCharacter(begin, end) !=
+            ReferenceFindControlCharacter(begin, end))
+          success = false;
+
+        /* must not look past the end */
+        if (FindControlCharacter(begin, buffer + position) != nullptr)
+          success = false;
+
+        buffer[position] = old;
+      }
+    }
+  }
+
+  ok1(success);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(20);
+
+  TestChecksumKernel();
+  TestVerify();
+  TestFindControlCharacter();
+
+  return exit_status();
+}
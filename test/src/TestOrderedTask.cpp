@@ -419,9 +419,41 @@ TestAll()
   TestLowTPFinal();
 }
 
+/**
+ * Inserting a task point must discard the boundary distance table
+ * of the previous point, which was built for the old neighbour.
+ */
+static void
+TestInsertBoundaryDistances()
+{
+  OrderedTask task(task_behaviour);
+  const StartPoint tp1(new LineSectorZone(wp1->location),
+                       WaypointPtr(wp1), task_behaviour,
+                       ordered_task_settings.start_constraints);
+  task.Append(tp1);
+  const FinishPoint tp3(new LineSectorZone(wp3->location),
+                        WaypointPtr(wp3), task_behaviour,
+                        ordered_task_settings.finish_constraints, false);
+  task.Append(tp3);
+  task.UpdateGeometry();
+  ok1(task.GetTaskPoint(0).GetBoundaryDistances() != nullptr);
+
+  const ASTPoint tp2(new LineSectorZone(wp5->location),
+                     WaypointPtr(wp5), task_behaviour);
+  task.Insert(tp2, 1);
+  ok1(task.GetTaskPoint(0).GetBoundaryDistances() == nullptr);
+  ok1(task.GetTaskPoint(1).GetBoundaryDistances() == nullptr);
+
+  task.UpdateGeometry();
+  ok1(task.GetTaskPoint(0).GetBoundaryDistances() != nullptr);
+  ok1(task.GetTaskPoint(1).GetBoundaryDistances() != nullptr);
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(728);
+  plan_tests(733);
+
+  TestInsertBoundaryDistances();
 
   task_behaviour.SetDefaults();
 
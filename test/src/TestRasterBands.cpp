@@ -0,0 +1,253 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Screen/Memory/RasterCanvas.hpp"
+#include "Screen/Memory/PixelTraits.hpp"
+#include "Screen/Memory/BandPool.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef GreyscalePixelTraits Traits;
+typedef RasterCanvas<Traits> TestCanvas;
+
+static constexpr unsigned WIDTH = 97, HEIGHT = 83;
+
+struct Image {
+  unsigned width, height;
+  std::vector<Luminosity8> pixels;
+
+  Image(unsigned _width, unsigned _height)
+    :width(_width), height(_height), pixels(width * height, Luminosity8(0)) {}
+
+  WritableImageBuffer<Traits> GetBuffer() {
+    return { pixels.data(), unsigned(width * sizeof(Luminosity8)),
+             width, height };
+  }
+
+  /**
+   * Compare with the rows [top, top + other.height) of this image.
+   */
+  bool Equals(const Image &other, unsigned top=0) const {
+    return width == other.width && top + other.height <= height &&
+      memcmp(pixels.data() + top * width, other.pixels.data(),
+             other.pixels.size() * sizeof(Luminosity8)) == 0;
+  }
+};
+
+static std::vector<PixelPoint>
+RandomPolygon()
+{
+  std::vector<PixelPoint> points(3 + rand() % 40);
+  for (auto &p : points) {
+    /* reach beyond all edges of the image */
+    p.x = int(rand() % (2 * WIDTH)) - int(WIDTH / 2);
+    p.y = int(rand() % (2 * HEIGHT)) - int(HEIGHT / 2);
+  }
+
+  return points;
+}
+
+static std::vector<PixelPoint>
+Translate(std::vector<PixelPoint> points, int dy)
+{
+  for (auto &p : points)
+    p.y += dy;
+  return points;
+}
+
+/**
+ * Call the function for random bands covering all rows.
+ */
+template<typename F>
+static void
+ForRandomBands(unsigned height, F &&f)
+{
+  for (unsigned top = 0; top < height;) {
+    const unsigned bottom = std::min(top + 1 + rand() % 20, height);
+    f(top, bottom);
+    top = bottom;
+  }
+}
+
+static void
+TestPolygons()
+{
+  /* large enough to contain every polygon */
+  static constexpr unsigned MARGIN = HEIGHT;
+
+  bool fast_clipped = true, fast_banded = true;
+  bool scan_clipped = true, scan_banded = true;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    const auto points = RandomPolygon();
+    const auto shifted = Translate(points, MARGIN);
+    const Luminosity8 color(1 + rand() % 255);
+
+    /* FillPolygonFast() */
+
+    Image full(WIDTH, HEIGHT), reference(WIDTH, HEIGHT + 2 * MARGIN);
+    TestCanvas(full.GetBuffer()).FillPolygon(points.data(), points.size(),
+                                             color);
+    TestCanvas(reference.GetBuffer()).FillPolygon(shifted.data(),
+                                                  shifted.size(), color);
+    fast_clipped &= reference.Equals(full, MARGIN);
+
+    Image banded(WIDTH, HEIGHT);
+    ForRandomBands(HEIGHT, [&](int top, int bottom){
+        TestCanvas(banded.GetBuffer()).FillPolygon(points.data(),
+                                                   points.size(),
+                                                   color, top, bottom);
+      });
+    fast_banded &= banded.Equals(full);
+
+    /* the per-scanline FillPolygon() */
+
+    Image full2(WIDTH, HEIGHT), reference2(WIDTH, HEIGHT + 2 * MARGIN);
+    TestCanvas(full2.GetBuffer()).FillPolygon(points.data(), points.size(),
+                                              color, Traits());
+    TestCanvas(reference2.GetBuffer()).FillPolygon(shifted.data(),
+                                                   shifted.size(), color,
+                                                   Traits());
+    scan_clipped &= reference2.Equals(full2, MARGIN);
+
+    Image banded2(WIDTH, HEIGHT);
+    ForRandomBands(HEIGHT, [&](int top, int bottom){
+        TestCanvas(banded2.GetBuffer()).FillPolygon(points.data(),
+                                                    points.size(),
+                                                    color, Traits(),
+                                                    top, bottom);
+      });
+    scan_banded &= banded2.Equals(full2);
+  }
+
+  /* skipping invisible rows does not change the result */
+  ok1(fast_clipped);
+  ok1(scan_clipped);
+
+  /* neither does splitting into bands */
+  ok1(fast_banded);
+  ok1(scan_banded);
+}
+
+static void
+TestScale()
+{
+  Image src(37, 23);
+  for (auto &i : src.pixels)
+    i = Luminosity8(rand());
+
+  bool enlarge = true, shrink = true;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    /* alternate between enlarging and shrinking */
+    const bool large = i % 2 == 0;
+    const unsigned dest_width = large
+      ? src.width + rand() % (3 * WIDTH)
+      : 1 + rand() % src.width;
+    const unsigned dest_height = large
+      ? src.height + rand() % (3 * HEIGHT)
+      : 1 + rand() % src.height;
+    const int dest_x = int(rand() % (2 * WIDTH)) - int(WIDTH);
+    const int dest_y = int(rand() % (2 * HEIGHT)) - int(HEIGHT);
+
+    Image full(WIDTH, HEIGHT);
+    TestCanvas(full.GetBuffer()).ScaleRectangle(dest_x, dest_y,
+                                                dest_width, dest_height,
+                                                src.pixels.data(), src.width,
+                                                src.width, src.height);
+
+    Image banded(WIDTH, HEIGHT);
+    ForRandomBands(HEIGHT, [&](int top, int bottom){
+        TestCanvas(banded.GetBuffer()).ScaleRectangle(dest_x, dest_y,
+                                                      dest_width, dest_height,
+                                                      src.pixels.data(),
+                                                      src.width,
+                                                      src.width, src.height,
+                                                      top, bottom);
+      });
+
+    (large ? enlarge : shrink) &= banded.Equals(full);
+  }
+
+  ok1(enlarge);
+  ok1(shrink);
+}
+
+static void
+TestPool()
+{
+  ok1(!BandPool::CanSplit(1000, 1000));
+
+  BandPool::Initialise(3);
+  ok1(BandPool::CanSplit(1000, 1000));
+  ok1(!BandPool::CanSplit(10, 1000));
+  ok1(!BandPool::CanSplit(100, 10));
+
+  /* every row is drawn exactly once */
+  std::vector<unsigned> counts(1000, 0);
+  BandPool::RunParallel(13, 1000, [&counts](int top, int bottom){
+      for (int y = top; y < bottom; ++y)
+        ++counts[y];
+    });
+
+  bool once = true;
+  for (unsigned y = 0; y < counts.size(); ++y)
+    once &= counts[y] == (y < 13 ? 0u : 1u);
+  ok1(once);
+
+  /* a polygon drawn by the pool */
+  static constexpr unsigned SIZE = 512;
+  const std::vector<PixelPoint> points{
+    { -10, 3 }, { 400, -50 }, { 520, 200 }, { 250, 260 },
+    { 480, 530 }, { 20, 500 }, { 120, 250 },
+  };
+
+  Image full(SIZE, SIZE), banded(SIZE, SIZE);
+  TestCanvas(full.GetBuffer()).FillPolygon(points.data(), points.size(),
+                                           Luminosity8(0x80));
+  BandPool::Run(0, SIZE, SIZE, [&](int top, int bottom){
+      TestCanvas(banded.GetBuffer()).FillPolygon(points.data(),
+                                                 points.size(),
+                                                 Luminosity8(0x80),
+                                                 top, bottom);
+    });
+  ok1(banded.Equals(full));
+
+  BandPool::Deinitialise();
+  ok1(!BandPool::CanSplit(1000, 1000));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(13);
+
+  TestPolygons();
+  TestScale();
+  TestPool();
+
+  return exit_status();
+}
@@ -0,0 +1,98 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Route/ReachRayCache.hpp"
+#include "TestUtil.hpp"
+
+static constexpr double GRADIENT = 0.025;
+
+/**
+ * Look up a ray from the specified origin, with a projection scale of
+ * 1 m per unit.
+ */
+static const ReachRayCache::Ray *
+Find(const ReachRayCache &cache, int index, int x, int y, int altitude,
+     double gradient=GRADIENT)
+{
+  return cache.Find(index, AFlatGeoPoint(x, y, altitude), gradient, 1);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(20);
+
+  ReachRayCache cache;
+  ok1(cache.GetRayCount() == 0);
+
+  cache.Add(3, {AFlatGeoPoint(0, 0, 1000), FlatGeoPoint(10000, 0), GRADIENT},
+            false);
+
+  // same origin
+  const auto *ray = Find(cache, 3, 0, 0, 1000);
+  ok1(ray != nullptr);
+  ok1(ray != nullptr && ray->intercept == FlatGeoPoint(10000, 0));
+
+  // wrong direction
+  ok1(Find(cache, 4, 0, 0, 1000) == nullptr);
+
+  // glided 200m along the ray
+  ok1(Find(cache, 3, 200, 0, 995) != nullptr);
+
+  // sinking faster than the glide slope, even slightly
+  ok1(Find(cache, 3, 200, 0, 994) == nullptr);
+  ok1(Find(cache, 3, 200, 0, 980) == nullptr);
+
+  // climbing a little: under-estimating is allowed
+  ok1(Find(cache, 3, 200, 0, 1010) != nullptr);
+
+  // climbing too much
+  ok1(Find(cache, 3, 0, 0, 1050) == nullptr);
+
+  // lateral offset within/beyond the angular resolution
+  ok1(Find(cache, 3, 0, 200, 1000) != nullptr);
+  ok1(Find(cache, 3, 0, 500, 1000) == nullptr);
+
+  // moved behind the old origin, or beyond the intercept
+  ok1(Find(cache, 3, -500, 0, 1000) == nullptr);
+  ok1(Find(cache, 3, 10000, 0, 1000) == nullptr);
+
+  // a little behind the old origin, within the lateral tolerance
+  ok1(Find(cache, 3, -100, 0, 1005) == nullptr);
+
+  // worse glide slope
+  ok1(Find(cache, 3, 0, 0, 1000, 0.03) == nullptr);
+
+  /* better glide slope, starting below the old glide line: the new
+     line is above the old one at the intercept, but below it near
+     the new origin */
+  ok1(Find(cache, 3, 4000, 0, 880, 0.02) == nullptr);
+  ok1(Find(cache, 3, 4000, 0, 900, 0.0235) != nullptr);
+
+  cache.Add(5, *Find(cache, 3, 0, 0, 1000), true);
+  ok1(cache.GetRayCount() == 2);
+  ok1(cache.GetReusedCount() == 1);
+
+  cache.Clear();
+  ok1(Find(cache, 3, 0, 0, 1000) == nullptr);
+
+  return exit_status();
+}
@@ -0,0 +1,125 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/Prefetch.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "TestUtil.hpp"
+
+static GeoBounds
+MakeScreen()
+{
+  /* about 11 km x 7 km */
+  return GeoBounds(GeoPoint(Angle::Degrees(7.0), Angle::Degrees(51.1)),
+                   GeoPoint(Angle::Degrees(7.1), Angle::Degrees(51.0)));
+}
+
+static void
+TestIdle()
+{
+  TopographyPrefetch p;
+  p.UpdateZoom(0, 1000);
+  p.UpdateZoom(1, 1000);
+  ok1(p.GetZoomFactor() == 1);
+
+  /* not moving, not zooming: nothing to prefetch */
+  ok1(!p.Predict(MakeScreen(), 1000, SpeedVector::Zero()).IsDefined());
+  ok1(!p.Predict(GeoBounds::Invalid(), 1000,
+                 SpeedVector(Angle::Zero(), 30)).IsDefined());
+}
+
+static void
+TestMotion()
+{
+  TopographyPrefetch p;
+  const GeoBounds screen = MakeScreen();
+
+  /* 30 m/s eastwards: 1.8 km ahead, same size and scale */
+  auto area = p.Predict(screen, 1000, SpeedVector(Angle::Degrees(90), 30));
+  ok1(area.IsDefined());
+  ok1(equals(area.map_scale, 1000));
+  ok1(area.bounds.GetEast() > screen.GetEast());
+  ok1(area.bounds.GetWest() > screen.GetWest());
+  ok1(area.bounds.GetWest() < screen.GetEast());
+  ok1(equals(area.bounds.GetNorth(), screen.GetNorth()));
+  ok1(equals(area.bounds.GetWidth(), screen.GetWidth()));
+
+  /* northwards */
+  area = p.Predict(screen, 1000, SpeedVector(Angle::Zero(), 30));
+  ok1(area.bounds.GetNorth() > screen.GetNorth());
+  ok1(equals(area.bounds.GetWest(), screen.GetWest()));
+
+  /* very fast: not more than one screen height ahead */
+  area = p.Predict(screen, 1000, SpeedVector(Angle::Zero(), 1000));
+  ok1(equals(area.bounds.GetSouth(), screen.GetNorth()));
+}
+
+static void
+TestZoom()
+{
+  TopographyPrefetch p;
+  const GeoBounds screen = MakeScreen();
+
+  /* zoom out by a factor of two */
+  p.UpdateZoom(0, 1000);
+  p.UpdateZoom(1, 2000);
+  ok1(equals(p.GetZoomFactor(), 2));
+
+  auto area = p.Predict(screen, 2000, SpeedVector::Zero());
+  ok1(area.IsDefined());
+  ok1(equals(area.map_scale, 4000));
+  ok1(area.bounds.IsInside(screen));
+  ok1(equals(area.bounds.GetHeight(), screen.GetHeight() * 2));
+
+  /* the trend decays */
+  p.UpdateZoom(11, 2000);
+  ok1(p.GetZoomFactor() > 1.1);
+  ok1(p.GetZoomFactor() < 2);
+  p.UpdateZoom(60, 2000);
+  ok1(p.GetZoomFactor() == 1);
+
+  /* zoom in: smaller area at a smaller scale */
+  p.UpdateZoom(61, 1000);
+  area = p.Predict(screen, 1000, SpeedVector::Zero());
+  ok1(area.map_scale < 1000);
+  ok1(screen.IsInside(area.bounds));
+
+  /* the prediction is limited */
+  for (unsigned i = 0; i < 10; ++i)
+    p.UpdateZoom(62 + i, 1000 >> i);
+  ok1(equals(p.GetZoomFactor(), 1. / TopographyPrefetch::MAX_ZOOM_FACTOR));
+
+  /* a clock going backwards resets the trend */
+  p.UpdateZoom(10, 1000);
+  ok1(p.GetZoomFactor() == 1);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(25);
+
+  TestIdle();
+  TestMotion();
+  TestZoom();
+
+  return exit_status();
+}
@@ -0,0 +1,193 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Waypoint/WaypointIndex.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * A simple deterministic pseudo random number generator.
+ */
+static unsigned
+Random()
+{
+  static uint32_t state = 12345;
+  state = state * 1103515245u + 12345u;
+  return state >> 8;
+}
+
+static int
+RandomCoordinate()
+{
+  return int(Random() % 200000) - 100000;
+}
+
+static WaypointPtr
+MakeWaypoint(int x, int y, Waypoint::Type type)
+{
+  Waypoint wp(GeoPoint(Angle::Zero(), Angle::Zero()));
+  wp.flat_location = FlatGeoPoint(x, y);
+  wp.type = type;
+  return WaypointPtr(new Waypoint(std::move(wp)));
+}
+
+static uint64_t
+SquareDistance(const Waypoint &wp, const FlatGeoPoint &p)
+{
+  const int64_t dx = int64_t(wp.flat_location.x) - p.x;
+  const int64_t dy = int64_t(wp.flat_location.y) - p.y;
+  return uint64_t(dx * dx) + uint64_t(dy * dy);
+}
+
+/**
+ * Brute force reference for WaypointIndex::FindNearestIf().  Returns
+ * the square distance of the nearest match, or UINT64_MAX.
+ */
+template<typename P>
+static uint64_t
+NearestSquareDistance(const std::vector<WaypointPtr> &waypoints,
+                      const FlatGeoPoint &p, unsigned range, P predicate)
+{
+  uint64_t result = UINT64_MAX;
+  for (const auto &wp : waypoints) {
+    const uint64_t d = SquareDistance(*wp, p);
+    if (d <= uint64_t(range) * range && predicate(*wp) && d < result)
+      result = d;
+  }
+
+  return result;
+}
+
+static uint64_t
+SquareDistance(const WaypointPtr *wp, const FlatGeoPoint &p)
+{
+  return wp != nullptr ? SquareDistance(**wp, p) : UINT64_MAX;
+}
+
+static bool
+IsLandable(const Waypoint &wp)
+{
+  return wp.IsLandable();
+}
+
+static bool
+AlwaysTrue(const Waypoint &wp)
+{
+  return true;
+}
+
+static void
+TestRandom()
+{
+  std::vector<WaypointPtr> waypoints;
+
+  /* a dense cluster and a sparse field, with a few duplicates */
+  for (unsigned i = 0; i < 2000; ++i)
+    waypoints.push_back(MakeWaypoint(RandomCoordinate(), RandomCoordinate(),
+                                     i % 5 == 0
+                                     ? Waypoint::Type::OUTLANDING
+                                     : Waypoint::Type::NORMAL));
+
+  for (unsigned i = 0; i < 2000; ++i)
+    waypoints.push_back(MakeWaypoint(RandomCoordinate() / 100,
+                                     RandomCoordinate() / 100,
+                                     Waypoint::Type::NORMAL));
+
+  waypoints.push_back(MakeWaypoint(0, 0, Waypoint::Type::AIRFIELD));
+  waypoints.push_back(MakeWaypoint(0, 0, Waypoint::Type::NORMAL));
+
+  WaypointIndex index;
+  index.Build(waypoints.begin(), waypoints.end());
+  ok1(index.size() == waypoints.size());
+
+  static constexpr unsigned ranges[] = { 0, 10, 500, 5000, 50000, 1000000 };
+
+  bool visit_ok = true, nearest_ok = true, landable_ok = true, if_ok = true;
+
+  for (unsigned i = 0; i < 300; ++i) {
+    const FlatGeoPoint p = i % 3 == 0
+      ? FlatGeoPoint(RandomCoordinate() / 50, RandomCoordinate() / 50)
+      : FlatGeoPoint(RandomCoordinate() * 3 / 2, RandomCoordinate() * 3 / 2);
+    const unsigned range = ranges[i % (sizeof(ranges) / sizeof(ranges[0]))];
+
+    unsigned expected = 0;
+    for (const auto &wp : waypoints)
+      if (SquareDistance(*wp, p) <= uint64_t(range) * range)
+        ++expected;
+
+    unsigned visited = 0;
+    bool in_range = true;
+    index.VisitWithinRange(p, range, [&](const WaypointPtr &wp){
+        ++visited;
+        if (SquareDistance(*wp, p) > uint64_t(range) * range)
+          in_range = false;
+      });
+
+    if (visited != expected || !in_range)
+      visit_ok = false;
+
+    if (SquareDistance(index.FindNearest(p, range), p) !=
+        NearestSquareDistance(waypoints, p, range, AlwaysTrue))
+      nearest_ok = false;
+
+    if (SquareDistance(index.FindNearest(p, range, WaypointIndex::LANDABLE), p) !=
+        NearestSquareDistance(waypoints, p, range, IsLandable))
+      landable_ok = false;
+
+    if (SquareDistance(index.FindNearestIf(p, range, IsLandable), p) !=
+        NearestSquareDistance(waypoints, p, range, IsLandable))
+      if_ok = false;
+  }
+
+  ok1(visit_ok);
+  ok1(nearest_ok);
+  ok1(landable_ok);
+  ok1(if_ok);
+
+  const WaypointPtr *airport = index.FindNearest(FlatGeoPoint(0, 0), 0,
+                                                 WaypointIndex::AIRPORT);
+  ok1(airport != nullptr && (*airport)->IsAirport());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(10);
+
+  WaypointIndex index;
+  ok1(index.IsEmpty());
+  ok1(index.FindNearest(FlatGeoPoint(0, 0), 1000) == nullptr);
+
+  const std::vector<WaypointPtr> one{
+    MakeWaypoint(100, 100, Waypoint::Type::NORMAL),
+  };
+  index.Build(one.begin(), one.end());
+  ok1(index.FindNearest(FlatGeoPoint(0, 0), 100) == nullptr);
+  ok1(index.FindNearest(FlatGeoPoint(0, 0), 142) != nullptr);
+
+  TestRandom();
+
+  return exit_status();
+}
@@ -22,11 +22,18 @@
 
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/WaypointReaderSeeYou.hpp"
+#include "Waypoint/WaypointFileType.hpp"
+#include "Waypoint/WaypointCache.hpp"
+#include "Waypoint/Factory.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/System.hpp"
 #include "TestUtil.hpp"
 #include "OS/Path.hpp"
+#include "OS/FileUtil.hpp"
+#include "IO/FileLineReader.hpp"
+#include "IO/FileCache.hpp"
 #include "Util/tstring.hpp"
 #include "Util/StringAPI.hxx"
 #include "Util/ExtractParameters.hpp"
@@ -34,6 +41,8 @@
 
 #include <vector>
 
+#include <stdio.h>
+
 static void
 TestExtractParameters()
 {
@@ -440,6 +449,106 @@ TestCompeGPS_UTM(wp_vector org_wp)
   }
 }
 
+static bool
+IsEqual(const Waypoint &a, const Waypoint &b)
+{
+  return a.location == b.location && a.elevation == b.elevation &&
+    a.name == b.name && a.comment == b.comment &&
+    a.type == b.type && a.origin == b.origin &&
+    a.flags.turn_point == b.flags.turn_point &&
+    a.runway.IsLengthDefined() == b.runway.IsLengthDefined() &&
+    a.radio_frequency.IsDefined() == b.radio_frequency.IsDefined() &&
+    (!a.radio_frequency.IsDefined() ||
+     a.radio_frequency.GetKiloHertz() == b.radio_frequency.GetKiloHertz());
+}
+
+static bool
+IsEqual(const std::vector<Waypoint> &a, const std::vector<Waypoint> &b)
+{
+  return a.size() == b.size() &&
+    std::equal(a.begin(), a.end(), b.begin(),
+               [](const Waypoint &x, const Waypoint &y){
+                 return IsEqual(x, y);
+               });
+}
+
+/**
+ * Write a SeeYou file which is large enough to be parsed in chunks,
+ * followed by a task section which must be ignored.
+ */
+static void
+WriteLargeSeeYouFile(Path path, unsigned n)
+{
+  FILE *file = _tfopen(path.c_str(), _T("w"));
+  fputs("name,code,country,lat,lon,elev,style,rwdir,rwlen,freq,desc\n", file);
+
+  for (unsigned i = 0; i < n; ++i)
+    fprintf(file, "\"WP%u\",%u,DE,%02u%02u.%03uN,%03u%02u.%03uE,%um,%u,,%s,%s,\"%s\"\n",
+            i, i, 40 + i % 10, i % 60, i % 1000, 5 + i % 7, (i / 7) % 60,
+            (i * 7) % 1000, i % 3000, 1 + i % 5,
+            i % 5 == 1 ? "800m" : "", i % 5 == 1 ? "123.500" : "",
+            i % 11 == 0 ? "Hotspot" : "comment");
+
+  fputs("-----Related Tasks-----\n", file);
+  for (unsigned i = 0; i < 100; ++i)
+    fprintf(file, "\"Task%u\",\"WP1\",\"WP2\"\n", i);
+
+  fclose(file);
+}
+
+static void
+TestSeeYouParallel()
+{
+  static constexpr unsigned N = 50000;
+  const Path path(_T("output/results/waypoints_large.cup"));
+
+  Directory::Create(Path(_T("output/results")));
+  WriteLargeSeeYouFile(path, N);
+
+  const WaypointFactory factory(WaypointOrigin::PRIMARY);
+  NullOperationEnvironment operation;
+
+  /* reference: parse line by line */
+  std::vector<Waypoint> expected;
+  {
+    WaypointReaderSeeYou reader(factory);
+    FileLineReader line_reader(path, Charset::AUTO);
+    reader.Parse(expected, line_reader, operation);
+  }
+  ok1(expected.size() == N);
+
+  /* split the file into chunks */
+  std::vector<Waypoint> actual;
+  {
+    WaypointReaderSeeYou reader(factory);
+    FileLineReader line_reader(path, Charset::AUTO);
+    ParseWaypointFile(reader, line_reader, actual, 4, operation);
+  }
+  ok1(IsEqual(actual, expected));
+
+  /* with the default number of threads */
+  actual.clear();
+  ok1(ReadWaypointFile(path, WaypointFileType::SEEYOU, actual,
+                       factory, operation));
+  ok1(IsEqual(actual, expected));
+
+  /* binary snapshot round trip */
+  FileCache cache(AllocatedPath(_T("output/results/cache")));
+  ok1(SaveWaypointCache(cache, _T("waypoints"), path, _T("key"),
+                        actual));
+
+  std::vector<Waypoint> cached;
+  ok1(!LoadWaypointCache(cache, _T("waypoints"), path,
+                         _T("other key"), cached));
+  ok1(cached.empty());
+
+  ok1(SaveWaypointCache(cache, _T("waypoints"), path, _T("key"),
+                        actual));
+  ok1(LoadWaypointCache(cache, _T("waypoints"), path, _T("key"),
+                        cached));
+  ok1(IsEqual(cached, expected));
+}
+
 static wp_vector
 CreateOriginalWaypoints()
 {
@@ -537,7 +646,7 @@ int main(int argc, char **argv)
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(360);
+  plan_tests(370);
 
   TestExtractParameters();
 
@@ -549,6 +658,7 @@ int main(int argc, char **argv)
   TestOzi(org_wp);
   TestCompeGPS(org_wp);
   TestCompeGPS_UTM(org_wp);
+  TestSeeYouParallel();
 
   return exit_status();
 }
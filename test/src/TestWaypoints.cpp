@@ -25,7 +25,13 @@
 #include "Geo/GeoVector.hpp"
 #include "test_debug.hpp"
 
+#include "Util/StringAPI.hxx"
+#include "Util/StringCompare.hxx"
+#include "Util/Macros.hpp"
+
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <stdio.h>
 #include <tchar.h>
@@ -158,6 +164,79 @@ TestNamePrefixVisitor(const Waypoints &waypoints)
   TestNamePrefixVisitor(waypoints, _T("Field"), 51 - 8);
 }
 
+/**
+ * Collects the names visited by Waypoints::VisitNameContaining().
+ */
+class NameCollector final : public WaypointVisitor {
+public:
+  std::vector<tstring> names;
+
+  void Visit(const WaypointPtr &wp) override {
+    names.push_back(wp->name);
+  }
+};
+
+static std::vector<tstring>
+VisitNameContaining(const Waypoints &waypoints, const TCHAR *s)
+{
+  NameCollector collector;
+  waypoints.VisitNameContaining(s, collector);
+  return collector.names;
+}
+
+static void
+TestNameContaining(const Waypoints &waypoints)
+{
+  /* "Airfield #N" and "Field #N"; names starting with the string
+     come first */
+  auto names = VisitNameContaining(waypoints, _T("field"));
+  ok1(names.size() == 22 + 51 - 8);
+  ok1(std::all_of(names.begin(), names.begin() + 51 - 8,
+                  [](const tstring &name){
+                    return StringStartsWith(name.c_str(), _T("Field"));
+                  }));
+
+  /* non-alphanumeric characters are ignored */
+  names = VisitNameContaining(waypoints, _T("d #15"));
+  ok1(names.size() == 2);
+  ok1(names.size() == 2 && names[0] == _T("Airfield #15") &&
+      names[1] == _T("Field #151"));
+
+  ok1(VisitNameContaining(waypoints, _T("")).size() == 151);
+  ok1(VisitNameContaining(waypoints, _T("xyz")).empty());
+
+  TCHAR buffer[64];
+  const TCHAR *suggest =
+    waypoints.SuggestNameContaining(_T("fiel"), buffer, ARRAY_SIZE(buffer));
+  ok1(suggest != nullptr && StringIsEqual(suggest, _T("D")));
+
+  suggest = waypoints.SuggestNameContaining(_T("d"), buffer,
+                                            ARRAY_SIZE(buffer));
+  ok1(suggest != nullptr && StringIsEqual(suggest, _T("123456789")));
+
+  ok1(waypoints.SuggestNameContaining(_T("xyz"), buffer,
+                                      ARRAY_SIZE(buffer)) == nullptr);
+
+  /* without the index (not optimised yet), the same names are
+     visited in the same order */
+  Waypoints copy;
+  for (const auto &i : waypoints) {
+    Waypoint w = *i;
+    copy.Append(std::move(w));
+  }
+
+  auto a = VisitNameContaining(waypoints, _T("int 1"));
+  auto b = VisitNameContaining(copy, _T("int 1"));
+  ok1(!a.empty() && a == b);
+
+  a = VisitNameContaining(waypoints, _T("field"));
+  b = VisitNameContaining(copy, _T("field"));
+  ok1(!a.empty() && a == b);
+
+  suggest = copy.SuggestNameContaining(_T("d"), buffer, ARRAY_SIZE(buffer));
+  ok1(suggest != nullptr && StringIsEqual(suggest, _T("123456789")));
+}
+
 class CloserThan
 {
   double distance;
@@ -299,13 +378,43 @@ TestReplace(Waypoints& waypoints, unsigned id)
   return wp != NULL && wp->name != oldName && wp->name == _T("Fred");
 }
 
+static bool
+TestPendingIndex(Waypoints &waypoints, const GeoPoint &center)
+{
+  Waypoint a(GeoVector(500, Angle::Degrees(200)).EndPoint(center));
+  a.name = _T("Marker A");
+  const auto wp_a = waypoints.Append(std::move(a));
+  waypoints.OptimiseTree();
+
+  Waypoints::PendingIndex pending;
+  waypoints.BuildIndex(pending);
+
+  /* modified after the index was built: it must not be installed */
+  Waypoint b(GeoVector(500, Angle::Degrees(20)).EndPoint(center));
+  b.name = _T("Marker B");
+  const auto wp_b = waypoints.Append(std::move(b));
+  waypoints.OptimiseTree();
+  waypoints.InstallIndex(pending);
+
+  if (waypoints.GetNearest(wp_a->location, 1) != wp_a ||
+      waypoints.GetNearest(wp_b->location, 1) != wp_b)
+    return false;
+
+  waypoints.BuildIndex(pending);
+  waypoints.InstallIndex(pending);
+
+  return waypoints.GetNearest(wp_a->location, 1) == wp_a &&
+    waypoints.GetNearest(wp_b->location, 1) == wp_b &&
+    waypoints.LookupName(_T("Marker B")) == wp_b;
+}
+
 int
 main(int argc, char** argv)
 {
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(65);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -319,6 +428,7 @@ main(int argc, char** argv)
 
   TestLookups(waypoints, center);
   TestNamePrefixVisitor(waypoints);
+  TestNameContaining(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
   TestIterator(waypoints);
@@ -326,6 +436,7 @@ main(int argc, char** argv)
   ok(TestCopy(waypoints), "waypoint copy", 0);
   ok(TestErase(waypoints, 3), "waypoint erase", 0);
   ok(TestReplace(waypoints, 4), "waypoint replace", 0);
+  ok(TestPendingIndex(waypoints, center), "waypoint pending index", 0);
 
   // test clear
   waypoints.Clear();
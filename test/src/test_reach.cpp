@@ -33,11 +33,14 @@
 #include "GlideSolvers/GlideSettings.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
 #include "Operation/Operation.hpp"
 #include "OS/FileUtil.hpp"
 
 #include <zzip/zzip.h>
 
+#include <algorithm>
+
 #include <string.h>
 
 static void
@@ -101,6 +104,86 @@ test_reach(const RasterMap &map, double mwind, double mc, double height_min_work
   //  printf("# pixel size %g\n", (double)pd);
 }
 
+/**
+ * Compare an incremental reach solution after a small move with a
+ * full solution from the same origin.
+ */
+static void
+test_reach_incremental(const RasterMap &map, double mc,
+                       double height_min_working,
+                       const SpeedVector wind_moved=SpeedVector::Zero())
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.reach_incremental = true;
+
+  GlidePolar polar(mc);
+  SpeedVector wind(Angle::Degrees(0), 0);
+
+  TerrainRoute incremental, full;
+  incremental.UpdatePolar(settings, config, polar, polar, wind,
+                          height_min_working);
+  incremental.SetTerrain(&map);
+  full.UpdatePolar(settings, config, polar, polar, wind,
+                   height_min_working);
+  full.SetTerrain(&map);
+
+  const GeoPoint origin(map.GetMapCenter());
+  const int horigin = map.GetHeight(origin).GetValueOr0() + 1000;
+  incremental.SolveReachTerrain(AGeoPoint(origin, horigin), config, INT_MAX);
+
+  /* glide 200m to the north, a little better than the glide slope;
+     this reuses some of the terrain scans of the previous solution */
+  const AGeoPoint amoved(GeoVector(200, Angle::Zero()).EndPoint(origin),
+                         horigin - 3);
+
+  /* the wind may change in the meantime, which changes the glide
+     slope of all rays */
+  incremental.UpdatePolar(settings, config, polar, polar, wind_moved,
+                          height_min_working);
+  full.UpdatePolar(settings, config, polar, polar, wind_moved,
+                   height_min_working);
+
+  bool retval = incremental.SolveReachTerrain(amoved, config, INT_MAX);
+  ok(retval, "reach terrain incremental", 0);
+
+  RoutePlannerConfig full_config = config;
+  full_config.reach_incremental = false;
+  full.SolveReachTerrain(amoved, full_config, INT_MAX);
+
+  /* the footprints must match; a reused ray may only under-estimate
+     the arrival height */
+  static constexpr int TOLERANCE = 50;
+  unsigned n = 0, n_mismatch = 0;
+  int max_excess = 0;
+  for (int i = -20; i <= 20; ++i) {
+    for (int j = -20; j <= 20; ++j) {
+      GeoPoint x(amoved.longitude + Angle::Degrees(0.015 * i),
+                 amoved.latitude + Angle::Degrees(0.015 * j));
+      const AGeoPoint adest(x, map.GetInterpolatedHeight(x).GetValueOr0());
+
+      ReachResult a, b;
+      incremental.FindPositiveArrival(adest, a);
+      full.FindPositiveArrival(adest, b);
+
+      ++n;
+      if (a.IsReachableTerrain() != b.IsReachableTerrain() ||
+          (a.IsReachableTerrain() && abs(a.terrain - b.terrain) > TOLERANCE))
+        ++n_mismatch;
+
+      if (a.IsReachableTerrain() && b.IsReachableTerrain())
+        max_excess = std::max(max_excess, a.terrain - b.terrain);
+    }
+  }
+
+  printf("# incremental: %u of %u points differ, max excess %d m\n",
+         n_mismatch, n, max_excess);
+  ok(n_mismatch * 50 <= n && max_excess <= TOLERANCE,
+     "reach terrain incremental footprint", 0);
+}
+
 int main(int argc, char** argv) {
   static const char hc_path[] = "tmp/map.xcm";
   const char *map_path;
@@ -135,11 +218,15 @@ int main(int argc, char** argv) {
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(8);
+  plan_tests(14);
   test_reach(map, 0, 0.1, 0);
   test_reach(map, 0, 0.1, 750);
   test_reach(map, 0, 0.1, 500);
   test_reach(map, 0, 0.1, 250);
+  test_reach_incremental(map, 0.1, 0);
+  test_reach_incremental(map, 0.1, 500);
+  test_reach_incremental(map, 0.1, 0,
+                         SpeedVector(Angle::Degrees(180), 0.5));
 
   return exit_status();
 }
@@ -148,6 +148,7 @@ test_route(const unsigned n_airspaces, const RasterMap& map)
     GlideSettings settings;
     settings.SetDefaults();
     RoutePlannerConfig config;
+    config.SetDefaults();
     config.mode = RoutePlannerConfig::Mode::BOTH;
 
     AirspaceRoute route;
@@ -176,6 +177,65 @@ test_route(const unsigned n_airspaces, const RasterMap& map)
       sprintf(buffer, "route %d solution", i);
       ok(sol, buffer, 0);
     }
+
+    // the last route again, in anytime mode with a tiny time budget
+    route.Solve(loc_start, loc_end, config);
+    const unsigned cost = route.GetSolveStats().cost;
+
+    /* a pending search is continued only while the configuration
+       stays the same */
+    route.Reset();
+    config.time_budget = std::chrono::nanoseconds(1);
+    route.Synchronise(airspaces, predicate, loc_start, loc_end);
+    route.Solve(loc_start, loc_end, config);
+    ok(route.GetSolveStats().pending, "anytime route pending", 0);
+    route.Solve(loc_start, loc_end, config);
+    ok(route.GetSolveStats().total_duration >
+       route.GetSolveStats().duration, "anytime route resumed", 0);
+    config.safety_height_terrain += 50;
+    route.Solve(loc_start, loc_end, config);
+    ok(route.GetSolveStats().total_duration ==
+       route.GetSolveStats().duration, "anytime route restarted", 0);
+    config.safety_height_terrain -= 50;
+
+    route.Reset();
+    config.time_budget = std::chrono::microseconds(100);
+    unsigned n_calls = 0;
+    do {
+      route.Synchronise(airspaces, predicate, loc_start, loc_end);
+      route.Solve(loc_start, loc_end, config);
+      ++n_calls;
+    } while (route.GetSolveStats().pending && n_calls < 100000);
+
+    if (verbose)
+      printf("# anytime solution after %u calls\n", n_calls);
+
+    const RoutePlanner::SolveStats &stats = route.GetSolveStats();
+    ok(!stats.pending, "anytime route finished", 0);
+    ok(stats.IsOptimal(), "anytime route optimal", 0);
+    ok(stats.cost <= cost, "anytime route cost", 0);
+
+    /* the destination (the aircraft) moves between the calls; the
+       pending search is continued towards the position it was started
+       with */
+    route.Reset();
+    AGeoPoint moving_end = loc_end;
+    n_calls = 0;
+    do {
+      route.Synchronise(airspaces, predicate, loc_start, moving_end);
+      route.Solve(loc_start, moving_end, config);
+      moving_end.latitude += Angle::Degrees(0.0005);
+      ++n_calls;
+    } while (stats.pending && n_calls < 100000);
+
+    if (verbose)
+      printf("# moving anytime solution after %u calls\n", n_calls);
+
+    ok(n_calls > 1 && !stats.pending, "moving anytime route finished", 0);
+    ok(stats.IsOptimal() && stats.cost <= cost,
+       "moving anytime route optimal", 0);
+    ok(route.GetSolution().back().Distance(loc_end) < 1,
+       "moving anytime route destination", 0);
   }
 
   return true;
@@ -211,7 +271,7 @@ main(int argc, char** argv)
   } while (map.IsDirty());
   zzip_dir_close(dir);
 
-  plan_tests(4 + NUM_SOL);
+  plan_tests(13 + NUM_SOL);
   ok(test_route(28, map), "route 28", 0);
   return exit_status();
 }